@@ -0,0 +1,66 @@
+// Videomancer SDK - Benchmark Helpers
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace bench
+{
+    /// @brief Monotonic time in nanoseconds
+    inline uint64_t now_ns()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /// @brief Summary of a set of latency samples
+    struct summary
+    {
+        double min;
+        double p50;
+        double p99;
+        double max;
+        double mean;
+    };
+
+    /// @brief Summarize samples (sorts the input)
+    inline summary summarize(std::vector<double>& samples)
+    {
+        summary s = { 0, 0, 0, 0, 0 };
+        if (samples.empty())
+            return s;
+
+        std::sort(samples.begin(), samples.end());
+        double total = 0.0;
+        for (double v : samples)
+            total += v;
+
+        s.min = samples.front();
+        s.p50 = samples[samples.size() / 2];
+        s.p99 = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+        s.max = samples.back();
+        s.mean = total / static_cast<double>(samples.size());
+        return s;
+    }
+
+    /// @brief Print a summary row in microseconds
+    inline void print_summary_us(const char* label, const summary& s)
+    {
+        std::printf("%-34s min %8.2f  p50 %8.2f  p99 %8.2f  max %9.2f  mean %8.2f us\n",
+                    label, s.min, s.p50, s.p99, s.max, s.mean);
+    }
+
+    /// @brief Print the benchmark banner
+    inline void print_banner(const char* title)
+    {
+        std::printf("======================================\n");
+        std::printf("%s\n", title);
+        std::printf("======================================\n\n");
+    }
+}
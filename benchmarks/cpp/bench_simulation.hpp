@@ -0,0 +1,114 @@
+// Videomancer SDK - Simulated Storage and SPI for Benchmarks
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+//
+// Stream and FPGA implementations that charge a simulated clock for every
+// operation, so host runs of the real loader code report the I/O time a
+// slower target would spend.
+
+#pragma once
+
+#include "bench_vmprog_package.hpp"
+#include <lzx/videomancer/videomancer_clock.hpp>
+#include <lzx/videomancer/videomancer_fpga.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace bench
+{
+    /// @brief Throughput and fixed per-operation cost of a simulated link
+    struct io_profile
+    {
+        double bytes_per_second;
+        double op_latency_us;
+    };
+
+    /// @brief Time in microseconds to move size bytes in one operation
+    inline double io_cost_us(const io_profile& profile, size_t size)
+    {
+        double us = profile.op_latency_us;
+        if (profile.bytes_per_second > 0.0)
+            us += static_cast<double>(size) * 1e6 / profile.bytes_per_second;
+        return us;
+    }
+
+    /// @brief Clock advanced explicitly by the simulators
+    class simulated_clock : public lzx::videomancer_clock
+    {
+    public:
+        uint64_t now_us() override { return static_cast<uint64_t>(m_us); }
+
+        void advance_us(double us) { m_us += us; }
+        double elapsed_us() const { return m_us; }
+
+    private:
+        double m_us = 0.0;
+    };
+
+    /// @brief Package stream that charges each read to a simulated clock
+    ///
+    /// Every read() costs one operation latency plus the transfer time of the
+    /// bytes returned. Seeks are free; the latency of re-addressing is part
+    /// of the next read.
+    class simulated_stream : public memory_stream
+    {
+    public:
+        simulated_stream(const std::vector<uint8_t>& data, simulated_clock& clock, const io_profile& profile)
+            : memory_stream(data), m_clock(clock), m_profile(profile)
+        {}
+
+        size_t read(uint8_t* buffer, size_t size) override
+        {
+            const size_t n = memory_stream::read(buffer, size);
+            m_clock.advance_us(io_cost_us(m_profile, n));
+            ++m_reads;
+            m_bytes_read += n;
+            return n;
+        }
+
+        uint32_t reads() const { return m_reads; }
+        uint64_t bytes_read() const { return m_bytes_read; }
+
+    private:
+        simulated_clock& m_clock;
+        io_profile m_profile;
+        uint32_t m_reads = 0;
+        uint64_t m_bytes_read = 0;
+    };
+
+    /// @brief FPGA SPI endpoint that charges each transfer to a simulated clock
+    ///
+    /// Data is discarded. bytes_per_second is the SPI clock divided by 8.
+    class simulated_fpga : public lzx::videomancer_fpga
+    {
+    public:
+        simulated_fpga(simulated_clock& clock, const io_profile& profile)
+            : m_clock(clock), m_profile(profile)
+        {}
+
+        size_t transfer_spi(const uint8_t* tx_buffer, uint8_t* rx_buffer, size_t size) override
+        {
+            (void)tx_buffer;
+            for (size_t i = 0; rx_buffer && i < size; ++i)
+                rx_buffer[i] = 0;
+            m_clock.advance_us(io_cost_us(m_profile, size));
+            ++m_transfers;
+            m_bytes_sent += size;
+            return size;
+        }
+
+        void assert_chip_select_spi(bool assert) override
+        {
+            (void)assert;
+        }
+
+        uint32_t transfers() const { return m_transfers; }
+        uint64_t bytes_sent() const { return m_bytes_sent; }
+
+    private:
+        simulated_clock& m_clock;
+        io_profile m_profile;
+        uint32_t m_transfers = 0;
+        uint64_t m_bytes_sent = 0;
+    };
+}
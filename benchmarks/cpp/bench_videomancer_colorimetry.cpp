@@ -0,0 +1,86 @@
+// Videomancer SDK - YUV to RGB Preview Conversion Benchmark
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+//
+// Converts full 10-bit 4:4:4 frames to RGBA8 with videomancer_colorimetry.hpp
+// on one core, scalar kernel against the SSE2/NEON kernel, for an SD and an
+// HD timing mode. Frames per second are derived from the median frame time.
+
+#include "bench_common.hpp"
+#include <lzx/videomancer/videomancer_colorimetry.hpp>
+#include <random>
+#include <vector>
+
+using namespace lzx;
+
+namespace
+{
+    struct frame
+    {
+        std::vector<uint16_t> y, u, v;
+        std::vector<uint8_t> rgba;
+    };
+
+    frame make_frame(size_t pixels)
+    {
+        frame f;
+        f.y.resize(pixels);
+        f.u.resize(pixels);
+        f.v.resize(pixels);
+        f.rgba.resize(pixels * 4);
+        std::mt19937 rng(1);
+        for (size_t i = 0; i < pixels; ++i)
+        {
+            f.y[i] = static_cast<uint16_t>(64 + rng() % 877);
+            f.u[i] = static_cast<uint16_t>(64 + rng() % 897);
+            f.v[i] = static_cast<uint16_t>(64 + rng() % 897);
+        }
+        return f;
+    }
+
+    template <typename Kernel>
+    bench::summary time_frames(frame& f, const videomancer_yuv_coefficients& k, Kernel kernel, int iterations)
+    {
+        std::vector<double> samples;
+        for (int i = 0; i < iterations; ++i)
+        {
+            const uint64_t t0 = bench::now_ns();
+            kernel(f.y.data(), f.u.data(), f.v.data(), f.rgba.data(), f.y.size(), k);
+            samples.push_back(static_cast<double>(bench::now_ns() - t0) / 1000.0);
+        }
+        return bench::summarize(samples);
+    }
+}
+
+int main()
+{
+    bench::print_banner("Videomancer YUV to RGB Preview Benchmark");
+#if defined(VIDEOMANCER_COLORIMETRY_SSE2)
+    const char* vector_name = "SSE2";
+#elif defined(VIDEOMANCER_COLORIMETRY_NEON)
+    const char* vector_name = "NEON";
+#else
+    const char* vector_name = "scalar (no SIMD)";
+#endif
+    std::printf("Vector kernel: %s\n\n", vector_name);
+
+    using id = videomancer_abi_v1_0::video_timing_id;
+    const id modes[] = { id::ntsc, id::_1080p30 };
+    for (id mode : modes)
+    {
+        const auto& info = videomancer_abi_v1_0::get_video_timing_info(mode);
+        const auto matrix = get_videomancer_color_matrix(mode);
+        const auto& k = get_videomancer_yuv_coefficients(matrix);
+        frame f = make_frame(static_cast<size_t>(info.frame_width) * info.frame_height);
+
+        std::printf("%ux%u, %s\n", info.frame_width, info.frame_height,
+                    matrix == videomancer_color_matrix::bt601 ? "BT.601" : "BT.709");
+        const bench::summary scalar = time_frames(f, k, convert_yuv444_to_rgba8_scalar, 30);
+        const bench::summary vector = time_frames(f, k, convert_yuv444_to_rgba8, 200);
+        bench::print_summary_us("  scalar", scalar);
+        bench::print_summary_us("  vector", vector);
+        std::printf("  scalar %.0f fps, vector %.0f fps, speedup %.1fx\n\n",
+                    1e6 / scalar.p50, 1e6 / vector.p50, scalar.p50 / vector.p50);
+    }
+    return 0;
+}
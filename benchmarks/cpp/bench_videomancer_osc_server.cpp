@@ -0,0 +1,198 @@
+// Videomancer SDK - OSC/UDP Control Server Benchmark
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+//
+// Measures, over loopback UDP:
+//   - Message-to-SPI latency: one OSC message in flight at a time, timed from
+//     sendto() until the controller issues the register write
+//   - Burst throughput: messages per second the server drains, and SPI writes
+//     issued per message after batch coalescing
+
+#include "bench_common.hpp"
+#include <lzx/videomancer/videomancer_osc_server.hpp>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace lzx;
+
+#ifdef VIDEOMANCER_OSC_HAS_EPOLL
+
+namespace
+{
+    // SPI endpoint that timestamps every write frame
+    class timestamp_fpga : public videomancer_fpga
+    {
+    public:
+        std::atomic<uint64_t> frames{0};
+        std::atomic<uint64_t> last_frame_ns{0};
+
+        size_t transfer_spi(const uint8_t*, uint8_t* rx_buffer, size_t size) override
+        {
+            if (rx_buffer)
+                memset(rx_buffer, 0, size);
+            last_frame_ns.store(bench::now_ns(), std::memory_order_relaxed);
+            frames.fetch_add(size / 2, std::memory_order_release);
+            return size;
+        }
+
+        void assert_chip_select_spi(bool) override {}
+    };
+
+    size_t build_message(uint8_t* out, const char* address, int32_t value)
+    {
+        const size_t length = strlen(address);
+        const size_t padded = osc_padded_size(length);
+        memset(out, 0, padded + 8);
+        memcpy(out, address, length);
+        out[padded] = ',';
+        out[padded + 1] = 'i';
+        const uint32_t v = static_cast<uint32_t>(value);
+        out[padded + 4] = static_cast<uint8_t>(v >> 24);
+        out[padded + 5] = static_cast<uint8_t>(v >> 16);
+        out[padded + 6] = static_cast<uint8_t>(v >> 8);
+        out[padded + 7] = static_cast<uint8_t>(v);
+        return padded + 8;
+    }
+
+    struct server_fixture
+    {
+        timestamp_fpga fpga;
+        videomancer_fpga_controller controller{fpga};
+        videomancer_osc_router router{controller};
+        videomancer_osc_udp_server server{router};
+        std::atomic<bool> stop{false};
+        std::atomic<uint64_t> received{0};
+        std::thread thread;
+        int sender = -1;
+        sockaddr_in addr = {};
+
+        bool start()
+        {
+            for (uint32_t id = 1; id <= 12; ++id)
+            {
+                char address[32];
+                std::snprintf(address, sizeof(address), "/videomancer/param/%u", id);
+                router.add_route(address, static_cast<vmprog_parameter_id_v1_0>(id));
+            }
+            if (!server.open(0))
+                return false;
+
+            thread = std::thread([this]() {
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    const int n = server.run_once(10);
+                    if (n > 0)
+                        received.fetch_add(static_cast<uint64_t>(n), std::memory_order_relaxed);
+                }
+            });
+
+            sender = ::socket(AF_INET, SOCK_DGRAM, 0);
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(server.port());
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            return sender >= 0;
+        }
+
+        void finish()
+        {
+            stop.store(true);
+            thread.join();
+            ::close(sender);
+        }
+
+        void send(const uint8_t* data, size_t size)
+        {
+            ::sendto(sender, data, size, 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        }
+    };
+
+    void bench_latency(size_t iterations)
+    {
+        server_fixture f;
+        if (!f.start())
+        {
+            std::printf("Latency benchmark: cannot open UDP socket\n");
+            return;
+        }
+
+        std::vector<double> samples;
+        samples.reserve(iterations);
+        uint8_t packet[64];
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            // Alternate values so the controller never filters the write
+            const size_t size = build_message(packet, "/videomancer/param/1", static_cast<int32_t>(i & 1 ? 100 : 900));
+            const uint64_t before = f.fpga.frames.load(std::memory_order_acquire);
+            const uint64_t t0 = bench::now_ns();
+            f.send(packet, size);
+            while (f.fpga.frames.load(std::memory_order_acquire) == before)
+                std::this_thread::yield();
+            samples.push_back(static_cast<double>(f.fpga.last_frame_ns.load() - t0) / 1000.0);
+        }
+        f.finish();
+
+        bench::summary s = bench::summarize(samples);
+        bench::print_summary_us("Message-to-SPI latency", s);
+    }
+
+    void bench_throughput(size_t messages, size_t burst)
+    {
+        server_fixture f;
+        if (!f.start())
+        {
+            std::printf("Throughput benchmark: cannot open UDP socket\n");
+            return;
+        }
+
+        uint8_t packet[64];
+        char address[32];
+        const uint64_t t0 = bench::now_ns();
+        for (size_t i = 0; i < messages; ++i)
+        {
+            // Sweep all 12 controls, as a fader bank would
+            std::snprintf(address, sizeof(address), "/videomancer/param/%u", static_cast<unsigned>(i % 12 + 1));
+            const size_t size = build_message(packet, address, static_cast<int32_t>((i * 7) & 1023));
+            f.send(packet, size);
+            if ((i + 1) % burst == 0)
+                std::this_thread::yield();
+        }
+
+        // Wait for the server to go idle
+        uint64_t last = ~0ull;
+        while (f.received.load() != last)
+        {
+            last = f.received.load();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        const uint64_t t1 = bench::now_ns();
+        f.finish();
+
+        const osc_router_stats& stats = f.router.stats();
+        const double seconds = static_cast<double>(t1 - t0) / 1e9 - 0.02;
+        std::printf("%-34s %zu sent, %u received, %.0f msg/s\n", "Burst throughput",
+                    messages, stats.messages, stats.messages / seconds);
+        std::printf("%-34s %llu SPI writes, %u flushes, %.3f writes/msg\n", "Coalescing",
+                    static_cast<unsigned long long>(f.fpga.frames.load()), f.server.flush_count(),
+                    stats.messages ? static_cast<double>(f.fpga.frames.load()) / stats.messages : 0.0);
+    }
+}
+
+int main()
+{
+    bench::print_banner("Videomancer OSC/UDP Control Server Benchmark");
+    bench_latency(20000);
+    bench_throughput(200000, 64);
+    return 0;
+}
+
+#else
+
+int main()
+{
+    std::printf("OSC server benchmark requires Linux (epoll)\n");
+    return 0;
+}
+
+#endif
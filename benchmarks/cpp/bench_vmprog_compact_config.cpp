@@ -0,0 +1,214 @@
+// Videomancer SDK - Compact Config Size and Parse Time
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+//
+// Compares loading a program's fixed 7372-byte config payload with loading
+// its config_compact encoding:
+//   - fixed:   read + hash + validate into a vmprog_program_config_v1_0
+//   - compact: read + hash + validate + open a zero-copy view
+//   - expand:  compact view back into the fixed struct (legacy callers)
+// The target estimate adds QSPI read and BLAKE2b time on an RP2040, which
+// scale with payload size and dominate on the device.
+//
+// Pass program_config.bin files (as written by toml_to_config_binary.py)
+// to measure shipped programs; with no arguments two built-in configs
+// shaped like passthru and yuv_amplifier are used.
+
+#include "bench_common.hpp"
+#include "bench_simulation.hpp"
+#include "bench_vmprog_package.hpp"
+#include <lzx/videomancer/vmprog_compact_config.hpp>
+#include <cstring>
+#include <string>
+
+using namespace lzx;
+
+namespace
+{
+    constexpr int iterations = 2000;
+    constexpr bench::io_profile rp2040_flash = { 20e6, 5.0 };
+    constexpr double rp2040_hash_bytes_per_second = 1.0e6;
+
+    struct named_config
+    {
+        std::string name;
+        vmprog_program_config_v1_0 config;
+    };
+
+    bool load_config(const char* path, named_config& out)
+    {
+        FILE* file = std::fopen(path, "rb");
+        if (!file)
+            return false;
+        const size_t n = std::fread(&out.config, 1, sizeof(out.config), file);
+        std::fclose(file);
+        if (n != sizeof(out.config) || validate_vmprog_program_config_v1_0(out.config) != vmprog_validation_result::ok)
+            return false;
+        out.name = out.config.program_id;
+        return true;
+    }
+
+    void add_parameter(vmprog_program_config_v1_0& config, vmprog_parameter_id_v1_0 id, const char* name,
+                       const char* suffix, int16_t display_max)
+    {
+        vmprog_parameter_config_v1_0& param = config.parameters[config.parameter_count++];
+        init_parameter_config(param);
+        param.parameter_id = id;
+        param.max_value = 1023;
+        param.initial_value = 512;
+        param.display_max_value = display_max;
+        safe_strncpy(param.name_label, name, sizeof(param.name_label));
+        safe_strncpy(param.suffix_label, suffix, sizeof(param.suffix_label));
+    }
+
+    named_config builtin_config(bool amplifier)
+    {
+        named_config out;
+        init_vmprog_config(out.config);
+        vmprog_program_config_v1_0& config = out.config;
+        safe_strncpy(config.program_id, amplifier ? "com.lzx.yuv_amplifier" : "com.lzx.passthru", sizeof(config.program_id));
+        safe_strncpy(config.program_name, amplifier ? "YUV Amplifier" : "Passthru", sizeof(config.program_name));
+        safe_strncpy(config.author, "LZX Industries", sizeof(config.author));
+        safe_strncpy(config.license, "GPL-3.0", sizeof(config.license));
+        safe_strncpy(config.category, "Utility", sizeof(config.category));
+        safe_strncpy(config.description, "Builtin benchmark config", sizeof(config.description));
+        config.abi_min_major = 1;
+        config.abi_max_major = 2;
+        if (amplifier)
+        {
+            add_parameter(config, vmprog_parameter_id_v1_0::rotary_potentiometer_1, "Y Gain", "%", 200);
+            add_parameter(config, vmprog_parameter_id_v1_0::rotary_potentiometer_2, "U Gain", "%", 200);
+            add_parameter(config, vmprog_parameter_id_v1_0::rotary_potentiometer_3, "V Gain", "%", 200);
+            add_parameter(config, vmprog_parameter_id_v1_0::rotary_potentiometer_4, "Y Offset", "%", 100);
+            add_parameter(config, vmprog_parameter_id_v1_0::rotary_potentiometer_5, "U Offset", "%", 100);
+            add_parameter(config, vmprog_parameter_id_v1_0::rotary_potentiometer_6, "V Offset", "%", 100);
+            vmprog_parameter_config_v1_0& toggle = config.parameters[config.parameter_count - 1];
+            toggle.parameter_id = vmprog_parameter_id_v1_0::toggle_switch_7;
+            toggle.control_mode = vmprog_parameter_control_mode_v1_0::boolean;
+            toggle.max_value = 1;
+            toggle.initial_value = 0;
+            toggle.value_label_count = 2;
+            safe_strncpy(toggle.value_labels[0], "Off", sizeof(toggle.value_labels[0]));
+            safe_strncpy(toggle.value_labels[1], "On", sizeof(toggle.value_labels[1]));
+        }
+        out.name = config.program_id;
+        return out;
+    }
+
+    /// @brief Package holding only a config entry and a config_compact entry
+    std::vector<uint8_t> build_config_package(const vmprog_program_config_v1_0& config, const uint8_t* compact,
+                                              uint32_t compact_size, vmprog_toc_entry_v1_0 toc[2])
+    {
+        std::vector<uint8_t> data(sizeof(config) + compact_size);
+        std::memcpy(data.data(), &config, sizeof(config));
+        std::memcpy(data.data() + sizeof(config), compact, compact_size);
+
+        init_toc_entry(toc[0]);
+        toc[0].type = vmprog_toc_entry_type_v1_0::config;
+        toc[0].offset = 0;
+        toc[0].size = sizeof(config);
+        sha256_oneshot(data.data(), toc[0].size, toc[0].sha256);
+
+        init_toc_entry(toc[1]);
+        toc[1].type = vmprog_toc_entry_type_v1_0::config_compact;
+        toc[1].offset = sizeof(config);
+        toc[1].size = compact_size;
+        sha256_oneshot(data.data() + toc[1].offset, toc[1].size, toc[1].sha256);
+        return data;
+    }
+
+    template <typename Fn>
+    bench::summary time_us(Fn fn)
+    {
+        std::vector<double> samples;
+        samples.reserve(iterations);
+        for (int i = 0; i < iterations; ++i)
+        {
+            const uint64_t t0 = bench::now_ns();
+            if (!fn())
+                std::printf("  load failed\n");
+            samples.push_back(static_cast<double>(bench::now_ns() - t0) / 1000.0);
+        }
+        return bench::summarize(samples);
+    }
+
+    double target_us(uint32_t size)
+    {
+        return bench::io_cost_us(rp2040_flash, size) + static_cast<double>(size) * 1e6 / rp2040_hash_bytes_per_second;
+    }
+
+    void bench_config(const named_config& program)
+    {
+        static uint8_t compact[vmprog_compact_config_max_size];
+        const uint32_t compact_size = encode_vmprog_compact_config(program.config, compact, sizeof(compact));
+        if (compact_size == 0)
+        {
+            std::printf("%s: cannot encode\n\n", program.name.c_str());
+            return;
+        }
+
+        vmprog_toc_entry_v1_0 toc[2];
+        const std::vector<uint8_t> package = build_config_package(program.config, compact, compact_size, toc);
+        bench::memory_stream stream(package);
+
+        // Signature checked once when the program list is built, not per read
+        vmprog_signed_descriptor_v1_0 descriptor;
+        init_signed_descriptor(descriptor);
+        descriptor.artifact_count = 1;
+        descriptor.artifacts[0].type = vmprog_toc_entry_type_v1_0::config_compact;
+        std::memcpy(descriptor.artifacts[0].sha256, toc[1].sha256, sizeof(descriptor.artifacts[0].sha256));
+
+        static vmprog_program_config_v1_0 fixed;
+        static uint8_t buffer[vmprog_compact_config_max_size];
+        vmprog_compact_config_view view;
+        static vmprog_program_config_v1_0 expanded;
+
+        std::printf("%s: %u parameters, fixed %u bytes, compact %u bytes (%.1f%%)\n",
+                    program.name.c_str(), program.config.parameter_count,
+                    static_cast<unsigned>(sizeof(fixed)), compact_size,
+                    100.0 * compact_size / static_cast<double>(sizeof(fixed)));
+        if (read_vmprog_compact_config(stream, toc[1], descriptor, buffer, sizeof(buffer), view) != vmprog_validation_result::ok ||
+            (view.expand(expanded), std::memcmp(&expanded, &program.config, sizeof(expanded)) != 0))
+            std::printf("  warning: expanded config differs from the original\n");
+
+        const bench::summary fixed_us = time_us([&] {
+            return read_and_validate_vmprog_config(stream, toc[0], fixed) == vmprog_validation_result::ok;
+        });
+        const bench::summary compact_us = time_us([&] {
+            return read_vmprog_compact_config(stream, toc[1], descriptor, buffer, sizeof(buffer), view) == vmprog_validation_result::ok;
+        });
+        const bench::summary expand_us = time_us([&] {
+            view.expand(expanded);
+            return true;
+        });
+        bench::print_summary_us("  fixed read+hash+validate", fixed_us);
+        bench::print_summary_us("  compact read+hash+open", compact_us);
+        bench::print_summary_us("  compact expand", expand_us);
+        std::printf("  target read+hash (RP2040 est.)   fixed %8.0f us  compact %8.0f us\n\n",
+                    target_us(sizeof(fixed)), target_us(compact_size));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bench::print_banner("Videomancer Compact Config Benchmark");
+
+    std::vector<named_config> programs;
+    for (int i = 1; i < argc; ++i)
+    {
+        named_config program;
+        if (load_config(argv[i], program))
+            programs.push_back(program);
+        else
+            std::printf("Skipping %s: not a valid program_config.bin\n", argv[i]);
+    }
+    if (argc <= 1)
+    {
+        programs.push_back(builtin_config(false));
+        programs.push_back(builtin_config(true));
+    }
+
+    for (const named_config& program : programs)
+        bench_config(program);
+    return 0;
+}
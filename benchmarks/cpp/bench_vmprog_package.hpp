@@ -0,0 +1,152 @@
+// Videomancer SDK - Benchmark Package Builder
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <lzx/videomancer/vmprog_stream_reader.hpp>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace bench
+{
+    /// @brief Bitstream size of an iCE40 HX4K configuration image
+    constexpr uint32_t ice40_hx4k_bitstream_size = 135100;
+
+    /// @brief Read-only stream over a byte vector
+    class memory_stream : public lzx::vmprog_stream
+    {
+    public:
+        explicit memory_stream(const std::vector<uint8_t>& data) : m_data(data) {}
+
+        size_t read(uint8_t* buffer, size_t size) override
+        {
+            if (m_position >= m_data.size())
+                return 0;
+            const size_t n = std::min(size, m_data.size() - m_position);
+            std::memcpy(buffer, m_data.data() + m_position, n);
+            m_position += n;
+            return n;
+        }
+
+        bool seek(size_t position) override
+        {
+            if (position > m_data.size())
+                return false;
+            m_position = position;
+            return true;
+        }
+
+    private:
+        const std::vector<uint8_t>& m_data;
+        size_t m_position = 0;
+    };
+
+    /// @brief Build a signed package with up to three bitstream variants
+    ///
+    /// Variants are sd_analog, hd_analog and hd_hdmi, in that order. The config
+    /// maps the six rotary pots and linear pot 12 so loading it produces
+    /// register writes.
+    /// @param out_public_key Receives the signing public key (32 bytes)
+    /// @param bitstream_size Size of each bitstream payload
+    /// @param variant_count Number of bitstream variants (1-3)
+    inline std::vector<uint8_t> build_signed_package(uint8_t out_public_key[32],
+                                                     uint32_t bitstream_size,
+                                                     uint32_t variant_count)
+    {
+        using namespace lzx;
+
+        uint8_t seed[32];
+        for (int i = 0; i < 32; ++i)
+            seed[i] = static_cast<uint8_t>(i + 7);
+        uint8_t secret_key[64];
+        crypto_ed25519_key_pair(secret_key, out_public_key, seed);
+
+        vmprog_program_config_v1_0 config;
+        init_vmprog_config(config);
+        safe_strncpy(config.program_id, "bench.package", sizeof(config.program_id));
+        safe_strncpy(config.program_name, "Bench Package", sizeof(config.program_name));
+        const vmprog_parameter_id_v1_0 parameter_ids[7] = {
+            vmprog_parameter_id_v1_0::rotary_potentiometer_1, vmprog_parameter_id_v1_0::rotary_potentiometer_2,
+            vmprog_parameter_id_v1_0::rotary_potentiometer_3, vmprog_parameter_id_v1_0::rotary_potentiometer_4,
+            vmprog_parameter_id_v1_0::rotary_potentiometer_5, vmprog_parameter_id_v1_0::rotary_potentiometer_6,
+            vmprog_parameter_id_v1_0::linear_potentiometer_12,
+        };
+        config.parameter_count = 7;
+        for (uint32_t i = 0; i < 7; ++i)
+        {
+            config.parameters[i].parameter_id = parameter_ids[i];
+            config.parameters[i].max_value = 1023;
+            config.parameters[i].initial_value = static_cast<uint16_t>(100 + i * 100);
+            config.parameters[i].display_max_value = 100;
+        }
+
+        const vmprog_toc_entry_type_v1_0 all_variants[3] = {
+            vmprog_toc_entry_type_v1_0::bitstream_sd_analog,
+            vmprog_toc_entry_type_v1_0::bitstream_hd_analog,
+            vmprog_toc_entry_type_v1_0::bitstream_hd_hdmi,
+        };
+        variant_count = std::min<uint32_t>(std::max<uint32_t>(variant_count, 1), 3);
+        std::vector<uint8_t> bitstreams[3];
+        for (uint32_t v = 0; v < variant_count; ++v)
+        {
+            bitstreams[v].resize(bitstream_size);
+            for (uint32_t i = 0; i < bitstream_size; ++i)
+                bitstreams[v][i] = static_cast<uint8_t>(i * 31 + v);
+        }
+
+        vmprog_signed_descriptor_v1_0 descriptor;
+        init_signed_descriptor(descriptor);
+        sha256_oneshot(reinterpret_cast<const uint8_t*>(&config), sizeof(config), descriptor.config_sha256);
+        descriptor.artifact_count = static_cast<uint8_t>(variant_count);
+        for (uint32_t v = 0; v < variant_count; ++v)
+        {
+            descriptor.artifacts[v].type = all_variants[v];
+            sha256_oneshot(bitstreams[v].data(), bitstream_size, descriptor.artifacts[v].sha256);
+        }
+        uint8_t signature[64];
+        crypto_ed25519_sign(signature, secret_key, reinterpret_cast<const uint8_t*>(&descriptor), sizeof(descriptor));
+
+        const uint32_t toc_count = 3 + variant_count;
+        const uint8_t* payloads[6] = {
+            reinterpret_cast<const uint8_t*>(&config), reinterpret_cast<const uint8_t*>(&descriptor), signature,
+            bitstreams[0].data(), bitstreams[1].data(), bitstreams[2].data(),
+        };
+        const vmprog_toc_entry_type_v1_0 types[6] = {
+            vmprog_toc_entry_type_v1_0::config, vmprog_toc_entry_type_v1_0::signed_descriptor,
+            vmprog_toc_entry_type_v1_0::signature, all_variants[0], all_variants[1], all_variants[2],
+        };
+        const uint32_t sizes[6] = {
+            sizeof(config), sizeof(descriptor), 64, bitstream_size, bitstream_size, bitstream_size,
+        };
+
+        vmprog_toc_entry_v1_0 toc[6];
+        const uint32_t toc_bytes = toc_count * sizeof(vmprog_toc_entry_v1_0);
+        uint32_t offset = sizeof(vmprog_header_v1_0) + toc_bytes;
+        for (uint32_t i = 0; i < toc_count; ++i)
+        {
+            init_toc_entry(toc[i]);
+            toc[i].type = types[i];
+            toc[i].offset = offset;
+            toc[i].size = sizes[i];
+            sha256_oneshot(payloads[i], sizes[i], toc[i].sha256);
+            offset += sizes[i];
+        }
+
+        vmprog_header_v1_0 header;
+        init_vmprog_header(header);
+        header.flags = vmprog_header_flags_v1_0::signed_pkg;
+        header.file_size = offset;
+        header.toc_offset = sizeof(vmprog_header_v1_0);
+        header.toc_count = toc_count;
+        header.toc_bytes = toc_bytes;
+
+        std::vector<uint8_t> package(offset);
+        std::memcpy(package.data(), &header, sizeof(header));
+        std::memcpy(package.data() + header.toc_offset, toc, toc_bytes);
+        for (uint32_t i = 0; i < toc_count; ++i)
+            std::memcpy(package.data() + toc[i].offset, payloads[i], sizes[i]);
+        return package;
+    }
+}
@@ -0,0 +1,100 @@
+// Videomancer SDK - Program Preloader Benchmark
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+//
+// Measures program switch latency for a signed package with three
+// iCE40-sized bitstream variants:
+//   - Cold switch: full stream validation, open, read bitstream, push
+//   - Cold switch with selective verification (signature, config, one variant)
+//   - Preloaded switch: push the staged bitstream only
+//   - Longest single preloader step, which bounds the stall the main loop
+//     sees while preloading in the background
+// Pushing the bitstream is a memcpy into a stub configuration memory; on the
+// device the SPI configuration transfer adds the same time to every path.
+
+#include "bench_common.hpp"
+#include "bench_vmprog_package.hpp"
+#include <lzx/videomancer/vmprog_program_preloader.hpp>
+
+using namespace lzx;
+
+int main()
+{
+    bench::print_banner("Videomancer Program Preloader Benchmark");
+
+    uint8_t public_key[32];
+    const uint32_t bitstream_size = bench::ice40_hx4k_bitstream_size;
+    const std::vector<uint8_t> package = bench::build_signed_package(public_key, bitstream_size, 3);
+    const uint32_t file_size = static_cast<uint32_t>(package.size());
+    const vmprog_toc_entry_type_v1_0 variant = vmprog_toc_entry_type_v1_0::bitstream_hd_analog;
+    std::printf("Package %u KB, bitstream %u bytes\n\n", file_size / 1024, bitstream_size);
+
+    std::vector<uint8_t> scratch(bitstream_size);
+    std::vector<uint8_t> bitstream(bitstream_size);
+    std::vector<uint8_t> config_memory(bitstream_size);
+    static vmprog_program_config_v1_0 config;
+    const size_t iterations = 100;
+
+    // Cold: validate everything, then read and push
+    std::vector<double> cold;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        bench::memory_stream stream(package);
+        const uint64_t t0 = bench::now_ns();
+        validate_vmprog_package_stream(stream, file_size, true, true, public_key, scratch.data(), bitstream_size);
+        vmprog_package_reader reader;
+        reader.open(stream, file_size, false);
+        reader.read_payload_by_type(variant, bitstream.data(), bitstream_size);
+        memcpy(config_memory.data(), bitstream.data(), bitstream_size);
+        cold.push_back(static_cast<double>(bench::now_ns() - t0) / 1000.0);
+    }
+
+    // Cold, selective verification of the one variant
+    std::vector<double> selective;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        bench::memory_stream stream(package);
+        const uint64_t t0 = bench::now_ns();
+        validate_vmprog_package_selective_stream(stream, file_size, variant, public_key, scratch.data(), 4096, config);
+        vmprog_package_reader reader;
+        reader.open(stream, file_size, false);
+        reader.read_payload_by_type(variant, bitstream.data(), bitstream_size);
+        memcpy(config_memory.data(), bitstream.data(), bitstream_size);
+        selective.push_back(static_cast<double>(bench::now_ns() - t0) / 1000.0);
+    }
+
+    // Preloaded: background steps are timed separately; the switch is the push
+    std::vector<double> warm;
+    std::vector<double> steps;
+    uint8_t chunk[4096];
+    vmprog_program_preloader preloader(chunk, sizeof(chunk));
+    vmprog_preload_buffer staging(bitstream.data(), bitstream_size);
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        bench::memory_stream stream(package);
+        preloader.begin(stream, file_size, variant, staging, public_key);
+        while (preloader.is_busy())
+        {
+            const uint64_t s0 = bench::now_ns();
+            preloader.step();
+            steps.push_back(static_cast<double>(bench::now_ns() - s0) / 1000.0);
+        }
+        if (!preloader.is_ready())
+            std::printf("Preload failed\n");
+
+        const uint64_t t0 = bench::now_ns();
+        memcpy(config_memory.data(), staging.data(), staging.size());
+        warm.push_back(static_cast<double>(bench::now_ns() - t0) / 1000.0);
+    }
+
+    bench::summary s = bench::summarize(cold);
+    bench::print_summary_us("Cold switch (full validation)", s);
+    s = bench::summarize(selective);
+    bench::print_summary_us("Cold switch (selective verify)", s);
+    s = bench::summarize(warm);
+    bench::print_summary_us("Preloaded switch", s);
+    s = bench::summarize(steps);
+    bench::print_summary_us("Preloader step (4 KB chunk)", s);
+    std::printf("%-34s %.0f steps per preload\n", "", static_cast<double>(steps.size()) / iterations);
+    return 0;
+}
@@ -0,0 +1,295 @@
+// Videomancer SDK - Program Switch Latency Breakdown
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+//
+// Runs the real package reader, validation and controller code against
+// simulated storage and SPI, and splits a program switch into phases:
+//   - Header + TOC read and validation
+//   - Payload hashing and signature check (full or selective)
+//   - Config parse
+//   - Initial parameter register writes
+//   - Bitstream push to the FPGA
+// Each phase reports host time and a target estimate: simulated I/O time
+// plus modeled CPU time for hashing, Ed25519 and the remaining host work.
+//
+// The default target is an RP2040 loading from QSPI flash and configuring
+// the FPGA over SPI. Its figures are assumptions; override them with
+// name=value arguments, e.g. spi_mhz=40 hash_mbps=2.5. Names:
+//   flash_mbps, flash_latency_us, spi_mhz, spi_latency_us,
+//   hash_mbps, verify_ms, cpu_scale
+
+#include "bench_common.hpp"
+#include "bench_simulation.hpp"
+#include <lzx/videomancer/videomancer_fpga_controller.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+using namespace lzx;
+
+namespace
+{
+    struct target_model
+    {
+        bench::io_profile flash;
+        bench::io_profile spi;
+        double hash_bytes_per_second;
+        double signature_verify_us;
+        double cpu_scale;  // target CPU time per host CPU time for other work
+    };
+
+    target_model rp2040_model()
+    {
+        target_model model;
+        model.flash = { 20e6, 5.0 };      // QSPI reads through the flash driver
+        model.spi = { 25e6 / 8.0, 2.0 };  // 25 MHz SPI, DMA setup per transfer
+        model.hash_bytes_per_second = 1.0e6;  // BLAKE2b on Cortex-M0+ (64-bit ops emulated)
+        model.signature_verify_us = 200000.0;
+        model.cpu_scale = 25.0;
+        return model;
+    }
+
+    bool apply_override(target_model& model, const char* arg)
+    {
+        const char* eq = std::strchr(arg, '=');
+        if (!eq)
+            return false;
+        const std::string name(arg, eq);
+        const double value = std::atof(eq + 1);
+        if (name == "flash_mbps")            model.flash.bytes_per_second = value * 1e6;
+        else if (name == "flash_latency_us") model.flash.op_latency_us = value;
+        else if (name == "spi_mhz")          model.spi.bytes_per_second = value * 1e6 / 8.0;
+        else if (name == "spi_latency_us")   model.spi.op_latency_us = value;
+        else if (name == "hash_mbps")        model.hash_bytes_per_second = value * 1e6;
+        else if (name == "verify_ms")        model.signature_verify_us = value * 1000.0;
+        else if (name == "cpu_scale")        model.cpu_scale = value;
+        else return false;
+        return true;
+    }
+
+    /// @brief Cost model tag for a phase's CPU time
+    enum class cpu_cost : uint8_t
+    {
+        scaled,     // host time times cpu_scale
+        hashing,    // every byte read is hashed
+        signature,  // one Ed25519 verification
+        selective,  // one verification plus hashing every byte read
+    };
+
+    struct phase_stats
+    {
+        const char* name;
+        cpu_cost cost;
+        std::vector<double> host_us;
+        double io_us = 0.0;
+        uint64_t bytes_read = 0;
+    };
+
+    /// @brief Everything one switch operates on
+    struct switch_context
+    {
+        bench::simulated_clock clock;
+        bench::simulated_stream stream;
+        bench::simulated_fpga fpga;
+        videomancer_fpga_controller controller;
+        vmprog_header_v1_0 header;
+        vmprog_toc_entry_v1_0 toc[vmprog_stream_max_toc_entries];
+        vmprog_program_config_v1_0 config;
+
+        switch_context(const std::vector<uint8_t>& package, const target_model& model)
+            : stream(package, clock, model.flash)
+            , fpga(clock, model.spi)
+            , controller(fpga)
+        {}
+    };
+
+    template <typename Fn>
+    bool run_phase(phase_stats& stats, switch_context& ctx, bool record_io, Fn fn)
+    {
+        const double io0 = ctx.clock.elapsed_us();
+        const uint64_t bytes0 = ctx.stream.bytes_read();
+        const uint64_t t0 = bench::now_ns();
+        const bool ok = fn();
+        stats.host_us.push_back(static_cast<double>(bench::now_ns() - t0) / 1000.0);
+        if (record_io)
+        {
+            stats.io_us = ctx.clock.elapsed_us() - io0;
+            stats.bytes_read = ctx.stream.bytes_read() - bytes0;
+        }
+        return ok;
+    }
+
+    /// @brief Stream a bitstream into the FPGA SPI configuration port
+    ///
+    /// Mirrors iCE40 slave SPI configuration: the image is clocked in with
+    /// chip select held, followed by dummy clocks to start the device.
+    bool push_bitstream(switch_context& ctx, const vmprog_toc_entry_v1_0& entry, uint8_t* chunk, uint32_t chunk_size)
+    {
+        if (!ctx.stream.seek(entry.offset))
+            return false;
+        ctx.fpga.assert_chip_select_spi(true);
+        uint32_t remaining = entry.size;
+        while (remaining > 0)
+        {
+            const uint32_t n = remaining < chunk_size ? remaining : chunk_size;
+            if (ctx.stream.read(chunk, n) != n)
+            {
+                ctx.fpga.assert_chip_select_spi(false);
+                return false;
+            }
+            ctx.fpga.transfer_spi(chunk, nullptr, n);
+            remaining -= n;
+        }
+        ctx.fpga.assert_chip_select_spi(false);
+        const uint8_t dummy[8] = {};
+        ctx.fpga.transfer_spi(dummy, nullptr, sizeof(dummy));
+        return true;
+    }
+
+    bool apply_initial_parameters(switch_context& ctx)
+    {
+        ctx.controller.begin_batch();
+        for (uint32_t i = 0; i < ctx.config.parameter_count; ++i)
+            ctx.controller.set_parameter(ctx.config.parameters[i].parameter_id, ctx.config.parameters[i].initial_value);
+        return ctx.controller.flush();
+    }
+
+    double modeled_cpu_us(const phase_stats& stats, double host_p50_us, const target_model& model)
+    {
+        const double hash_us = static_cast<double>(stats.bytes_read) * 1e6 / model.hash_bytes_per_second;
+        switch (stats.cost)
+        {
+            case cpu_cost::hashing:   return hash_us;
+            case cpu_cost::signature: return model.signature_verify_us;
+            case cpu_cost::selective: return model.signature_verify_us + hash_us;
+            default:                  return host_p50_us * model.cpu_scale;
+        }
+    }
+
+    void print_breakdown(const char* title, std::vector<phase_stats>& phases, const target_model& model)
+    {
+        std::printf("%s\n", title);
+        std::printf("  %-22s %10s %10s %12s %12s %12s\n",
+                    "Phase", "Host us", "Read KB", "Target I/O", "Target CPU", "Target ms");
+        double total_host = 0.0, total_io = 0.0, total_cpu = 0.0;
+        for (phase_stats& phase : phases)
+        {
+            const double host = bench::summarize(phase.host_us).p50;
+            const double cpu = modeled_cpu_us(phase, host, model);
+            std::printf("  %-22s %10.1f %10.1f %9.2f ms %9.2f ms %12.2f\n",
+                        phase.name, host, static_cast<double>(phase.bytes_read) / 1024.0,
+                        phase.io_us / 1000.0, cpu / 1000.0, (phase.io_us + cpu) / 1000.0);
+            total_host += host;
+            total_io += phase.io_us;
+            total_cpu += cpu;
+        }
+        std::printf("  %-22s %10.1f %10s %9.2f ms %9.2f ms %12.2f\n\n",
+                    "Total", total_host, "", total_io / 1000.0, total_cpu / 1000.0, (total_io + total_cpu) / 1000.0);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bench::print_banner("Videomancer Program Switch Breakdown");
+
+    target_model model = rp2040_model();
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!apply_override(model, argv[i]))
+        {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    uint8_t public_key[32];
+    const uint32_t bitstream_size = bench::ice40_hx4k_bitstream_size;
+    const std::vector<uint8_t> package = bench::build_signed_package(public_key, bitstream_size, 3);
+    const uint32_t file_size = static_cast<uint32_t>(package.size());
+    const vmprog_toc_entry_type_v1_0 variant = vmprog_toc_entry_type_v1_0::bitstream_hd_analog;
+
+    std::printf("Package %u KB, three %u-byte bitstream variants, loading one\n", file_size / 1024, bitstream_size);
+    std::printf("Target: flash %.1f MB/s + %.1f us/read, SPI %.1f MHz + %.1f us/transfer,\n",
+                model.flash.bytes_per_second / 1e6, model.flash.op_latency_us,
+                model.spi.bytes_per_second * 8.0 / 1e6, model.spi.op_latency_us);
+    std::printf("        hash %.2f MB/s, Ed25519 verify %.1f ms, other CPU x%.0f host\n\n",
+                model.hash_bytes_per_second / 1e6, model.signature_verify_us / 1000.0, model.cpu_scale);
+
+    const uint32_t chunk_size = 4096;
+    std::vector<uint8_t> scratch(bitstream_size);
+    std::vector<uint8_t> chunk(chunk_size);
+    const size_t iterations = 20;
+
+    std::vector<phase_stats> full(6);
+    full[0].name = "Header + TOC";     full[0].cost = cpu_cost::scaled;
+    full[1].name = "Payload hashes";   full[1].cost = cpu_cost::hashing;
+    full[2].name = "Signature";        full[2].cost = cpu_cost::signature;
+    full[3].name = "Config parse";     full[3].cost = cpu_cost::scaled;
+    full[4].name = "Parameter writes"; full[4].cost = cpu_cost::scaled;
+    full[5].name = "Bitstream push";   full[5].cost = cpu_cost::scaled;
+
+    std::vector<phase_stats> selective(5);
+    selective[0].name = "Header + TOC";     selective[0].cost = cpu_cost::scaled;
+    selective[1].name = "Selective verify"; selective[1].cost = cpu_cost::selective;
+    selective[2].name = "Config parse";     selective[2].cost = cpu_cost::scaled;
+    selective[3].name = "Parameter writes"; selective[3].cost = cpu_cost::scaled;
+    selective[4].name = "Bitstream push";   selective[4].cost = cpu_cost::scaled;
+
+    for (size_t iter = 0; iter < iterations; ++iter)
+    {
+        for (int path = 0; path < 2; ++path)
+        {
+            std::unique_ptr<switch_context> ctx(new switch_context(package, model));
+            std::vector<phase_stats>& phases = path == 0 ? full : selective;
+            const bool record_io = iter == 0;
+            size_t p = 0;
+            bool ok = run_phase(phases[p++], *ctx, record_io, [&]() {
+                return read_and_validate_vmprog_header(ctx->stream, file_size, ctx->header) == vmprog_validation_result::ok &&
+                       read_and_validate_vmprog_toc(ctx->stream, ctx->header, file_size, ctx->toc,
+                                                    vmprog_stream_max_toc_entries) == vmprog_validation_result::ok;
+            });
+            const uint32_t toc_count = ctx->header.toc_count;
+            if (path == 0)
+            {
+                ok = ok && run_phase(phases[p++], *ctx, record_io, [&]() {
+                    return verify_all_payload_hashes_stream(ctx->stream, ctx->toc, toc_count, scratch.data(),
+                                                            bitstream_size) == vmprog_validation_result::ok;
+                });
+                ok = ok && run_phase(phases[p++], *ctx, record_io, [&]() {
+                    return verify_package_signature_stream(ctx->stream, ctx->toc, toc_count, public_key) ==
+                           vmprog_validation_result::ok;
+                });
+            }
+            else
+            {
+                ok = ok && run_phase(phases[p++], *ctx, record_io, [&]() {
+                    return verify_package_selective_stream(ctx->stream, ctx->toc, toc_count, variant, public_key,
+                                                           chunk.data(), chunk_size) == vmprog_validation_result::ok;
+                });
+            }
+            ok = ok && run_phase(phases[p++], *ctx, record_io, [&]() {
+                const vmprog_toc_entry_v1_0* entry =
+                    find_toc_entry(ctx->toc, toc_count, vmprog_toc_entry_type_v1_0::config);
+                return entry && read_and_validate_vmprog_config(ctx->stream, *entry, ctx->config, false) ==
+                                    vmprog_validation_result::ok;
+            });
+            ok = ok && run_phase(phases[p++], *ctx, record_io, [&]() {
+                return apply_initial_parameters(*ctx);
+            });
+            ok = ok && run_phase(phases[p++], *ctx, record_io, [&]() {
+                const vmprog_toc_entry_v1_0* entry = find_toc_entry(ctx->toc, toc_count, variant);
+                return entry && push_bitstream(*ctx, *entry, chunk.data(), chunk_size);
+            });
+            if (!ok)
+            {
+                std::fprintf(stderr, "Switch failed in phase %s\n", phases[p - 1].name);
+                return 1;
+            }
+        }
+    }
+
+    print_breakdown("Full validation (validate_vmprog_package_stream order)", full, model);
+    print_breakdown("Selective verification (signature, config, one variant)", selective, model);
+    return 0;
+}
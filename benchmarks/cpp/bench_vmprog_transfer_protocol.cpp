@@ -0,0 +1,239 @@
+// Videomancer SDK - Package Transfer Protocol Benchmark
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+//
+// Transfers a signed package through vmprog_transfer_protocol.hpp over two
+// socketpairs joined by a relay thread. The relay models the link: one-way
+// latency, a bandwidth cap and random loss of whole read segments (which
+// also truncates frames, so the parser has to resynchronize). The receiver
+// installs into a RAM target through vmprog_package_installer.
+//
+// Window 1 is stop-and-wait; larger windows keep the link busy across the
+// round trip.
+
+#include "bench_common.hpp"
+#include "bench_vmprog_package.hpp"
+#include <lzx/videomancer/vmprog_transfer_protocol.hpp>
+#include <atomic>
+#include <deque>
+#include <fcntl.h>
+#include <random>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace lzx;
+
+namespace
+{
+    class steady_clock_source : public videomancer_clock
+    {
+    public:
+        uint64_t now_us() override { return bench::now_ns() / 1000; }
+    };
+
+    struct link_model
+    {
+        double one_way_latency_us;
+        double bytes_per_second;
+        double loss;  // probability of dropping a read segment
+    };
+
+    /// @brief Forwards both directions between two socketpairs
+    class relay
+    {
+    public:
+        relay(int a, int b, const link_model& model) : m_model(model), m_rng(1234)
+        {
+            m_dirs[0].in = a;
+            m_dirs[0].out = b;
+            m_dirs[1].in = b;
+            m_dirs[1].out = a;
+            fcntl(a, F_SETFL, fcntl(a, F_GETFL, 0) | O_NONBLOCK);
+            fcntl(b, F_SETFL, fcntl(b, F_GETFL, 0) | O_NONBLOCK);
+            m_thread = std::thread([this]() { run(); });
+        }
+
+        ~relay()
+        {
+            m_running = false;
+            m_thread.join();
+        }
+
+    private:
+        struct segment
+        {
+            double deliver_at_us;
+            std::vector<uint8_t> bytes;
+        };
+
+        struct direction
+        {
+            int in = -1;
+            int out = -1;
+            double link_free_at_us = 0.0;
+            std::deque<segment> queue;
+        };
+
+        link_model m_model;
+        direction m_dirs[2];
+        std::mt19937 m_rng;
+        std::atomic<bool> m_running{ true };
+        std::thread m_thread;
+
+        void run()
+        {
+            std::uniform_real_distribution<double> uniform(0.0, 1.0);
+            uint8_t buffer[512];
+            while (m_running)
+            {
+                const double now = static_cast<double>(bench::now_ns()) / 1000.0;
+                for (direction& dir : m_dirs)
+                {
+                    ssize_t n;
+                    while ((n = ::read(dir.in, buffer, sizeof(buffer))) > 0)
+                    {
+                        if (uniform(m_rng) < m_model.loss)
+                            continue;
+                        const double start = std::max(now, dir.link_free_at_us);
+                        dir.link_free_at_us = start + static_cast<double>(n) * 1e6 / m_model.bytes_per_second;
+                        dir.queue.push_back({ dir.link_free_at_us + m_model.one_way_latency_us,
+                                              std::vector<uint8_t>(buffer, buffer + n) });
+                    }
+                    while (!dir.queue.empty() && dir.queue.front().deliver_at_us <= now)
+                    {
+                        const std::vector<uint8_t>& bytes = dir.queue.front().bytes;
+                        size_t sent = 0;
+                        while (sent < bytes.size())
+                        {
+                            const ssize_t w = ::write(dir.out, bytes.data() + sent, bytes.size() - sent);
+                            if (w > 0)
+                                sent += static_cast<size_t>(w);
+                        }
+                        dir.queue.pop_front();
+                    }
+                }
+                usleep(50);
+            }
+        }
+    };
+
+    class memory_target : public vmprog_install_target
+    {
+    public:
+        std::vector<uint8_t> staged;
+        bool committed = false;
+
+        bool begin(uint32_t size) override
+        {
+            staged.assign(size, 0xFF);
+            committed = false;
+            return true;
+        }
+
+        bool write(uint32_t offset, const uint8_t* data, uint32_t size) override
+        {
+            std::memcpy(staged.data() + offset, data, size);
+            return true;
+        }
+
+        bool commit() override
+        {
+            committed = true;
+            return true;
+        }
+    };
+
+    struct run_result
+    {
+        double seconds;
+        bool installed;
+        uint32_t retransmits;
+        uint32_t rejected;
+    };
+
+    run_result run_transfer(const std::vector<uint8_t>& package, const uint8_t public_key[32],
+                            const link_model& model, uint32_t window)
+    {
+        int host_pair[2];
+        int device_pair[2];
+        socketpair(AF_UNIX, SOCK_STREAM, 0, host_pair);
+        socketpair(AF_UNIX, SOCK_STREAM, 0, device_pair);
+
+        run_result result = { 0.0, false, 0, 0 };
+        {
+            relay wire(host_pair[1], device_pair[1], model);
+            vmprog_transfer_fd_link host_link(host_pair[0]);
+            vmprog_transfer_fd_link device_link(device_pair[0]);
+            steady_clock_source clock;
+
+            bench::memory_stream stream(package);
+            vmprog_transfer_sender sender(host_link, clock);
+
+            static uint8_t sector[4096];
+            static uint8_t reorder[vmprog_transfer_max_window * vmprog_transfer_max_chunk_size];
+            vmprog_package_installer installer(sector, sizeof(sector));
+            memory_target target;
+            vmprog_transfer_install_sink sink(installer, target, public_key);
+            vmprog_transfer_receiver receiver(device_link, sink, reorder, sizeof(reorder));
+
+            const uint32_t timeout_us = static_cast<uint32_t>(4.0 * model.one_way_latency_us) + 20000;
+            sender.begin(stream, static_cast<uint32_t>(package.size()), vmprog_transfer_max_chunk_size, window, timeout_us);
+
+            const uint64_t t0 = bench::now_ns();
+            while (true)
+            {
+                const vmprog_transfer_state s = sender.poll();
+                const vmprog_transfer_state r = receiver.poll();
+                if (s == vmprog_transfer_state::failed || r == vmprog_transfer_state::failed)
+                    break;
+                if (s == vmprog_transfer_state::done && r == vmprog_transfer_state::done)
+                    break;
+                if (bench::now_ns() - t0 > 60ull * 1000000000ull)
+                    break;
+                usleep(20);
+            }
+            result.seconds = static_cast<double>(bench::now_ns() - t0) / 1e9;
+            result.installed = installer.is_committed() && target.staged == package;
+            result.retransmits = sender.retransmits();
+            result.rejected = sender.frames_rejected() + receiver.frames_rejected();
+        }
+        close(host_pair[0]);
+        close(host_pair[1]);
+        close(device_pair[0]);
+        close(device_pair[1]);
+        return result;
+    }
+}
+
+int main()
+{
+    bench::print_banner("Videomancer Package Transfer Benchmark");
+
+    uint8_t public_key[32];
+    const std::vector<uint8_t> package = bench::build_signed_package(public_key, bench::ice40_hx4k_bitstream_size, 1);
+    std::printf("Package %zu KB, 1 KB chunks\n\n", package.size() / 1024);
+
+    const link_model models[] = {
+        { 1000.0, 1.0e6, 0.0 },
+        { 1000.0, 1.0e6, 0.01 },
+        { 5000.0, 1.0e6, 0.0 },
+    };
+    const uint32_t windows[] = { 1, 4, 16, 32 };
+
+    std::printf("%-28s %7s %10s %12s %12s %9s\n", "Link", "Window", "Time ms", "KB/s", "Retransmits", "Rejected");
+    for (const link_model& model : models)
+    {
+        char label[64];
+        std::snprintf(label, sizeof(label), "%.0f ms RTT, 1 MB/s, %.0f%% loss",
+                      2.0 * model.one_way_latency_us / 1000.0, model.loss * 100.0);
+        for (uint32_t window : windows)
+        {
+            const run_result r = run_transfer(package, public_key, model, window);
+            std::printf("%-28s %7u %10.1f %12.1f %12u %9u%s\n", label, window, r.seconds * 1000.0,
+                        static_cast<double>(package.size()) / 1024.0 / r.seconds, r.retransmits, r.rejected,
+                        r.installed ? "" : "  NOT INSTALLED");
+        }
+    }
+    return 0;
+}
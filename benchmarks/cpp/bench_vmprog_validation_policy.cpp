@@ -0,0 +1,199 @@
+// Videomancer SDK - Package Validation Policy Benchmark
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+//
+// Measures, for signed packages of several sizes:
+//   - Calibration: Ed25519 verify cost relative to BLAKE2b hashing
+//   - Time per validation profile (boot, ingest, strict, browse) and for the
+//     legacy validate_vmprog_package() with hashes and signature enabled
+//   - Time to reject a package whose only defect is a non-zero config
+//     reserved field: the cheapest-first plan fails before hashing anything
+
+#include "bench_common.hpp"
+#include <lzx/videomancer/vmprog_validation_policy.hpp>
+#include <cstring>
+#include <vector>
+
+using namespace lzx;
+
+namespace
+{
+    struct signed_package
+    {
+        std::vector<uint8_t> data;
+        uint8_t public_key[32];
+    };
+
+    signed_package build_package(uint32_t bitstream_size)
+    {
+        signed_package pkg;
+        uint8_t seed[32];
+        for (int i = 0; i < 32; ++i)
+            seed[i] = static_cast<uint8_t>(i * 3 + 1);
+        uint8_t secret_key[64];
+        crypto_ed25519_key_pair(secret_key, pkg.public_key, seed);
+
+        vmprog_program_config_v1_0 config;
+        init_vmprog_config(config);
+        safe_strncpy(config.program_id, "bench.validation.policy", sizeof(config.program_id));
+        safe_strncpy(config.program_name, "Validation Bench", sizeof(config.program_name));
+
+        std::vector<uint8_t> bitstream(bitstream_size);
+        for (uint32_t i = 0; i < bitstream_size; ++i)
+            bitstream[i] = static_cast<uint8_t>(i * 13 + (i >> 8));
+
+        vmprog_signed_descriptor_v1_0 descriptor;
+        init_signed_descriptor(descriptor);
+        sha256_oneshot(reinterpret_cast<const uint8_t*>(&config), sizeof(config), descriptor.config_sha256);
+        descriptor.artifact_count = 1;
+        descriptor.artifacts[0].type = vmprog_toc_entry_type_v1_0::fpga_bitstream;
+        sha256_oneshot(bitstream.data(), bitstream_size, descriptor.artifacts[0].sha256);
+
+        uint8_t signature[64];
+        crypto_ed25519_sign(signature, secret_key, reinterpret_cast<const uint8_t*>(&descriptor), sizeof(descriptor));
+
+        const uint32_t toc_count = 4;
+        const uint8_t* payloads[toc_count] = {
+            reinterpret_cast<const uint8_t*>(&config), reinterpret_cast<const uint8_t*>(&descriptor),
+            signature, bitstream.data(),
+        };
+        const vmprog_toc_entry_type_v1_0 types[toc_count] = {
+            vmprog_toc_entry_type_v1_0::config, vmprog_toc_entry_type_v1_0::signed_descriptor,
+            vmprog_toc_entry_type_v1_0::signature, vmprog_toc_entry_type_v1_0::fpga_bitstream,
+        };
+        const uint32_t sizes[toc_count] = { sizeof(config), sizeof(descriptor), 64, bitstream_size };
+
+        vmprog_toc_entry_v1_0 toc[toc_count];
+        uint32_t offset = sizeof(vmprog_header_v1_0) + sizeof(toc);
+        for (uint32_t i = 0; i < toc_count; ++i)
+        {
+            init_toc_entry(toc[i]);
+            toc[i].type = types[i];
+            toc[i].offset = offset;
+            toc[i].size = sizes[i];
+            sha256_oneshot(payloads[i], sizes[i], toc[i].sha256);
+            offset += sizes[i];
+        }
+
+        vmprog_header_v1_0 header;
+        init_vmprog_header(header);
+        header.flags = vmprog_header_flags_v1_0::signed_pkg;
+        header.file_size = offset;
+        header.toc_offset = sizeof(vmprog_header_v1_0);
+        header.toc_count = toc_count;
+        header.toc_bytes = sizeof(toc);
+
+        pkg.data.resize(offset);
+        memcpy(pkg.data.data(), &header, sizeof(header));
+        memcpy(pkg.data.data() + header.toc_offset, toc, sizeof(toc));
+        for (uint32_t i = 0; i < toc_count; ++i)
+            memcpy(pkg.data.data() + toc[i].offset, payloads[i], sizes[i]);
+
+        uint8_t package_hash[32];
+        calculate_package_sha256(pkg.data.data(), offset, package_hash);
+        memcpy(pkg.data.data() + offsetof(vmprog_header_v1_0, sha256_package), package_hash, 32);
+        return pkg;
+    }
+
+    template<typename F>
+    bench::summary time_us(size_t iterations, F&& fn)
+    {
+        std::vector<double> samples;
+        samples.reserve(iterations);
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            const uint64_t t0 = bench::now_ns();
+            if (!fn())
+                std::printf("  unexpected validation result\n");
+            samples.push_back(static_cast<double>(bench::now_ns() - t0) / 1000.0);
+        }
+        return bench::summarize(samples);
+    }
+
+    void bench_calibration()
+    {
+        const signed_package pkg = build_package(1024);
+        const auto& header = *reinterpret_cast<const vmprog_header_v1_0*>(pkg.data.data());
+        const auto* toc = reinterpret_cast<const vmprog_toc_entry_v1_0*>(pkg.data.data() + header.toc_offset);
+        const auto& descriptor = *reinterpret_cast<const vmprog_signed_descriptor_v1_0*>(pkg.data.data() + toc[1].offset);
+        const uint8_t* signature = pkg.data.data() + toc[2].offset;
+
+        bench::summary verify = time_us(200, [&]() {
+            return verify_ed25519_signature(signature, pkg.public_key, descriptor);
+        });
+
+        std::vector<uint8_t> block(1 << 20, 0x5A);
+        uint8_t hash[32];
+        bench::summary hashing = time_us(50, [&]() {
+            sha256_oneshot(block.data(), static_cast<uint32_t>(block.size()), hash);
+            return true;
+        });
+
+        const double bytes_per_us = static_cast<double>(block.size()) / hashing.p50;
+        bench::print_summary_us("Ed25519 verify", verify);
+        std::printf("%-34s %.0f MB/s\n", "BLAKE2b-256 throughput", bytes_per_us);
+        std::printf("%-34s %.0f KB hashed (model: %u KB)\n\n", "Signature cost equivalent",
+                    verify.p50 * bytes_per_us / 1024.0, vmprog_signature_cost_bytes / 1024);
+    }
+
+    void bench_profiles(uint32_t bitstream_size)
+    {
+        signed_package pkg = build_package(bitstream_size);
+        const uint8_t* data = pkg.data.data();
+        const uint32_t size = static_cast<uint32_t>(pkg.data.size());
+        std::printf("Package size %u KB\n", size / 1024);
+
+        struct profile { const char* name; vmprog_validation_policy_v1_0 policy; };
+        profile profiles[] = {
+            { "  browse", vmprog_validation_profile_browse },
+            { "  boot", vmprog_validation_profile_boot },
+            { "  ingest", vmprog_validation_profile_ingest },
+            { "  strict", vmprog_validation_profile_strict },
+        };
+        for (auto& p : profiles)
+        {
+            p.policy.public_key = pkg.public_key;
+            bench::summary s = time_us(200, [&]() {
+                return validate_vmprog_package_with_policy(data, size, p.policy) == vmprog_validation_result::ok;
+            });
+            bench::print_summary_us(p.name, s);
+        }
+
+        bench::summary legacy = time_us(200, [&]() {
+            return validate_vmprog_package(data, size, true, true, pkg.public_key) == vmprog_validation_result::ok;
+        });
+        bench::print_summary_us("  legacy (hashes + signature)", legacy);
+
+        // Reject path: non-zero config reserved field with all hashes fixed up,
+        // which the legacy order only notices after hashing the whole package
+        auto& header = *reinterpret_cast<vmprog_header_v1_0*>(pkg.data.data());
+        auto* toc = reinterpret_cast<vmprog_toc_entry_v1_0*>(pkg.data.data() + header.toc_offset);
+        auto* config = reinterpret_cast<vmprog_program_config_v1_0*>(pkg.data.data() + toc[0].offset);
+        config->reserved_pad = 1;
+        sha256_oneshot(reinterpret_cast<const uint8_t*>(config), sizeof(*config), toc[0].sha256);
+        calculate_package_sha256(pkg.data.data(), size, header.sha256_package);
+
+        vmprog_validation_policy_v1_0 strict = vmprog_validation_profile_strict;
+        strict.public_key = pkg.public_key;
+        bench::summary reject = time_us(200, [&]() {
+            return validate_vmprog_package_with_policy(data, size, strict) == vmprog_validation_result::reserved_field_not_zero;
+        });
+        bench::print_summary_us("  reject reserved (strict plan)", reject);
+
+        bench::summary legacy_reject = time_us(200, [&]() {
+            return validate_vmprog_package(data, size, true, true, pkg.public_key) != vmprog_validation_result::ok;
+        });
+        bench::print_summary_us("  reject reserved (legacy)", legacy_reject);
+        std::printf("\n");
+    }
+}
+
+int main()
+{
+    bench::print_banner("Videomancer Package Validation Policy Benchmark");
+    bench_calibration();
+    bench_profiles(16 * 1024);
+    bench_profiles(128 * 1024);
+    bench_profiles(1000 * 1024);
+    return 0;
+}
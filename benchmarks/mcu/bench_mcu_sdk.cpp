@@ -0,0 +1,291 @@
+// Videomancer SDK - ARMv6-M Hot Path Benchmark
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+//
+// Instruction counts for the SDK paths the RP2040 firmware runs most:
+// control curves, parameter display strings, BLAKE2b, Ed25519 verification,
+// controller register writes, and modulation matrix and generator ticks.
+// Runs under qemu-system-arm -M microbit with -icount shift=0 (see
+// mcu_bench.hpp and benchmarks/README.md).
+
+#include "mcu_bench.hpp"
+#include <lzx/videomancer/videomancer_fpga_controller.hpp>
+#include <lzx/videomancer/videomancer_modulation_generators.hpp>
+#include <lzx/videomancer/videomancer_modulation_matrix.hpp>
+#include <lzx/videomancer/vmprog_crypto.hpp>
+#include <lzx/videomancer/vmprog_parameter_utils.hpp>
+#include <cstring>
+
+using namespace lzx;
+
+namespace
+{
+    // SPI endpoint that only counts bytes, so controller results are SDK code alone
+    class null_fpga : public videomancer_fpga
+    {
+    public:
+        size_t transfer_spi(const uint8_t* tx_buffer, uint8_t* rx_buffer, size_t size) override
+        {
+            (void)tx_buffer;
+            (void)rx_buffer;
+            bytes += size;
+            return size;
+        }
+
+        void assert_chip_select_spi(bool assert) override
+        {
+            (void)assert;
+        }
+
+        uint32_t bytes = 0;
+    };
+
+    constexpr uint32_t curve_mode_count = static_cast<uint32_t>(vmprog_parameter_control_mode_v1_0::expo_in_out) + 1;
+
+    // Every control mode over the full pot range
+    void bench_curves()
+    {
+        const uint32_t ticks = mcu::measure([] {
+            uint32_t sum = 0;
+            for (uint32_t mode = 0; mode < curve_mode_count; ++mode)
+            {
+                for (int32_t value = 0; value < 1024; ++value)
+                    sum += apply_parameter_control_curve(value, static_cast<vmprog_parameter_control_mode_v1_0>(mode));
+            }
+            mcu::keep(sum);
+        });
+        mcu::report("apply_parameter_control_curve (all modes)", ticks, curve_mode_count * 1024, "call");
+
+        static const vmprog_parameter_control_mode_v1_0 modes[] = {
+            vmprog_parameter_control_mode_v1_0::linear,
+            vmprog_parameter_control_mode_v1_0::steps_16,
+            vmprog_parameter_control_mode_v1_0::polar_degs_360,
+            vmprog_parameter_control_mode_v1_0::sine_in_out,
+            vmprog_parameter_control_mode_v1_0::expo_in_out,
+        };
+        static const char* const names[] = {
+            "  linear", "  steps_16", "  polar_degs_360", "  sine_in_out", "  expo_in_out",
+        };
+        for (size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); ++i)
+        {
+            const vmprog_parameter_control_mode_v1_0 mode = modes[i];
+            const uint32_t mode_ticks = mcu::measure([mode] {
+                uint32_t sum = 0;
+                for (int32_t value = 0; value < 1024; ++value)
+                    sum += apply_parameter_control_curve(value, mode);
+                mcu::keep(sum);
+            });
+            mcu::report(names[i], mode_ticks, 1024, "call");
+        }
+    }
+
+    // Numeric value with two decimals and a suffix, and a labelled switch
+    void bench_display_strings()
+    {
+        static vmprog_parameter_config_v1_0 numeric;
+        init_parameter_config(numeric);
+        numeric.control_mode = vmprog_parameter_control_mode_v1_0::quad_in;
+        numeric.max_value = 1023;
+        numeric.display_min_value = -1000;
+        numeric.display_max_value = 1000;
+        numeric.display_float_digits = 2;
+        strcpy(numeric.suffix_label, "dB");
+
+        static vmprog_parameter_config_v1_0 labelled;
+        init_parameter_config(labelled);
+        labelled.max_value = 1023;
+        labelled.value_label_count = 4;
+        strcpy(labelled.value_labels[0], "Off");
+        strcpy(labelled.value_labels[1], "Low");
+        strcpy(labelled.value_labels[2], "Mid");
+        strcpy(labelled.value_labels[3], "High");
+
+        const uint32_t numeric_ticks = mcu::measure([] {
+            char text[32];
+            for (int32_t value = 0; value < 1024; ++value)
+            {
+                generate_parameter_value_display_string(value, numeric, text, sizeof(text));
+                mcu::keep(text);
+            }
+        });
+        mcu::report("generate_parameter_value_display_string (numeric)", numeric_ticks, 1024, "call");
+
+        const uint32_t labelled_ticks = mcu::measure([] {
+            char text[32];
+            for (int32_t value = 0; value < 1024; ++value)
+            {
+                generate_parameter_value_display_string(value, labelled, text, sizeof(text));
+                mcu::keep(text);
+            }
+        });
+        mcu::report("generate_parameter_value_display_string (labels)", labelled_ticks, 1024, "call");
+    }
+
+    // 1 KB keeps RAM free for the stack; cost per byte is flat past a few blocks
+    uint8_t hash_input[1024];
+
+    void bench_blake2b()
+    {
+        for (size_t i = 0; i < sizeof(hash_input); ++i)
+            hash_input[i] = static_cast<uint8_t>(i * 7 + 3);
+
+        const uint32_t ticks = mcu::measure([] {
+            uint8_t hash[32];
+            sha256_oneshot(hash_input, sizeof(hash_input), hash);
+            mcu::keep(hash);
+        });
+        mcu::report("BLAKE2b-256 (1 KB)", ticks, sizeof(hash_input), "byte");
+
+        const uint32_t small_ticks = mcu::measure([] {
+            uint8_t hash[32];
+            sha256_oneshot(hash_input, 64, hash);
+            mcu::keep(hash);
+        });
+        mcu::report("BLAKE2b-256 (64 bytes)", small_ticks, 1, "hash");
+    }
+
+    void bench_ed25519()
+    {
+        uint8_t seed[32];
+        for (size_t i = 0; i < sizeof(seed); ++i)
+            seed[i] = static_cast<uint8_t>(i + 1);
+        static uint8_t secret_key[64];
+        static uint8_t public_key[32];
+        static uint8_t signature[64];
+        static uint8_t message[32];
+        crypto_ed25519_key_pair(secret_key, public_key, seed);
+        sha256_oneshot(hash_input, sizeof(hash_input), message);
+        crypto_ed25519_sign(signature, secret_key, message, sizeof(message));
+
+        bool valid = false;
+        const uint32_t ticks = mcu::measure([&valid] {
+            valid = ed25519_verify(signature, public_key, message, sizeof(message));
+        });
+        if (!valid)
+        {
+            mcu::print("FAILED: Ed25519 signature rejected\n");
+            return;
+        }
+        mcu::report("ed25519_verify (32-byte digest)", ticks, 1, "verify");
+    }
+
+    void bench_controller()
+    {
+        null_fpga fpga;
+        videomancer_fpga_controller controller(fpga);
+
+        const uint32_t immediate_ticks = mcu::measure([&controller] {
+            for (uint16_t value = 0; value < 256; ++value)
+                controller.set_rotary_pot_1(value);
+        });
+        mcu::report("controller set_rotary_pot_1 (immediate)", immediate_ticks, 256, "write");
+
+        const uint32_t parameter_ticks = mcu::measure([&controller] {
+            for (uint16_t value = 0; value < 256; ++value)
+                controller.set_parameter(vmprog_parameter_id_v1_0::linear_potentiometer_12, value);
+        });
+        mcu::report("controller set_parameter (immediate)", parameter_ticks, 256, "write");
+
+        // One update per frame: all six pots and the fader change, then one flush
+        const uint32_t batch_ticks = mcu::measure([&controller] {
+            for (uint16_t frame = 0; frame < 64; ++frame)
+            {
+                controller.begin_batch();
+                controller.set_rotary_pot_1(frame);
+                controller.set_rotary_pot_2(frame + 1);
+                controller.set_rotary_pot_3(frame + 2);
+                controller.set_rotary_pot_4(frame + 3);
+                controller.set_rotary_pot_5(frame + 4);
+                controller.set_rotary_pot_6(frame + 5);
+                controller.set_linear_pot_12(frame + 6);
+                controller.flush();
+            }
+        });
+        mcu::report("controller batch of 7 + flush", batch_ticks, 64, "frame");
+        mcu::keep(fpga.bytes);
+    }
+
+    // Shared by the matrix and generator benchmarks
+    videomancer_modulation_matrix matrix;
+
+    void bench_modulation_matrix()
+    {
+        null_fpga fpga;
+        videomancer_fpga_controller controller(fpga);
+        matrix.clear();
+
+        // Pot 1 drives three gains; two automation slots modulate pots 4 and 5
+        using src = videomancer_mod_source;
+        using dst = vmprog_parameter_id_v1_0;
+        matrix.add_route(src::rotary_potentiometer_1, dst::rotary_potentiometer_1, matrix.unity);
+        matrix.add_route(src::rotary_potentiometer_1, dst::rotary_potentiometer_2, matrix.unity);
+        matrix.add_route(src::rotary_potentiometer_1, dst::rotary_potentiometer_3, matrix.unity);
+        matrix.add_route(src::rotary_potentiometer_4, dst::rotary_potentiometer_4, matrix.unity);
+        matrix.add_route(src::automation_1, dst::rotary_potentiometer_4, to_mod_amount(0.25f),
+                         vmprog_parameter_control_mode_v1_0::sine_in_out);
+        matrix.add_route(src::rotary_potentiometer_5, dst::rotary_potentiometer_5, matrix.unity);
+        matrix.add_route(src::automation_2, dst::rotary_potentiometer_5, to_mod_amount(-0.5f));
+        matrix.set_offset(dst::rotary_potentiometer_5, 256);
+
+        // Automation moves every tick; pot 1 moves every fourth tick
+        const uint32_t ticks = mcu::measure([&controller] {
+            for (uint16_t frame = 0; frame < 64; ++frame)
+            {
+                matrix.set_source(src::rotary_potentiometer_1, static_cast<uint16_t>(frame & ~3u));
+                matrix.set_source(src::automation_1, static_cast<uint16_t>(frame * 16));
+                matrix.set_source(src::automation_2, static_cast<uint16_t>(1023 - frame * 16));
+                matrix.tick(controller);
+            }
+        });
+        mcu::report("modulation matrix tick (7 routes)", ticks, 64, "tick");
+        mcu::keep(fpga.bytes);
+    }
+
+    void bench_modulation_generators()
+    {
+        null_fpga fpga;
+        videomancer_fpga_controller controller(fpga);
+        static videomancer_modulation_generators generators;
+        matrix.clear();
+
+        // Two LFOs, an envelope and a sample-and-hold; the sine LFO and the
+        // sample-and-hold feed pots 1-2 through the matrix, the others write directly
+        generators.set_timing(videomancer_abi_v1_0::video_timing_id::_1080i5994, videomancer_tick_kind::field);
+        generators.set_lfo(0, videomancer_lfo_wave::triangle, vmprog_parameter_control_mode_v1_0::sine_in_out);
+        generators.set_rate_mhz(0, 500);
+        generators.set_lfo(1, videomancer_lfo_wave::ramp_up);
+        generators.set_period_ticks(1, 30);
+        generators.set_destination(1, vmprog_parameter_id_v1_0::rotary_potentiometer_5);
+        generators.set_envelope(2, 10, 20, 600, 40, vmprog_parameter_control_mode_v1_0::expo_out);
+        generators.set_destination(2, vmprog_parameter_id_v1_0::rotary_potentiometer_6);
+        generators.set_gate(2, true);
+        generators.set_sample_hold(3, 1234);
+        generators.set_rate_mhz(3, 4000);
+        matrix.add_route(videomancer_mod_source::automation_1, vmprog_parameter_id_v1_0::rotary_potentiometer_1, matrix.unity);
+        matrix.add_route(videomancer_mod_source::automation_4, vmprog_parameter_id_v1_0::rotary_potentiometer_2, matrix.unity);
+
+        const uint32_t ticks = mcu::measure([&controller] {
+            for (uint16_t field = 0; field < 64; ++field)
+                generators.tick(matrix, controller);
+        });
+        mcu::report("generators + matrix tick (4 slots)", ticks, 64, "tick");
+        mcu::keep(fpga.bytes);
+    }
+} // namespace
+
+int main()
+{
+    mcu::print("======================================\n");
+    mcu::print("Videomancer SDK ARMv6-M Benchmark\n");
+    mcu::print("======================================\n");
+
+    mcu::calibrate();
+    bench_curves();
+    bench_display_strings();
+    bench_blake2b();
+    bench_ed25519();
+    bench_controller();
+    bench_modulation_matrix();
+    bench_modulation_generators();
+    return 0;
+}
@@ -0,0 +1,140 @@
+// Videomancer SDK - MCU Benchmark Helpers
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+//
+// Timing and output for benchmarks that run bare-metal under QEMU's
+// "microbit" machine (nRF51, ARMv6-M). Output goes to the host through
+// semihosting. Time is read from nRF51 TIMER0 at 16 MHz, which QEMU drives
+// from its virtual clock. With -icount shift=0 every guest instruction
+// advances that clock by exactly 1 ns, so one timer tick is 62.5
+// instructions and the counts are the same on every host and every run.
+
+#pragma once
+
+#include <lzx/videomancer/vmprog_parameter_utils.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace mcu
+{
+    // ARM semihosting operations
+    constexpr uint32_t sys_write0 = 0x04;
+    constexpr uint32_t sys_exit = 0x18;
+    constexpr uint32_t adp_stopped_application_exit = 0x20026;
+
+    inline uint32_t semihost(uint32_t operation, const void* argument)
+    {
+        register uint32_t r0 __asm__("r0") = operation;
+        register const void* r1 __asm__("r1") = argument;
+        __asm__ volatile("bkpt 0xab" : "+r"(r0) : "r"(r1) : "memory");
+        return r0;
+    }
+
+    inline void print(const char* text)
+    {
+        semihost(sys_write0, text);
+    }
+
+    inline void print(uint32_t value)
+    {
+        char buffer[12] = {};
+        lzx::uint32_to_string(value, buffer, sizeof(buffer));
+        print(buffer);
+    }
+
+    /// @brief Stop QEMU
+    [[noreturn]] inline void exit()
+    {
+        semihost(sys_exit, reinterpret_cast<const void*>(adp_stopped_application_exit));
+        for (;;)
+            ;
+    }
+
+    // nRF51 TIMER0
+    struct nrf51_timer
+    {
+        static constexpr uintptr_t base = 0x40008000;
+
+        static volatile uint32_t& reg(uint32_t offset)
+        {
+            return *reinterpret_cast<volatile uint32_t*>(base + offset);
+        }
+
+        /// @brief 32-bit timer mode at 16 MHz, running
+        static void start()
+        {
+            reg(0x004) = 1;     // TASKS_STOP
+            reg(0x504) = 0;     // MODE = timer
+            reg(0x508) = 3;     // BITMODE = 32 bit
+            reg(0x510) = 0;     // PRESCALER = 16 MHz
+            reg(0x00C) = 1;     // TASKS_CLEAR
+            reg(0x000) = 1;     // TASKS_START
+        }
+
+        /// @brief Current count (16 ticks per microsecond of virtual time)
+        static uint32_t now()
+        {
+            reg(0x040) = 1;     // TASKS_CAPTURE[0]
+            return reg(0x540);  // CC[0]
+        }
+    };
+
+    /// @brief Instructions per timer tick with -icount shift=0, times two
+    constexpr uint32_t instructions_per_2_ticks = 125;
+
+    /// @brief Keep a value alive without letting the compiler see through it
+    template <typename T>
+    inline void keep(const T& value)
+    {
+        __asm__ volatile("" : : "r"(&value) : "memory");
+    }
+
+    /// @brief Ticks spent by an empty measurement, subtracted from every result
+    inline uint32_t& overhead_ticks()
+    {
+        static uint32_t ticks = 0;
+        return ticks;
+    }
+
+    /// @brief Run a function and return the ticks it took
+    template <typename Function>
+    inline uint32_t measure(Function&& function)
+    {
+        const uint32_t start = nrf51_timer::now();
+        function();
+        const uint32_t ticks = nrf51_timer::now() - start;
+        return ticks > overhead_ticks() ? ticks - overhead_ticks() : 0;
+    }
+
+    inline void calibrate()
+    {
+        nrf51_timer::start();
+        overhead_ticks() = 0;
+        uint32_t best = ~0u;
+        for (int i = 0; i < 8; ++i)
+        {
+            const uint32_t ticks = measure([] {});
+            best = ticks < best ? ticks : best;
+        }
+        overhead_ticks() = best;
+    }
+
+    /// @brief Print one result line: name, instructions per operation (one decimal), unit
+    /// @param name Benchmark name
+    /// @param ticks Ticks measured for all operations
+    /// @param operations Operations in the measurement
+    /// @param unit What one operation is
+    inline void report(const char* name, uint32_t ticks, uint32_t operations, const char* unit)
+    {
+        const uint64_t tenths = (static_cast<uint64_t>(ticks) * instructions_per_2_ticks * 10 / 2) / operations;
+        print(name);
+        print(": ");
+        print(static_cast<uint32_t>(tenths / 10));
+        print(".");
+        print(static_cast<uint32_t>(tenths % 10));
+        print(" instructions/");
+        print(unit);
+        print("\n");
+    }
+
+} // namespace mcu
@@ -0,0 +1,86 @@
+// Videomancer SDK - MCU Benchmark Startup
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+//
+// Vector table and reset handler for the QEMU "microbit" machine. QEMU
+// loads the ELF at its load addresses, so .data is copied out of flash and
+// .bss cleared here as on hardware. Any fault ends the run.
+//
+// The free stack is painted before main() so the run can end with its RAM
+// use: static .data + .bss and the stack high-water mark.
+
+#include "mcu_bench.hpp"
+#include <cstdint>
+#include <cstring>
+
+extern "C" {
+extern uint32_t __stack_top;
+extern uint32_t __data_load;
+extern uint32_t __data_start;
+extern uint32_t __data_end;
+extern uint32_t __bss_start;
+extern uint32_t __bss_end;
+extern uint32_t __stack_size;  // Linker symbol: its address is the size
+void __libc_init_array();
+int main();
+
+// Called by __libc_init_array(); crti.o is not linked
+void _init() {}
+
+constexpr uint32_t mcu_stack_paint = 0xA5A5A5A5u;
+
+static uint32_t* mcu_stack_bottom()
+{
+    return &__stack_top - reinterpret_cast<uintptr_t>(&__stack_size) / sizeof(uint32_t);
+}
+
+// Fill the stack below this frame with a pattern; volatile keeps it a plain loop
+static void mcu_paint_stack()
+{
+    volatile uint32_t* word = mcu_stack_bottom();
+    volatile uint32_t* const limit = static_cast<uint32_t*>(__builtin_frame_address(0)) - 16;
+    while (word < limit)
+        *word++ = mcu_stack_paint;
+}
+
+static void mcu_report_ram()
+{
+    const uint32_t* word = mcu_stack_bottom();
+    while (word < &__stack_top && *word == mcu_stack_paint)
+        ++word;
+    mcu::print("RAM: ");
+    mcu::print(static_cast<uint32_t>(reinterpret_cast<char*>(&__bss_end) - reinterpret_cast<char*>(&__data_start)));
+    mcu::print(" bytes .data + .bss, stack ");
+    mcu::print(static_cast<uint32_t>(reinterpret_cast<const char*>(&__stack_top) - reinterpret_cast<const char*>(word)));
+    mcu::print(" of ");
+    mcu::print(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&__stack_size)));
+    mcu::print(" bytes\n");
+}
+
+[[noreturn]] void mcu_reset_handler()
+{
+    memcpy(&__data_start, &__data_load,
+           static_cast<size_t>(reinterpret_cast<char*>(&__data_end) - reinterpret_cast<char*>(&__data_start)));
+    memset(&__bss_start, 0,
+           static_cast<size_t>(reinterpret_cast<char*>(&__bss_end) - reinterpret_cast<char*>(&__bss_start)));
+    mcu_paint_stack();
+    __libc_init_array();
+    main();
+    mcu_report_ram();
+    mcu::exit();
+}
+
+[[noreturn]] void mcu_fault_handler()
+{
+    mcu::print("FAILED: CPU fault\n");
+    mcu::exit();
+}
+
+__attribute__((section(".vectors"), used))
+const void* const mcu_vectors[] = {
+    &__stack_top,
+    reinterpret_cast<const void*>(&mcu_reset_handler),
+    reinterpret_cast<const void*>(&mcu_fault_handler),    // NMI
+    reinterpret_cast<const void*>(&mcu_fault_handler),    // HardFault
+};
+}
@@ -0,0 +1,33 @@
+# Videomancer SDK - ARMv6-M (Cortex-M0+) Cross Toolchain
+# Copyright (C) 2025 LZX Industries LLC
+# SPDX-License-Identifier: GPL-3.0-only
+#
+# Bare-metal arm-none-eabi GCC for the RP2040 core (Cortex-M0+, Thumb only).
+# Used by the MCU benchmarks; tests and host tools must be disabled:
+#
+#   cmake -S . -B build-mcu \
+#       -DCMAKE_TOOLCHAIN_FILE=cmake/toolchains/armv6m-none-eabi.cmake \
+#       -DBUILD_TESTS=OFF -DBUILD_VIRTUAL_DEVICE=OFF -DBUILD_MCU_BENCHMARKS=ON
+
+set(CMAKE_SYSTEM_NAME Generic)
+set(CMAKE_SYSTEM_PROCESSOR armv6m)
+
+set(ARM_NONE_EABI_PREFIX "arm-none-eabi-" CACHE STRING "Cross compiler prefix")
+
+set(CMAKE_C_COMPILER ${ARM_NONE_EABI_PREFIX}gcc)
+set(CMAKE_CXX_COMPILER ${ARM_NONE_EABI_PREFIX}g++)
+set(CMAKE_ASM_COMPILER ${ARM_NONE_EABI_PREFIX}gcc)
+set(CMAKE_OBJCOPY ${ARM_NONE_EABI_PREFIX}objcopy CACHE FILEPATH "objcopy")
+set(CMAKE_SIZE ${ARM_NONE_EABI_PREFIX}size CACHE FILEPATH "size")
+
+# No OS to link a test executable against
+set(CMAKE_TRY_COMPILE_TARGET_TYPE STATIC_LIBRARY)
+
+set(CMAKE_C_FLAGS_INIT "-mcpu=cortex-m0plus -mthumb -ffunction-sections -fdata-sections")
+set(CMAKE_CXX_FLAGS_INIT "-mcpu=cortex-m0plus -mthumb -ffunction-sections -fdata-sections -fno-exceptions -fno-rtti -fno-threadsafe-statics")
+set(CMAKE_EXE_LINKER_FLAGS_INIT "--specs=nano.specs --specs=nosys.specs -nostartfiles -Wl,--gc-sections")
+
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_PACKAGE ONLY)
@@ -276,6 +276,13 @@ begin
 
   s_video_timing_id <= s_spi_ram_d(8)(3 downto 0);
 
+  -- Register 0x09 is read straight from the SPI RAM: a warmboot need not wait for hsync
+  warmboot_trigger_inst : entity work.warmboot_trigger
+    port map(
+      clk        => vid_clk,
+      i_register => s_spi_ram(9)
+    );
+
   yuv422_20b_top_inst : entity work.program_top
     port map(
       clk => vid_clk,
@@ -0,0 +1,70 @@
+-- Videomancer SDK - Open source FPGA-based video effects development kit
+-- Copyright (C) 2025 LZX Industries LLC
+-- File: warmboot_trigger.vhd - SB_WARMBOOT Wrapper Driven by ABI Register 0x09
+-- License: GNU General Public License v3.0
+-- https://github.com/lzxindustries/videomancer-sdk
+--
+-- This file is free software: you can redistribute it and/or modify
+-- it under the terms of the GNU General Public License as published by
+-- the Free Software Foundation, either version 3 of the License, or
+-- (at your option) any later version.
+--
+-- This program is distributed in the hope that it will be useful,
+-- but WITHOUT ANY WARRANTY; without even the implied warranty of
+-- MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+-- GNU General Public License for more details.
+--
+-- You should have received a copy of the GNU General Public License
+-- along with this program. If not, see <https://www.gnu.org/licenses/>.
+--
+-- Description:
+--   Register 0x09 bits [1:0] select a multiboot image and bit 2 requests
+--   the warmboot. The select lines are registered one cycle ahead of BOOT
+--   so they are stable on its rising edge; the device then reloads itself
+--   from the selected flash image.
+
+--------------------------------------------------------------------------------
+
+library ieee;
+use ieee.std_logic_1164.all;
+
+entity warmboot_trigger is
+  port(
+    clk        : in  std_logic;
+    i_register : in  std_logic_vector(9 downto 0)  -- ABI register 0x09
+  );
+end entity warmboot_trigger;
+
+architecture rtl of warmboot_trigger is
+
+  component SB_WARMBOOT is
+    port (
+      BOOT : in std_logic;
+      S1   : in std_logic;
+      S0   : in std_logic
+    );
+  end component SB_WARMBOOT;
+
+  signal s_select : std_logic_vector(1 downto 0) := (others => '0');
+  signal s_request : std_logic := '0';
+  signal s_boot : std_logic := '0';
+
+begin
+
+  process (clk)
+  begin
+    if rising_edge(clk) then
+      s_select  <= i_register(1 downto 0);
+      s_request <= i_register(2);
+      s_boot    <= s_request;
+    end if;
+  end process;
+
+  warmboot_inst : SB_WARMBOOT
+    port map(
+      BOOT => s_boot,
+      S1   => s_select(1),
+      S0   => s_select(0)
+    );
+
+end architecture rtl;
@@ -0,0 +1,188 @@
+// Videomancer SDK - core_top Cycle Simulation Driver
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+//
+// Runs the CXXRTL model generated by fpga/sim/Makefile under
+// videomancer_core_harness. Control values are written over the model's
+// SPI pins by videomancer_fpga_controller, video enters on the decoder pins
+// and leaves on the HDMI transmitter pins, which every core configuration
+// drives. The first frame primes the pipeline; the following frames are
+// captured and hashed so regressions can compare against a golden hash.
+//
+// Usage: core_top_sim [timing=N] [frames=N] [pot1..pot6=V] [slider=V]
+//                     [switches=V] [in=file] [out=file]
+// Frame files hold 16-bit little-endian planes, Y then U then V, at the
+// active size of the selected timing.
+
+#include VIDEOMANCER_CXXRTL_MODEL
+
+#include <lzx/videomancer/videomancer_core_harness.hpp>
+#include <lzx/videomancer/videomancer_fpga_controller.hpp>
+#include <lzx/videomancer/vmprog_crypto.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace lzx;
+
+namespace
+{
+    /// @brief core_top CXXRTL model behind the harness pin interface
+    class cxxrtl_core : public videomancer_core_model
+    {
+    public:
+        void clock(const videomancer_core_inputs& in, videomancer_core_outputs& out) override
+        {
+            m_top.p_i__spi__sck.set<bool>(in.spi_sck);
+            m_top.p_i__spi__sdi.set<bool>(in.spi_sdi);
+            m_top.p_i__spi__cs__n.set<bool>(in.spi_cs_n);
+
+            // Analog decoder bus: C in bits 19-10, Y in bits 9-0
+            m_top.p_i__vid__dec__d.set<uint32_t>((static_cast<uint32_t>(in.c) << 10) | in.y);
+            m_top.p_i__vid__dec__hsync.set<bool>(in.hsync_n);
+            m_top.p_i__vid__dec__vsync.set<bool>(in.vsync_n);
+            m_top.p_i__vid__dec__field__de.set<bool>(in.avid);
+
+            // HDMI receiver bus: upper 8 bits of Y and C, then the low 2 bits
+            const uint32_t hdmi = (static_cast<uint32_t>(in.y >> 2) << 8) | (in.c >> 2) |
+                                  (static_cast<uint32_t>(in.y & 3) << 22) | (static_cast<uint32_t>(in.c & 3) << 18);
+            m_top.p_i__hdmi__rx__d.set<uint32_t>(hdmi);
+            m_top.p_i__hdmi__rx__hsync.set<bool>(in.hsync_n);
+            m_top.p_i__hdmi__rx__vsync.set<bool>(in.vsync_n);
+            m_top.p_i__hdmi__rx__de.set<bool>(in.avid);
+
+            m_top.p_i__vid__dec__clk.set<bool>(false);
+            m_top.p_i__hdmi__rx__clk.set<bool>(false);
+            m_top.step();
+            m_top.p_i__vid__dec__clk.set<bool>(true);
+            m_top.p_i__hdmi__rx__clk.set<bool>(true);
+            m_top.step();
+
+            const uint32_t d = m_top.p_o__hdmi__tx__d.get<uint32_t>();
+            out.y = static_cast<uint16_t>((d >> 14) & 0x3FF);
+            out.c = static_cast<uint16_t>((d >> 4) & 0x3FF);
+            out.hsync_n = m_top.p_o__hdmi__tx__hsync.get<bool>();
+            out.vsync_n = m_top.p_o__hdmi__tx__vsync.get<bool>();
+        }
+
+    private:
+        cxxrtl_design::p_core__top m_top;
+    };
+
+    bool read_planes(const char* path, std::vector<uint16_t>& planes)
+    {
+        FILE* f = std::fopen(path, "rb");
+        if (!f)
+            return false;
+        const size_t n = std::fread(planes.data(), sizeof(uint16_t), planes.size(), f);
+        std::fclose(f);
+        return n == planes.size();
+    }
+
+    void print_hash(const std::vector<uint16_t>& planes)
+    {
+        uint8_t hash[32];
+        sha256_oneshot(reinterpret_cast<const uint8_t*>(planes.data()),
+                       static_cast<uint32_t>(planes.size() * sizeof(uint16_t)), hash);
+        for (uint8_t b : hash)
+            std::printf("%02x", b);
+        std::printf("\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint8_t timing_id = 0;
+    uint32_t frames = 1;
+    uint16_t pots[6] = { 512, 512, 512, 512, 512, 512 };
+    uint16_t slider = 512;
+    uint16_t switches = 0;
+    const char* in_path = nullptr;
+    const char* out_path = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* eq = std::strchr(argv[i], '=');
+        if (!eq)
+        {
+            std::fprintf(stderr, "Expected name=value, got %s\n", argv[i]);
+            return 2;
+        }
+        const std::string name(argv[i], static_cast<size_t>(eq - argv[i]));
+        const char* value = eq + 1;
+        if (name == "timing")
+            timing_id = static_cast<uint8_t>(std::strtoul(value, nullptr, 0));
+        else if (name == "frames")
+            frames = static_cast<uint32_t>(std::strtoul(value, nullptr, 0));
+        else if (name.size() == 4 && name.compare(0, 3, "pot") == 0 && name[3] >= '1' && name[3] <= '6')
+            pots[name[3] - '1'] = static_cast<uint16_t>(std::strtoul(value, nullptr, 0));
+        else if (name == "slider")
+            slider = static_cast<uint16_t>(std::strtoul(value, nullptr, 0));
+        else if (name == "switches")
+            switches = static_cast<uint16_t>(std::strtoul(value, nullptr, 0));
+        else if (name == "in")
+            in_path = value;
+        else if (name == "out")
+            out_path = value;
+        else
+        {
+            std::fprintf(stderr, "Unknown option %s\n", name.c_str());
+            return 2;
+        }
+    }
+
+    const auto timing = static_cast<videomancer_abi_v1_0::video_timing_id>(timing_id & 0xF);
+    const auto& info = videomancer_abi_v1_0::get_video_timing_info(timing);
+    if (info.lines_per_frame == 0)
+    {
+        std::fprintf(stderr, "Timing %u is reserved\n", timing_id);
+        return 2;
+    }
+    const size_t plane = static_cast<size_t>(info.frame_width) * info.frame_height;
+
+    std::vector<uint16_t> input(plane * 3);
+    std::vector<uint16_t> output(plane * 3, 0);
+    if (in_path && !read_planes(in_path, input))
+    {
+        std::fprintf(stderr, "Cannot read %zu samples from %s\n", input.size(), in_path);
+        return 1;
+    }
+
+    static cxxrtl_core core;
+    videomancer_core_harness harness(core, timing);
+    if (in_path)
+        harness.set_input_frame({ input.data(), input.data() + plane, input.data() + 2 * plane });
+    harness.set_output_frame({ output.data(), output.data() + plane, output.data() + 2 * plane });
+
+    videomancer_fpga_controller controller(harness);
+    controller.set_all_controls(pots, slider, static_cast<uint8_t>(switches), timing_id);
+
+    // Prime the pipeline and register shadow with one full frame
+    if (harness.run_frames(1) != 1)
+    {
+        std::fprintf(stderr, "No output sync from model\n");
+        return 1;
+    }
+
+    FILE* out = out_path ? std::fopen(out_path, "wb") : nullptr;
+    for (uint32_t f = 0; f < frames; ++f)
+    {
+        if (harness.run_frames(1) != 1)
+        {
+            std::fprintf(stderr, "Output lost sync in frame %u\n", f);
+            return 1;
+        }
+        if (out)
+            std::fwrite(output.data(), sizeof(uint16_t), output.size(), out);
+    }
+    if (out)
+        std::fclose(out);
+
+    std::printf("timing %u: %ux%u, latency %d clocks, %llu clocks simulated\n", timing_id,
+                info.frame_width, info.frame_height, harness.sync_latency_clocks(),
+                static_cast<unsigned long long>(harness.clock_count()));
+    print_hash(output);
+    return 0;
+}
@@ -0,0 +1,44 @@
+-- Videomancer SDK - Open source FPGA-based video effects development kit
+-- Copyright (C) 2025 LZX Industries LLC
+-- File: sd_video_clk_pll_2x.vhd - 2x Clock PLL Stand-in for Cycle Simulation
+-- License: GNU General Public License v3.0
+-- https://github.com/lzxindustries/videomancer-sdk
+--
+-- This file is free software: you can redistribute it and/or modify
+-- it under the terms of the GNU General Public License as published by
+-- the Free Software Foundation, either version 3 of the License, or
+-- (at your option) any later version.
+--
+-- This program is distributed in the hope that it will be useful,
+-- but WITHOUT ANY WARRANTY; without even the implied warranty of
+-- MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+-- GNU General Public License for more details.
+--
+-- You should have received a copy of the GNU General Public License
+-- along with this program. If not, see <https://www.gnu.org/licenses/>.
+--
+-- Description:
+--   Replaces the SB_PLL40_CORE wrapper when building the CXXRTL model. The
+--   2x clock only drives the SD encoder clock pin, which the cycle harness
+--   does not sample, so the input clock is passed straight through.
+
+--------------------------------------------------------------------------------
+
+library ieee;
+use ieee.std_logic_1164.all;
+
+entity sd_video_clk_pll_2x is
+  port(
+    i_clk       : in  std_logic;
+    o_clk       : out std_logic;
+    i_resetb    : in  std_logic;
+    i_bypass    : in  std_logic
+  );
+end entity sd_video_clk_pll_2x;
+
+architecture sim of sd_video_clk_pll_2x is
+begin
+
+  o_clk <= i_clk;
+
+end architecture sim;
@@ -0,0 +1,38 @@
+-- Videomancer SDK - Open source FPGA-based video effects development kit
+-- Copyright (C) 2025 LZX Industries LLC
+-- File: warmboot_trigger.vhd - Warmboot Stand-in for Cycle Simulation
+-- License: GNU General Public License v3.0
+-- https://github.com/lzxindustries/videomancer-sdk
+--
+-- This file is free software: you can redistribute it and/or modify
+-- it under the terms of the GNU General Public License as published by
+-- the Free Software Foundation, either version 3 of the License, or
+-- (at your option) any later version.
+--
+-- This program is distributed in the hope that it will be useful,
+-- but WITHOUT ANY WARRANTY; without even the implied warranty of
+-- MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+-- GNU General Public License for more details.
+--
+-- You should have received a copy of the GNU General Public License
+-- along with this program. If not, see <https://www.gnu.org/licenses/>.
+--
+-- Description:
+--   Replaces the SB_WARMBOOT wrapper when building the CXXRTL model. The
+--   harness models a single image, so warmboot requests are ignored.
+
+--------------------------------------------------------------------------------
+
+library ieee;
+use ieee.std_logic_1164.all;
+
+entity warmboot_trigger is
+  port(
+    clk        : in  std_logic;
+    i_register : in  std_logic_vector(9 downto 0)
+  );
+end entity warmboot_trigger;
+
+architecture sim of warmboot_trigger is
+begin
+end architecture sim;
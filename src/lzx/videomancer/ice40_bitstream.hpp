@@ -0,0 +1,399 @@
+// Videomancer SDK - Open source FPGA-based video effects development kit
+// Copyright (C) 2025 LZX Industries LLC
+// File: ice40_bitstream.hpp - iCE40 Bitstream Parser and BRAM Patcher
+// License: GNU General Public License v3.0
+// https://github.com/lzxindustries/videomancer-sdk
+//
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// Overview:
+//   Indexes the CRAM and BRAM sections of an icepack image (the payload of
+//   bitstream_* TOC entries) and rewrites BRAM init contents in place, so a
+//   lookup-table variant of a program is a patch plus a CRC and hash update
+//   instead of a full synthesis and place-and-route run.
+//
+// Image Format (icepack):
+//   - Optional comment block, then the preamble 7E AA 99 7E
+//   - Commands: one byte (opcode << 4 | payload length), then the payload,
+//     big-endian. 0x01 05 resets the CRC, 0x1 sets the bank, 0x6/0x7/0x8 set
+//     width - 1, height and row offset, 0x01 01 / 0x01 03 are followed by
+//     width * height / 8 CRAM / BRAM data bytes and two zero bytes, 0x22 is
+//     followed by the CRC and 0x01 06 wakes the device
+//   - CRC-16/CCITT (polynomial 0x1021, initial 0xFFFF) covers every byte
+//     after the CRC reset up to and including the 0x22 opcode
+//   - Data is row-major, most significant bit first; bit (x, y) of a bank is
+//     row y, column x
+//
+// BRAM Blocks:
+//   - Each SB_RAM40_4K occupies 16 columns of its bank across 256 rows;
+//     column 16 * block + n holds INIT_n, row k holds bit k of that INIT
+//   - Word w of the 256 x 16 view is INIT_(w / 16) bits (w % 16) * 16 upward
+//   - Block positions depend on the device and placement; locate a table by
+//     building the program with a distinctive placeholder and searching for
+//     it with find_bram_block()
+//
+// Usage:
+//   ice40_bitstream bitstream;
+//   bitstream.parse(payload, payload_size);
+//   bitstream.find_bram_block(placeholder, bank, block);
+//   bitstream.write_bram_block(bank, block, table);
+//   bitstream.update_crc();
+//   rehash_vmprog_payload(package, package_size, toc_index, secret_key, signature_stale);
+
+#pragma once
+
+#include "vmprog_format.hpp"
+#include <cstdint>
+#include <cstddef>
+
+namespace lzx {
+
+    /// Sync word that starts the command stream.
+    constexpr uint32_t ice40_preamble = 0x7EAA997Eu;
+
+    /// Words in a 4 Kbit BRAM block viewed as 256 x 16.
+    constexpr uint32_t ice40_bram_block_words = 256;
+
+    /**
+     * @brief Configuration memory type of a data section.
+     */
+    enum class ice40_section_kind : uint8_t {
+        cram = 0x01,
+        bram = 0x03,
+    };
+
+    /**
+     * @brief Parse outcome.
+     */
+    enum class ice40_parse_result : uint8_t {
+        ok = 0,
+        no_preamble = 1,          // Sync word not found
+        truncated = 2,            // Image ends inside a command or data section
+        unknown_command = 3,      // Opcode icepack never emits
+        bad_terminator = 4,       // Data section not followed by two zero bytes
+        too_many_sections = 5,    // More than ice40_bitstream::max_sections
+        no_crc = 6,               // No CRC reset and CRC check pair
+        crc_mismatch = 7,         // Stored CRC differs from the data
+    };
+
+    /**
+     * @brief One CRAM or BRAM data section.
+     */
+    struct ice40_section {
+        ice40_section_kind kind;
+        uint8_t bank;
+        uint16_t width;         // Bits per row
+        uint16_t height;        // Rows
+        uint16_t row_offset;    // First bank row covered
+        uint32_t data_offset;   // Offset of the first data byte in the image
+    };
+
+    /**
+     * @brief CRC-16/CCITT of icepack images.
+     *
+     * @param crc Running value (0xFFFF after a CRC reset)
+     * @param data Bytes to add
+     * @param size Number of bytes
+     * @return Updated CRC
+     */
+    inline uint16_t ice40_crc16(uint16_t crc, const uint8_t* data, uint32_t size) {
+        struct table_type {
+            uint16_t entries[256];
+            constexpr table_type() : entries() {
+                for (uint32_t i = 0; i < 256; ++i) {
+                    uint16_t value = static_cast<uint16_t>(i << 8);
+                    for (int bit = 0; bit < 8; ++bit) {
+                        value = static_cast<uint16_t>((value & 0x8000) ? (value << 1) ^ 0x1021 : value << 1);
+                    }
+                    entries[i] = value;
+                }
+            }
+        };
+        static constexpr table_type table;
+
+        for (uint32_t i = 0; i < size; ++i) {
+            crc = static_cast<uint16_t>((crc << 8) ^ table.entries[((crc >> 8) ^ data[i]) & 0xFF]);
+        }
+        return crc;
+    }
+
+    /**
+     * @brief Index over an icepack image held in caller memory.
+     *
+     * The image is not copied; BRAM writes modify it directly. Call
+     * update_crc() after the last write so the device accepts the image.
+     */
+    class ice40_bitstream {
+    public:
+        /// Sections indexed per image (HX8K-class dies use 12).
+        static constexpr uint32_t max_sections = 32;
+
+        ice40_bitstream() = default;
+
+        /**
+         * @brief Index an image.
+         *
+         * @param image Image bytes (kept by reference for later writes)
+         * @param size Image size in bytes
+         * @return Parse result; the stored CRC is checked
+         */
+        ice40_parse_result parse(uint8_t* image, uint32_t size) {
+            image_ = image;
+            size_ = size;
+            section_count_ = 0;
+            crc_start_ = 0;
+            crc_offset_ = 0;
+
+            uint32_t pos = 0;
+            uint32_t window = 0;
+            while (pos < size && window != ice40_preamble) {
+                window = (window << 8) | image[pos++];
+            }
+            if (window != ice40_preamble) {
+                return ice40_parse_result::no_preamble;
+            }
+
+            uint8_t bank = 0;
+            uint16_t width = 0;
+            uint16_t height = 0;
+            uint16_t row_offset = 0;
+            bool crc_reset = false;
+            while (pos < size) {
+                const uint8_t opcode = image[pos] >> 4;
+                const uint8_t length = image[pos] & 0x0F;
+                if (length > 4 || pos + 1 + length > size) {
+                    return ice40_parse_result::truncated;
+                }
+                uint32_t payload = 0;
+                for (uint8_t i = 0; i < length; ++i) {
+                    payload = (payload << 8) | image[pos + 1 + i];
+                }
+                const uint32_t opcode_pos = pos;
+                pos += 1 + length;
+
+                switch (opcode) {
+                case 0x0:
+                    if (length == 0) {
+                        break;  // Padding
+                    }
+                    if (payload == 0x01 || payload == 0x03) {
+                        const uint32_t data_size = static_cast<uint32_t>(width) * height / 8;
+                        if (pos + data_size + 2 > size) {
+                            return ice40_parse_result::truncated;
+                        }
+                        if (image[pos + data_size] != 0 || image[pos + data_size + 1] != 0) {
+                            return ice40_parse_result::bad_terminator;
+                        }
+                        if (section_count_ == max_sections) {
+                            return ice40_parse_result::too_many_sections;
+                        }
+                        sections_[section_count_++] = { static_cast<ice40_section_kind>(payload), bank,
+                                                        width, height, row_offset, pos };
+                        pos += data_size + 2;
+                    } else if (payload == 0x05) {
+                        crc_reset = true;
+                        crc_start_ = pos;
+                    } else if (payload == 0x06) {
+                        return finish(crc_reset);  // Wakeup ends the stream
+                    }
+                    break;
+                case 0x1:
+                    bank = static_cast<uint8_t>(payload);
+                    break;
+                case 0x2:
+                    crc_offset_ = opcode_pos + 1;
+                    break;
+                case 0x5:
+                case 0x9:
+                    break;  // Oscillator range, feature flags
+                case 0x6:
+                    width = static_cast<uint16_t>(payload + 1);
+                    break;
+                case 0x7:
+                    height = static_cast<uint16_t>(payload);
+                    break;
+                case 0x8:
+                    row_offset = static_cast<uint16_t>(payload);
+                    break;
+                default:
+                    return ice40_parse_result::unknown_command;
+                }
+            }
+            return finish(crc_reset);
+        }
+
+        /// Number of indexed sections.
+        uint32_t section_count() const { return section_count_; }
+
+        /// Section by index.
+        const ice40_section& section(uint32_t index) const { return sections_[index]; }
+
+        /// CRC computed over the current image contents.
+        uint16_t compute_crc() const {
+            return ice40_crc16(0xFFFF, image_ + crc_start_, crc_offset_ - crc_start_);
+        }
+
+        /// CRC stored in the image.
+        uint16_t stored_crc() const {
+            return static_cast<uint16_t>((image_[crc_offset_] << 8) | image_[crc_offset_ + 1]);
+        }
+
+        /// Rewrite the stored CRC after BRAM writes.
+        void update_crc() {
+            const uint16_t crc = compute_crc();
+            image_[crc_offset_] = static_cast<uint8_t>(crc >> 8);
+            image_[crc_offset_ + 1] = static_cast<uint8_t>(crc);
+        }
+
+        /**
+         * @brief Number of BRAM blocks in a bank.
+         * @return 0 when the bank has no 256-row BRAM data
+         */
+        uint16_t bram_block_count(uint8_t bank) const {
+            uint16_t width = 0;
+            uint32_t rows = 0;
+            for (uint32_t i = 0; i < section_count_; ++i) {
+                const auto& s = sections_[i];
+                if (s.kind == ice40_section_kind::bram && s.bank == bank) {
+                    width = s.width;
+                    rows += s.height;
+                }
+            }
+            return rows >= 256 ? static_cast<uint16_t>(width / 16) : 0;
+        }
+
+        /**
+         * @brief Read one BRAM bit.
+         * @return false if the bit lies outside the indexed BRAM data
+         */
+        bool get_bram_bit(uint8_t bank, uint16_t column, uint16_t row, bool& out_value) const {
+            uint32_t byte = 0;
+            uint8_t mask = 0;
+            if (!locate(bank, column, row, byte, mask)) {
+                return false;
+            }
+            out_value = (image_[byte] & mask) != 0;
+            return true;
+        }
+
+        /**
+         * @brief Write one BRAM bit (the CRC is not updated).
+         * @return false if the bit lies outside the indexed BRAM data
+         */
+        bool set_bram_bit(uint8_t bank, uint16_t column, uint16_t row, bool value) {
+            uint32_t byte = 0;
+            uint8_t mask = 0;
+            if (!locate(bank, column, row, byte, mask)) {
+                return false;
+            }
+            image_[byte] = static_cast<uint8_t>(value ? image_[byte] | mask : image_[byte] & ~mask);
+            return true;
+        }
+
+        /**
+         * @brief Read a BRAM block as 256 16-bit words.
+         * @return false if the block is not in the image
+         */
+        bool read_bram_block(uint8_t bank, uint16_t block, uint16_t out_words[ice40_bram_block_words]) const {
+            if (block >= bram_block_count(bank)) {
+                return false;
+            }
+            for (uint32_t w = 0; w < ice40_bram_block_words; ++w) {
+                uint16_t word = 0;
+                for (uint16_t b = 0; b < 16; ++b) {
+                    bool bit = false;
+                    get_bram_bit(bank, word_column(block, w), word_row(w, b), bit);
+                    word = static_cast<uint16_t>(word | (bit ? 1u << b : 0u));
+                }
+                out_words[w] = word;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Replace a BRAM block's init contents (the CRC is not updated).
+         * @return false if the block is not in the image
+         */
+        bool write_bram_block(uint8_t bank, uint16_t block, const uint16_t words[ice40_bram_block_words]) {
+            if (block >= bram_block_count(bank)) {
+                return false;
+            }
+            for (uint32_t w = 0; w < ice40_bram_block_words; ++w) {
+                for (uint16_t b = 0; b < 16; ++b) {
+                    set_bram_bit(bank, word_column(block, w), word_row(w, b), ((words[w] >> b) & 1) != 0);
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Find the block whose contents equal a placeholder table.
+         * @return true and the first match, false if none matches
+         */
+        bool find_bram_block(const uint16_t words[ice40_bram_block_words],
+                             uint8_t& out_bank, uint16_t& out_block) const {
+            uint16_t contents[ice40_bram_block_words];
+            for (uint8_t bank = 0; bank < 4; ++bank) {
+                for (uint16_t block = 0; block < bram_block_count(bank); ++block) {
+                    read_bram_block(bank, block, contents);
+                    if (memcmp(contents, words, sizeof(contents)) == 0) {
+                        out_bank = bank;
+                        out_block = block;
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+    private:
+        uint8_t* image_ = nullptr;
+        uint32_t size_ = 0;
+        ice40_section sections_[max_sections] = {};
+        uint32_t section_count_ = 0;
+        uint32_t crc_start_ = 0;
+        uint32_t crc_offset_ = 0;
+
+        static uint16_t word_column(uint16_t block, uint32_t word) {
+            return static_cast<uint16_t>(block * 16 + word / 16);
+        }
+
+        static uint16_t word_row(uint32_t word, uint16_t bit) {
+            return static_cast<uint16_t>((word % 16) * 16 + bit);
+        }
+
+        ice40_parse_result finish(bool crc_reset) const {
+            if (!crc_reset || crc_offset_ <= crc_start_ || crc_offset_ + 2 > size_) {
+                return ice40_parse_result::no_crc;
+            }
+            return compute_crc() == stored_crc() ? ice40_parse_result::ok : ice40_parse_result::crc_mismatch;
+        }
+
+        bool locate(uint8_t bank, uint16_t column, uint16_t row, uint32_t& out_byte, uint8_t& out_mask) const {
+            for (uint32_t i = 0; i < section_count_; ++i) {
+                const auto& s = sections_[i];
+                if (s.kind != ice40_section_kind::bram || s.bank != bank || column >= s.width ||
+                    row < s.row_offset || row >= s.row_offset + s.height) {
+                    continue;
+                }
+                const uint32_t bit = static_cast<uint32_t>(row - s.row_offset) * s.width + column;
+                out_byte = s.data_offset + bit / 8;
+                out_mask = static_cast<uint8_t>(0x80 >> (bit % 8));
+                return true;
+            }
+            return false;
+        }
+    };
+
+} // namespace lzx
@@ -0,0 +1,219 @@
+// Videomancer SDK - Open source FPGA-based video effects development kit
+// Copyright (C) 2025 LZX Industries LLC
+// File: ice40_multiboot.hpp - iCE40 Multiboot Flash Layout
+// License: GNU General Public License v3.0
+// https://github.com/lzxindustries/videomancer-sdk
+//
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// Overview:
+//   Packs up to four program bitstreams into the multiboot layout an iCE40
+//   reads from its configuration flash (the layout icemulti produces), so a
+//   favourite program can be entered with a warmboot through ABI register
+//   0x09 (videomancer_fpga_controller::warmboot()) in milliseconds instead
+//   of a full SPI configuration from the MCU.
+//
+// Flash Layout:
+//   - Five 32-byte headers at offset 0: the power-on image, then warmboot
+//     images 0-3 (SB_WARMBOOT S1:S0)
+//   - Each header: preamble 7E AA 99 7E, boot mode 92 00 00, boot address
+//     44 03 + 24-bit offset, bank 82 00 00, reboot 01 08, zero padding
+//   - Images follow at aligned offsets; gaps are 0xFF (erased flash)
+//   - Unused warmboot slots point at image 0
+//   - Every image must itself contain the warmboot logic (the standard
+//     cores do) to be able to leave again
+//
+// Usage (MCU, streaming bitstreams out of installed packages):
+//   uint32_t sizes[] = { toc_a.size, toc_b.size };
+//   ice40_multiboot_layout layout;
+//   plan_ice40_multiboot(sizes, 2, 0, ice40_multiboot_default_alignment, layout);
+//   write_ice40_multiboot_headers(layout, headers);   // flash offset 0
+//   // copy each bitstream payload to layout.offset[i]
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace lzx {
+
+    /// Warmboot images selectable through SB_WARMBOOT.
+    constexpr uint32_t ice40_multiboot_max_images = 4;
+
+    /// Size of one boot header.
+    constexpr uint32_t ice40_multiboot_header_size = 32;
+
+    /// Boot headers: power-on image plus one per warmboot image.
+    constexpr uint32_t ice40_multiboot_header_count = 1 + ice40_multiboot_max_images;
+
+    /// Bytes reserved for the boot headers at the start of flash.
+    constexpr uint32_t ice40_multiboot_headers_size = ice40_multiboot_header_count * ice40_multiboot_header_size;
+
+    /// Image alignment: one 4 KB flash sector, so each slot can be rewritten alone.
+    constexpr uint32_t ice40_multiboot_default_alignment = 4096;
+
+    /// Boot addresses are 24-bit.
+    constexpr uint32_t ice40_multiboot_max_flash_size = 1u << 24;
+
+    /**
+     * @brief Placement of the images in flash.
+     */
+    struct ice40_multiboot_layout {
+        uint32_t image_count;                           // Images placed (1-4)
+        uint32_t power_on_image;                        // Image loaded at power-on
+        uint32_t offset[ice40_multiboot_max_images];    // Flash offset of each image
+        uint32_t size[ice40_multiboot_max_images];      // Size of each image
+        uint32_t total_size;                            // Flash bytes used (end of last image)
+    };
+
+    /**
+     * @brief Place images after the boot headers.
+     *
+     * @param sizes Image sizes in bytes (e.g. bitstream TOC entry sizes)
+     * @param count Number of images (1-4)
+     * @param power_on_image Image booted at power-on (< count)
+     * @param alignment Image alignment, a power of two
+     * @param layout Output placement
+     * @return false for an invalid argument or a layout beyond 16 MB
+     */
+    inline bool plan_ice40_multiboot(
+        const uint32_t* sizes,
+        uint32_t count,
+        uint32_t power_on_image,
+        uint32_t alignment,
+        ice40_multiboot_layout& layout
+    ) {
+        if (!sizes || count == 0 || count > ice40_multiboot_max_images || power_on_image >= count) {
+            return false;
+        }
+        if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment >= ice40_multiboot_max_flash_size) {
+            return false;
+        }
+
+        memset(&layout, 0, sizeof(layout));
+        layout.image_count = count;
+        layout.power_on_image = power_on_image;
+
+        uint64_t position = ice40_multiboot_headers_size;
+        for (uint32_t i = 0; i < count; ++i) {
+            if (sizes[i] == 0) return false;
+            position = (position + alignment - 1) & ~static_cast<uint64_t>(alignment - 1);
+            if (position + sizes[i] > ice40_multiboot_max_flash_size) return false;
+            layout.offset[i] = static_cast<uint32_t>(position);
+            layout.size[i] = sizes[i];
+            position += sizes[i];
+        }
+        layout.total_size = static_cast<uint32_t>(position);
+        return true;
+    }
+
+    /**
+     * @brief Write the five boot headers.
+     *
+     * @param layout Placement from plan_ice40_multiboot()
+     * @param out Destination (ice40_multiboot_headers_size bytes, flash offset 0)
+     */
+    inline void write_ice40_multiboot_headers(
+        const ice40_multiboot_layout& layout,
+        uint8_t out[ice40_multiboot_headers_size]
+    ) {
+        memset(out, 0, ice40_multiboot_headers_size);
+        for (uint32_t slot = 0; slot < ice40_multiboot_header_count; ++slot) {
+            uint32_t image = (slot == 0) ? layout.power_on_image : slot - 1;
+            if (image >= layout.image_count) image = 0;
+            const uint32_t address = layout.offset[image];
+
+            const uint8_t header[] = {
+                0x7E, 0xAA, 0x99, 0x7E,                 // Preamble
+                0x92, 0x00, 0x00,                       // Boot mode
+                0x44, 0x03,                             // Boot address
+                static_cast<uint8_t>(address >> 16),
+                static_cast<uint8_t>(address >> 8),
+                static_cast<uint8_t>(address),
+                0x82, 0x00, 0x00,                       // Bank offset
+                0x01, 0x08,                             // Reboot
+            };
+            memcpy(out + slot * ice40_multiboot_header_size, header, sizeof(header));
+        }
+    }
+
+    /**
+     * @brief Build a complete multiboot flash image in memory.
+     *
+     * @param images Image data pointers
+     * @param sizes Image sizes
+     * @param count Number of images (1-4)
+     * @param power_on_image Image booted at power-on
+     * @param out Destination
+     * @param out_capacity Size of out
+     * @param layout Output placement; layout.total_size bytes of out are written
+     * @param alignment Image alignment, a power of two
+     * @return false for an invalid argument or if out is too small
+     */
+    inline bool pack_ice40_multiboot(
+        const uint8_t* const* images,
+        const uint32_t* sizes,
+        uint32_t count,
+        uint32_t power_on_image,
+        uint8_t* out,
+        uint32_t out_capacity,
+        ice40_multiboot_layout& layout,
+        uint32_t alignment = ice40_multiboot_default_alignment
+    ) {
+        if (!images || !out || !plan_ice40_multiboot(sizes, count, power_on_image, alignment, layout)) {
+            return false;
+        }
+        if (layout.total_size > out_capacity) return false;
+
+        memset(out, 0xFF, layout.total_size);
+        write_ice40_multiboot_headers(layout, out);
+        for (uint32_t i = 0; i < count; ++i) {
+            if (!images[i]) return false;
+            memcpy(out + layout.offset[i], images[i], sizes[i]);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Read the boot addresses back from a flash image.
+     *
+     * @param data Start of flash
+     * @param size Bytes available (at least ice40_multiboot_headers_size)
+     * @param addresses Output: power-on address, then warmboot images 0-3
+     * @return false if any header is malformed
+     */
+    inline bool read_ice40_multiboot_headers(
+        const uint8_t* data,
+        uint32_t size,
+        uint32_t addresses[ice40_multiboot_header_count]
+    ) {
+        if (!data || size < ice40_multiboot_headers_size) return false;
+
+        static const uint8_t preamble[] = { 0x7E, 0xAA, 0x99, 0x7E };
+        for (uint32_t slot = 0; slot < ice40_multiboot_header_count; ++slot) {
+            const uint8_t* header = data + slot * ice40_multiboot_header_size;
+            if (memcmp(header, preamble, sizeof(preamble)) != 0 ||
+                header[4] != 0x92 || header[7] != 0x44 || header[8] != 0x03 ||
+                header[15] != 0x01 || header[16] != 0x08) {
+                return false;
+            }
+            addresses[slot] = (static_cast<uint32_t>(header[9]) << 16) |
+                              (static_cast<uint32_t>(header[10]) << 8) |
+                              header[11];
+        }
+        return true;
+    }
+
+} // namespace lzx
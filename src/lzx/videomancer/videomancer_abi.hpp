@@ -40,6 +40,7 @@ namespace videomancer_abi_v1_0
         constexpr uint8_t toggle_switches  = 0x06;
         constexpr uint8_t linear_pot_12    = 0x07;
         constexpr uint8_t video_timing_id  = 0x08;
+        constexpr uint8_t warmboot         = 0x09;
     }
 
     /// @brief Bit positions for toggle switches in register 0x06
@@ -52,6 +53,19 @@ namespace videomancer_abi_v1_0
         constexpr uint8_t switch_11 = 4;
     }
 
+    /// @brief Bit positions in the warmboot register 0x09
+    ///
+    /// Writing boot = 1 reloads the FPGA from multiboot flash image
+    /// image_select (see ice40_multiboot.hpp); all registers reset.
+    namespace warmboot_bit
+    {
+        constexpr uint8_t image_select = 0;  // Bits [1:0], image 0-3
+        constexpr uint8_t boot         = 2;
+    }
+
+    /// @brief Number of warmboot images addressable through register 0x09
+    constexpr uint8_t warmboot_image_count = 4;
+
     /// @brief Video timing mode IDs
     enum class video_timing_id : uint8_t
     {
@@ -73,5 +87,111 @@ namespace videomancer_abi_v1_0
         reserved     = 0xF   // Reserved
     };
 
+    /// @brief Raster geometry and frame rate of a video timing mode
+    ///
+    /// Geometry mirrors C_VIDEO_SYNC_CONFIG_ARRAY in
+    /// fpga/common/rtl/video_sync/video_sync_pkg.vhd. Frame rates are exact
+    /// rationals (e.g. 29.97 Hz = 30000/1001); interlaced modes carry two
+    /// fields per frame.
+    struct video_timing_info
+    {
+        uint16_t clocks_per_line;   // Total pixel clocks per line (active + blanking)
+        uint16_t lines_per_frame;   // Total lines per frame (both fields if interlaced)
+        uint16_t frame_width;       // Active pixels per line
+        uint16_t frame_height;      // Active lines per frame
+        uint32_t frame_rate_num;    // Frame rate numerator (Hz)
+        uint32_t frame_rate_den;    // Frame rate denominator
+        bool     is_interlaced;     // Two fields per frame
+        bool     top_field_first;   // Field order (interlaced modes only)
+    };
+
+    /// @brief Timing table indexed by video_timing_id
+    constexpr video_timing_info video_timing_table[16] =
+    {
+        {  858,  525,  720,  486, 30000, 1001, true,  false },  // 0x0 ntsc
+        { 2640, 1125, 1920, 1080,    25,    1, true,  true  },  // 0x1 1080i50
+        { 2200, 1125, 1920, 1080, 30000, 1001, true,  true  },  // 0x2 1080i59.94
+        { 2750, 1125, 1920, 1080,    24,    1, false, true  },  // 0x3 1080p24
+        {  858,  525,  720,  480, 60000, 1001, false, true  },  // 0x4 480p
+        { 1980,  750, 1280,  720,    50,    1, false, true  },  // 0x5 720p50
+        { 1650,  750, 1280,  720, 60000, 1001, false, true  },  // 0x6 720p59.94
+        { 2200, 1125, 1920, 1080,    30,    1, false, true  },  // 0x7 1080p30
+        {  864,  625,  720,  576,    25,    1, true,  true  },  // 0x8 pal
+        { 2750, 1125, 1920, 1080, 24000, 1001, false, true  },  // 0x9 1080p23.98
+        { 2200, 1125, 1920, 1080,    30,    1, true,  true  },  // 0xA 1080i60
+        { 2640, 1125, 1920, 1080,    25,    1, false, true  },  // 0xB 1080p25
+        {  864,  625,  720,  576,    50,    1, false, true  },  // 0xC 576p
+        { 2200, 1125, 1920, 1080, 30000, 1001, false, true  },  // 0xD 1080p29.97
+        { 1650,  750, 1280,  720,    60,    1, false, true  },  // 0xE 720p60
+        {    0,    0,    0,    0,     0,    1, false, true  },  // 0xF reserved
+    };
+
+    /// @brief Look up raster geometry and frame rate for a timing mode
+    /// @param id Video timing mode
+    /// @return Timing table entry (all-zero geometry for reserved)
+    constexpr const video_timing_info& get_video_timing_info(video_timing_id id)
+    {
+        return video_timing_table[static_cast<uint8_t>(id) & 0xF];
+    }
+
+    /// @brief Check whether a timing mode has a defined raster
+    /// @param id Video timing mode
+    /// @return true for all modes except reserved
+    constexpr bool is_video_timing_defined(video_timing_id id)
+    {
+        return get_video_timing_info(id).frame_rate_num != 0;
+    }
+
+    /// @brief Exact rate in Hz as a rational
+    struct video_rate
+    {
+        uint32_t num;
+        uint32_t den;
+    };
+
+    /// @brief Frame rate of a timing mode
+    /// @param id Video timing mode
+    /// @return Rate (num = 0 for reserved)
+    constexpr video_rate get_frame_rate(video_timing_id id)
+    {
+        return { get_video_timing_info(id).frame_rate_num, get_video_timing_info(id).frame_rate_den };
+    }
+
+    /// @brief Field rate of a timing mode (twice the frame rate if interlaced)
+    /// @param id Video timing mode
+    /// @return Rate (num = 0 for reserved)
+    constexpr video_rate get_field_rate(video_timing_id id)
+    {
+        return { get_video_timing_info(id).frame_rate_num * (get_video_timing_info(id).is_interlaced ? 2u : 1u),
+                 get_video_timing_info(id).frame_rate_den };
+    }
+
+    /// @brief Start time of tick n at a rate, in nanoseconds (rounded down)
+    ///
+    /// Computed from n directly, so deadlines never accumulate rounding
+    /// error: tick 60000 at 60000/1001 Hz is exactly 1001 s.
+    /// @param rate Tick rate
+    /// @param n Tick index
+    /// @return n / rate in nanoseconds, 0 for a reserved rate
+    constexpr uint64_t get_tick_time_ns(video_rate rate, uint64_t n)
+    {
+        // n = q * num + r: q * num ticks last exactly q * den seconds
+        return rate.num == 0 ? 0 :
+            (n / rate.num) * rate.den * 1000000000ull +
+            (n % rate.num) * rate.den * 1000000000ull / rate.num;
+    }
+
+    /// @brief Pixel clock of a timing mode in Hz (rounded down)
+    /// @param id Video timing mode
+    /// @return Pixel clock frequency, 0 for reserved
+    constexpr uint32_t get_pixel_clock_hz(video_timing_id id)
+    {
+        return static_cast<uint32_t>(
+            static_cast<uint64_t>(get_video_timing_info(id).clocks_per_line) *
+            get_video_timing_info(id).lines_per_frame *
+            get_video_timing_info(id).frame_rate_num /
+            get_video_timing_info(id).frame_rate_den);
+    }
+
 } // namespace videomancer_abi_v1_0
 } // namespace lzx
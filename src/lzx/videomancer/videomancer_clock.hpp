@@ -0,0 +1,38 @@
+// Videomancer SDK - Open source FPGA-based video effects development kit
+// Copyright (C) 2025 LZX Industries LLC
+// File: videomancer_clock.hpp - Videomancer Time Source Interface
+// License: GNU General Public License v3.0
+// https://github.com/lzxindustries/videomancer-sdk
+//
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lzx
+{
+    /// @brief Monotonic microsecond time source
+    ///
+    /// Firmware implements this on top of the MCU timer (e.g. time_us_64() on
+    /// RP2040); host tools and tests supply a steady or simulated clock.
+    class videomancer_clock
+    {
+    public:
+        virtual ~videomancer_clock() = default;
+        virtual uint64_t now_us() = 0;
+    };
+
+} // namespace lzx
@@ -0,0 +1,227 @@
+// Videomancer SDK - Open source FPGA-based video effects development kit
+// Copyright (C) 2025 LZX Industries LLC
+// File: videomancer_colorimetry.hpp - YUV to RGB Preview Conversion
+// License: GNU General Public License v3.0
+// https://github.com/lzxindustries/videomancer-sdk
+//
+// Converts 10-bit limited-range Y'CbCr 4:4:4 planes, as captured from the
+// program output, into 8-bit full-range RGBA for on-screen previews. The
+// matrix follows the timing mode: BT.601 (SMPTE 170M, BT.470) for SD modes
+// and BT.709 (SMPTE 274M) for HD modes. See docs/video-standards.
+//
+// All kernels use the same Q15 fixed-point arithmetic, so the SSE2 and NEON
+// paths produce exactly the scalar result.
+//
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// Limited range (10-bit):
+//   Y'    64..940  (black..white)
+//   Cb,Cr 64..960  (512 = no colour)
+
+#pragma once
+
+#include "videomancer_abi.hpp"
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VIDEOMANCER_COLORIMETRY_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define VIDEOMANCER_COLORIMETRY_NEON 1
+#endif
+
+namespace lzx
+{
+    /// @brief Y'CbCr to R'G'B' matrix
+    enum class videomancer_color_matrix : uint8_t
+    {
+        bt601,  // SD: SMPTE 170M, BT.470
+        bt709   // HD: SMPTE 274M
+    };
+
+    /// @brief Q15 coefficients mapping 10-bit limited-range Y'CbCr to 8-bit R'G'B'
+    struct videomancer_yuv_coefficients
+    {
+        int16_t y;      // Luma gain
+        int16_t r_v;    // Cr contribution to R
+        int16_t g_u;    // Cb contribution subtracted from G
+        int16_t g_v;    // Cr contribution subtracted from G
+        int16_t b_u;    // Cb contribution to B
+    };
+
+    /// @brief Derive coefficients from the luma weights Kr and Kb
+    constexpr videomancer_yuv_coefficients make_videomancer_yuv_coefficients(double kr, double kb)
+    {
+        // Y' spans 876 codes and Cb/Cr 896 codes in 10-bit limited range
+        return {
+            static_cast<int16_t>(255.0 / 876.0 * 32768.0 + 0.5),
+            static_cast<int16_t>(255.0 * 2.0 * (1.0 - kr) / 896.0 * 32768.0 + 0.5),
+            static_cast<int16_t>(255.0 * 2.0 * kb * (1.0 - kb) / (1.0 - kr - kb) / 896.0 * 32768.0 + 0.5),
+            static_cast<int16_t>(255.0 * 2.0 * kr * (1.0 - kr) / (1.0 - kr - kb) / 896.0 * 32768.0 + 0.5),
+            static_cast<int16_t>(255.0 * 2.0 * (1.0 - kb) / 896.0 * 32768.0 + 0.5)
+        };
+    }
+
+    constexpr videomancer_yuv_coefficients videomancer_bt601_coefficients =
+        make_videomancer_yuv_coefficients(0.299, 0.114);
+    constexpr videomancer_yuv_coefficients videomancer_bt709_coefficients =
+        make_videomancer_yuv_coefficients(0.2126, 0.0722);
+
+    /// @brief Coefficients of a matrix
+    constexpr const videomancer_yuv_coefficients& get_videomancer_yuv_coefficients(videomancer_color_matrix matrix)
+    {
+        return matrix == videomancer_color_matrix::bt601 ? videomancer_bt601_coefficients
+                                                         : videomancer_bt709_coefficients;
+    }
+
+    /// @brief Matrix of a timing mode: BT.601 for SD (576 lines or fewer), BT.709 for HD
+    constexpr videomancer_color_matrix get_videomancer_color_matrix(videomancer_abi_v1_0::video_timing_id id)
+    {
+        return videomancer_abi_v1_0::get_video_timing_info(id).frame_height <= 576
+            ? videomancer_color_matrix::bt601
+            : videomancer_color_matrix::bt709;
+    }
+
+    /// @brief Convert pixels one at a time (reference and tail kernel)
+    /// @param y Luma plane (10-bit)
+    /// @param u Cb plane (10-bit)
+    /// @param v Cr plane (10-bit)
+    /// @param rgba Output, 4 bytes per pixel with opaque alpha
+    /// @param count Number of pixels
+    /// @param k Matrix coefficients
+    inline void convert_yuv444_to_rgba8_scalar(const uint16_t* y, const uint16_t* u, const uint16_t* v,
+                                               uint8_t* rgba, size_t count, const videomancer_yuv_coefficients& k)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const int32_t yy = (static_cast<int32_t>(y[i]) - 64) * k.y + (1 << 14);
+            const int32_t cb = static_cast<int32_t>(u[i]) - 512;
+            const int32_t cr = static_cast<int32_t>(v[i]) - 512;
+            const int32_t rgb[3] = {
+                (yy + k.r_v * cr) >> 15,
+                (yy - k.g_u * cb - k.g_v * cr) >> 15,
+                (yy + k.b_u * cb) >> 15
+            };
+            for (int c = 0; c < 3; ++c)
+                rgba[c] = static_cast<uint8_t>(rgb[c] < 0 ? 0 : (rgb[c] > 255 ? 255 : rgb[c]));
+            rgba[3] = 255;
+            rgba += 4;
+        }
+    }
+
+    /// @brief Convert a row of pixels with the widest kernel available
+    /// @param y Luma plane (10-bit)
+    /// @param u Cb plane (10-bit)
+    /// @param v Cr plane (10-bit)
+    /// @param rgba Output, 4 bytes per pixel with opaque alpha
+    /// @param count Number of pixels
+    /// @param k Matrix coefficients
+    inline void convert_yuv444_to_rgba8(const uint16_t* y, const uint16_t* u, const uint16_t* v,
+                                        uint8_t* rgba, size_t count, const videomancer_yuv_coefficients& k)
+    {
+        size_t i = 0;
+#if defined(VIDEOMANCER_COLORIMETRY_SSE2)
+        // Pairs of 16-bit lanes feed _mm_madd_epi16; the odd lane of the
+        // G-from-Cr pair multiplies a constant 1 to add the rounding term.
+        const __m128i luma_offset = _mm_set1_epi16(64);
+        const __m128i chroma_offset = _mm_set1_epi16(512);
+        const __m128i one = _mm_set1_epi16(1);
+        const __m128i round = _mm_set1_epi32(1 << 14);
+        const __m128i alpha = _mm_set1_epi8(static_cast<char>(0xFF));
+        const __m128i k_r = _mm_set1_epi32(static_cast<int32_t>((static_cast<uint32_t>(static_cast<uint16_t>(k.r_v)) << 16) |
+                                                                static_cast<uint16_t>(k.y)));
+        const __m128i k_b = _mm_set1_epi32(static_cast<int32_t>((static_cast<uint32_t>(static_cast<uint16_t>(k.b_u)) << 16) |
+                                                                static_cast<uint16_t>(k.y)));
+        const __m128i k_g_yu = _mm_set1_epi32(static_cast<int32_t>((static_cast<uint32_t>(static_cast<uint16_t>(-k.g_u)) << 16) |
+                                                                   static_cast<uint16_t>(k.y)));
+        const __m128i k_g_v = _mm_set1_epi32(static_cast<int32_t>((static_cast<uint32_t>(1u << 14) << 16) |
+                                                                  static_cast<uint16_t>(-k.g_v)));
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i yy = _mm_sub_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i)), luma_offset);
+            const __m128i cb = _mm_sub_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(u + i)), chroma_offset);
+            const __m128i cr = _mm_sub_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(v + i)), chroma_offset);
+
+            const __m128i yv_lo = _mm_unpacklo_epi16(yy, cr);
+            const __m128i yv_hi = _mm_unpackhi_epi16(yy, cr);
+            const __m128i yu_lo = _mm_unpacklo_epi16(yy, cb);
+            const __m128i yu_hi = _mm_unpackhi_epi16(yy, cb);
+            const __m128i v1_lo = _mm_unpacklo_epi16(cr, one);
+            const __m128i v1_hi = _mm_unpackhi_epi16(cr, one);
+
+            const __m128i r = _mm_packs_epi32(
+                _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(yv_lo, k_r), round), 15),
+                _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(yv_hi, k_r), round), 15));
+            const __m128i g = _mm_packs_epi32(
+                _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(yu_lo, k_g_yu), _mm_madd_epi16(v1_lo, k_g_v)), 15),
+                _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(yu_hi, k_g_yu), _mm_madd_epi16(v1_hi, k_g_v)), 15));
+            const __m128i b = _mm_packs_epi32(
+                _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(yu_lo, k_b), round), 15),
+                _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(yu_hi, k_b), round), 15));
+
+            const __m128i rg = _mm_unpacklo_epi8(_mm_packus_epi16(r, r), _mm_packus_epi16(g, g));
+            const __m128i ba = _mm_unpacklo_epi8(_mm_packus_epi16(b, b), alpha);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + i * 4), _mm_unpacklo_epi16(rg, ba));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + i * 4 + 16), _mm_unpackhi_epi16(rg, ba));
+        }
+#elif defined(VIDEOMANCER_COLORIMETRY_NEON)
+        const int16x8_t luma_offset = vdupq_n_s16(64);
+        const int16x8_t chroma_offset = vdupq_n_s16(512);
+        for (; i + 8 <= count; i += 8)
+        {
+            const int16x8_t yy = vsubq_s16(vreinterpretq_s16_u16(vld1q_u16(y + i)), luma_offset);
+            const int16x8_t cb = vsubq_s16(vreinterpretq_s16_u16(vld1q_u16(u + i)), chroma_offset);
+            const int16x8_t cr = vsubq_s16(vreinterpretq_s16_u16(vld1q_u16(v + i)), chroma_offset);
+
+            const int32x4_t y_lo = vmull_n_s16(vget_low_s16(yy), k.y);
+            const int32x4_t y_hi = vmull_n_s16(vget_high_s16(yy), k.y);
+
+            // vqrshrun adds the 1 << 14 rounding term and clamps negatives to 0
+            const uint16x8_t r = vcombine_u16(
+                vqrshrun_n_s32(vmlal_n_s16(y_lo, vget_low_s16(cr), k.r_v), 15),
+                vqrshrun_n_s32(vmlal_n_s16(y_hi, vget_high_s16(cr), k.r_v), 15));
+            const uint16x8_t g = vcombine_u16(
+                vqrshrun_n_s32(vmlsl_n_s16(vmlsl_n_s16(y_lo, vget_low_s16(cb), k.g_u), vget_low_s16(cr), k.g_v), 15),
+                vqrshrun_n_s32(vmlsl_n_s16(vmlsl_n_s16(y_hi, vget_high_s16(cb), k.g_u), vget_high_s16(cr), k.g_v), 15));
+            const uint16x8_t b = vcombine_u16(
+                vqrshrun_n_s32(vmlal_n_s16(y_lo, vget_low_s16(cb), k.b_u), 15),
+                vqrshrun_n_s32(vmlal_n_s16(y_hi, vget_high_s16(cb), k.b_u), 15));
+
+            uint8x8x4_t out;
+            out.val[0] = vqmovn_u16(r);
+            out.val[1] = vqmovn_u16(g);
+            out.val[2] = vqmovn_u16(b);
+            out.val[3] = vdup_n_u8(255);
+            vst4_u8(rgba + i * 4, out);
+        }
+#endif
+        convert_yuv444_to_rgba8_scalar(y + i, u + i, v + i, rgba + i * 4, count - i, k);
+    }
+
+    /// @brief Convert a frame of planar samples for the given timing mode
+    /// @param y Luma plane, width * height samples
+    /// @param u Cb plane
+    /// @param v Cr plane
+    /// @param rgba Output, width * height * 4 bytes
+    /// @param id Timing mode (selects the frame size and matrix)
+    inline void convert_yuv444_frame_to_rgba8(const uint16_t* y, const uint16_t* u, const uint16_t* v,
+                                              uint8_t* rgba, videomancer_abi_v1_0::video_timing_id id)
+    {
+        const auto& info = videomancer_abi_v1_0::get_video_timing_info(id);
+        convert_yuv444_to_rgba8(y, u, v, rgba, static_cast<size_t>(info.frame_width) * info.frame_height,
+                                get_videomancer_yuv_coefficients(get_videomancer_color_matrix(id)));
+    }
+}
@@ -0,0 +1,358 @@
+// Videomancer SDK - Open source FPGA-based video effects development kit
+// Copyright (C) 2025 LZX Industries LLC
+// File: videomancer_core_harness.hpp - Pin-Level Driver for Cycle Models of core_top
+// License: GNU General Public License v3.0
+// https://github.com/lzxindustries/videomancer-sdk
+//
+// Drives a cycle model of core_top (for example the C++ model generated from
+// the program and core VHDL by fpga/sim/Makefile) one pixel clock at a time.
+// The harness generates the decoder raster from a frame buffer, bit-bangs
+// SPI frames from a videomancer_fpga_controller into the model, and captures
+// the 4:2:2 encoder output back into a frame buffer. Register writes and
+// video share one clock, so parameter changes land on the same line they
+// would on hardware.
+//
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// Raster (per field):
+//   hsync_n   low for the first quarter of horizontal blanking
+//   avid      high for frame_width clocks starting half way through blanking
+//   vsync_n   low for the first 3 lines
+//   active    the last frame_height (or frame_height / 2) lines
+// Interlaced modes split lines_per_frame into two fields as described by
+// video_field_layout. The second field's vsync starts and ends half a line
+// later, as on interlaced sources, so video_field_detector alternates field_n.
+
+#pragma once
+
+#include "videomancer_fpga.hpp"
+#include "videomancer_abi.hpp"
+#include "videomancer_video_model.hpp"
+#include "videomancer_virtual_device.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace lzx
+{
+    /// @brief Pins sampled by core_top on a rising pixel clock edge
+    struct videomancer_core_inputs
+    {
+        bool spi_sck;
+        bool spi_sdi;
+        bool spi_cs_n;
+        uint16_t y;         // 10-bit luma
+        uint16_t c;         // 10-bit chroma, Cb on even active pixels, Cr on odd
+        bool hsync_n;
+        bool vsync_n;
+        bool avid;
+    };
+
+    /// @brief Encoder-side pins of core_top after a rising pixel clock edge
+    struct videomancer_core_outputs
+    {
+        uint16_t y;
+        uint16_t c;
+        bool hsync_n;
+        bool vsync_n;
+    };
+
+    /// @brief Cycle model of core_top
+    class videomancer_core_model
+    {
+    public:
+        virtual ~videomancer_core_model() = default;
+
+        /// @brief Apply inputs and run one full pixel clock
+        /// @param in Pin levels before the rising edge
+        /// @param out Pin levels after the rising edge
+        virtual void clock(const videomancer_core_inputs& in, videomancer_core_outputs& out) = 0;
+    };
+
+    /// @brief Raster position of one pixel clock
+    struct videomancer_raster_position
+    {
+        bool hsync_n;
+        bool vsync_n;
+        bool avid;
+        uint16_t row;       // Active frame row (valid when avid)
+        uint16_t column;    // Active pixel (valid when avid)
+    };
+
+    /// @brief Decoder raster of one timing mode
+    class videomancer_core_raster
+    {
+    public:
+        explicit videomancer_core_raster(videomancer_abi_v1_0::video_timing_id timing)
+            : m_info(videomancer_abi_v1_0::get_video_timing_info(timing))
+            , m_layout(make_video_field_layout(timing))
+        {
+            const uint16_t hblank = static_cast<uint16_t>(m_info.clocks_per_line - m_info.frame_width);
+            m_hsync_clocks = hblank / 4 ? hblank / 4 : 1;
+            m_active_start = hblank / 2;
+        }
+
+        /// @brief Timing mode geometry
+        const videomancer_abi_v1_0::video_timing_info& info() const { return m_info; }
+
+        /// @brief Pixel clocks per frame (both fields)
+        uint32_t frame_clocks() const
+        {
+            return static_cast<uint32_t>(m_info.clocks_per_line) * m_info.lines_per_frame;
+        }
+
+        /// @brief Raster state at a clock offset within the frame
+        videomancer_raster_position at(uint32_t clock) const
+        {
+            const uint16_t x = static_cast<uint16_t>(clock % m_info.clocks_per_line);
+            uint16_t line = static_cast<uint16_t>(clock / m_info.clocks_per_line);
+            uint8_t field = 0;
+            if (m_layout.field_count == 2 && line >= m_layout.field_lines[0])
+            {
+                line = static_cast<uint16_t>(line - m_layout.field_lines[0]);
+                field = 1;
+            }
+
+            videomancer_raster_position pos = { true, true, false, 0, 0 };
+            pos.hsync_n = x >= m_hsync_clocks;
+            if (field == 0)
+            {
+                pos.vsync_n = line >= 3;
+            }
+            else
+            {
+                const uint32_t half_lines = (static_cast<uint32_t>(line) * m_info.clocks_per_line + x) * 2 /
+                                            m_info.clocks_per_line;
+                pos.vsync_n = half_lines < 1 || half_lines >= 7;
+            }
+
+            const uint16_t first_active = static_cast<uint16_t>(m_layout.field_lines[field] - m_layout.active_lines);
+            if (line >= first_active && x >= m_active_start && x < m_active_start + m_info.frame_width)
+            {
+                pos.avid = true;
+                pos.column = static_cast<uint16_t>(x - m_active_start);
+                pos.row = video_field_row(m_layout, field, static_cast<uint16_t>(line - first_active));
+            }
+            return pos;
+        }
+
+    private:
+        videomancer_abi_v1_0::video_timing_info m_info;
+        video_field_layout m_layout;
+        uint16_t m_hsync_clocks;
+        uint16_t m_active_start;
+    };
+
+    /// @brief Drives a core_top cycle model with video and SPI register writes
+    ///
+    /// Acts as the videomancer_fpga of a videomancer_fpga_controller: each
+    /// SPI bit runs the model for a full SCK period, so video keeps flowing
+    /// while registers are written. The output is matched to the input
+    /// raster through the sync latency measured on the first hsync, so the
+    /// captured frame lines up with the input whatever the program's delay.
+    class videomancer_core_harness : public videomancer_fpga
+    {
+    public:
+        /// @brief Construct harness
+        /// @param model Cycle model to drive
+        /// @param timing Input timing mode
+        videomancer_core_harness(videomancer_core_model& model, videomancer_abi_v1_0::video_timing_id timing)
+            : m_model(model)
+            , m_raster(timing)
+            , m_input({ nullptr, nullptr, nullptr })
+            , m_output({ nullptr, nullptr, nullptr })
+            , m_spi_half_period(4)
+            , m_data_delay(2)
+        {
+            m_pins = { false, false, true, 0, 512, true, true, false };
+            m_out = { 0, 512, true, true };
+            restart();
+        }
+
+        /// @brief Switch timing mode and restart the raster
+        void set_timing(videomancer_abi_v1_0::video_timing_id timing)
+        {
+            m_raster = videomancer_core_raster(timing);
+            restart();
+        }
+
+        /// @brief Frame fed to the decoder pins (nullptr planes for a luma ramp)
+        void set_input_frame(const videomancer_frame_buffer& frame) { m_input = frame; }
+
+        /// @brief Frame receiving the captured encoder output (nullptr planes to skip capture)
+        void set_output_frame(const videomancer_frame_buffer& frame) { m_output = frame; }
+
+        /// @brief Pixel clocks per SCK half period (core_top samples SCK through a 2-flop synchronizer)
+        void set_spi_half_period(uint16_t clocks) { m_spi_half_period = clocks ? clocks : 1; }
+
+        /// @brief Clocks by which output pixels trail output syncs (2 in core_top's 4:2:2 converters)
+        void set_data_delay(uint16_t clocks) { m_data_delay = clocks; }
+
+        /// @brief Input raster
+        const videomancer_core_raster& raster() const { return m_raster; }
+
+        /// @brief Run the model for a number of pixel clocks
+        void run_clocks(uint64_t count)
+        {
+            for (uint64_t i = 0; i < count; ++i)
+                tick();
+        }
+
+        /// @brief Run until more complete output frames have been captured
+        /// @param count Frames to capture
+        /// @return Frames captured (less than count if the output never synced)
+        uint32_t run_frames(uint32_t count)
+        {
+            const uint32_t target = m_frames_captured + count;
+            const uint64_t limit = m_clock + static_cast<uint64_t>(count + 2) * m_raster.frame_clocks();
+            while (m_frames_captured < target && m_clock < limit)
+                tick();
+            return count - (target - m_frames_captured);
+        }
+
+        /// @brief Pixel clocks run since the last restart
+        uint64_t clock_count() const { return m_clock; }
+
+        /// @brief Complete output frames captured since the last restart
+        uint32_t frames_captured() const { return m_frames_captured; }
+
+        /// @brief Clocks from an input hsync fall to the matching output hsync fall, -1 until seen
+        int32_t sync_latency_clocks() const { return m_latency; }
+
+        // videomancer_fpga interface
+
+        size_t transfer_spi(const uint8_t* tx_buffer, uint8_t* rx_buffer, size_t size) override
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                const uint8_t byte = tx_buffer ? tx_buffer[i] : 0;
+                for (int bit = 7; bit >= 0; --bit)
+                {
+                    m_pins.spi_sdi = ((byte >> bit) & 1) != 0;
+                    m_pins.spi_sck = false;
+                    run_clocks(m_spi_half_period);
+                    m_pins.spi_sck = true;
+                    run_clocks(m_spi_half_period);
+                }
+                if (rx_buffer)
+                    rx_buffer[i] = 0;  // SDO is not connected in core_top
+            }
+            m_pins.spi_sck = false;
+            return size;
+        }
+
+        void assert_chip_select_spi(bool assert) override
+        {
+            if (!assert)
+                run_clocks(m_spi_half_period);
+            m_pins.spi_cs_n = !assert;
+            run_clocks(assert ? m_spi_half_period : 2u * m_spi_half_period);
+        }
+
+    private:
+        videomancer_core_model& m_model;
+        videomancer_core_raster m_raster;
+        videomancer_frame_buffer m_input;
+        videomancer_frame_buffer m_output;
+        uint16_t m_spi_half_period;
+        uint16_t m_data_delay;
+        videomancer_core_inputs m_pins;
+        videomancer_core_outputs m_out;
+        uint64_t m_clock;
+        uint64_t m_last_input_hsync;
+        bool m_prev_out_hsync_n;
+        int32_t m_latency;
+        bool m_capturing;
+        uint32_t m_frames_captured;
+
+        void restart()
+        {
+            m_clock = 0;
+            m_last_input_hsync = 0;
+            m_prev_out_hsync_n = true;
+            m_latency = -1;
+            m_capturing = false;
+            m_frames_captured = 0;
+        }
+
+        void tick()
+        {
+            const uint32_t frame_clocks = m_raster.frame_clocks();
+            if (frame_clocks == 0)
+                return;
+
+            const videomancer_raster_position in = m_raster.at(static_cast<uint32_t>(m_clock % frame_clocks));
+            if (!in.hsync_n && m_pins.hsync_n)
+                m_last_input_hsync = m_clock;
+            m_pins.hsync_n = in.hsync_n;
+            m_pins.vsync_n = in.vsync_n;
+            m_pins.avid = in.avid;
+            if (in.avid)
+            {
+                m_pins.y = input_sample(m_input.y, in, static_cast<uint16_t>(
+                    64 + (static_cast<uint32_t>(in.column) * 876) / m_raster.info().frame_width));
+                m_pins.c = input_sample(in.column & 1 ? m_input.v : m_input.u, in, 512);
+            }
+            else
+            {
+                m_pins.y = 64;
+                m_pins.c = 512;
+            }
+
+            m_model.clock(m_pins, m_out);
+
+            if (m_latency < 0 && !m_out.hsync_n && m_prev_out_hsync_n)
+                m_latency = static_cast<int32_t>(m_clock - m_last_input_hsync);
+            m_prev_out_hsync_n = m_out.hsync_n;
+
+            if (m_latency >= 0)
+                capture(frame_clocks);
+            ++m_clock;
+        }
+
+        uint16_t input_sample(const uint16_t* plane, const videomancer_raster_position& pos, uint16_t fallback) const
+        {
+            if (!plane)
+                return fallback;
+            return plane[static_cast<size_t>(pos.row) * m_raster.info().frame_width + pos.column] & 0x3FF;
+        }
+
+        void capture(uint32_t frame_clocks)
+        {
+            const uint64_t delay = static_cast<uint64_t>(m_latency) + m_data_delay;
+            if (m_clock < delay)
+                return;
+            const uint32_t clock = static_cast<uint32_t>((m_clock - delay) % frame_clocks);
+            if (clock == 0)
+                m_capturing = true;
+            if (!m_capturing)
+                return;
+
+            const videomancer_raster_position pos = m_raster.at(clock);
+            if (pos.avid && m_output.y && m_output.u && m_output.v)
+            {
+                const uint16_t width = m_raster.info().frame_width;
+                const size_t index = static_cast<size_t>(pos.row) * width + pos.column;
+                m_output.y[index] = m_out.y;
+                // Both pixels of a 4:2:2 pair share the Cb and Cr samples (widths are even)
+                const size_t pair = index - (pos.column & 1);
+                uint16_t* plane = pos.column & 1 ? m_output.v : m_output.u;
+                plane[pair] = m_out.c;
+                plane[pair + 1] = m_out.c;
+            }
+
+            if (clock == frame_clocks - 1)
+                ++m_frames_captured;
+        }
+    };
+}
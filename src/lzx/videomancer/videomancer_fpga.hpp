@@ -24,12 +24,68 @@
 
 namespace lzx
 {
+    /// @brief iCE40 slave SPI configuration pins
+    ///
+    /// Optional companion to videomancer_fpga for boards where the MCU
+    /// configures the FPGA. write_config() may return before the bytes are
+    /// on the wire (DMA); the buffer must stay untouched until wait_config()
+    /// returns, and the next write_config() or pin change implies a wait.
+    class videomancer_fpga_configuration
+    {
+    public:
+        virtual ~videomancer_fpga_configuration() = default;
+
+        /// @brief Drive CRESET_B (true = high, device running)
+        virtual void set_creset(bool high) = 0;
+
+        /// @brief Drive SPI_SS_B low (true) or high (false)
+        virtual void select_config(bool assert) = 0;
+
+        /// @brief Read the CDONE pin
+        virtual bool get_cdone() = 0;
+
+        /// @brief Busy-wait for at least us microseconds
+        virtual void delay_us(uint32_t us) = 0;
+
+        /// @brief Start clocking bytes out MSB first on the configuration SPI
+        /// @return false if the transfer could not be started
+        virtual bool write_config(const uint8_t* data, size_t size) = 0;
+
+        /// @brief Wait for the last write_config() to finish
+        /// @return false if the transfer failed
+        virtual bool wait_config() { return true; }
+    };
+
     class videomancer_fpga
     {
     public:
         virtual ~videomancer_fpga() = default;
         virtual size_t transfer_spi(const uint8_t* tx_buffer, uint8_t* rx_buffer, size_t size) = 0;
         virtual void assert_chip_select_spi(bool assert) = 0;
+
+        /// @brief Configuration pins, or nullptr if the MCU cannot configure the FPGA
+        virtual videomancer_fpga_configuration* configuration_interface() { return nullptr; }
+
+        /// @brief Send consecutive write frames, each framed by its own chip select
+        ///
+        /// Boards whose SPI block can toggle chip select per frame (or a DMA
+        /// chain) override this to send the whole burst in one transfer.
+        /// @param frames Frame bytes, back to back
+        /// @param frame_size Bytes per frame
+        /// @param count Number of frames
+        /// @return Frames sent; frames after the first failure are not sent
+        virtual size_t transfer_spi_frames(const uint8_t* frames, size_t frame_size, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                assert_chip_select_spi(true);
+                const size_t transferred = transfer_spi(frames + i * frame_size, nullptr, frame_size);
+                assert_chip_select_spi(false);
+                if (transferred != frame_size)
+                    return i;
+            }
+            return count;
+        }
     };
 
 } // namespace lzx
@@ -0,0 +1,503 @@
+// Videomancer SDK - Open source FPGA-based video effects development kit
+// Copyright (C) 2025 LZX Industries LLC
+// File: videomancer_fpga_configurator.hpp - iCE40 Slave SPI Configuration Engine
+// License: GNU General Public License v3.0
+// https://github.com/lzxindustries/videomancer-sdk
+//
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// Configures an iCE40 over slave SPI through videomancer_fpga's optional
+// configuration interface, streaming a bitstream TOC payload straight from
+// a vmprog_stream. The caller's buffer is split in two halves: while one
+// half is clocked out (by DMA where the board supports it) the next chunk is
+// read and hashed into the other. The payload hash is checked before the
+// wakeup clocks are sent, so a corrupt image never enters user mode; the
+// device is held in reset instead.
+//
+// Sequence (Lattice TN1248):
+//   1. SPI_SS_B low, CRESET_B low for at least 200 ns
+//   2. CRESET_B high, wait 1200 us while configuration memory clears
+//   3. SPI_SS_B high, 8 dummy clocks, SPI_SS_B low
+//   4. Bitstream, MSB first
+//   5. SPI_SS_B high, at least 100 clocks until CDONE rises, then at
+//      least 49 more to release the user I/O
+//
+// videomancer_fpga_config_model is a simulated device that checks this
+// sequence, validates the received image and measures configuration time.
+
+#pragma once
+
+#include "videomancer_fpga.hpp"
+#include "ice40_bitstream.hpp"
+#include "vmprog_format.hpp"
+#include "vmprog_stream.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace lzx
+{
+    /// @brief Outcome of a configuration attempt
+    enum class videomancer_configuration_result : uint8_t
+    {
+        ok = 0,
+        no_interface = 1,       // videomancer_fpga has no configuration pins
+        buffer_too_small = 2,   // Chunk buffer under two minimum chunks
+        invalid_entry = 3,      // Empty payload
+        read_error = 4,         // Stream seek or read failed
+        transfer_error = 5,     // write_config() or wait_config() failed
+        hash_mismatch = 6,      // Payload hash differs from the expected one (device held in reset)
+        cdone_timeout = 7,      // CDONE did not rise
+        register_error = 8,     // Initial register writes failed
+    };
+
+    /// @brief Streams bitstreams into an iCE40 over slave SPI
+    class videomancer_fpga_configurator
+    {
+    public:
+        /// @brief Minimum CRESET_B high time before SPI_SS_B is released
+        static constexpr uint32_t clear_wait_us = 1200;
+
+        /// @brief Dummy clocks sent after the image before CDONE is polled (13 bytes = 104)
+        static constexpr uint32_t cdone_clock_bytes = 13;
+
+        /// @brief Dummy clocks sent after CDONE to release the user I/O (7 bytes = 56)
+        static constexpr uint32_t wakeup_clock_bytes = 7;
+
+        /// @brief Further dummy bytes sent while waiting for CDONE
+        static constexpr uint32_t max_cdone_polls = 256;
+
+        /// @brief Smallest usable chunk in bytes
+        static constexpr uint32_t min_chunk_size = 64;
+
+        /// @brief Construct configurator
+        /// @param buffer Chunk buffer; each half is one DMA transfer
+        /// @param buffer_size Size of buffer (at least 2 * min_chunk_size)
+        videomancer_fpga_configurator(uint8_t* buffer, uint32_t buffer_size)
+            : m_buffer(buffer)
+            , m_chunk_size((buffer_size / 2) & ~3u)
+            , m_chunks_written(0)
+        {}
+
+        /// @brief Configure from a bitstream payload in a package stream
+        /// @param fpga FPGA whose configuration_interface() is used
+        /// @param stream Package stream (repositioned)
+        /// @param entry TOC entry of the bitstream
+        /// @param verify_hash Check the payload against entry.sha256 before wakeup
+        /// @return Result; the device is left in reset on any failure
+        videomancer_configuration_result configure(videomancer_fpga& fpga,
+                                                   vmprog_stream& stream,
+                                                   const vmprog_toc_entry_v1_0& entry,
+                                                   bool verify_hash = true)
+        {
+            return configure(fpga, stream, entry, verify_hash ? entry.sha256 : nullptr);
+        }
+
+        /// @brief Configure from a package stream, checking a hash the caller trusts
+        /// @param fpga FPGA whose configuration_interface() is used
+        /// @param stream Package stream (repositioned)
+        /// @param entry TOC entry of the bitstream (offset and size)
+        /// @param expected_sha256 Hash checked before wakeup, e.g. the signed descriptor
+        ///        artifact; nullptr skips the check
+        /// @return Result; the device is left in reset on any failure
+        videomancer_configuration_result configure(videomancer_fpga& fpga,
+                                                   vmprog_stream& stream,
+                                                   const vmprog_toc_entry_v1_0& entry,
+                                                   const uint8_t* expected_sha256)
+        {
+            const bool verify_hash = expected_sha256 != nullptr;
+            videomancer_fpga_configuration* config = fpga.configuration_interface();
+            videomancer_configuration_result result = check_setup(config, entry.size);
+            if (result != videomancer_configuration_result::ok)
+                return result;
+            if (!stream.seek(entry.offset))
+                return videomancer_configuration_result::read_error;
+
+            begin(*config);
+
+            sha256_ctx hash;
+            sha256_init(hash);
+            uint8_t* halves[2] = { m_buffer, m_buffer + m_chunk_size };
+            uint32_t remaining = entry.size;
+            uint32_t half = 0;
+            bool in_flight = false;
+            while (remaining > 0)
+            {
+                // Read and hash the next chunk while the previous one is on the wire
+                const uint32_t n = remaining < m_chunk_size ? remaining : m_chunk_size;
+                if (stream.read(halves[half], n) != n)
+                    return abort(*config, in_flight, videomancer_configuration_result::read_error);
+                if (verify_hash)
+                    sha256_update(hash, halves[half], n);
+
+                if (in_flight && !config->wait_config())
+                    return abort(*config, false, videomancer_configuration_result::transfer_error);
+                if (!config->write_config(halves[half], n))
+                    return abort(*config, false, videomancer_configuration_result::transfer_error);
+                in_flight = true;
+                ++m_chunks_written;
+                remaining -= n;
+                half ^= 1;
+            }
+            if (!config->wait_config())
+                return abort(*config, false, videomancer_configuration_result::transfer_error);
+
+            if (verify_hash)
+            {
+                uint8_t digest[32];
+                sha256_final(hash, digest);
+                if (!secure_compare_hash(digest, expected_sha256))
+                    return abort(*config, false, videomancer_configuration_result::hash_mismatch);
+            }
+            return finish(*config);
+        }
+
+        /// @brief Configure from a bitstream already in memory (e.g. a preloaded program)
+        /// @param fpga FPGA whose configuration_interface() is used
+        /// @param bitstream Image bytes (must stay valid until this returns)
+        /// @param size Image size in bytes
+        /// @return Result; the device is left in reset on any failure
+        videomancer_configuration_result configure(videomancer_fpga& fpga, const uint8_t* bitstream, uint32_t size)
+        {
+            videomancer_fpga_configuration* config = fpga.configuration_interface();
+            videomancer_configuration_result result = check_setup(config, size);
+            if (result != videomancer_configuration_result::ok)
+                return result;
+
+            begin(*config);
+            for (uint32_t offset = 0; offset < size; offset += m_chunk_size)
+            {
+                const uint32_t n = size - offset < m_chunk_size ? size - offset : m_chunk_size;
+                if (offset > 0 && !config->wait_config())
+                    return abort(*config, false, videomancer_configuration_result::transfer_error);
+                if (!config->write_config(bitstream + offset, n))
+                    return abort(*config, false, videomancer_configuration_result::transfer_error);
+                ++m_chunks_written;
+            }
+            if (!config->wait_config())
+                return abort(*config, false, videomancer_configuration_result::transfer_error);
+            return finish(*config);
+        }
+
+        /// @brief Bytes per configuration write
+        uint32_t chunk_size() const { return m_chunk_size; }
+
+        /// @brief Bitstream writes issued by the last configure()
+        uint32_t chunks_written() const { return m_chunks_written; }
+
+    private:
+        uint8_t* m_buffer;
+        uint32_t m_chunk_size;
+        uint32_t m_chunks_written;
+
+        videomancer_configuration_result check_setup(videomancer_fpga_configuration* config, uint32_t size)
+        {
+            m_chunks_written = 0;
+            if (!config)
+                return videomancer_configuration_result::no_interface;
+            if (!m_buffer || m_chunk_size < min_chunk_size)
+                return videomancer_configuration_result::buffer_too_small;
+            if (size == 0)
+                return videomancer_configuration_result::invalid_entry;
+            return videomancer_configuration_result::ok;
+        }
+
+        static bool write_dummy(videomancer_fpga_configuration& config, uint32_t bytes)
+        {
+            static const uint8_t zeros[16] = {};
+            while (bytes > 0)
+            {
+                const uint32_t n = bytes < sizeof(zeros) ? bytes : static_cast<uint32_t>(sizeof(zeros));
+                if (!config.write_config(zeros, n) || !config.wait_config())
+                    return false;
+                bytes -= n;
+            }
+            return true;
+        }
+
+        void begin(videomancer_fpga_configuration& config)
+        {
+            // SPI_SS_B low while CRESET_B rises selects slave SPI mode
+            config.select_config(true);
+            config.set_creset(false);
+            config.delay_us(1);
+            config.set_creset(true);
+            config.delay_us(clear_wait_us);
+
+            config.select_config(false);
+            write_dummy(config, 1);
+            config.select_config(true);
+        }
+
+        videomancer_configuration_result finish(videomancer_fpga_configuration& config)
+        {
+            config.select_config(false);
+            if (!write_dummy(config, cdone_clock_bytes))
+                return abort(config, false, videomancer_configuration_result::transfer_error);
+            for (uint32_t i = 0; !config.get_cdone(); ++i)
+            {
+                if (i == max_cdone_polls || !write_dummy(config, 1))
+                    return abort(config, false, videomancer_configuration_result::cdone_timeout);
+            }
+            if (!write_dummy(config, wakeup_clock_bytes))
+                return abort(config, false, videomancer_configuration_result::transfer_error);
+            return videomancer_configuration_result::ok;
+        }
+
+        static videomancer_configuration_result abort(videomancer_fpga_configuration& config, bool in_flight,
+                                                      videomancer_configuration_result result)
+        {
+            if (in_flight)
+                config.wait_config();
+            config.select_config(false);
+            config.set_creset(false);
+            return result;
+        }
+    };
+
+    /// @brief Protocol violation seen by videomancer_fpga_config_model
+    enum class videomancer_config_model_error : uint8_t
+    {
+        none = 0,
+        slave_mode_not_selected = 1,  // SPI_SS_B high when CRESET_B rose (device boots from flash)
+        clear_wait_too_short = 2,     // SPI_SS_B released before configuration memory cleared
+        missing_dummy_clocks = 3,     // Fewer than 8 clocks before the image
+        capture_overflow = 4,         // Image larger than the capture buffer
+        invalid_image = 5,            // Received image does not parse or fails its CRC
+        data_out_of_sequence = 6,     // Bytes clocked before the clear wait
+    };
+
+    /// @brief Simulated iCE40 in slave SPI configuration mode
+    ///
+    /// Implements both videomancer_fpga (register writes are discarded) and
+    /// its configuration interface. Time is simulated: SPI bytes cost
+    /// 8 / spi_hz seconds, delay_us() and advance_us() move the CPU forward.
+    /// With DMA enabled, write_config() returns at once and the transfer
+    /// runs alongside the CPU; bytes are taken from the caller's buffer only
+    /// when the transfer completes, so a buffer reused too early shows up as
+    /// an invalid image. CDONE rises once the image passes its CRC and 100
+    /// further clocks have been sent; user mode follows 49 clocks later.
+    class videomancer_fpga_config_model : public videomancer_fpga, public videomancer_fpga_configuration
+    {
+    public:
+        /// @brief Construct model
+        /// @param capture Buffer receiving the image
+        /// @param capture_size Size of capture
+        /// @param spi_hz Configuration SPI clock
+        /// @param dma Overlap transfers with the CPU
+        videomancer_fpga_config_model(uint8_t* capture, uint32_t capture_size, uint32_t spi_hz, bool dma)
+            : m_capture(capture)
+            , m_capture_size(capture_size)
+            , m_spi_hz(spi_hz)
+            , m_dma(dma)
+            , m_now_us(0.0)
+            , m_busy_until_us(0.0)
+            , m_pending(nullptr)
+            , m_pending_size(0)
+            , m_creset(true)
+            , m_select(false)
+            , m_phase(phase::user)
+            , m_error(videomancer_config_model_error::none)
+            , m_received(0)
+            , m_clocks(0)
+            , m_release_us(0.0)
+            , m_image_ok(false)
+            , m_user_mode_us(0.0)
+        {}
+
+        // videomancer_fpga
+
+        size_t transfer_spi(const uint8_t*, uint8_t* rx_buffer, size_t size) override
+        {
+            for (size_t i = 0; rx_buffer && i < size; ++i)
+                rx_buffer[i] = 0;
+            return size;
+        }
+
+        void assert_chip_select_spi(bool) override {}
+
+        videomancer_fpga_configuration* configuration_interface() override { return this; }
+
+        // videomancer_fpga_configuration
+
+        void set_creset(bool high) override
+        {
+            complete();
+            if (!high)
+            {
+                m_phase = phase::reset;
+                m_received = 0;
+                m_clocks = 0;
+                m_image_ok = false;
+            }
+            else if (!m_creset)
+            {
+                if (!m_select)
+                    fail(videomancer_config_model_error::slave_mode_not_selected);
+                m_phase = phase::clearing;
+                m_release_us = m_now_us;
+            }
+            m_creset = high;
+        }
+
+        void select_config(bool assert) override
+        {
+            complete();
+            if (assert == m_select)
+                return;
+            m_select = assert;
+            if (!assert && m_phase == phase::clearing)
+            {
+                if (m_now_us < m_release_us + videomancer_fpga_configurator::clear_wait_us)
+                    fail(videomancer_config_model_error::clear_wait_too_short);
+                m_phase = phase::dummy;
+                m_clocks = 0;
+            }
+            else if (assert && m_phase == phase::dummy)
+            {
+                if (m_clocks < 8)
+                    fail(videomancer_config_model_error::missing_dummy_clocks);
+                m_phase = phase::receiving;
+            }
+            else if (!assert && m_phase == phase::receiving)
+            {
+                ice40_bitstream image;
+                m_image_ok = m_error == videomancer_config_model_error::none &&
+                             image.parse(m_capture, m_received) == ice40_parse_result::ok;
+                if (!m_image_ok)
+                    fail(videomancer_config_model_error::invalid_image);
+                m_phase = phase::wakeup;
+                m_clocks = 0;
+            }
+        }
+
+        bool get_cdone() override
+        {
+            complete();
+            return m_phase == phase::user || (m_phase == phase::wakeup && m_image_ok && m_clocks >= 100);
+        }
+
+        void delay_us(uint32_t us) override { m_now_us += us; }
+
+        bool write_config(const uint8_t* data, size_t size) override
+        {
+            complete();
+            const double cost = static_cast<double>(size) * 8.0 * 1e6 / m_spi_hz;
+            m_pending = data;
+            m_pending_size = size;
+            m_busy_until_us = m_now_us + cost;
+            if (!m_dma)
+                complete();
+            return true;
+        }
+
+        bool wait_config() override
+        {
+            complete();
+            return true;
+        }
+
+        // Simulation
+
+        /// @brief Charge CPU time (stream reads, hashing) to the simulated clock
+        void advance_us(double us) { m_now_us += us; }
+
+        /// @brief Simulated time since construction
+        double elapsed_us() const { return m_now_us; }
+
+        /// @brief Time from CRESET_B release to user mode of the last configuration
+        double configuration_us() const { return m_user_mode_us - m_release_us; }
+
+        /// @brief True once the device runs the new image
+        bool user_mode() const { return m_phase == phase::user; }
+
+        /// @brief First protocol violation since construction
+        videomancer_config_model_error error() const { return m_error; }
+
+        /// @brief Image bytes received in the last configuration
+        uint32_t received_bytes() const { return m_received; }
+
+    private:
+        enum class phase : uint8_t
+        {
+            reset,
+            clearing,
+            dummy,
+            receiving,
+            wakeup,
+            user,
+        };
+
+        uint8_t* m_capture;
+        uint32_t m_capture_size;
+        uint32_t m_spi_hz;
+        bool m_dma;
+        double m_now_us;
+        double m_busy_until_us;
+        const uint8_t* m_pending;
+        size_t m_pending_size;
+        bool m_creset;
+        bool m_select;
+        phase m_phase;
+        videomancer_config_model_error m_error;
+        uint32_t m_received;
+        uint32_t m_clocks;
+        double m_release_us;
+        bool m_image_ok;
+        double m_user_mode_us;
+
+        void fail(videomancer_config_model_error error)
+        {
+            if (m_error == videomancer_config_model_error::none)
+                m_error = error;
+        }
+
+        /// @brief Finish the transfer in flight, consuming its bytes now
+        void complete()
+        {
+            if (!m_pending)
+                return;
+            if (m_busy_until_us > m_now_us)
+                m_now_us = m_busy_until_us;
+            const uint8_t* data = m_pending;
+            const size_t size = m_pending_size;
+            m_pending = nullptr;
+
+            if (m_phase == phase::receiving && m_select)
+            {
+                if (m_received + size > m_capture_size)
+                {
+                    fail(videomancer_config_model_error::capture_overflow);
+                    return;
+                }
+                memcpy(m_capture + m_received, data, size);
+                m_received += static_cast<uint32_t>(size);
+            }
+            else if (m_phase == phase::dummy || m_phase == phase::wakeup)
+            {
+                m_clocks += static_cast<uint32_t>(size * 8);
+                if (m_phase == phase::wakeup && m_image_ok && m_clocks >= 149)
+                {
+                    m_phase = phase::user;
+                    m_user_mode_us = m_now_us;
+                }
+            }
+            else if (m_phase != phase::user)
+            {
+                fail(videomancer_config_model_error::data_out_of_sequence);
+            }
+        }
+    };
+
+} // namespace lzx
@@ -24,6 +24,7 @@
 
 #include "videomancer_fpga.hpp"
 #include "videomancer_abi.hpp"
+#include "vmprog_format.hpp"
 #include <cstddef>
 #include <cstdint>
 
@@ -39,6 +40,16 @@ namespace lzx
     /// - Bit 15: R/W flag (0 = Write, 1 = Read)
     /// - Bits 14-10: 5-bit register address
     /// - Bits 9-0: 10-bit data payload
+    ///
+    /// Writes are sent immediately by default. Between begin_batch() and
+    /// flush(), set methods only update the shadow registers and mark them
+    /// dirty; flush() then sends one frame per changed register, so bursts of
+    /// updates to the same control cost a single SPI write. The frames go out
+    /// back to back through videomancer_fpga::transfer_spi_frames().
+    ///
+    /// After the FPGA is configured its registers reset; resync() pushes the
+    /// whole shadow state (or a program's initial values) in one burst, so
+    /// the program runs with correct parameters from its first frame.
     class videomancer_fpga_controller
     {
     public:
@@ -55,6 +66,8 @@ namespace lzx
             , m_shadow_linear_pot_12(0)
             , m_shadow_toggle_switches(0)
             , m_shadow_video_timing_id(0)
+            , m_dirty_mask(0)
+            , m_batching(false)
         {}
 
         // Potentiometer control methods (0-1023 range)
@@ -209,6 +222,139 @@ namespace lzx
             return write_register(videomancer_abi_v1_0::register_address::video_timing_id, timing_id & 0xF);
         }
 
+        /// @brief Set a register by program parameter ID
+        /// @param id Parameter ID from the program configuration
+        /// @param value 10-bit value (0-1023); toggle switches are on when non-zero
+        /// @return true on success, false for vmprog_parameter_id_v1_0::none or unknown IDs
+        bool set_parameter(vmprog_parameter_id_v1_0 id, uint16_t value)
+        {
+            switch (id)
+            {
+                case vmprog_parameter_id_v1_0::rotary_potentiometer_1:  return set_rotary_pot_1(value);
+                case vmprog_parameter_id_v1_0::rotary_potentiometer_2:  return set_rotary_pot_2(value);
+                case vmprog_parameter_id_v1_0::rotary_potentiometer_3:  return set_rotary_pot_3(value);
+                case vmprog_parameter_id_v1_0::rotary_potentiometer_4:  return set_rotary_pot_4(value);
+                case vmprog_parameter_id_v1_0::rotary_potentiometer_5:  return set_rotary_pot_5(value);
+                case vmprog_parameter_id_v1_0::rotary_potentiometer_6:  return set_rotary_pot_6(value);
+                case vmprog_parameter_id_v1_0::toggle_switch_7:         return set_toggle_switch_7(value != 0);
+                case vmprog_parameter_id_v1_0::toggle_switch_8:         return set_toggle_switch_8(value != 0);
+                case vmprog_parameter_id_v1_0::toggle_switch_9:         return set_toggle_switch_9(value != 0);
+                case vmprog_parameter_id_v1_0::toggle_switch_10:        return set_toggle_switch_10(value != 0);
+                case vmprog_parameter_id_v1_0::toggle_switch_11:        return set_toggle_switch_11(value != 0);
+                case vmprog_parameter_id_v1_0::linear_potentiometer_12: return set_linear_pot_12(value);
+                default: return false;
+            }
+        }
+
+        /// @brief Reboot the FPGA into a multiboot flash image
+        /// @param image Image slot (0-3) in the layout built by ice40_multiboot.hpp
+        /// @return true if the request was sent, false for an invalid slot
+        /// @note Registers reset with the new image: shadows are cleared to match
+        ///       and any open batch is dropped. The video timing ID is kept and
+        ///       left dirty. Nothing is resent here because the FPGA is rebooting;
+        ///       once the new image runs, call resync(config) to load the program's
+        ///       values and the timing ID. videomancer_program_switcher::warmboot()
+        ///       arranges this on its next switch_program().
+        bool warmboot(uint8_t image)
+        {
+            if (image >= videomancer_abi_v1_0::warmboot_image_count)
+                return false;
+
+            const uint16_t value = static_cast<uint16_t>(
+                (1u << videomancer_abi_v1_0::warmboot_bit::boot) |
+                (static_cast<uint16_t>(image) << videomancer_abi_v1_0::warmboot_bit::image_select));
+            if (!transmit_frame(videomancer_abi_v1_0::register_address::warmboot, value))
+                return false;
+
+            const uint16_t timing_id = m_shadow_video_timing_id;
+            reset_shadow_registers();
+            m_shadow_video_timing_id = timing_id;
+            if (timing_id != 0)
+                m_dirty_mask = static_cast<uint16_t>(1u << videomancer_abi_v1_0::register_address::video_timing_id);
+            return true;
+        }
+
+        // Batched update methods
+
+        /// @brief Start collecting register updates without sending them
+        /// @note Calls do not nest; the next flush() ends the batch
+        void begin_batch()
+        {
+            m_batching = true;
+        }
+
+        /// @brief Send every register changed since begin_batch() and end the batch
+        /// @return true if all pending writes succeeded (failed ones stay dirty)
+        bool flush()
+        {
+            m_batching = false;
+
+            uint8_t frames[2 * register_count];
+            uint8_t addresses[register_count];
+            size_t count = 0;
+            for (uint8_t address = 0; address < register_count; ++address)
+            {
+                if ((m_dirty_mask & (1u << address)) == 0)
+                    continue;
+                encode_frame(address, *get_shadow_register(address), frames + 2 * count);
+                addresses[count++] = address;
+            }
+            if (count == 0)
+                return true;
+
+            const size_t sent = m_fpga.transfer_spi_frames(frames, 2, count);
+            for (size_t i = 0; i < sent; ++i)
+                m_dirty_mask &= static_cast<uint16_t>(~(1u << addresses[i]));
+            return sent == count;
+        }
+
+        /// @brief Send every register from the shadows in one burst and end any batch
+        /// @return true if all frames were sent (unsent registers stay dirty)
+        /// @note Use after configuration or warmboot: the FPGA registers reset,
+        ///       so the whole state is sent, not only changes
+        bool resync()
+        {
+            m_dirty_mask = static_cast<uint16_t>((1u << register_count) - 1);
+            return flush();
+        }
+
+        /// @brief Load a program's initial values and send every register in one burst
+        /// @param config Program configuration; controls it does not list are set to
+        ///        zero and the video timing ID is kept
+        /// @return true if all frames were sent
+        bool resync(const vmprog_program_config_v1_0& config)
+        {
+            begin_batch();
+            set_initial_values(config);
+            return resync();
+        }
+
+        /// @brief Move to a program's initial values, sending only registers that change
+        /// @param config Program configuration; controls it does not list are set to
+        ///        zero and the video timing ID is kept
+        /// @return true if all changed registers were sent
+        /// @note For a program switch that keeps the loaded bitstream
+        bool apply_initial_values(const vmprog_program_config_v1_0& config)
+        {
+            begin_batch();
+            set_initial_values(config);
+            return flush();
+        }
+
+        /// @brief Check whether a batch is open
+        /// @return true between begin_batch() and flush()
+        bool is_batching() const
+        {
+            return m_batching;
+        }
+
+        /// @brief Get registers changed but not yet sent
+        /// @return Bit mask indexed by register address
+        uint16_t get_dirty_mask() const
+        {
+            return m_dirty_mask;
+        }
+
         // Bulk update methods
 
         /// @brief Update all rotary potentiometers at once
@@ -319,11 +465,11 @@ namespace lzx
         /// @return 4-bit timing ID (0-15)
         uint8_t get_video_timing_id() const
         {
-            return m_shadow_video_timing_id;
+            return static_cast<uint8_t>(m_shadow_video_timing_id);
         }
 
-        /// @brief Reset all shadow registers to zero
-        /// @note This does not write to hardware; call set methods after reset to sync
+        /// @brief Reset all shadow registers to zero and drop any open batch
+        /// @note This does not write to hardware; call resync() to push the shadows
         void reset_shadow_registers()
         {
             m_shadow_rotary_pot_1 = 0;
@@ -335,9 +481,14 @@ namespace lzx
             m_shadow_linear_pot_12 = 0;
             m_shadow_toggle_switches = 0;
             m_shadow_video_timing_id = 0;
+            m_dirty_mask = 0;
+            m_batching = false;
         }
 
     private:
+        /// @brief Registers covered by the shadows (addresses 0x00-0x08)
+        static constexpr uint8_t register_count = videomancer_abi_v1_0::register_address::video_timing_id + 1;
+
         videomancer_fpga& m_fpga;
 
         // Shadow registers (initialized to zero in constructor)
@@ -349,7 +500,10 @@ namespace lzx
         uint16_t m_shadow_rotary_pot_6;
         uint16_t m_shadow_linear_pot_12;
         uint16_t m_shadow_toggle_switches;
-        uint8_t m_shadow_video_timing_id;
+        uint16_t m_shadow_video_timing_id;
+
+        uint16_t m_dirty_mask;  // Registers changed during a batch, by address
+        bool m_batching;
 
         /// @brief Write to a register using the ABI protocol
         /// @param address 5-bit register address
@@ -366,29 +520,91 @@ namespace lzx
                 return true; // No change needed
             }
 
-            // Build 16-bit frame: [R/W(1)][Addr(5)][Data(10)]
+            // Defer the write until flush()
+            if (m_batching && shadow_reg != nullptr)
+            {
+                *shadow_reg = data;
+                m_dirty_mask |= static_cast<uint16_t>(1u << address);
+                return true;
+            }
+
+            bool success = transmit_frame(address, data);
+
+            // Update shadow register on successful write
+            if (success && shadow_reg != nullptr)
+            {
+                *shadow_reg = data;
+            }
+
+            return success;
+        }
+
+        /// @brief Build a 16-bit write frame: [R/W(1)][Addr(5)][Data(10)], MSB first
+        /// @param address 5-bit register address
+        /// @param data 10-bit data value
+        /// @param out Two frame bytes
+        static void encode_frame(uint8_t address, uint16_t data, uint8_t out[2])
+        {
             // R/W = 0 for write, Addr << 10, Data in lower 10 bits
             uint16_t frame = (0 << 15) |                    // Write bit
                            ((address & 0x1F) << 10) |      // 5-bit address
                            (data & 0x3FF);                  // 10-bit data
 
+            out[0] = static_cast<uint8_t>(frame >> 8);    // MSB first
+            out[1] = static_cast<uint8_t>(frame & 0xFF);
+        }
+
+        /// @brief Send one CS-framed write frame
+        /// @param address 5-bit register address
+        /// @param data 10-bit data value
+        /// @return true if both bytes were transferred
+        bool transmit_frame(uint8_t address, uint16_t data)
+        {
             uint8_t tx_buffer[2];
-            tx_buffer[0] = static_cast<uint8_t>(frame >> 8);    // MSB first
-            tx_buffer[1] = static_cast<uint8_t>(frame & 0xFF);
+            encode_frame(address, data, tx_buffer);
 
             m_fpga.assert_chip_select_spi(true);  // Assert CS low
             size_t transferred = m_fpga.transfer_spi(tx_buffer, nullptr, 2);
             m_fpga.assert_chip_select_spi(false); // De-assert CS high
 
-            bool success = (transferred == 2);
+            return transferred == 2;
+        }
 
-            // Update shadow register on successful write
-            if (success && shadow_reg != nullptr)
+        /// @brief Set every control to its initial value in a program (zero if unlisted)
+        /// @param config Program configuration
+        /// @note Each control is set once, so inside a batch only net changes are dirty
+        void set_initial_values(const vmprog_program_config_v1_0& config)
+        {
+            static const vmprog_parameter_id_v1_0 controls[] = {
+                vmprog_parameter_id_v1_0::rotary_potentiometer_1,
+                vmprog_parameter_id_v1_0::rotary_potentiometer_2,
+                vmprog_parameter_id_v1_0::rotary_potentiometer_3,
+                vmprog_parameter_id_v1_0::rotary_potentiometer_4,
+                vmprog_parameter_id_v1_0::rotary_potentiometer_5,
+                vmprog_parameter_id_v1_0::rotary_potentiometer_6,
+                vmprog_parameter_id_v1_0::toggle_switch_7,
+                vmprog_parameter_id_v1_0::toggle_switch_8,
+                vmprog_parameter_id_v1_0::toggle_switch_9,
+                vmprog_parameter_id_v1_0::toggle_switch_10,
+                vmprog_parameter_id_v1_0::toggle_switch_11,
+                vmprog_parameter_id_v1_0::linear_potentiometer_12,
+            };
+            constexpr size_t control_count = sizeof(controls) / sizeof(controls[0]);
+
+            uint16_t values[control_count] = {};
+            const uint16_t count = config.parameter_count < vmprog_program_config_v1_0::num_parameters
+                ? config.parameter_count
+                : static_cast<uint16_t>(vmprog_program_config_v1_0::num_parameters);
+            for (uint16_t i = 0; i < count; ++i)
             {
-                *shadow_reg = data;
+                for (size_t c = 0; c < control_count; ++c)
+                {
+                    if (controls[c] == config.parameters[i].parameter_id)
+                        values[c] = config.parameters[i].initial_value;
+                }
             }
-
-            return success;
+            for (size_t c = 0; c < control_count; ++c)
+                set_parameter(controls[c], values[c]);
         }
 
         /// @brief Get pointer to shadow register for given address
@@ -406,9 +622,7 @@ namespace lzx
                 case videomancer_abi_v1_0::register_address::rotary_pot_6:     return &m_shadow_rotary_pot_6;
                 case videomancer_abi_v1_0::register_address::linear_pot_12:    return &m_shadow_linear_pot_12;
                 case videomancer_abi_v1_0::register_address::toggle_switches:  return &m_shadow_toggle_switches;
-                case videomancer_abi_v1_0::register_address::video_timing_id:
-                    // Return pointer to uint8_t as uint16_t* (safe since we only use lower byte)
-                    return reinterpret_cast<uint16_t*>(&m_shadow_video_timing_id);
+                case videomancer_abi_v1_0::register_address::video_timing_id:  return &m_shadow_video_timing_id;
                 default: return nullptr;
             }
         }
@@ -0,0 +1,256 @@
+// Videomancer SDK - Open source FPGA-based video effects development kit
+// Copyright (C) 2025 LZX Industries LLC
+// File: videomancer_frame_timer.hpp - Frame and Field Rate Timer Service
+// License: GNU General Public License v3.0
+// https://github.com/lzxindustries/videomancer-sdk
+//
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// Ticks on frame or field boundaries of a video timing mode so control
+// flushes and automation playback line up with video. Deadline n is
+// origin + n / rate, computed from the exact rational rate in
+// videomancer_abi.hpp, so 59.94 Hz is 60000/1001 and no rounding error
+// accumulates however long the timer runs.
+//
+// videomancer_frame_schedule is the platform-independent arithmetic.
+// videomancer_frame_timer (Linux) arms a timerfd with absolute
+// CLOCK_MONOTONIC deadlines; its descriptor can join an epoll set. Calling
+// lock() with the timestamp of an observed vsync re-anchors the schedule to
+// the video source.
+
+#pragma once
+
+#include "videomancer_abi.hpp"
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <ctime>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#define VIDEOMANCER_HAS_TIMERFD 1
+#endif
+
+namespace lzx
+{
+    /// @brief Boundaries a frame timer ticks on
+    enum class videomancer_tick_kind : uint8_t
+    {
+        frame = 0,  // Once per frame
+        field = 1,  // Once per field (same as frame for progressive modes)
+    };
+
+    /// @brief Exact tick deadlines for a video timing mode
+    class videomancer_frame_schedule
+    {
+    public:
+        /// @brief Construct an unconfigured schedule (rate 0)
+        videomancer_frame_schedule()
+            : m_rate{ 0, 1 }
+            , m_origin_ns(0)
+        {}
+
+        /// @brief Construct schedule
+        /// @param mode Video timing mode
+        /// @param kind Frame or field ticks
+        /// @param origin_ns Time of tick 0
+        videomancer_frame_schedule(videomancer_abi_v1_0::video_timing_id mode,
+                                   videomancer_tick_kind kind,
+                                   uint64_t origin_ns)
+            : m_rate(kind == videomancer_tick_kind::field ? videomancer_abi_v1_0::get_field_rate(mode)
+                                                          : videomancer_abi_v1_0::get_frame_rate(mode))
+            , m_origin_ns(origin_ns)
+        {}
+
+        /// @brief Whether the mode has a defined rate
+        bool is_valid() const { return m_rate.num != 0; }
+
+        /// @brief Tick rate
+        videomancer_abi_v1_0::video_rate rate() const { return m_rate; }
+
+        /// @brief Time of tick 0
+        uint64_t origin_ns() const { return m_origin_ns; }
+
+        /// @brief Deadline of tick n
+        uint64_t deadline_ns(uint64_t n) const
+        {
+            return m_origin_ns + videomancer_abi_v1_0::get_tick_time_ns(m_rate, n);
+        }
+
+        /// @brief Number of ticks whose deadline is at or before a time
+        /// @param time_ns Time on the schedule's clock
+        /// @return Ticks elapsed (0 before the origin); deadline_ns(result) > time_ns
+        uint64_t ticks_until(uint64_t time_ns) const
+        {
+            if (!is_valid() || time_ns < m_origin_ns)
+                return 0;
+
+            // Largest n with floor(n * d / num) <= t is floor(((t + 1) * num - 1) / d),
+            // d = den * 1e9; split t + 1 = q * d + r to stay within 64 bits
+            const uint64_t d = static_cast<uint64_t>(m_rate.den) * 1000000000ull;
+            const uint64_t t = time_ns - m_origin_ns + 1;
+            const uint64_t q = t / d;
+            const uint64_t r = t % d;
+            const uint64_t last = (r == 0) ? q * m_rate.num - 1 : q * m_rate.num + (r * m_rate.num - 1) / d;
+            return last + 1;
+        }
+
+        /// @brief Move tick 0 (e.g. to an observed vsync)
+        void set_origin(uint64_t origin_ns) { m_origin_ns = origin_ns; }
+
+    private:
+        videomancer_abi_v1_0::video_rate m_rate;
+        uint64_t m_origin_ns;
+    };
+
+#ifdef VIDEOMANCER_HAS_TIMERFD
+
+    /// @brief Drift-free frame or field timer on a Linux timerfd
+    ///
+    /// Example:
+    ///   videomancer_frame_timer timer;
+    ///   timer.start(video_timing_id::_1080i5994, videomancer_tick_kind::field);
+    ///   for (;;) {
+    ///       timer.wait();          // next field boundary
+    ///       controller.flush();    // one batched update per field
+    ///   }
+    class videomancer_frame_timer
+    {
+    public:
+        videomancer_frame_timer()
+            : m_fd(-1)
+            , m_next_tick(0)
+            , m_missed(0)
+        {}
+
+        ~videomancer_frame_timer()
+        {
+            stop();
+        }
+
+        videomancer_frame_timer(const videomancer_frame_timer&) = delete;
+        videomancer_frame_timer& operator=(const videomancer_frame_timer&) = delete;
+
+        /// @brief Current CLOCK_MONOTONIC time in nanoseconds
+        static uint64_t monotonic_ns()
+        {
+            timespec now = {};
+            ::clock_gettime(CLOCK_MONOTONIC, &now);
+            return static_cast<uint64_t>(now.tv_sec) * 1000000000ull + static_cast<uint64_t>(now.tv_nsec);
+        }
+
+        /// @brief Start ticking
+        /// @param mode Video timing mode
+        /// @param kind Frame or field ticks
+        /// @param origin_ns CLOCK_MONOTONIC time of tick 0 (0 = now)
+        /// @return false for a reserved mode or if the timerfd cannot be created
+        bool start(videomancer_abi_v1_0::video_timing_id mode,
+                   videomancer_tick_kind kind,
+                   uint64_t origin_ns = 0)
+        {
+            stop();
+            m_schedule = videomancer_frame_schedule(mode, kind, origin_ns ? origin_ns : monotonic_ns());
+            if (!m_schedule.is_valid())
+                return false;
+
+            m_fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+            if (m_fd < 0)
+                return false;
+            m_next_tick = 1;
+            m_missed = 0;
+            return arm();
+        }
+
+        /// @brief Stop the timer and close the descriptor
+        void stop()
+        {
+            if (m_fd >= 0)
+                ::close(m_fd);
+            m_fd = -1;
+        }
+
+        /// @brief Re-anchor the schedule to an observed vsync
+        /// @param vsync_ns CLOCK_MONOTONIC time of a frame (or field) start
+        /// @return false if the timer is not running
+        bool lock(uint64_t vsync_ns)
+        {
+            if (m_fd < 0)
+                return false;
+            m_schedule.set_origin(vsync_ns);
+            m_next_tick = m_schedule.ticks_until(monotonic_ns());
+            return arm();
+        }
+
+        /// @brief Block until the next tick
+        /// @return Index of the tick reached; skipped ticks are counted in missed()
+        uint64_t wait()
+        {
+            uint64_t expirations = 0;
+            while (::read(m_fd, &expirations, sizeof(expirations)) < 0 && errno == EINTR)
+                ;
+            return acknowledge();
+        }
+
+        /// @brief Account for a tick after the descriptor polled readable and re-arm
+        ///
+        /// For epoll loops: read the descriptor's 8-byte count, then call this.
+        /// @return Index of the tick reached
+        uint64_t acknowledge()
+        {
+            // Skip deadlines already in the past instead of firing back to back
+            const uint64_t elapsed = m_schedule.ticks_until(monotonic_ns());
+            const uint64_t reached = elapsed > 0 ? elapsed - 1 : 0;
+            if (reached > m_next_tick)
+                m_missed += reached - m_next_tick;
+            const uint64_t tick = reached > m_next_tick ? reached : m_next_tick;
+            m_next_tick = tick + 1;
+            arm();
+            return tick;
+        }
+
+        /// @brief Descriptor for poll/epoll (-1 when stopped)
+        int fd() const { return m_fd; }
+
+        /// @brief Deadline of a tick
+        uint64_t deadline_ns(uint64_t tick) const { return m_schedule.deadline_ns(tick); }
+
+        /// @brief Index of the next tick to fire
+        uint64_t next_tick() const { return m_next_tick; }
+
+        /// @brief Ticks skipped because the caller was late
+        uint64_t missed() const { return m_missed; }
+
+        /// @brief Schedule in use
+        const videomancer_frame_schedule& schedule() const { return m_schedule; }
+
+    private:
+        int m_fd;
+        videomancer_frame_schedule m_schedule;
+        uint64_t m_next_tick;
+        uint64_t m_missed;
+
+        bool arm()
+        {
+            const uint64_t deadline = m_schedule.deadline_ns(m_next_tick);
+            itimerspec spec = {};
+            spec.it_value.tv_sec = static_cast<time_t>(deadline / 1000000000ull);
+            spec.it_value.tv_nsec = static_cast<long>(deadline % 1000000000ull);
+            return ::timerfd_settime(m_fd, TFD_TIMER_ABSTIME, &spec, nullptr) == 0;
+        }
+    };
+
+#endif // VIDEOMANCER_HAS_TIMERFD
+
+} // namespace lzx
@@ -0,0 +1,520 @@
+// Videomancer SDK - Open source FPGA-based video effects development kit
+// Copyright (C) 2025 LZX Industries LLC
+// File: videomancer_modulation_generators.hpp - LFO, Envelope and Sample-and-Hold Generators
+// License: GNU General Public License v3.0
+// https://github.com/lzxindustries/videomancer-sdk
+//
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// Eight modulation generators that run on the device once per control
+// tick, so periodic parameter movement does not depend on a host sending
+// writes on time. Each slot is an LFO, an ADSR envelope or a random
+// sample-and-hold, and its 10-bit output passes through one of the control
+// curves from vmprog_parameter_utils.hpp (e.g. a triangle LFO through
+// sine_in_out gives a sine-like wave).
+//
+// The tick is a frame or field of the current video timing mode, as
+// produced by videomancer_frame_timer. LFO and sample-and-hold phases are
+// 32-bit accumulators advanced by an exact rational step: a rate in mHz is
+// converted with the mode's num/den rate and the remainder is carried, so
+// 1 Hz at 59.94 fields/s completes exactly 1001 cycles every 60000 fields
+// and never drifts against the video. Rates can also be given as a whole
+// number of ticks per cycle, which locks them to the frame.
+//
+// Outputs feed the modulation matrix's automation sources, or go straight
+// to a parameter register through the controller's batched shadow path.
+// Everything is integer arithmetic on fixed arrays; nothing allocates.
+
+#pragma once
+
+#include "videomancer_frame_timer.hpp"
+#include "videomancer_modulation_matrix.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace lzx
+{
+    /// @brief Generator type of a slot
+    enum class videomancer_generator_kind : uint8_t
+    {
+        off = 0,
+        lfo = 1,
+        envelope = 2,
+        sample_hold = 3,
+    };
+
+    /// @brief LFO waveform, before the output curve
+    enum class videomancer_lfo_wave : uint8_t
+    {
+        triangle = 0,
+        ramp_up = 1,
+        ramp_down = 2,
+        square = 3,
+    };
+
+    /// @brief Fixed-point LFO, ADSR and sample-and-hold generators
+    ///
+    /// Example (a 0.5 Hz sine on automation 1, a 4-field ramp on pot 6):
+    ///   videomancer_modulation_generators generators;
+    ///   generators.set_timing(video_timing_id::_1080i5994, videomancer_tick_kind::field);
+    ///   generators.set_lfo(0, videomancer_lfo_wave::triangle, vmprog_parameter_control_mode_v1_0::sine_in_out);
+    ///   generators.set_rate_mhz(0, 500);
+    ///   generators.set_lfo(1, videomancer_lfo_wave::ramp_up);
+    ///   generators.set_period_ticks(1, 4);
+    ///   generators.set_destination(1, vmprog_parameter_id_v1_0::rotary_potentiometer_6);
+    ///   uint64_t last = 0;
+    ///   for (;;) {
+    ///       const uint64_t tick = timer.wait();
+    ///       generators.tick(matrix, controller, static_cast<uint32_t>(tick - last));
+    ///       last = tick;
+    ///   }
+    class videomancer_modulation_generators
+    {
+    public:
+        /// @brief Number of generator slots (one per matrix automation source)
+        static constexpr uint8_t generator_count = 8;
+
+        /// @brief Highest rate accepted by set_rate_mhz() (1 kHz)
+        static constexpr uint32_t max_rate_mhz = 1000000;
+
+        videomancer_modulation_generators()
+            : m_rate{ 60, 1 }
+        {
+            for (uint8_t i = 0; i < generator_count; ++i)
+                disable(i);
+        }
+
+        /// @brief Set the tick rate from a video timing mode
+        /// @param mode Video timing mode
+        /// @param kind Whether tick() is called per frame or per field
+        /// @return false for a reserved mode (the rate is unchanged)
+        bool set_timing(videomancer_abi_v1_0::video_timing_id mode, videomancer_tick_kind kind)
+        {
+            return set_tick_rate(kind == videomancer_tick_kind::field ? videomancer_abi_v1_0::get_field_rate(mode)
+                                                                      : videomancer_abi_v1_0::get_frame_rate(mode));
+        }
+
+        /// @brief Set the tick rate directly (default 60 Hz)
+        /// @return false if num or den is zero or out of range (num up to
+        ///         4000000, den up to 2000; video rates use den 1 or 1001)
+        /// @note Rates given in mHz are re-derived; phases are kept
+        bool set_tick_rate(videomancer_abi_v1_0::video_rate rate)
+        {
+            if (rate.num == 0 || rate.den == 0 || rate.num > 4000000 || rate.den > 2000)
+                return false;
+            m_rate = rate;
+            for (uint8_t i = 0; i < generator_count; ++i)
+                update_step(m_generators[i]);
+            return true;
+        }
+
+        /// @brief Current tick rate
+        videomancer_abi_v1_0::video_rate tick_rate() const { return m_rate; }
+
+        /// @brief Turn a slot off (output 0, no destination)
+        void disable(uint8_t slot)
+        {
+            if (slot >= generator_count)
+                return;
+            generator& g = m_generators[slot];
+            g = generator();
+            g.random = 0x9E3779B9u ^ (slot * 0x85EBCA6Bu);
+        }
+
+        /// @brief Make a slot an LFO
+        /// @param curve Curve applied to the waveform
+        void set_lfo(uint8_t slot, videomancer_lfo_wave wave,
+                     vmprog_parameter_control_mode_v1_0 curve = vmprog_parameter_control_mode_v1_0::linear)
+        {
+            if (slot >= generator_count)
+                return;
+            generator& g = m_generators[slot];
+            g.kind = videomancer_generator_kind::lfo;
+            g.wave = wave;
+            g.curve = curve;
+            g.raw = lfo_value(g);
+        }
+
+        /// @brief Make a slot a random sample-and-hold, sampled once per cycle
+        /// @param seed Random seed (0 keeps the slot's current sequence)
+        void set_sample_hold(uint8_t slot, uint32_t seed = 0,
+                             vmprog_parameter_control_mode_v1_0 curve = vmprog_parameter_control_mode_v1_0::linear)
+        {
+            if (slot >= generator_count)
+                return;
+            generator& g = m_generators[slot];
+            g.kind = videomancer_generator_kind::sample_hold;
+            g.curve = curve;
+            if (seed != 0)
+                g.random = seed;
+            g.raw = next_random(g);
+        }
+
+        /// @brief Make a slot an ADSR envelope (idle until set_gate(true))
+        /// @param attack_ticks Ticks from 0 to 1023 (0 = jump)
+        /// @param decay_ticks Ticks from 1023 to sustain (0 = jump)
+        /// @param sustain Level held while the gate is on (0-1023)
+        /// @param release_ticks Ticks from the current level to 0 (0 = jump)
+        void set_envelope(uint8_t slot, uint16_t attack_ticks, uint16_t decay_ticks, uint16_t sustain, uint16_t release_ticks,
+                          vmprog_parameter_control_mode_v1_0 curve = vmprog_parameter_control_mode_v1_0::linear)
+        {
+            if (slot >= generator_count)
+                return;
+            generator& g = m_generators[slot];
+            g.kind = videomancer_generator_kind::envelope;
+            g.curve = curve;
+            g.attack_ticks = attack_ticks;
+            g.decay_ticks = decay_ticks;
+            g.sustain = sustain > 1023 ? 1023 : sustain;
+            g.release_ticks = release_ticks;
+            g.stage = envelope_stage::idle;
+            g.level = 0;
+            g.raw = 0;
+        }
+
+        /// @brief Open or close an envelope's gate
+        /// @note Opening restarts the attack from the current level
+        void set_gate(uint8_t slot, bool gate)
+        {
+            if (slot >= generator_count || m_generators[slot].kind != videomancer_generator_kind::envelope)
+                return;
+            generator& g = m_generators[slot];
+            if (gate)
+                g.stage = envelope_stage::attack;
+            else if (g.stage != envelope_stage::idle)
+            {
+                g.stage = envelope_stage::release;
+                g.release_step = g.release_ticks ? g.level / g.release_ticks : g.level;
+                if (g.release_step == 0)
+                    g.release_step = 1;
+            }
+        }
+
+        /// @brief Set an LFO or sample-and-hold rate in millihertz
+        /// @param rate_mhz 0 (stopped) to max_rate_mhz; follows later set_timing() calls
+        void set_rate_mhz(uint8_t slot, uint32_t rate_mhz)
+        {
+            if (slot >= generator_count)
+                return;
+            generator& g = m_generators[slot];
+            g.rate_mhz = rate_mhz > max_rate_mhz ? max_rate_mhz : rate_mhz;
+            g.period_ticks = 0;
+            update_step(g);
+        }
+
+        /// @brief Set an LFO or sample-and-hold period in ticks (frame-locked)
+        /// @param ticks Ticks per cycle (0 = stopped)
+        void set_period_ticks(uint8_t slot, uint32_t ticks)
+        {
+            if (slot >= generator_count)
+                return;
+            generator& g = m_generators[slot];
+            g.period_ticks = ticks;
+            g.rate_mhz = 0;
+            update_step(g);
+        }
+
+        /// @brief Set a slot's phase (0 to 2^32 - 1 is one cycle)
+        void set_phase(uint8_t slot, uint32_t phase)
+        {
+            if (slot >= generator_count)
+                return;
+            generator& g = m_generators[slot];
+            g.phase = phase;
+            g.remainder = 0;
+            if (g.kind == videomancer_generator_kind::lfo)
+                g.raw = lfo_value(g);
+        }
+
+        /// @brief Restart every LFO and sample-and-hold cycle (e.g. after a vsync lock)
+        void reset_phases()
+        {
+            for (uint8_t i = 0; i < generator_count; ++i)
+                set_phase(i, 0);
+        }
+
+        /// @brief Send a slot's output straight to a register
+        /// @param destination Parameter ID (none = matrix only)
+        /// @param min_value Register value at output 0
+        /// @param max_value Register value at output 1023
+        void set_destination(uint8_t slot, vmprog_parameter_id_v1_0 destination,
+                             uint16_t min_value = 0, uint16_t max_value = 1023)
+        {
+            if (slot >= generator_count)
+                return;
+            generator& g = m_generators[slot];
+            g.destination = destination;
+            g.min_value = min_value > 1023 ? 1023 : min_value;
+            g.max_value = max_value > 1023 ? 1023 : max_value;
+        }
+
+        /// @brief Advance every slot
+        /// @param ticks Ticks elapsed since the last call (e.g. from videomancer_frame_timer)
+        void advance(uint32_t ticks = 1)
+        {
+            for (uint8_t i = 0; i < generator_count; ++i)
+            {
+                generator& g = m_generators[i];
+                switch (g.kind)
+                {
+                    case videomancer_generator_kind::lfo:
+                        advance_phase(g, ticks);
+                        g.raw = lfo_value(g);
+                        break;
+                    case videomancer_generator_kind::sample_hold:
+                        if (advance_phase(g, ticks))
+                            g.raw = next_random(g);
+                        break;
+                    case videomancer_generator_kind::envelope:
+                        advance_envelope(g, ticks);
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+        /// @brief Output of a slot after its curve (0-1023)
+        uint16_t get_output(uint8_t slot) const
+        {
+            if (slot >= generator_count || m_generators[slot].kind == videomancer_generator_kind::off)
+                return 0;
+            const generator& g = m_generators[slot];
+            return apply_parameter_control_curve(g.raw, g.curve);
+        }
+
+        /// @brief Current envelope level before the curve (0-1023)
+        uint16_t get_envelope_level(uint8_t slot) const
+        {
+            return slot < generator_count ? static_cast<uint16_t>(m_generators[slot].level >> 16) : 0;
+        }
+
+        /// @brief Copy slot i's output to the matrix's automation source i
+        void write_sources(videomancer_modulation_matrix& matrix) const
+        {
+            for (uint8_t i = 0; i < generator_count; ++i)
+                matrix.set_source(to_automation_source(i), get_output(i));
+        }
+
+        /// @brief Write slots with a destination to the controller
+        ///
+        /// Like videomancer_modulation_matrix::apply(), the writes go through one
+        /// batch (the caller's, if open), so only changed registers are sent.
+        /// @return true if all writes (and the flush, if made here) succeeded
+        bool apply(videomancer_fpga_controller& controller) const
+        {
+            const bool own_batch = !controller.is_batching();
+            if (own_batch)
+                controller.begin_batch();
+            bool success = write_destinations(controller);
+            if (own_batch)
+                success &= controller.flush();
+            return success;
+        }
+
+        /// @brief Advance and write direct destinations
+        bool tick(videomancer_fpga_controller& controller, uint32_t ticks = 1)
+        {
+            advance(ticks);
+            return apply(controller);
+        }
+
+        /// @brief Advance, feed the matrix and send everything in one burst
+        bool tick(videomancer_modulation_matrix& matrix, videomancer_fpga_controller& controller, uint32_t ticks = 1)
+        {
+            advance(ticks);
+            write_sources(matrix);
+            matrix.evaluate();
+
+            const bool own_batch = !controller.is_batching();
+            if (own_batch)
+                controller.begin_batch();
+            bool success = write_destinations(controller);
+            success &= matrix.apply(controller);
+            if (own_batch)
+                success &= controller.flush();
+            return success;
+        }
+
+    private:
+        enum class envelope_stage : uint8_t
+        {
+            idle,
+            attack,
+            decay,
+            sustain,
+            release,
+        };
+
+        struct generator
+        {
+            videomancer_generator_kind kind = videomancer_generator_kind::off;
+            videomancer_lfo_wave wave = videomancer_lfo_wave::triangle;
+            vmprog_parameter_control_mode_v1_0 curve = vmprog_parameter_control_mode_v1_0::linear;
+            envelope_stage stage = envelope_stage::idle;
+
+            // Phase accumulator: phase += step + (remainder += step_remainder) / step_den
+            uint32_t phase = 0;
+            uint32_t step = 0;
+            uint32_t step_remainder = 0;
+            uint32_t step_den = 1;
+            uint32_t remainder = 0;
+            uint32_t whole_cycles = 0;
+            uint32_t rate_mhz = 0;      // Rate in mHz, or 0 when period_ticks is used
+            uint32_t period_ticks = 0;  // Ticks per cycle, or 0 when rate_mhz is used
+
+            // Envelope, level in 10.16 fixed point
+            uint32_t level = 0;
+            uint32_t release_step = 0;
+            uint16_t attack_ticks = 0;
+            uint16_t decay_ticks = 0;
+            uint16_t sustain = 0;
+            uint16_t release_ticks = 0;
+
+            uint32_t random = 1;  // xorshift32 state
+            uint16_t raw = 0;     // Output before the curve
+
+            vmprog_parameter_id_v1_0 destination = vmprog_parameter_id_v1_0::none;
+            uint16_t min_value = 0;
+            uint16_t max_value = 1023;
+        };
+
+        static constexpr uint32_t full_level = 1023u << 16;
+
+        generator m_generators[generator_count];
+        videomancer_abi_v1_0::video_rate m_rate;
+
+        /// @brief Derive the phase step: 2^32 * cycles per tick as a mixed fraction
+        void update_step(generator& g) const
+        {
+            // Cycles per tick = p / q
+            uint64_t p = 0;
+            uint64_t q = 1;
+            if (g.period_ticks != 0)
+            {
+                p = 1;
+                q = g.period_ticks;
+            }
+            else if (g.rate_mhz != 0)
+            {
+                p = static_cast<uint64_t>(g.rate_mhz) * m_rate.den;
+                q = static_cast<uint64_t>(m_rate.num) * 1000u;
+            }
+            // Whole cycles per tick do not move the phase (rates at or above the
+            // tick rate alias, as sampling would) but still count as wraps
+            g.whole_cycles = static_cast<uint32_t>(p / q);
+            p %= q;
+            const uint64_t scaled = p << 32;  // p < q < 2^32
+            g.step = static_cast<uint32_t>(scaled / q);
+            g.step_remainder = static_cast<uint32_t>(scaled % q);
+            g.step_den = static_cast<uint32_t>(q);
+            if (g.remainder >= g.step_den)
+                g.remainder = 0;
+        }
+
+        /// @brief Advance the phase; return true if it wrapped
+        static bool advance_phase(generator& g, uint32_t ticks)
+        {
+            const uint64_t remainder = g.remainder + static_cast<uint64_t>(g.step_remainder) * ticks;
+            const uint64_t increment = static_cast<uint64_t>(g.step) * ticks + remainder / g.step_den;
+            g.remainder = static_cast<uint32_t>(remainder % g.step_den);
+            const uint64_t next = g.phase + increment;
+            g.phase = static_cast<uint32_t>(next);
+            return (next >> 32) != 0 || (g.whole_cycles != 0 && ticks != 0);
+        }
+
+        static uint16_t lfo_value(const generator& g)
+        {
+            switch (g.wave)
+            {
+                case videomancer_lfo_wave::ramp_up:
+                    return static_cast<uint16_t>(g.phase >> 22);
+                case videomancer_lfo_wave::ramp_down:
+                    return static_cast<uint16_t>(1023 - (g.phase >> 22));
+                case videomancer_lfo_wave::square:
+                    return g.phase < 0x80000000u ? 1023 : 0;
+                case videomancer_lfo_wave::triangle:
+                default:
+                {
+                    const uint32_t t = g.phase >> 21;  // 0-2047
+                    return static_cast<uint16_t>(t < 1024 ? t : 2047 - t);
+                }
+            }
+        }
+
+        static uint16_t next_random(generator& g)
+        {
+            uint32_t x = g.random;
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            g.random = x;
+            return static_cast<uint16_t>(x >> 22);
+        }
+
+        /// @brief Run the envelope for a number of ticks (each stage ends within its tick count)
+        static void advance_envelope(generator& g, uint32_t ticks)
+        {
+            const uint32_t sustain_level = static_cast<uint32_t>(g.sustain) << 16;
+            while (ticks > 0)
+            {
+                switch (g.stage)
+                {
+                    case envelope_stage::attack:
+                    {
+                        const uint32_t step = g.attack_ticks ? full_level / g.attack_ticks : full_level;
+                        g.level = (full_level - g.level <= step) ? full_level : g.level + step;
+                        if (g.level == full_level)
+                            g.stage = envelope_stage::decay;
+                        break;
+                    }
+                    case envelope_stage::decay:
+                    {
+                        const uint32_t step = g.decay_ticks ? (full_level - sustain_level) / g.decay_ticks : full_level;
+                        g.level = (g.level <= sustain_level + step) ? sustain_level : g.level - step;
+                        if (g.level == sustain_level)
+                            g.stage = envelope_stage::sustain;
+                        break;
+                    }
+                    case envelope_stage::release:
+                        g.level = (g.level <= g.release_step) ? 0 : g.level - g.release_step;
+                        if (g.level == 0)
+                            g.stage = envelope_stage::idle;
+                        break;
+                    default:
+                        ticks = 1;  // Sustain and idle hold their level
+                        break;
+                }
+                --ticks;
+            }
+            g.raw = static_cast<uint16_t>(g.level >> 16);
+        }
+
+        bool write_destinations(videomancer_fpga_controller& controller) const
+        {
+            bool success = true;
+            for (uint8_t i = 0; i < generator_count; ++i)
+            {
+                const generator& g = m_generators[i];
+                if (g.destination == vmprog_parameter_id_v1_0::none || g.kind == videomancer_generator_kind::off)
+                    continue;
+                const int32_t span = static_cast<int32_t>(g.max_value) - g.min_value;
+                const uint16_t value = static_cast<uint16_t>(g.min_value + span * get_output(i) / 1023);
+                success &= controller.set_parameter(g.destination, value);
+            }
+            return success;
+        }
+    };
+
+} // namespace lzx
@@ -0,0 +1,372 @@
+// Videomancer SDK - Open source FPGA-based video effects development kit
+// Copyright (C) 2025 LZX Industries LLC
+// File: videomancer_modulation_matrix.hpp - Fixed-Point Parameter Modulation Matrix
+// License: GNU General Public License v3.0
+// https://github.com/lzxindustries/videomancer-sdk
+//
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// Routes control sources (pots, switches, automation) to parameter
+// registers so one control can drive several registers, e.g. one knob
+// setting Y, U and V gain together. Each route has a source, a destination,
+// a signed amount and a control curve from vmprog_parameter_utils.hpp:
+//
+//   destination = clamp(offset + sum(amount * curve(source)), 0, 1023)
+//
+// Values are 10-bit (0-1023) and amounts are Q2.14 (16384 = 1.0), so the
+// whole evaluation is integer arithmetic with no allocation. Routes are kept
+// sorted by destination in structure-of-arrays form: one tick re-curves the
+// routes whose source changed, multiplies every route in one loop the
+// compiler can vectorize, and sums each destination's contiguous run. The
+// results go to the controller in one batch, so only registers whose value
+// changed are sent, in a single burst.
+
+#pragma once
+
+#include "videomancer_fpga_controller.hpp"
+#include "vmprog_parameter_utils.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace lzx
+{
+    /// @brief Modulation matrix inputs
+    ///
+    /// Values 1-12 are the panel controls and match vmprog_parameter_id_v1_0.
+    /// Automation slots are written by the host or by modulation generators.
+    enum class videomancer_mod_source : uint8_t
+    {
+        none = 0,
+        rotary_potentiometer_1 = 1,
+        rotary_potentiometer_2 = 2,
+        rotary_potentiometer_3 = 3,
+        rotary_potentiometer_4 = 4,
+        rotary_potentiometer_5 = 5,
+        rotary_potentiometer_6 = 6,
+        toggle_switch_7 = 7,
+        toggle_switch_8 = 8,
+        toggle_switch_9 = 9,
+        toggle_switch_10 = 10,
+        toggle_switch_11 = 11,
+        linear_potentiometer_12 = 12,
+        automation_1 = 13,
+        automation_2 = 14,
+        automation_3 = 15,
+        automation_4 = 16,
+        automation_5 = 17,
+        automation_6 = 18,
+        automation_7 = 19,
+        automation_8 = 20,
+    };
+
+    /// @brief Source for a panel control
+    constexpr videomancer_mod_source to_mod_source(vmprog_parameter_id_v1_0 id)
+    {
+        return static_cast<videomancer_mod_source>(static_cast<uint8_t>(id));
+    }
+
+    /// @brief Source for automation slot 0-7
+    constexpr videomancer_mod_source to_automation_source(uint8_t slot)
+    {
+        return static_cast<videomancer_mod_source>(static_cast<uint8_t>(videomancer_mod_source::automation_1) + slot);
+    }
+
+    /// @brief Route amount in Q2.14 from a ratio (-2.0 to just under 2.0)
+    constexpr int16_t to_mod_amount(float ratio)
+    {
+        const float scaled = ratio * 16384.0f + (ratio < 0.0f ? -0.5f : 0.5f);
+        return scaled >= 32767.0f ? int16_t(32767) : (scaled <= -32768.0f ? int16_t(-32768) : static_cast<int16_t>(scaled));
+    }
+
+    /// @brief Fixed-point modulation matrix feeding videomancer_fpga_controller
+    ///
+    /// Example (pot 1 drives three gains; automation 1 adds to pot 4's own value):
+    ///   using src = videomancer_mod_source;
+    ///   using dst = vmprog_parameter_id_v1_0;
+    ///   videomancer_modulation_matrix matrix;
+    ///   matrix.add_route(src::rotary_potentiometer_1, dst::rotary_potentiometer_1, matrix.unity);
+    ///   matrix.add_route(src::rotary_potentiometer_1, dst::rotary_potentiometer_2, matrix.unity);
+    ///   matrix.add_route(src::rotary_potentiometer_1, dst::rotary_potentiometer_3, matrix.unity);
+    ///   matrix.add_route(src::rotary_potentiometer_4, dst::rotary_potentiometer_4, matrix.unity);
+    ///   matrix.add_route(src::automation_1, dst::rotary_potentiometer_4, to_mod_amount(0.25f));
+    ///   for (;;) {                    // once per control tick
+    ///       matrix.set_source(src::rotary_potentiometer_1, panel_pot_1);
+    ///       matrix.tick(controller);  // one burst of changed registers
+    ///   }
+    ///
+    /// Sources are the physical inputs, not the controller's shadows: once a
+    /// register is a destination its shadow holds the modulated value.
+    /// Registers with no route are left to the caller. Toggle switch
+    /// destinations are on when their value is 512 or more.
+    class videomancer_modulation_matrix
+    {
+    public:
+        /// @brief Maximum number of routes
+        static constexpr uint8_t max_routes = 32;
+
+        /// @brief Number of source values (including none)
+        static constexpr uint8_t source_count = static_cast<uint8_t>(videomancer_mod_source::automation_8) + 1;
+
+        /// @brief Number of destination slots, indexed by parameter ID
+        static constexpr uint8_t destination_count = static_cast<uint8_t>(vmprog_parameter_id_v1_0::linear_potentiometer_12) + 1;
+
+        /// @brief Route amount of 1.0
+        static constexpr int16_t unity = 16384;
+
+        videomancer_modulation_matrix()
+        {
+            clear();
+        }
+
+        /// @brief Remove all routes and offsets, and zero every source
+        void clear()
+        {
+            m_route_count = 0;
+            m_routed_mask = 0;
+            m_changed_mask = 0;
+            for (uint8_t i = 0; i < max_routes; ++i)
+            {
+                m_route_amount[i] = 0;
+                m_curved[i] = 0;
+            }
+            for (uint8_t i = 0; i < source_count; ++i)
+                m_sources[i] = 0;
+            for (uint8_t i = 0; i < destination_count; ++i)
+            {
+                m_offsets[i] = 0;
+                m_outputs[i] = 0;
+                m_segment_end[i] = 0;
+            }
+        }
+
+        /// @brief Add a route
+        /// @param source Input value
+        /// @param destination Register, by parameter ID
+        /// @param amount Q2.14 gain, negative to invert
+        /// @param curve Curve applied to the source before the gain
+        /// @return false if the matrix is full or an ID is none or out of range
+        bool add_route(videomancer_mod_source source,
+                       vmprog_parameter_id_v1_0 destination,
+                       int16_t amount,
+                       vmprog_parameter_control_mode_v1_0 curve = vmprog_parameter_control_mode_v1_0::linear)
+        {
+            const uint8_t src = static_cast<uint8_t>(source);
+            const uint32_t dst = static_cast<uint32_t>(destination);
+            if (m_route_count >= max_routes || src == 0 || src >= source_count || dst == 0 || dst >= destination_count)
+                return false;
+
+            // Insert after the last route to the same or a lower destination
+            uint8_t at = m_segment_end[dst];
+            for (uint8_t i = m_route_count; i > at; --i)
+                copy_route(i - 1, i);
+            m_route_source[at] = src;
+            m_route_destination[at] = static_cast<uint8_t>(dst);
+            m_route_curve[at] = curve;
+            m_route_amount[at] = amount;
+            m_curved[at] = static_cast<int16_t>(apply_parameter_control_curve(m_sources[src], curve));
+            ++m_route_count;
+            update_segments();
+            return true;
+        }
+
+        /// @brief Remove every route from a source to a destination
+        /// @return Number of routes removed
+        uint8_t remove_route(videomancer_mod_source source, vmprog_parameter_id_v1_0 destination)
+        {
+            uint8_t kept = 0;
+            for (uint8_t i = 0; i < m_route_count; ++i)
+            {
+                if (m_route_source[i] == static_cast<uint8_t>(source) &&
+                    m_route_destination[i] == static_cast<uint8_t>(destination))
+                    continue;
+                if (kept != i)
+                    copy_route(i, kept);
+                ++kept;
+            }
+            const uint8_t removed = static_cast<uint8_t>(m_route_count - kept);
+            for (uint8_t i = kept; i < m_route_count; ++i)
+            {
+                m_route_amount[i] = 0;
+                m_curved[i] = 0;
+            }
+            m_route_count = kept;
+            update_segments();
+            return removed;
+        }
+
+        /// @brief Number of routes
+        uint8_t route_count() const { return m_route_count; }
+
+        /// @brief Set a source value
+        /// @param value 10-bit value (clamped to 1023)
+        void set_source(videomancer_mod_source source, uint16_t value)
+        {
+            const uint8_t src = static_cast<uint8_t>(source);
+            if (src == 0 || src >= source_count)
+                return;
+            if (value > 1023)
+                value = 1023;
+            if (m_sources[src] != value)
+            {
+                m_sources[src] = value;
+                m_changed_mask |= 1u << src;
+            }
+        }
+
+        /// @brief Get a source value
+        uint16_t get_source(videomancer_mod_source source) const
+        {
+            const uint8_t src = static_cast<uint8_t>(source);
+            return src < source_count ? m_sources[src] : 0;
+        }
+
+        /// @brief Set a destination's value before modulation (default 0)
+        /// @param offset -1023 to 1023, e.g. 512 to center a bipolar route
+        void set_offset(vmprog_parameter_id_v1_0 destination, int16_t offset)
+        {
+            const uint32_t dst = static_cast<uint32_t>(destination);
+            if (dst > 0 && dst < destination_count)
+                m_offsets[dst] = offset;
+        }
+
+        /// @brief Compute every routed destination from the current sources
+        void evaluate()
+        {
+            // Re-curve only routes whose source moved
+            if (m_changed_mask != 0)
+            {
+                for (uint8_t i = 0; i < m_route_count; ++i)
+                {
+                    if (m_changed_mask & (1u << m_route_source[i]))
+                        m_curved[i] = static_cast<int16_t>(
+                            apply_parameter_control_curve(m_sources[m_route_source[i]], m_route_curve[i]));
+                }
+                m_changed_mask = 0;
+            }
+
+            // One multiply per slot over contiguous arrays; the fixed trip count
+            // lets the compiler vectorize it at -O2 (unused slots are zero)
+            for (uint8_t i = 0; i < max_routes; ++i)
+                m_products[i] = static_cast<int32_t>(m_curved[i]) * m_route_amount[i];
+
+            // Routes are sorted by destination, so each sum is one contiguous run
+            uint8_t begin = 0;
+            for (uint8_t dst = 1; dst < destination_count; ++dst)
+            {
+                const uint8_t end = m_segment_end[dst];
+                if (end == begin)
+                    continue;
+                int32_t sum = 0;
+                for (uint8_t i = begin; i < end; ++i)
+                    sum += m_products[i];
+                const int32_t value = m_offsets[dst] + ((sum + (unity / 2)) >> 14);
+                m_outputs[dst] = static_cast<uint16_t>(value < 0 ? 0 : (value > 1023 ? 1023 : value));
+                begin = end;
+            }
+        }
+
+        /// @brief Last evaluated value of a destination
+        uint16_t get_output(vmprog_parameter_id_v1_0 destination) const
+        {
+            const uint32_t dst = static_cast<uint32_t>(destination);
+            return dst < destination_count ? m_outputs[dst] : 0;
+        }
+
+        /// @brief Whether any route targets a destination
+        bool is_routed(vmprog_parameter_id_v1_0 destination) const
+        {
+            const uint32_t dst = static_cast<uint32_t>(destination);
+            return dst < destination_count && (m_routed_mask & (1u << dst)) != 0;
+        }
+
+        /// @brief Write every routed destination to the controller
+        ///
+        /// Opens a batch and flushes it, so unchanged registers cost nothing and
+        /// the changed ones go out in one burst. If the caller already opened a
+        /// batch the writes join it and the caller's flush() sends them.
+        /// @return true if all writes (and the flush, if made here) succeeded
+        bool apply(videomancer_fpga_controller& controller) const
+        {
+            const bool own_batch = !controller.is_batching();
+            if (own_batch)
+                controller.begin_batch();
+
+            bool success = true;
+            for (uint8_t dst = 1; dst < destination_count; ++dst)
+            {
+                if ((m_routed_mask & (1u << dst)) == 0)
+                    continue;
+                const vmprog_parameter_id_v1_0 id = static_cast<vmprog_parameter_id_v1_0>(dst);
+                const bool is_switch = id >= vmprog_parameter_id_v1_0::toggle_switch_7 &&
+                                       id <= vmprog_parameter_id_v1_0::toggle_switch_11;
+                const uint16_t value = is_switch ? static_cast<uint16_t>(m_outputs[dst] >= 512) : m_outputs[dst];
+                success &= controller.set_parameter(id, value);
+            }
+
+            if (own_batch)
+                success &= controller.flush();
+            return success;
+        }
+
+        /// @brief Evaluate and apply once per control tick
+        /// @return true if all writes succeeded
+        bool tick(videomancer_fpga_controller& controller)
+        {
+            evaluate();
+            return apply(controller);
+        }
+
+    private:
+        // Routes in structure-of-arrays form, sorted by destination
+        uint8_t m_route_source[max_routes];
+        uint8_t m_route_destination[max_routes];
+        vmprog_parameter_control_mode_v1_0 m_route_curve[max_routes];
+        int16_t m_route_amount[max_routes];
+        int16_t m_curved[max_routes];       // curve(source) cached per route
+        int32_t m_products[max_routes];
+        uint8_t m_route_count;
+
+        uint8_t m_segment_end[destination_count];  // One past each destination's last route
+        uint16_t m_routed_mask;                    // Destinations with routes, by parameter ID
+        uint16_t m_sources[source_count];
+        uint32_t m_changed_mask;                   // Sources changed since the last evaluate()
+        int16_t m_offsets[destination_count];
+        uint16_t m_outputs[destination_count];
+
+        void copy_route(uint8_t from, uint8_t to)
+        {
+            m_route_source[to] = m_route_source[from];
+            m_route_destination[to] = m_route_destination[from];
+            m_route_curve[to] = m_route_curve[from];
+            m_route_amount[to] = m_route_amount[from];
+            m_curved[to] = m_curved[from];
+        }
+
+        void update_segments()
+        {
+            m_routed_mask = 0;
+            uint8_t i = 0;
+            for (uint8_t dst = 0; dst < destination_count; ++dst)
+            {
+                const uint8_t begin = i;
+                while (i < m_route_count && m_route_destination[i] == dst)
+                    ++i;
+                m_segment_end[dst] = i;
+                if (i > begin)
+                    m_routed_mask |= static_cast<uint16_t>(1u << dst);
+            }
+        }
+    };
+
+} // namespace lzx
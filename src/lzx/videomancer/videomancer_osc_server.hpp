@@ -0,0 +1,484 @@
+// Videomancer SDK - Open source FPGA-based video effects development kit
+// Copyright (C) 2025 LZX Industries LLC
+// File: videomancer_osc_server.hpp - OSC/UDP Parameter Control Server
+// License: GNU General Public License v3.0
+// https://github.com/lzxindustries/videomancer-sdk
+//
+// Allocation-free OSC 1.0 message parsing, address-to-parameter routing with
+// control curves, and a Linux epoll UDP server that coalesces each burst of
+// messages into one batched register flush.
+//
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// OSC Address Space:
+//   /videomancer/param/<n>   n = vmprog_parameter_id_v1_0 (1-12)
+//   Argument types:
+//     i  int32   raw control value, passed through the parameter curve (0-1023)
+//     f  float32 normalized control value (0.0-1.0)
+//     T/F        boolean (1023 / 0)
+//   Bundles are unpacked recursively; timetags are ignored (applied on receipt).
+
+#pragma once
+
+#include "videomancer_fpga_controller.hpp"
+#include "vmprog_format.hpp"
+#include "vmprog_parameter_utils.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <cerrno>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define VIDEOMANCER_OSC_HAS_EPOLL 1
+#endif
+
+namespace lzx
+{
+    /// @brief Parsed OSC message (all pointers reference the packet buffer)
+    struct osc_message
+    {
+        const char* address;     // Null-terminated address pattern
+        const char* type_tags;   // Type tags without the leading ','
+        const uint8_t* arguments;
+        size_t arguments_size;
+    };
+
+    /// @brief Padded size of an OSC string
+    /// @param length String length excluding terminator
+    /// @return Padded size including the terminator, a multiple of 4
+    constexpr size_t osc_padded_size(size_t length)
+    {
+        return (length + 4) & ~static_cast<size_t>(3);
+    }
+
+    /// @brief Parse a single OSC message
+    /// @param data Packet data (must not start with '#bundle')
+    /// @param size Packet size in bytes
+    /// @param out_message Receives pointers into data
+    /// @return true if the message is well formed
+    inline bool parse_osc_message(const uint8_t* data, size_t size, osc_message& out_message)
+    {
+        if (size < 8 || (size & 3) != 0 || data[0] != '/')
+            return false;
+
+        const void* address_end = memchr(data, 0, size);
+        if (!address_end)
+            return false;
+        const size_t address_size = osc_padded_size(static_cast<const uint8_t*>(address_end) - data);
+        if (address_size >= size || data[address_size] != ',')
+            return false;
+
+        const void* tags_end = memchr(data + address_size, 0, size - address_size);
+        if (!tags_end)
+            return false;
+        const size_t tags_size = osc_padded_size(static_cast<const uint8_t*>(tags_end) - (data + address_size));
+        if (address_size + tags_size > size)
+            return false;
+
+        out_message.address = reinterpret_cast<const char*>(data);
+        out_message.type_tags = reinterpret_cast<const char*>(data + address_size + 1);
+        out_message.arguments = data + address_size + tags_size;
+        out_message.arguments_size = size - address_size - tags_size;
+        return true;
+    }
+
+    /// @brief Read the first argument of a message as a 10-bit control value
+    /// @param message Parsed message
+    /// @param out_value Receives the value (int32 raw, float scaled to 0-1023, bool 0/1023)
+    /// @return true if the first argument has a supported type
+    inline bool osc_first_argument_as_control(const osc_message& message, int32_t& out_value)
+    {
+        const char tag = message.type_tags[0];
+        if (tag == 'T' || tag == 'F')
+        {
+            out_value = (tag == 'T') ? 1023 : 0;
+            return true;
+        }
+
+        if ((tag != 'i' && tag != 'f') || message.arguments_size < 4)
+            return false;
+
+        const uint8_t* a = message.arguments;
+        const uint32_t bits = (static_cast<uint32_t>(a[0]) << 24) | (static_cast<uint32_t>(a[1]) << 16) |
+                              (static_cast<uint32_t>(a[2]) << 8) | static_cast<uint32_t>(a[3]);
+        if (tag == 'i')
+        {
+            out_value = static_cast<int32_t>(bits);
+            return true;
+        }
+
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        if (!(f > 0.0f))
+            f = 0.0f;  // Also catches NaN
+        if (f > 1.0f)
+            f = 1.0f;
+        out_value = static_cast<int32_t>(f * 1023.0f + 0.5f);
+        return true;
+    }
+
+    /// @brief Counters kept by videomancer_osc_router
+    struct osc_router_stats
+    {
+        uint32_t packets;
+        uint32_t messages;
+        uint32_t applied;
+        uint32_t unknown_address;
+        uint32_t malformed;
+    };
+
+    /// @brief Maps OSC addresses to program parameters and drives a controller
+    ///
+    /// Routes are stored in a fixed table. Each route optionally refers to a
+    /// parameter configuration whose control curve and min/max scaling are
+    /// applied to incoming values.
+    class videomancer_osc_router
+    {
+    public:
+        static constexpr size_t max_routes = 32;
+        static constexpr size_t max_address_length = 48;
+        static constexpr size_t max_bundle_depth = 4;
+
+        /// @brief Construct router
+        /// @param controller Controller receiving parameter updates
+        explicit videomancer_osc_router(videomancer_fpga_controller& controller)
+            : m_controller(controller)
+            , m_route_count(0)
+            , m_stats()
+        {}
+
+        /// @brief Add or replace a route
+        /// @param address OSC address (exact match)
+        /// @param id Parameter to drive
+        /// @param config Parameter configuration for curve and scaling (nullptr for raw values)
+        /// @return false if the table is full or the address is too long
+        bool add_route(const char* address, vmprog_parameter_id_v1_0 id,
+                       const vmprog_parameter_config_v1_0* config = nullptr)
+        {
+            const size_t length = strlen(address);
+            if (length >= max_address_length)
+                return false;
+
+            route* r = find_route(address);
+            if (!r)
+            {
+                if (m_route_count >= max_routes)
+                    return false;
+                r = &m_routes[m_route_count++];
+                memcpy(r->address, address, length + 1);
+            }
+            r->id = id;
+            r->config = config;
+            return true;
+        }
+
+        /// @brief Add /videomancer/param/<n> routes for every parameter of a program
+        /// @param config Program configuration (must outlive the router)
+        /// @return Number of routes added
+        size_t bind_program_config(const vmprog_program_config_v1_0& config)
+        {
+            size_t added = 0;
+            const uint16_t count = config.parameter_count < vmprog_program_config_v1_0::num_parameters
+                                       ? config.parameter_count
+                                       : static_cast<uint16_t>(vmprog_program_config_v1_0::num_parameters);
+            for (uint16_t i = 0; i < count; ++i)
+            {
+                const vmprog_parameter_config_v1_0& param = config.parameters[i];
+                const uint32_t id = static_cast<uint32_t>(param.parameter_id);
+                if (id == 0 || id > static_cast<uint32_t>(vmprog_parameter_id_v1_0::linear_potentiometer_12))
+                    continue;
+
+                char address[max_address_length] = "/videomancer/param/";
+                size_t length = strlen(address);
+                if (id >= 10)
+                    address[length++] = static_cast<char>('0' + id / 10);
+                address[length++] = static_cast<char>('0' + id % 10);
+                address[length] = '\0';
+
+                if (add_route(address, param.parameter_id, &param))
+                    ++added;
+            }
+            return added;
+        }
+
+        /// @brief Remove all routes
+        void clear_routes()
+        {
+            m_route_count = 0;
+        }
+
+        /// @brief Number of routes in the table
+        size_t route_count() const
+        {
+            return m_route_count;
+        }
+
+        /// @brief Dispatch one OSC packet (message or bundle)
+        ///
+        /// Does not flush; callers batch several packets between
+        /// begin_batch() and flush() on the controller.
+        ///
+        /// @param data Packet data
+        /// @param size Packet size in bytes
+        /// @return Number of parameter updates applied
+        uint32_t handle_packet(const uint8_t* data, size_t size)
+        {
+            ++m_stats.packets;
+            return handle_element(data, size, 0);
+        }
+
+        /// @brief Counters since construction or reset_stats()
+        const osc_router_stats& stats() const
+        {
+            return m_stats;
+        }
+
+        /// @brief Clear counters
+        void reset_stats()
+        {
+            m_stats = osc_router_stats();
+        }
+
+        /// @brief Controller driven by this router
+        videomancer_fpga_controller& controller()
+        {
+            return m_controller;
+        }
+
+    private:
+        struct route
+        {
+            char address[max_address_length];
+            vmprog_parameter_id_v1_0 id;
+            const vmprog_parameter_config_v1_0* config;
+        };
+
+        videomancer_fpga_controller& m_controller;
+        route m_routes[max_routes];
+        size_t m_route_count;
+        osc_router_stats m_stats;
+
+        route* find_route(const char* address)
+        {
+            for (size_t i = 0; i < m_route_count; ++i)
+            {
+                if (strcmp(m_routes[i].address, address) == 0)
+                    return &m_routes[i];
+            }
+            return nullptr;
+        }
+
+        uint32_t handle_element(const uint8_t* data, size_t size, size_t depth)
+        {
+            if (size >= 16 && memcmp(data, "#bundle", 8) == 0)
+            {
+                if (depth >= max_bundle_depth)
+                {
+                    ++m_stats.malformed;
+                    return 0;
+                }
+
+                uint32_t applied = 0;
+                size_t pos = 16;  // '#bundle\0' + 8-byte timetag
+                while (pos + 4 <= size)
+                {
+                    const uint32_t element_size = (static_cast<uint32_t>(data[pos]) << 24) |
+                                                  (static_cast<uint32_t>(data[pos + 1]) << 16) |
+                                                  (static_cast<uint32_t>(data[pos + 2]) << 8) |
+                                                  static_cast<uint32_t>(data[pos + 3]);
+                    pos += 4;
+                    if (element_size > size - pos)
+                    {
+                        ++m_stats.malformed;
+                        break;
+                    }
+                    applied += handle_element(data + pos, element_size, depth + 1);
+                    pos += element_size;
+                }
+                return applied;
+            }
+
+            ++m_stats.messages;
+            osc_message message;
+            int32_t value;
+            if (!parse_osc_message(data, size, message) || !osc_first_argument_as_control(message, value))
+            {
+                ++m_stats.malformed;
+                return 0;
+            }
+
+            const route* r = find_route(message.address);
+            if (!r)
+            {
+                ++m_stats.unknown_address;
+                return 0;
+            }
+
+            const uint16_t register_value = r->config
+                ? apply_parameter_control_curve_and_scaling(value, *r->config)
+                : clamp_u16(value, 0, 1023);
+            if (!m_controller.set_parameter(r->id, register_value))
+                return 0;
+
+            ++m_stats.applied;
+            return 1;
+        }
+    };
+
+#ifdef VIDEOMANCER_OSC_HAS_EPOLL
+
+    /// @brief Single-threaded epoll UDP server for OSC control
+    ///
+    /// Each wake-up drains every datagram queued on the socket inside one
+    /// controller batch, then flushes once. A burst of N messages touching K
+    /// controls therefore costs K SPI writes instead of N.
+    class videomancer_osc_udp_server
+    {
+    public:
+        static constexpr size_t max_packet_size = 1536;
+
+        /// @brief Construct server
+        /// @param router Router that dispatches decoded messages
+        explicit videomancer_osc_udp_server(videomancer_osc_router& router)
+            : m_router(router)
+            , m_socket_fd(-1)
+            , m_epoll_fd(-1)
+            , m_flush_count(0)
+        {}
+
+        ~videomancer_osc_udp_server()
+        {
+            close();
+        }
+
+        videomancer_osc_udp_server(const videomancer_osc_udp_server&) = delete;
+        videomancer_osc_udp_server& operator=(const videomancer_osc_udp_server&) = delete;
+
+        /// @brief Bind the UDP socket
+        /// @param port UDP port (0 picks a free port, see port())
+        /// @param bind_address IPv4 address in dotted notation
+        /// @return true on success
+        bool open(uint16_t port, const char* bind_address = "127.0.0.1")
+        {
+            close();
+
+            sockaddr_in addr = {};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(port);
+            if (::inet_pton(AF_INET, bind_address, &addr.sin_addr) != 1)
+                return false;
+
+            m_socket_fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            if (m_socket_fd < 0)
+                return false;
+
+            m_epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+            epoll_event event = {};
+            event.events = EPOLLIN;
+            event.data.fd = m_socket_fd;
+            if (m_epoll_fd < 0 ||
+                ::bind(m_socket_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+                ::epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_socket_fd, &event) != 0)
+            {
+                close();
+                return false;
+            }
+            return true;
+        }
+
+        /// @brief Close the socket and epoll instance
+        void close()
+        {
+            if (m_epoll_fd >= 0)
+                ::close(m_epoll_fd);
+            if (m_socket_fd >= 0)
+                ::close(m_socket_fd);
+            m_epoll_fd = -1;
+            m_socket_fd = -1;
+        }
+
+        /// @brief Bound UDP port, 0 if not open
+        uint16_t port() const
+        {
+            sockaddr_in addr = {};
+            socklen_t length = sizeof(addr);
+            if (m_socket_fd < 0 ||
+                ::getsockname(m_socket_fd, reinterpret_cast<sockaddr*>(&addr), &length) != 0)
+                return 0;
+            return ntohs(addr.sin_port);
+        }
+
+        /// @brief epoll descriptor, for nesting in an outer event loop
+        int epoll_fd() const
+        {
+            return m_epoll_fd;
+        }
+
+        /// @brief Wait for traffic, drain the socket and flush once
+        /// @param timeout_ms epoll timeout (-1 blocks, 0 polls)
+        /// @return Number of datagrams processed, or -1 on error
+        int run_once(int timeout_ms)
+        {
+            if (m_epoll_fd < 0)
+                return -1;
+
+            epoll_event event;
+            const int ready = ::epoll_wait(m_epoll_fd, &event, 1, timeout_ms);
+            if (ready < 0)
+                return errno == EINTR ? 0 : -1;
+            if (ready == 0)
+                return 0;
+
+            videomancer_fpga_controller& controller = m_router.controller();
+            controller.begin_batch();
+
+            int datagrams = 0;
+            for (;;)
+            {
+                const ssize_t n = ::recv(m_socket_fd, m_packet, sizeof(m_packet), 0);
+                if (n < 0 && errno == EINTR)
+                    continue;
+                if (n < 0)
+                    break;  // EAGAIN: socket drained
+                m_router.handle_packet(m_packet, static_cast<size_t>(n));
+                ++datagrams;
+            }
+
+            controller.flush();
+            ++m_flush_count;
+            return datagrams;
+        }
+
+        /// @brief Number of batched flushes issued
+        uint32_t flush_count() const
+        {
+            return m_flush_count;
+        }
+
+    private:
+        videomancer_osc_router& m_router;
+        int m_socket_fd;
+        int m_epoll_fd;
+        uint32_t m_flush_count;
+        alignas(4) uint8_t m_packet[max_packet_size];
+    };
+
+#endif // VIDEOMANCER_OSC_HAS_EPOLL
+
+} // namespace lzx
@@ -0,0 +1,206 @@
+// Videomancer SDK - Open source FPGA-based video effects development kit
+// Copyright (C) 2025 LZX Industries LLC
+// File: videomancer_program_switcher.hpp - Program Switching Without Redundant Reconfiguration
+// License: GNU General Public License v3.0
+// https://github.com/lzxindustries/videomancer-sdk
+//
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// Many programs share one bitstream and differ only in their program
+// configuration (labels, curves, initial values). The switcher remembers
+// the signed hash of the bitstream currently in the FPGA; switching to a
+// program with the same hash skips configuration entirely, so video keeps
+// running, and only the initial register values are written. The hash comes
+// from the signed descriptor (or the preloader), never from the unsigned
+// TOC, so a forged TOC hash cannot make the switcher keep a stale image.
+//
+// Register state after a switch is the same either way: every control not
+// listed by the new program returns to zero, the listed ones take their
+// initial values and the video timing ID is kept. With the bitstream kept
+// only registers that change are sent; after a configuration the whole
+// register state is pushed with videomancer_fpga_controller::resync().
+//
+// A multiboot warmboot also replaces the bitstream, so it goes through
+// videomancer_program_switcher::warmboot(), which records the image booted
+// (or forgets the loaded hash when the caller does not know it).
+
+#pragma once
+
+#include "videomancer_fpga_configurator.hpp"
+#include "videomancer_fpga_controller.hpp"
+#include "vmprog_format.hpp"
+#include "vmprog_stream_reader.hpp"
+#include <cstdint>
+#include <cstring>
+
+namespace lzx
+{
+    /// @brief Switches programs, reconfiguring the FPGA only when the bitstream changes
+    ///
+    /// Example:
+    ///   videomancer_program_switcher switcher(fpga, controller, configurator);
+    ///   // Package already validated; descriptor from read_and_verify_signed_descriptor_stream()
+    ///   auto result = switcher.switch_program(config, stream, *bitstream_entry, descriptor);
+    ///   if (result == videomancer_configuration_result::ok && !switcher.reconfigured())
+    ///       ; // same bitstream: video was never interrupted
+    class videomancer_program_switcher
+    {
+    public:
+        /// @brief Construct switcher
+        /// @param fpga FPGA to configure
+        /// @param controller Register controller for the same FPGA
+        /// @param configurator Configuration engine used on a bitstream change
+        videomancer_program_switcher(videomancer_fpga& fpga,
+                                     videomancer_fpga_controller& controller,
+                                     videomancer_fpga_configurator& configurator)
+            : m_fpga(fpga)
+            , m_controller(controller)
+            , m_configurator(configurator)
+            , m_loaded(false)
+            , m_reconfigured(false)
+            , m_resync_pending(false)
+        {
+            memset(m_loaded_sha256, 0, sizeof(m_loaded_sha256));
+        }
+
+        /// @brief Switch to a program whose bitstream is read from a package stream
+        /// @param config Validated program configuration
+        /// @param stream Package stream (only read if the bitstream changes)
+        /// @param bitstream TOC entry of the bitstream variant to run
+        /// @param descriptor Signed descriptor whose signature has been verified
+        /// @return ok, invalid_entry if the variant is not signed, a configuration
+        ///         failure, or register_error
+        videomancer_configuration_result switch_program(const vmprog_program_config_v1_0& config,
+                                                        vmprog_stream& stream,
+                                                        const vmprog_toc_entry_v1_0& bitstream,
+                                                        const vmprog_signed_descriptor_v1_0& descriptor)
+        {
+            m_reconfigured = false;
+            const vmprog_artifact_hash_v1_0* artifact = find_descriptor_artifact(descriptor, bitstream.type);
+            if (!artifact)
+                return videomancer_configuration_result::invalid_entry;
+            if (!is_loaded(artifact->sha256))
+            {
+                m_loaded = false;
+                const videomancer_configuration_result result =
+                    m_configurator.configure(m_fpga, stream, bitstream, artifact->sha256);
+                if (result != videomancer_configuration_result::ok)
+                    return result;
+                mark_configured(artifact->sha256);
+            }
+            return apply(config);
+        }
+
+        /// @brief Switch to a program whose bitstream is staged in memory
+        /// @param config Validated program configuration
+        /// @param bitstream Staged image (e.g. vmprog_preload_buffer::data())
+        /// @param size Image size in bytes
+        /// @param sha256 Verified hash of the image (e.g. vmprog_program_preloader::bitstream_sha256())
+        /// @return ok, a configuration failure, or register_error
+        videomancer_configuration_result switch_program(const vmprog_program_config_v1_0& config,
+                                                        const uint8_t* bitstream,
+                                                        uint32_t size,
+                                                        const uint8_t sha256[32])
+        {
+            m_reconfigured = false;
+            if (!is_loaded(sha256))
+            {
+                m_loaded = false;
+                const videomancer_configuration_result result = m_configurator.configure(m_fpga, bitstream, size);
+                if (result != videomancer_configuration_result::ok)
+                    return result;
+                mark_configured(sha256);
+            }
+            return apply(config);
+        }
+
+        /// @brief Check whether a bitstream is the one currently in the FPGA
+        /// @param sha256 Signed hash of the bitstream
+        /// @return true if a switch to it would skip configuration
+        bool is_loaded(const uint8_t sha256[32]) const
+        {
+            return m_loaded && memcmp(m_loaded_sha256, sha256, sizeof(m_loaded_sha256)) == 0;
+        }
+
+        /// @brief Hash of the loaded bitstream
+        /// @return 32-byte hash, or nullptr if nothing known is loaded
+        const uint8_t* loaded_sha256() const
+        {
+            return m_loaded ? m_loaded_sha256 : nullptr;
+        }
+
+        /// @brief Reboot the FPGA into a multiboot flash image
+        /// @param image Image slot (0-3) in the layout built by ice40_multiboot.hpp
+        /// @param sha256 Signed hash of the bitstream in that slot, or nullptr if unknown
+        /// @return true if the request was sent
+        /// @note Use this rather than videomancer_fpga_controller::warmboot() so the
+        ///       bitstream the switcher believes is loaded stays correct. The new
+        ///       image starts with its registers cleared; the next switch_program()
+        ///       sends the whole register state, even when it keeps this bitstream.
+        bool warmboot(uint8_t image, const uint8_t* sha256 = nullptr)
+        {
+            // Whatever was loaded is gone once the request may have reached the FPGA
+            m_loaded = false;
+            m_reconfigured = false;
+            m_resync_pending = true;
+            if (!m_controller.warmboot(image))
+                return false;
+            if (sha256)
+            {
+                memcpy(m_loaded_sha256, sha256, sizeof(m_loaded_sha256));
+                m_loaded = true;
+            }
+            return true;
+        }
+
+        /// @brief Forget the loaded bitstream (e.g. after the FPGA was reset externally)
+        void invalidate()
+        {
+            m_loaded = false;
+        }
+
+        /// @brief Whether the last switch reconfigured the FPGA
+        bool reconfigured() const
+        {
+            return m_reconfigured;
+        }
+
+    private:
+        videomancer_fpga& m_fpga;
+        videomancer_fpga_controller& m_controller;
+        videomancer_fpga_configurator& m_configurator;
+        uint8_t m_loaded_sha256[32];
+        bool m_loaded;
+        bool m_reconfigured;
+        bool m_resync_pending;  // Registers were reset by a warmboot
+
+        void mark_configured(const uint8_t sha256[32])
+        {
+            memcpy(m_loaded_sha256, sha256, sizeof(m_loaded_sha256));
+            m_loaded = true;
+            m_reconfigured = true;
+        }
+
+        videomancer_configuration_result apply(const vmprog_program_config_v1_0& config)
+        {
+            // A fresh configuration or warmboot cleared the registers: send all of them
+            const bool sent = (m_reconfigured || m_resync_pending) ? m_controller.resync(config)
+                                                                   : m_controller.apply_initial_values(config);
+            if (sent)
+                m_resync_pending = false;
+            return sent ? videomancer_configuration_result::ok : videomancer_configuration_result::register_error;
+        }
+    };
+
+} // namespace lzx
@@ -0,0 +1,593 @@
+// Videomancer SDK - Open source FPGA-based video effects development kit
+// Copyright (C) 2025 LZX Industries LLC
+// File: videomancer_spi_trace.hpp - SPI Traffic Recording, Replay and Analysis
+// License: GNU General Public License v3.0
+// https://github.com/lzxindustries/videomancer-sdk
+//
+// Records every videomancer_fpga call into a compact binary trace, replays a
+// trace into any videomancer_fpga implementation or controller, and reports
+// bus utilization figures. For protocol specification, see: docs/abi-format.md
+//
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// Trace Format:
+//   - 8-byte header: magic 'VMST' (0x54534D56, little-endian), version (u16), reserved (u16)
+//   - Sequence of events, each: [tag (u8)][delta_us (LEB128)][payload]
+//       tag 0x01: chip select asserted        (no payload)
+//       tag 0x02: chip select de-asserted     (no payload)
+//       tag 0x03: transfer                    [size (LEB128)][tx bytes]
+//       tag 0x04: transfer without tx buffer  [size (LEB128)]
+//   - delta_us is the time since the previous event (first event: since trace start)
+//   - A CS-framed register write costs 9 bytes of trace
+
+#pragma once
+
+#include "videomancer_fpga.hpp"
+#include "videomancer_fpga_controller.hpp"
+#include "videomancer_abi.hpp"
+#include "videomancer_clock.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace lzx
+{
+    /// @brief SPI trace event kinds (stored as the event tag byte)
+    enum class spi_trace_event_type : uint8_t
+    {
+        cs_assert = 0x01,
+        cs_deassert = 0x02,
+        transfer = 0x03,
+        transfer_no_tx = 0x04
+    };
+
+    /// @brief Decoded SPI trace event
+    struct spi_trace_event
+    {
+        spi_trace_event_type type;
+        uint64_t timestamp_us;   // Time since trace start
+        size_t size;             // Transfer size in bytes (transfers only)
+        const uint8_t* data;     // Transmitted bytes, nullptr for transfer_no_tx
+    };
+
+    /// @brief Trace header constants
+    namespace spi_trace_format
+    {
+        constexpr uint32_t magic = 0x54534D56u;  // 'VMST'
+        constexpr uint16_t version = 1;
+        constexpr size_t header_size = 8;
+    }
+
+    /// @brief Appends SPI events to a caller-provided trace buffer
+    ///
+    /// Never allocates. When the buffer fills, further events are dropped and
+    /// overflowed() reports true; the trace written so far stays valid.
+    class spi_trace_writer
+    {
+    public:
+        /// @brief Start a new trace in the given buffer
+        /// @param buffer Trace storage
+        /// @param capacity Size of buffer in bytes (must be at least header_size)
+        /// @param start_us Timestamp corresponding to trace time zero
+        /// @return true if the header fit in the buffer
+        bool begin(uint8_t* buffer, size_t capacity, uint64_t start_us)
+        {
+            m_buffer = buffer;
+            m_capacity = capacity;
+            m_size = 0;
+            m_last_us = start_us;
+            m_overflowed = false;
+
+            if (buffer == nullptr || capacity < spi_trace_format::header_size)
+            {
+                m_overflowed = true;
+                return false;
+            }
+
+            put_u32_le(spi_trace_format::magic);
+            put_u16_le(spi_trace_format::version);
+            put_u16_le(0);
+            return true;
+        }
+
+        /// @brief Record a chip select change
+        /// @param timestamp_us Absolute time of the event
+        /// @param assert true when CS is asserted (driven low)
+        void write_chip_select(uint64_t timestamp_us, bool assert)
+        {
+            const spi_trace_event_type type = assert ? spi_trace_event_type::cs_assert
+                                                     : spi_trace_event_type::cs_deassert;
+            uint8_t event[11];
+            size_t n = encode_event_head(event, type, timestamp_us);
+            commit(timestamp_us, event, n, nullptr, 0);
+        }
+
+        /// @brief Record a transfer
+        /// @param timestamp_us Absolute time of the event
+        /// @param tx_buffer Transmitted bytes (may be nullptr)
+        /// @param size Number of bytes transferred
+        void write_transfer(uint64_t timestamp_us, const uint8_t* tx_buffer, size_t size)
+        {
+            const spi_trace_event_type type = tx_buffer ? spi_trace_event_type::transfer
+                                                        : spi_trace_event_type::transfer_no_tx;
+            uint8_t event[22];
+            size_t n = encode_event_head(event, type, timestamp_us);
+            n += encode_leb128(event + n, size);
+            commit(timestamp_us, event, n, tx_buffer, tx_buffer ? size : 0);
+        }
+
+        /// @brief Number of trace bytes written so far
+        size_t size() const { return m_size; }
+
+        /// @brief Whether any event was dropped for lack of space
+        bool overflowed() const { return m_overflowed; }
+
+    private:
+        uint8_t* m_buffer = nullptr;
+        size_t m_capacity = 0;
+        size_t m_size = 0;
+        uint64_t m_last_us = 0;
+        bool m_overflowed = false;
+
+        static size_t encode_leb128(uint8_t* out, uint64_t value)
+        {
+            size_t n = 0;
+            do
+            {
+                uint8_t byte = static_cast<uint8_t>(value & 0x7F);
+                value >>= 7;
+                out[n++] = value ? static_cast<uint8_t>(byte | 0x80) : byte;
+            } while (value);
+            return n;
+        }
+
+        size_t encode_event_head(uint8_t* out, spi_trace_event_type type, uint64_t timestamp_us)
+        {
+            out[0] = static_cast<uint8_t>(type);
+            const uint64_t delta = (timestamp_us > m_last_us) ? (timestamp_us - m_last_us) : 0;
+            return 1 + encode_leb128(out + 1, delta);
+        }
+
+        void commit(uint64_t timestamp_us, const uint8_t* head, size_t head_size, const uint8_t* data, size_t data_size)
+        {
+            if (m_overflowed || m_size + head_size + data_size > m_capacity)
+            {
+                m_overflowed = true;
+                return;
+            }
+
+            for (size_t i = 0; i < head_size; ++i)
+                m_buffer[m_size++] = head[i];
+            for (size_t i = 0; i < data_size; ++i)
+                m_buffer[m_size++] = data[i];
+
+            // Advance the time base only for events that were stored; an
+            // out-of-order timestamp was encoded as delta 0 and leaves it alone
+            if (timestamp_us > m_last_us)
+                m_last_us = timestamp_us;
+        }
+
+        void put_u16_le(uint16_t value)
+        {
+            m_buffer[m_size++] = static_cast<uint8_t>(value & 0xFF);
+            m_buffer[m_size++] = static_cast<uint8_t>(value >> 8);
+        }
+
+        void put_u32_le(uint32_t value)
+        {
+            put_u16_le(static_cast<uint16_t>(value & 0xFFFF));
+            put_u16_le(static_cast<uint16_t>(value >> 16));
+        }
+    };
+
+    /// @brief Iterates over the events of a recorded trace
+    class spi_trace_reader
+    {
+    public:
+        /// @brief Attach to a trace and validate its header
+        /// @param trace Trace data
+        /// @param size Trace size in bytes
+        /// @return true if the header is valid
+        bool begin(const uint8_t* trace, size_t size)
+        {
+            m_trace = trace;
+            m_size = size;
+            m_pos = 0;
+            m_time_us = 0;
+            m_error = false;
+
+            if (trace == nullptr || size < spi_trace_format::header_size)
+            {
+                m_error = true;
+                return false;
+            }
+
+            const uint32_t magic = static_cast<uint32_t>(trace[0]) |
+                                   (static_cast<uint32_t>(trace[1]) << 8) |
+                                   (static_cast<uint32_t>(trace[2]) << 16) |
+                                   (static_cast<uint32_t>(trace[3]) << 24);
+            const uint16_t version = static_cast<uint16_t>(trace[4] | (trace[5] << 8));
+            if (magic != spi_trace_format::magic || version != spi_trace_format::version)
+            {
+                m_error = true;
+                return false;
+            }
+
+            m_pos = spi_trace_format::header_size;
+            return true;
+        }
+
+        /// @brief Decode the next event
+        /// @param out_event Receives the event (data points into the trace)
+        /// @return false at end of trace or on a malformed event
+        bool next(spi_trace_event& out_event)
+        {
+            if (m_error || m_pos >= m_size)
+                return false;
+
+            const uint8_t tag = m_trace[m_pos++];
+            uint64_t delta = 0;
+            if (tag < static_cast<uint8_t>(spi_trace_event_type::cs_assert) ||
+                tag > static_cast<uint8_t>(spi_trace_event_type::transfer_no_tx) ||
+                !read_leb128(delta))
+            {
+                m_error = true;
+                return false;
+            }
+
+            m_time_us += delta;
+            out_event.type = static_cast<spi_trace_event_type>(tag);
+            out_event.timestamp_us = m_time_us;
+            out_event.size = 0;
+            out_event.data = nullptr;
+
+            if (out_event.type == spi_trace_event_type::transfer ||
+                out_event.type == spi_trace_event_type::transfer_no_tx)
+            {
+                uint64_t size = 0;
+                if (!read_leb128(size))
+                {
+                    m_error = true;
+                    return false;
+                }
+                out_event.size = static_cast<size_t>(size);
+
+                if (out_event.type == spi_trace_event_type::transfer)
+                {
+                    if (size > m_size - m_pos)
+                    {
+                        m_error = true;
+                        return false;
+                    }
+                    out_event.data = m_trace + m_pos;
+                    m_pos += static_cast<size_t>(size);
+                }
+            }
+
+            return true;
+        }
+
+        /// @brief Whether decoding stopped on a malformed trace
+        bool has_error() const { return m_error; }
+
+    private:
+        const uint8_t* m_trace = nullptr;
+        size_t m_size = 0;
+        size_t m_pos = 0;
+        uint64_t m_time_us = 0;
+        bool m_error = false;
+
+        bool read_leb128(uint64_t& out_value)
+        {
+            out_value = 0;
+            for (uint32_t shift = 0; shift < 64; shift += 7)
+            {
+                if (m_pos >= m_size)
+                    return false;
+                const uint8_t byte = m_trace[m_pos++];
+                out_value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                    return true;
+            }
+            return false;
+        }
+    };
+
+    /// @brief Recording decorator for videomancer_fpga
+    ///
+    /// Forwards every call to the wrapped interface unchanged and logs it with a
+    /// timestamp into a spi_trace_writer. Drop it between a controller and the
+    /// real SPI driver to capture what the controller actually sends.
+    class videomancer_fpga_recorder : public videomancer_fpga
+    {
+    public:
+        /// @brief Construct recorder
+        /// @param target Interface that performs the real transfers
+        /// @param clock Time source for event timestamps
+        /// @param trace_buffer Trace storage
+        /// @param trace_capacity Size of trace_buffer in bytes
+        videomancer_fpga_recorder(videomancer_fpga& target,
+                                  videomancer_clock& clock,
+                                  uint8_t* trace_buffer,
+                                  size_t trace_capacity)
+            : m_target(target)
+            , m_clock(clock)
+        {
+            m_writer.begin(trace_buffer, trace_capacity, clock.now_us());
+        }
+
+        size_t transfer_spi(const uint8_t* tx_buffer, uint8_t* rx_buffer, size_t size) override
+        {
+            const uint64_t timestamp = m_clock.now_us();
+            const size_t transferred = m_target.transfer_spi(tx_buffer, rx_buffer, size);
+            m_writer.write_transfer(timestamp, tx_buffer, transferred);
+            return transferred;
+        }
+
+        void assert_chip_select_spi(bool assert) override
+        {
+            m_writer.write_chip_select(m_clock.now_us(), assert);
+            m_target.assert_chip_select_spi(assert);
+        }
+
+        /// @brief Number of valid trace bytes recorded
+        size_t trace_size() const { return m_writer.size(); }
+
+        /// @brief Whether the trace buffer ran out of space
+        bool trace_overflowed() const { return m_writer.overflowed(); }
+
+    private:
+        videomancer_fpga& m_target;
+        videomancer_clock& m_clock;
+        spi_trace_writer m_writer;
+    };
+
+    /// @brief Replay a trace into an FPGA interface or model
+    ///
+    /// Events are issued back-to-back; timestamps are not reproduced.
+    ///
+    /// @param trace Trace data
+    /// @param size Trace size in bytes
+    /// @param target Interface receiving the replayed calls
+    /// @param out_event_count Optional output for number of events replayed
+    /// @return true if the whole trace was replayed
+    inline bool replay_spi_trace(const uint8_t* trace,
+                                 size_t size,
+                                 videomancer_fpga& target,
+                                 size_t* out_event_count = nullptr)
+    {
+        spi_trace_reader reader;
+        size_t count = 0;
+        if (reader.begin(trace, size))
+        {
+            uint8_t rx_discard[16];
+            spi_trace_event event;
+            while (reader.next(event))
+            {
+                switch (event.type)
+                {
+                    case spi_trace_event_type::cs_assert:   target.assert_chip_select_spi(true); break;
+                    case spi_trace_event_type::cs_deassert: target.assert_chip_select_spi(false); break;
+                    case spi_trace_event_type::transfer:    target.transfer_spi(event.data, nullptr, event.size); break;
+                    case spi_trace_event_type::transfer_no_tx:
+                    {
+                        // Clock out the recorded length in small pieces
+                        size_t remaining = event.size;
+                        while (remaining > 0)
+                        {
+                            const size_t n = remaining < sizeof(rx_discard) ? remaining : sizeof(rx_discard);
+                            target.transfer_spi(nullptr, rx_discard, n);
+                            remaining -= n;
+                        }
+                        break;
+                    }
+                }
+                ++count;
+            }
+        }
+
+        if (out_event_count)
+            *out_event_count = count;
+        return !reader.has_error();
+    }
+
+    /// @brief Decode a 16-bit ABI frame
+    /// @param msb First byte on the wire
+    /// @param lsb Second byte on the wire
+    /// @param out_address Receives the 5-bit register address
+    /// @param out_data Receives the 10-bit data value
+    /// @return true if the frame is a write
+    inline bool decode_abi_frame(uint8_t msb, uint8_t lsb, uint8_t& out_address, uint16_t& out_data)
+    {
+        const uint16_t frame = static_cast<uint16_t>((msb << 8) | lsb);
+        out_address = static_cast<uint8_t>((frame >> 10) & 0x1F);
+        out_data = frame & 0x3FF;
+        return (frame & 0x8000) == 0;
+    }
+
+    /// @brief Replay the register writes of a trace through a controller
+    ///
+    /// Every ABI write frame in the trace is re-issued via the matching set
+    /// method, so the controller's own write filtering applies. Useful for
+    /// measuring how a controller change would have altered recorded traffic.
+    ///
+    /// @param trace Trace data
+    /// @param size Trace size in bytes
+    /// @param controller Controller receiving the decoded writes
+    /// @return true if the whole trace was decoded
+    inline bool replay_spi_trace_to_controller(const uint8_t* trace,
+                                               size_t size,
+                                               videomancer_fpga_controller& controller)
+    {
+        spi_trace_reader reader;
+        if (!reader.begin(trace, size))
+            return false;
+
+        spi_trace_event event;
+        while (reader.next(event))
+        {
+            if (event.type != spi_trace_event_type::transfer)
+                continue;
+
+            for (size_t i = 0; i + 1 < event.size; i += 2)
+            {
+                uint8_t address;
+                uint16_t data;
+                if (!decode_abi_frame(event.data[i], event.data[i + 1], address, data))
+                    continue;
+
+                switch (address)
+                {
+                    case videomancer_abi_v1_0::register_address::rotary_pot_1:    controller.set_rotary_pot_1(data); break;
+                    case videomancer_abi_v1_0::register_address::rotary_pot_2:    controller.set_rotary_pot_2(data); break;
+                    case videomancer_abi_v1_0::register_address::rotary_pot_3:    controller.set_rotary_pot_3(data); break;
+                    case videomancer_abi_v1_0::register_address::rotary_pot_4:    controller.set_rotary_pot_4(data); break;
+                    case videomancer_abi_v1_0::register_address::rotary_pot_5:    controller.set_rotary_pot_5(data); break;
+                    case videomancer_abi_v1_0::register_address::rotary_pot_6:    controller.set_rotary_pot_6(data); break;
+                    case videomancer_abi_v1_0::register_address::toggle_switches: controller.set_toggle_switches(data); break;
+                    case videomancer_abi_v1_0::register_address::linear_pot_12:   controller.set_linear_pot_12(data); break;
+                    case videomancer_abi_v1_0::register_address::video_timing_id: controller.set_video_timing_id(static_cast<uint8_t>(data)); break;
+                    default: break;
+                }
+            }
+        }
+
+        return !reader.has_error();
+    }
+
+    /// @brief Aggregate counters extracted from a trace
+    struct spi_trace_stats
+    {
+        uint32_t event_count;            // All decoded events
+        uint32_t transfer_count;         // transfer_spi calls
+        uint32_t cs_assert_count;        // Chip select assertions
+        uint32_t frame_count;            // 16-bit ABI frames
+        uint32_t write_frame_count;      // ABI write frames
+        uint32_t redundant_write_count;  // Writes repeating the last value sent to the same address
+        uint64_t payload_bytes;          // Bytes clocked on the bus
+        uint64_t duration_us;            // Time from trace start to last event
+        uint32_t register_write_counts[32];  // Write frames per register address
+    };
+
+    /// @brief Scan a trace and collect traffic counters
+    /// @param trace Trace data
+    /// @param size Trace size in bytes
+    /// @param out_stats Receives the counters
+    /// @return true if the whole trace was decoded
+    inline bool analyze_spi_trace(const uint8_t* trace, size_t size, spi_trace_stats& out_stats)
+    {
+        out_stats = {};
+
+        spi_trace_reader reader;
+        if (!reader.begin(trace, size))
+            return false;
+
+        uint16_t last_value[32];
+        uint32_t written_mask = 0;
+
+        spi_trace_event event;
+        while (reader.next(event))
+        {
+            ++out_stats.event_count;
+            out_stats.duration_us = event.timestamp_us;
+
+            switch (event.type)
+            {
+                case spi_trace_event_type::cs_assert:
+                    ++out_stats.cs_assert_count;
+                    break;
+                case spi_trace_event_type::cs_deassert:
+                    break;
+                case spi_trace_event_type::transfer_no_tx:
+                    ++out_stats.transfer_count;
+                    out_stats.payload_bytes += event.size;
+                    out_stats.frame_count += static_cast<uint32_t>(event.size / 2);
+                    break;
+                case spi_trace_event_type::transfer:
+                    ++out_stats.transfer_count;
+                    out_stats.payload_bytes += event.size;
+                    for (size_t i = 0; i + 1 < event.size; i += 2)
+                    {
+                        ++out_stats.frame_count;
+
+                        uint8_t address;
+                        uint16_t data;
+                        if (!decode_abi_frame(event.data[i], event.data[i + 1], address, data))
+                            continue;
+
+                        ++out_stats.write_frame_count;
+                        ++out_stats.register_write_counts[address];
+
+                        const uint32_t bit = 1u << address;
+                        if ((written_mask & bit) && last_value[address] == data)
+                            ++out_stats.redundant_write_count;
+                        last_value[address] = data;
+                        written_mask |= bit;
+                    }
+                    break;
+            }
+        }
+
+        return !reader.has_error();
+    }
+
+    /// @brief Bus load of recorded traffic projected onto a video timing mode
+    struct spi_bus_projection
+    {
+        double frames_per_second;       // ABI frames per second of trace time
+        double frames_per_video_frame;  // ABI frames per video frame
+        double cs_per_frame;            // Chip select assertions per ABI frame
+        double cs_overhead_ratio;       // Share of bus time spent on CS setup/hold/gap
+        double bus_us_per_video_frame;  // Bus time consumed per video frame
+        double occupancy;               // bus_us_per_video_frame / frame period (0.0-1.0+)
+    };
+
+    /// @brief Project trace statistics onto a video timing mode
+    ///
+    /// Bus time is modelled as 8 SPI clocks per payload byte plus a fixed
+    /// chip-select cost per assertion (setup + hold + inter-transaction gap,
+    /// 120 ns minimum per docs/abi-format.md).
+    ///
+    /// @param stats Counters from analyze_spi_trace()
+    /// @param timing Video timing mode to project onto
+    /// @param spi_clock_hz SPI clock frequency
+    /// @param cs_overhead_ns Bus time charged per chip select assertion
+    /// @return Projection (all zero if the trace has no duration or timing is reserved)
+    inline spi_bus_projection project_spi_bus_occupancy(const spi_trace_stats& stats,
+                                                        videomancer_abi_v1_0::video_timing_id timing,
+                                                        uint32_t spi_clock_hz,
+                                                        uint32_t cs_overhead_ns = 120)
+    {
+        spi_bus_projection projection = {};
+        const auto& info = videomancer_abi_v1_0::get_video_timing_info(timing);
+        if (stats.duration_us == 0 || spi_clock_hz == 0 || info.frame_rate_num == 0)
+            return projection;
+
+        const double seconds = static_cast<double>(stats.duration_us) / 1e6;
+        const double frame_rate = static_cast<double>(info.frame_rate_num) / info.frame_rate_den;
+        const double video_frames = seconds * frame_rate;
+
+        const double data_us = static_cast<double>(stats.payload_bytes) * 8.0 * 1e6 / spi_clock_hz;
+        const double cs_us = static_cast<double>(stats.cs_assert_count) * cs_overhead_ns / 1e3;
+        const double bus_us = data_us + cs_us;
+
+        projection.frames_per_second = stats.frame_count / seconds;
+        projection.frames_per_video_frame = stats.frame_count / video_frames;
+        projection.cs_per_frame = stats.frame_count ? static_cast<double>(stats.cs_assert_count) / stats.frame_count : 0.0;
+        projection.cs_overhead_ratio = bus_us > 0.0 ? cs_us / bus_us : 0.0;
+        projection.bus_us_per_video_frame = bus_us / video_frames;
+        projection.occupancy = projection.bus_us_per_video_frame * frame_rate / 1e6;
+        return projection;
+    }
+
+} // namespace lzx
@@ -0,0 +1,402 @@
+// Videomancer SDK - Open source FPGA-based video effects development kit
+// Copyright (C) 2025 LZX Industries LLC
+// File: videomancer_timing_detector.hpp - Video Timing Mode Detection
+// License: GNU General Public License v3.0
+// https://github.com/lzxindustries/videomancer-sdk
+//
+// Bit-exact model of video_field_detector.vhd and a streaming classifier that
+// identifies the video_timing_id of a captured sync trace in one pass.
+//
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "videomancer_abi.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace lzx
+{
+    /// @brief Bit-exact model of video_field_detector.vhd
+    ///
+    /// Records the pixel position of each vsync rising edge within the line.
+    /// Matching positions on consecutive fields mean progressive video;
+    /// differing positions mean interlaced video, and an earlier position
+    /// marks the odd field. As in the RTL, the comparison uses the position
+    /// registered at the previous vsync, so outputs settle after three vsyncs.
+    template<uint32_t LineCounterWidth = 12>
+    class video_field_detector_model
+    {
+    public:
+        static_assert(LineCounterWidth > 0 && LineCounterWidth <= 16, "Line counter width must be 1-16 bits");
+
+        video_field_detector_model()
+        {
+            reset();
+        }
+
+        /// @brief Return all registers to their initial values
+        void reset()
+        {
+            m_hsync_prev = true;
+            m_vsync_prev = true;
+            m_pixel_counter = 0;
+            m_vsync_pixel_pos = 0;
+            m_last_vsync_pixel_pos = 0;
+            m_field_parity = false;
+            m_interlaced = false;
+        }
+
+        /// @brief Advance one clock
+        /// @param hsync hsync input level
+        /// @param vsync vsync input level
+        void step(bool hsync, bool vsync)
+        {
+            // Next-state values computed from current register contents
+            uint16_t pixel_counter = static_cast<uint16_t>((m_pixel_counter + 1) & counter_mask);
+            if (!m_hsync_prev && hsync)
+                pixel_counter = 0;
+
+            if (!m_vsync_prev && vsync)
+            {
+                if (m_vsync_pixel_pos < m_last_vsync_pixel_pos)
+                {
+                    m_field_parity = true;
+                    m_interlaced = true;
+                }
+                else
+                {
+                    m_field_parity = false;
+                    m_interlaced = (m_vsync_pixel_pos != m_last_vsync_pixel_pos);
+                }
+                m_last_vsync_pixel_pos = m_vsync_pixel_pos;
+                m_vsync_pixel_pos = m_pixel_counter;
+            }
+
+            m_pixel_counter = pixel_counter;
+            m_hsync_prev = hsync;
+            m_vsync_prev = vsync;
+        }
+
+        /// @brief field_n output (low on the odd field)
+        bool field_n() const { return !m_field_parity; }
+
+        /// @brief is_interlaced output
+        bool is_interlaced() const { return m_interlaced; }
+
+        /// @brief Current pixel counter (clocks since the last hsync rising edge)
+        uint16_t pixel_counter() const { return m_pixel_counter; }
+
+    private:
+        static constexpr uint16_t counter_mask = static_cast<uint16_t>((1u << LineCounterWidth) - 1);
+
+        bool m_hsync_prev;
+        bool m_vsync_prev;
+        uint16_t m_pixel_counter;
+        uint16_t m_vsync_pixel_pos;
+        uint16_t m_last_vsync_pixel_pos;
+        bool m_field_parity;
+        bool m_interlaced;
+    };
+
+    /// @brief Raster signature shared by one or more timing modes
+    struct video_timing_signature
+    {
+        uint32_t key;                // (clocks_per_line << 12) | lines_per_frame
+        uint16_t progressive_mask;   // Progressive modes with this raster, by timing ID
+        uint16_t interlaced_mask;    // Interlaced modes with this raster, by timing ID
+    };
+
+    /// @brief Signature key of a raster
+    constexpr uint32_t make_video_timing_key(uint32_t clocks_per_line, uint32_t lines_per_frame)
+    {
+        return (clocks_per_line << 12) | (lines_per_frame & 0xFFF);
+    }
+
+    /// @brief Number of distinct rasters in the timing table
+    constexpr size_t count_video_timing_signatures()
+    {
+        size_t count = 0;
+        for (uint8_t i = 0; i < 16; ++i)
+        {
+            const auto& t = videomancer_abi_v1_0::video_timing_table[i];
+            if (t.frame_rate_num == 0)
+                continue;
+            bool seen = false;
+            for (uint8_t j = 0; j < i; ++j)
+            {
+                const auto& u = videomancer_abi_v1_0::video_timing_table[j];
+                if (u.frame_rate_num != 0 && u.clocks_per_line == t.clocks_per_line && u.lines_per_frame == t.lines_per_frame)
+                    seen = true;
+            }
+            if (!seen)
+                ++count;
+        }
+        return count;
+    }
+
+    /// @brief Signature table type, sorted by key
+    struct video_timing_signature_table
+    {
+        video_timing_signature entries[count_video_timing_signatures()];
+    };
+
+    /// @brief Build the signature table from the ABI timing table
+    constexpr video_timing_signature_table make_video_timing_signature_table()
+    {
+        video_timing_signature_table table = {};
+        size_t count = 0;
+        for (uint8_t i = 0; i < 16; ++i)
+        {
+            const auto& t = videomancer_abi_v1_0::video_timing_table[i];
+            if (t.frame_rate_num == 0)
+                continue;
+
+            const uint32_t key = make_video_timing_key(t.clocks_per_line, t.lines_per_frame);
+            size_t slot = count;
+            for (size_t j = 0; j < count; ++j)
+            {
+                if (table.entries[j].key == key)
+                    slot = j;
+            }
+            if (slot == count)
+            {
+                table.entries[count] = video_timing_signature{ key, 0, 0 };
+                ++count;
+            }
+            if (t.is_interlaced)
+                table.entries[slot].interlaced_mask = static_cast<uint16_t>(table.entries[slot].interlaced_mask | (1u << i));
+            else
+                table.entries[slot].progressive_mask = static_cast<uint16_t>(table.entries[slot].progressive_mask | (1u << i));
+        }
+
+        // Insertion sort by key for binary search
+        for (size_t i = 1; i < count; ++i)
+        {
+            for (size_t j = i; j > 0 && table.entries[j - 1].key > table.entries[j].key; --j)
+            {
+                const video_timing_signature tmp = table.entries[j];
+                table.entries[j] = table.entries[j - 1];
+                table.entries[j - 1] = tmp;
+            }
+        }
+        return table;
+    }
+
+    /// @brief Raster signatures of all defined timing modes
+    constexpr video_timing_signature_table video_timing_signatures = make_video_timing_signature_table();
+
+    /// @brief Candidate timing modes for a measured raster
+    /// @param clocks_per_line Measured clocks per line
+    /// @param lines_per_frame Measured lines per frame (both fields if interlaced)
+    /// @param is_interlaced Measured scan type
+    /// @return Bit mask of matching timing IDs (0 if none)
+    constexpr uint16_t find_video_timing_candidates(uint32_t clocks_per_line, uint32_t lines_per_frame, bool is_interlaced)
+    {
+        const uint32_t key = make_video_timing_key(clocks_per_line, lines_per_frame);
+        size_t lo = 0;
+        size_t hi = count_video_timing_signatures();
+        while (lo < hi)
+        {
+            const size_t mid = (lo + hi) / 2;
+            const video_timing_signature& s = video_timing_signatures.entries[mid];
+            if (s.key == key)
+                return is_interlaced ? s.interlaced_mask : s.progressive_mask;
+            if (s.key < key)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return 0;
+    }
+
+    /// @brief Narrow candidates by measured frame rate
+    ///
+    /// Picks the candidate whose exact frame rate is closest to
+    /// sample_clock_hz / (clocks_per_line * lines_per_frame), provided it is
+    /// within 0.05% (half the 1000/1001 spacing).
+    ///
+    /// @param candidates Candidate mask from find_video_timing_candidates()
+    /// @param sample_clock_hz Clock rate the trace was sampled at
+    /// @param clocks_per_line Measured clocks per line
+    /// @param lines_per_frame Measured lines per frame
+    /// @return Mask with at most one bit set
+    constexpr uint16_t narrow_video_timing_candidates(uint16_t candidates, uint32_t sample_clock_hz,
+                                                      uint32_t clocks_per_line, uint32_t lines_per_frame)
+    {
+        uint16_t best = 0;
+        uint64_t best_error = ~0ull;
+        const uint64_t samples_per_frame = static_cast<uint64_t>(clocks_per_line) * lines_per_frame;
+        for (uint8_t i = 0; i < 16; ++i)
+        {
+            if (!(candidates & (1u << i)))
+                continue;
+
+            // Compare sample_clock_hz * den against samples_per_frame * num (error in ppm)
+            const auto& t = videomancer_abi_v1_0::video_timing_table[i];
+            const uint64_t measured = static_cast<uint64_t>(sample_clock_hz) * t.frame_rate_den;
+            const uint64_t expected = samples_per_frame * t.frame_rate_num;
+            const uint64_t diff = measured > expected ? measured - expected : expected - measured;
+            const uint64_t error_ppm = expected ? diff * 1000000ull / expected : ~0ull;
+            if (error_ppm <= 500 && error_ppm < best_error)
+            {
+                best_error = error_ppm;
+                best = static_cast<uint16_t>(1u << i);
+            }
+        }
+        return best;
+    }
+
+    /// @brief Result of timing detection
+    struct video_timing_detection
+    {
+        bool locked;                 // Exactly one timing mode matches a stable raster
+        uint16_t candidates;         // All matching timing IDs (bit mask)
+        videomancer_abi_v1_0::video_timing_id id;  // Detected mode (reserved unless locked)
+        uint16_t clocks_per_line;    // Measured clocks per line
+        uint16_t lines_per_frame;    // Measured lines per frame
+        bool is_interlaced;          // From the field detector model
+    };
+
+    /// @brief Streaming video timing detector
+    ///
+    /// Feed one hsync/vsync sample per clock. Line length and field length
+    /// are measured with simple counters, scan type comes from the field
+    /// detector model, and each completed frame is classified with a single
+    /// signature lookup. Work per sample is O(1). A result locks once two
+    /// consecutive frames measure the same raster.
+    ///
+    /// Rasters shared by several modes (e.g. 1080p30 and 1080p29.97) can only
+    /// be separated by frame rate; pass the trace sample clock to enable that.
+    class video_timing_detector
+    {
+    public:
+        /// @brief Construct detector
+        /// @param sample_clock_hz Sample clock of the trace (0 if unknown)
+        explicit video_timing_detector(uint32_t sample_clock_hz = 0)
+            : m_sample_clock_hz(sample_clock_hz)
+        {
+            reset();
+        }
+
+        /// @brief Forget all measurements
+        void reset()
+        {
+            m_field_detector.reset();
+            m_hsync_prev = true;
+            m_vsync_prev = true;
+            m_line_clocks = 0;
+            m_clocks_per_line = 0;
+            m_field_lines = 0;
+            m_previous_field_lines = 0;
+            m_vsync_count = 0;
+            m_last_key = 0;
+            m_stable_frames = 0;
+            m_result = video_timing_detection{ false, 0, videomancer_abi_v1_0::video_timing_id::reserved, 0, 0, false };
+        }
+
+        /// @brief Advance one clock
+        /// @param hsync hsync level (measured on rising edges, as the RTL does)
+        /// @param vsync vsync level (measured on rising edges)
+        /// @return true if this sample completed a frame measurement
+        bool step(bool hsync, bool vsync)
+        {
+            m_field_detector.step(hsync, vsync);
+            ++m_line_clocks;
+
+            if (!m_hsync_prev && hsync)
+            {
+                m_clocks_per_line = m_line_clocks;
+                m_line_clocks = 0;
+                ++m_field_lines;
+            }
+
+            bool measured = false;
+            if (!m_vsync_prev && vsync)
+            {
+                measured = end_field();
+            }
+
+            m_hsync_prev = hsync;
+            m_vsync_prev = vsync;
+            return measured;
+        }
+
+        /// @brief Latest classification
+        const video_timing_detection& result() const { return m_result; }
+
+        /// @brief Whether a unique timing mode has been identified
+        bool is_locked() const { return m_result.locked; }
+
+    private:
+        video_field_detector_model<12> m_field_detector;
+        uint32_t m_sample_clock_hz;
+        bool m_hsync_prev;
+        bool m_vsync_prev;
+        uint32_t m_line_clocks;
+        uint32_t m_clocks_per_line;
+        uint32_t m_field_lines;
+        uint32_t m_previous_field_lines;
+        uint32_t m_vsync_count;
+        uint32_t m_last_key;
+        uint32_t m_stable_frames;
+        video_timing_detection m_result;
+
+        bool end_field()
+        {
+            const uint32_t field_lines = m_field_lines;
+            const uint32_t previous = m_previous_field_lines;
+            m_previous_field_lines = field_lines;
+            m_field_lines = 0;
+
+            // The first vsync only starts counting; the field detector needs three
+            if (++m_vsync_count < 3)
+                return false;
+
+            const bool interlaced = m_field_detector.is_interlaced();
+
+            // Interlaced frames span two fields; classify once per frame
+            if (interlaced && m_field_detector.field_n())
+                return false;
+            const uint32_t lines = interlaced ? field_lines + previous : field_lines;
+
+            const uint32_t key = make_video_timing_key(m_clocks_per_line, lines) ^ (interlaced ? 1u << 31 : 0u);
+            m_stable_frames = (key == m_last_key) ? m_stable_frames + 1 : 0;
+            m_last_key = key;
+
+            uint16_t candidates = find_video_timing_candidates(m_clocks_per_line, lines, interlaced);
+            if (m_sample_clock_hz != 0 && (candidates & (candidates - 1)) != 0)
+                candidates = narrow_video_timing_candidates(candidates, m_sample_clock_hz, m_clocks_per_line, lines);
+
+            const bool unique = candidates != 0 && (candidates & (candidates - 1)) == 0;
+            uint8_t id = 15;
+            if (unique)
+            {
+                id = 0;
+                while (!(candidates & (1u << id)))
+                    ++id;
+            }
+
+            m_result.locked = unique && m_stable_frames >= 1;
+            m_result.candidates = candidates;
+            m_result.id = m_result.locked ? static_cast<videomancer_abi_v1_0::video_timing_id>(id)
+                                          : videomancer_abi_v1_0::video_timing_id::reserved;
+            m_result.clocks_per_line = static_cast<uint16_t>(m_clocks_per_line);
+            m_result.lines_per_frame = static_cast<uint16_t>(lines);
+            m_result.is_interlaced = interlaced;
+            return true;
+        }
+    };
+
+} // namespace lzx
@@ -0,0 +1,538 @@
+// Videomancer SDK - Open source FPGA-based video effects development kit
+// Copyright (C) 2025 LZX Industries LLC
+// File: videomancer_video_model.hpp - Video Stream Models and Frame Buffers
+// License: GNU General Public License v3.0
+// https://github.com/lzxindustries/videomancer-sdk
+//
+// Bit-exact C++ models of the common video stream RTL, a frame buffer that
+// stores only the active raster and a field buffer that streams interlaced
+// video one field at a time. Mirrors fpga/common/rtl/video_stream and
+// fpga/common/rtl/video_sync.
+//
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "videomancer_abi.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace lzx
+{
+    /// @brief One clock of a t_video_stream_yuv444_30b stream (video_stream_pkg.vhd)
+    struct yuv444_30b_sample
+    {
+        uint16_t y;      // 10-bit luma
+        uint16_t u;      // 10-bit Cb
+        uint16_t v;      // 10-bit Cr
+        bool avid;       // Active video
+        bool hsync_n;    // Horizontal sync (active low)
+        bool vsync_n;    // Vertical sync (active low)
+        bool field_n;    // Field indicator (active low)
+    };
+
+    /// @brief Blanking levels driven outside avid
+    namespace yuv444_30b_blanking_level
+    {
+        constexpr uint16_t y = 0;
+        constexpr uint16_t u = 512;
+        constexpr uint16_t v = 512;
+    }
+
+    /// @brief Bit-exact model of yuv444_30b_blanking.vhd
+    ///
+    /// Two register stages: the input register and the output register.
+    /// data_out after a rising edge reflects the input sampled one edge
+    /// earlier, so a sample passed to step() is returned by the next call;
+    /// counted from the upstream register that launches it, this is the
+    /// 2-clock delay of the RTL. y/u/v are forced to blanking level whenever
+    /// avid is low, and sync flags are delayed by the same amount. Both stages
+    /// power up as a blanked sample with all syncs inactive.
+    class yuv444_30b_blanking_model
+    {
+    public:
+        /// @brief Pipeline delay in clocks (register stages)
+        static constexpr uint32_t latency_clocks = 2;
+
+        yuv444_30b_blanking_model()
+        {
+            reset();
+        }
+
+        /// @brief Return both register stages to their power-up value
+        void reset()
+        {
+            const yuv444_30b_sample idle = { yuv444_30b_blanking_level::y,
+                                             yuv444_30b_blanking_level::u,
+                                             yuv444_30b_blanking_level::v,
+                                             false, true, true, true };
+            m_data_reg = idle;
+            m_data_out = idle;
+        }
+
+        /// @brief Advance one clock
+        /// @param data_in Sample presented before the rising edge
+        /// @return data_out after the rising edge
+        yuv444_30b_sample step(const yuv444_30b_sample& data_in)
+        {
+            m_data_out = blank(m_data_reg);
+            m_data_reg = data_in;
+            return m_data_out;
+        }
+
+        /// @brief Current data_out
+        const yuv444_30b_sample& output() const { return m_data_out; }
+
+        /// @brief Combinational blanking function (no delay)
+        /// @param sample Input sample
+        /// @return Sample with y/u/v forced to blanking level outside avid
+        static constexpr yuv444_30b_sample blank(const yuv444_30b_sample& sample)
+        {
+            return sample.avid
+                ? yuv444_30b_sample{ static_cast<uint16_t>(sample.y & 0x3FF),
+                                     static_cast<uint16_t>(sample.u & 0x3FF),
+                                     static_cast<uint16_t>(sample.v & 0x3FF),
+                                     true, sample.hsync_n, sample.vsync_n, sample.field_n }
+                : yuv444_30b_sample{ yuv444_30b_blanking_level::y,
+                                     yuv444_30b_blanking_level::u,
+                                     yuv444_30b_blanking_level::v,
+                                     false, sample.hsync_n, sample.vsync_n, sample.field_n };
+        }
+
+    private:
+        yuv444_30b_sample m_data_reg;
+        yuv444_30b_sample m_data_out;
+    };
+
+    /// @brief Raster and active-region sizes of a timing mode
+    struct video_blanking_info
+    {
+        uint16_t h_blank_clocks;    // Clocks per line outside the active region
+        uint16_t v_blank_lines;     // Lines per frame outside the active region
+        uint32_t raster_samples;    // clocks_per_line * lines_per_frame
+        uint32_t active_samples;    // frame_width * frame_height
+    };
+
+    /// @brief Derive blanking spans from the timing table
+    /// @param id Video timing mode
+    /// @return Blanking info (all zero for reserved)
+    constexpr video_blanking_info make_video_blanking_info(videomancer_abi_v1_0::video_timing_id id)
+    {
+        const videomancer_abi_v1_0::video_timing_info& t = videomancer_abi_v1_0::get_video_timing_info(id);
+        return video_blanking_info{
+            static_cast<uint16_t>(t.clocks_per_line - t.frame_width),
+            static_cast<uint16_t>(t.lines_per_frame - t.frame_height),
+            static_cast<uint32_t>(t.clocks_per_line) * t.lines_per_frame,
+            static_cast<uint32_t>(t.frame_width) * t.frame_height
+        };
+    }
+
+    /// @brief Blanking spans indexed by video_timing_id
+    constexpr video_blanking_info video_blanking_table[16] =
+    {
+        make_video_blanking_info(videomancer_abi_v1_0::video_timing_id::ntsc),
+        make_video_blanking_info(videomancer_abi_v1_0::video_timing_id::_1080i50),
+        make_video_blanking_info(videomancer_abi_v1_0::video_timing_id::_1080i5994),
+        make_video_blanking_info(videomancer_abi_v1_0::video_timing_id::_1080p24),
+        make_video_blanking_info(videomancer_abi_v1_0::video_timing_id::_480p),
+        make_video_blanking_info(videomancer_abi_v1_0::video_timing_id::_720p50),
+        make_video_blanking_info(videomancer_abi_v1_0::video_timing_id::_720p5994),
+        make_video_blanking_info(videomancer_abi_v1_0::video_timing_id::_1080p30),
+        make_video_blanking_info(videomancer_abi_v1_0::video_timing_id::pal),
+        make_video_blanking_info(videomancer_abi_v1_0::video_timing_id::_1080p2398),
+        make_video_blanking_info(videomancer_abi_v1_0::video_timing_id::_1080i60),
+        make_video_blanking_info(videomancer_abi_v1_0::video_timing_id::_1080p25),
+        make_video_blanking_info(videomancer_abi_v1_0::video_timing_id::_576p),
+        make_video_blanking_info(videomancer_abi_v1_0::video_timing_id::_1080p2997),
+        make_video_blanking_info(videomancer_abi_v1_0::video_timing_id::_720p60),
+        make_video_blanking_info(videomancer_abi_v1_0::video_timing_id::reserved),
+    };
+
+    /// @brief Look up blanking spans for a timing mode
+    constexpr const video_blanking_info& get_video_blanking_info(videomancer_abi_v1_0::video_timing_id id)
+    {
+        return video_blanking_table[static_cast<uint8_t>(id) & 0xF];
+    }
+
+    /// @brief Planar 10-bit frame buffer holding only the active raster
+    ///
+    /// Storage is supplied by the caller: three planes of
+    /// required_samples(timing) entries each. Samples are pushed in raster
+    /// order straight from a video stream; blanking samples (avid low) are
+    /// dropped, and a falling vsync_n edge starts a new frame. Reading back a
+    /// full raster returns the blanking level for any position outside the
+    /// active region, so blanking is never stored or processed.
+    class yuv444_30b_active_frame
+    {
+    public:
+        /// @brief Samples per plane needed for a timing mode
+        static constexpr size_t required_samples(videomancer_abi_v1_0::video_timing_id id)
+        {
+            return get_video_blanking_info(id).active_samples;
+        }
+
+        /// @brief Attach caller storage
+        /// @param id Video timing mode
+        /// @param y Luma plane
+        /// @param u Cb plane
+        /// @param v Cr plane
+        /// @param capacity Samples available in each plane
+        /// @return false if the mode is reserved or capacity is too small
+        bool attach(videomancer_abi_v1_0::video_timing_id id,
+                    uint16_t* y, uint16_t* u, uint16_t* v, size_t capacity)
+        {
+            m_y = m_u = m_v = nullptr;
+            m_width = m_height = 0;
+            reset_stream();
+
+            if (!videomancer_abi_v1_0::is_video_timing_defined(id) || !y || !u || !v ||
+                capacity < required_samples(id))
+                return false;
+
+            const videomancer_abi_v1_0::video_timing_info& t = videomancer_abi_v1_0::get_video_timing_info(id);
+            m_y = y;
+            m_u = u;
+            m_v = v;
+            m_width = t.frame_width;
+            m_height = t.frame_height;
+            return true;
+        }
+
+        /// @brief Forget stream position (next vsync starts a frame)
+        void reset_stream()
+        {
+            m_write_index = 0;
+            m_vsync_prev = true;
+            m_synced = false;
+            m_frames_completed = 0;
+            m_overflow_samples = 0;
+        }
+
+        /// @brief Push one raster sample
+        /// @param sample Stream sample (blanking samples are ignored)
+        void push(const yuv444_30b_sample& sample)
+        {
+            if (m_vsync_prev && !sample.vsync_n)
+            {
+                m_write_index = 0;
+                m_synced = true;
+            }
+            m_vsync_prev = sample.vsync_n;
+
+            if (!sample.avid || !m_synced)
+                return;
+
+            if (m_write_index >= active_samples())
+            {
+                ++m_overflow_samples;
+                return;
+            }
+
+            m_y[m_write_index] = sample.y & 0x3FF;
+            m_u[m_write_index] = sample.u & 0x3FF;
+            m_v[m_write_index] = sample.v & 0x3FF;
+            if (++m_write_index == active_samples())
+                ++m_frames_completed;
+        }
+
+        /// @brief Push a run of raster samples
+        void push(const yuv444_30b_sample* samples, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+                push(samples[i]);
+        }
+
+        /// @brief Store a full active line directly (no stream parsing)
+        /// @param line Active line index
+        /// @param y Luma samples (width() entries)
+        /// @param u Cb samples
+        /// @param v Cr samples
+        /// @return false if line is out of range
+        bool write_line(uint16_t line, const uint16_t* y, const uint16_t* u, const uint16_t* v)
+        {
+            if (line >= m_height)
+                return false;
+            const size_t offset = static_cast<size_t>(line) * m_width;
+            for (uint16_t x = 0; x < m_width; ++x)
+            {
+                m_y[offset + x] = y[x] & 0x3FF;
+                m_u[offset + x] = u[x] & 0x3FF;
+                m_v[offset + x] = v[x] & 0x3FF;
+            }
+            return true;
+        }
+
+        /// @brief Read a sample by raster position
+        /// @param line Line within the raster (active region first, then blanking)
+        /// @param clock Clock within the line (active region first, then blanking)
+        /// @return Stored sample, or the blanking level outside the active region
+        yuv444_30b_sample read_raster(uint16_t line, uint16_t clock) const
+        {
+            if (line >= m_height || clock >= m_width)
+                return yuv444_30b_blanking_model::blank(yuv444_30b_sample{ 0, 0, 0, false, true, true, true });
+
+            const size_t i = static_cast<size_t>(line) * m_width + clock;
+            return yuv444_30b_sample{ m_y[i], m_u[i], m_v[i], true, true, true, true };
+        }
+
+        uint16_t width() const { return m_width; }
+        uint16_t height() const { return m_height; }
+        size_t active_samples() const { return static_cast<size_t>(m_width) * m_height; }
+        const uint16_t* y_plane() const { return m_y; }
+        const uint16_t* u_plane() const { return m_u; }
+        const uint16_t* v_plane() const { return m_v; }
+
+        /// @brief Active samples stored in the current frame
+        size_t samples_written() const { return m_write_index; }
+
+        /// @brief Number of frames filled completely
+        uint32_t frames_completed() const { return m_frames_completed; }
+
+        /// @brief Active samples dropped because a frame carried more than expected
+        uint32_t overflow_samples() const { return m_overflow_samples; }
+
+    private:
+        uint16_t* m_y = nullptr;
+        uint16_t* m_u = nullptr;
+        uint16_t* m_v = nullptr;
+        uint16_t m_width = 0;
+        uint16_t m_height = 0;
+        size_t m_write_index = 0;
+        bool m_vsync_prev = true;
+        bool m_synced = false;
+        uint32_t m_frames_completed = 0;
+        uint32_t m_overflow_samples = 0;
+    };
+
+    /// @brief Field structure of a timing mode
+    ///
+    /// Interlaced modes carry two fields per frame; the first field takes the
+    /// extra line when lines_per_frame is odd. Progressive modes are a single
+    /// field holding every frame row.
+    struct video_field_layout
+    {
+        uint8_t field_count;        // 1 progressive, 2 interlaced
+        uint16_t field_lines[2];    // Raster lines per field (second is 0 when progressive)
+        uint16_t active_lines;      // Active lines per field
+        bool first_field_top;       // First field carries frame rows 0, 2, 4...
+    };
+
+    /// @brief Derive the field structure from the timing table
+    /// @param id Video timing mode
+    /// @return Field layout (all zero lines for reserved)
+    constexpr video_field_layout make_video_field_layout(videomancer_abi_v1_0::video_timing_id id)
+    {
+        const videomancer_abi_v1_0::video_timing_info& t = videomancer_abi_v1_0::get_video_timing_info(id);
+        return t.is_interlaced
+            ? video_field_layout{ 2,
+                                  { static_cast<uint16_t>((t.lines_per_frame + 1) / 2),
+                                    static_cast<uint16_t>(t.lines_per_frame / 2) },
+                                  static_cast<uint16_t>(t.frame_height / 2),
+                                  t.top_field_first }
+            : video_field_layout{ 1, { t.lines_per_frame, 0 }, t.frame_height, true };
+    }
+
+    /// @brief Frame row of an active line within a field
+    /// @param layout Field layout
+    /// @param field Field index in transmission order (0 or 1)
+    /// @param active_line Active line within the field
+    constexpr uint16_t video_field_row(const video_field_layout& layout, uint8_t field, uint16_t active_line)
+    {
+        return layout.field_count == 1
+            ? active_line
+            : static_cast<uint16_t>(active_line * 2 + (((field == 0) == layout.first_field_top) ? 0 : 1));
+    }
+
+    class yuv444_30b_active_field;
+
+    /// @brief Receives each field as soon as its last active sample arrives
+    class yuv444_30b_field_processor
+    {
+    public:
+        virtual ~yuv444_30b_field_processor() = default;
+
+        /// @brief Process a completed field
+        /// @param field Field buffer (valid until the next field starts)
+        virtual void process_field(const yuv444_30b_active_field& field) = 0;
+    };
+
+    /// @brief Planar 10-bit buffer holding the active lines of one field
+    ///
+    /// The field-at-a-time counterpart of yuv444_30b_active_frame. Each
+    /// falling vsync_n edge starts a field; the field's field_n is taken from
+    /// its first active sample, after video_field_detector has updated it on
+    /// the preceding vsync rising edge. With the detector's one-field lag,
+    /// field_n is low during the first field of a frame and high during the
+    /// second (and always high for progressive video). The processor is
+    /// called when the last active line arrives, so interlaced video is
+    /// handled with half a frame of storage and half a frame of latency.
+    class yuv444_30b_active_field
+    {
+    public:
+        /// @brief Samples per plane needed for a timing mode
+        static constexpr size_t required_samples(videomancer_abi_v1_0::video_timing_id id)
+        {
+            return static_cast<size_t>(videomancer_abi_v1_0::get_video_timing_info(id).frame_width) *
+                   make_video_field_layout(id).active_lines;
+        }
+
+        /// @brief Attach caller storage
+        /// @param id Video timing mode
+        /// @param y Luma plane
+        /// @param u Cb plane
+        /// @param v Cr plane
+        /// @param capacity Samples available in each plane
+        /// @return false if the mode is reserved or capacity is too small
+        bool attach(videomancer_abi_v1_0::video_timing_id id,
+                    uint16_t* y, uint16_t* u, uint16_t* v, size_t capacity)
+        {
+            m_y = m_u = m_v = nullptr;
+            m_width = 0;
+            m_layout = video_field_layout{ 0, { 0, 0 }, 0, true };
+            reset_stream();
+
+            if (!videomancer_abi_v1_0::is_video_timing_defined(id) || !y || !u || !v ||
+                capacity < required_samples(id))
+                return false;
+
+            m_y = y;
+            m_u = u;
+            m_v = v;
+            m_width = videomancer_abi_v1_0::get_video_timing_info(id).frame_width;
+            m_layout = make_video_field_layout(id);
+            return true;
+        }
+
+        /// @brief Set the processor called on each completed field (nullptr to poll)
+        void set_processor(yuv444_30b_field_processor* processor) { m_processor = processor; }
+
+        /// @brief Forget stream position (next vsync starts a field)
+        void reset_stream()
+        {
+            m_write_index = 0;
+            m_vsync_prev = true;
+            m_synced = false;
+            m_field_started = false;
+            m_field_n = true;
+            m_fields_completed = 0;
+            m_overflow_samples = 0;
+        }
+
+        /// @brief Push one raster sample
+        /// @param sample Stream sample (blanking samples are ignored)
+        void push(const yuv444_30b_sample& sample)
+        {
+            if (m_vsync_prev && !sample.vsync_n)
+            {
+                m_write_index = 0;
+                m_synced = true;
+                m_field_started = false;
+            }
+            m_vsync_prev = sample.vsync_n;
+
+            if (!sample.avid || !m_synced)
+                return;
+
+            if (!m_field_started)
+            {
+                m_field_n = sample.field_n;
+                m_field_started = true;
+            }
+
+            if (m_write_index >= active_samples())
+            {
+                ++m_overflow_samples;
+                return;
+            }
+
+            m_y[m_write_index] = sample.y & 0x3FF;
+            m_u[m_write_index] = sample.u & 0x3FF;
+            m_v[m_write_index] = sample.v & 0x3FF;
+            if (++m_write_index == active_samples())
+            {
+                ++m_fields_completed;
+                if (m_processor)
+                    m_processor->process_field(*this);
+            }
+        }
+
+        /// @brief Push a run of raster samples
+        void push(const yuv444_30b_sample* samples, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+                push(samples[i]);
+        }
+
+        /// @brief field_n of the current field
+        bool field_n() const { return m_field_n; }
+
+        /// @brief Field index in transmission order (0 first, 1 second)
+        uint8_t field_index() const { return (m_layout.field_count == 2 && m_field_n) ? 1 : 0; }
+
+        /// @brief Whether the current field carries the even frame rows
+        bool is_top_field() const { return video_field_row(m_layout, field_index(), 0) == 0; }
+
+        /// @brief Frame row of an active line of the current field
+        uint16_t frame_row(uint16_t line) const { return video_field_row(m_layout, field_index(), line); }
+
+        /// @brief Copy the current field into its rows of a full frame
+        /// @param frame Frame to update (attached to the same timing mode)
+        /// @return false if the field is incomplete or the frame size differs
+        bool weave_into(yuv444_30b_active_frame& frame) const
+        {
+            if (m_write_index != active_samples() || frame.width() != m_width ||
+                frame.height() < static_cast<size_t>(m_layout.active_lines) * m_layout.field_count)
+                return false;
+            for (uint16_t line = 0; line < m_layout.active_lines; ++line)
+            {
+                const size_t offset = static_cast<size_t>(line) * m_width;
+                frame.write_line(frame_row(line), m_y + offset, m_u + offset, m_v + offset);
+            }
+            return true;
+        }
+
+        const video_field_layout& layout() const { return m_layout; }
+        uint16_t width() const { return m_width; }
+        uint16_t lines() const { return m_layout.active_lines; }
+        size_t active_samples() const { return static_cast<size_t>(m_width) * m_layout.active_lines; }
+        const uint16_t* y_plane() const { return m_y; }
+        const uint16_t* u_plane() const { return m_u; }
+        const uint16_t* v_plane() const { return m_v; }
+
+        /// @brief Active samples stored in the current field
+        size_t samples_written() const { return m_write_index; }
+
+        /// @brief Number of fields filled completely
+        uint32_t fields_completed() const { return m_fields_completed; }
+
+        /// @brief Active samples dropped because a field carried more than expected
+        uint32_t overflow_samples() const { return m_overflow_samples; }
+
+    private:
+        uint16_t* m_y = nullptr;
+        uint16_t* m_u = nullptr;
+        uint16_t* m_v = nullptr;
+        uint16_t m_width = 0;
+        video_field_layout m_layout = { 0, { 0, 0 }, 0, true };
+        yuv444_30b_field_processor* m_processor = nullptr;
+        size_t m_write_index = 0;
+        bool m_vsync_prev = true;
+        bool m_synced = false;
+        bool m_field_started = false;
+        bool m_field_n = true;
+        uint32_t m_fields_completed = 0;
+        uint32_t m_overflow_samples = 0;
+    };
+
+} // namespace lzx
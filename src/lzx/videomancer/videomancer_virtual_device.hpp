@@ -0,0 +1,627 @@
+// Videomancer SDK - Open source FPGA-based video effects development kit
+// Copyright (C) 2025 LZX Industries LLC
+// File: videomancer_virtual_device.hpp - Virtual Videomancer Device Emulator
+// License: GNU General Public License v3.0
+// https://github.com/lzxindustries/videomancer-sdk
+//
+// Host-side model of the FPGA control path: decodes ABI frames into a staged
+// register file, latches it on every hsync like core_top, runs a program model
+// over each active line and measures register-to-pixel latency. On POSIX hosts
+// the device can be driven over a stream socket so that control software runs
+// unmodified against virtual units. For protocol specification, see:
+// docs/abi-format.md
+//
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// Socket Wire Format (reuses the spi_trace event tags):
+//   0x01                  chip select asserted
+//   0x02                  chip select de-asserted
+//   0x03 [len u8] [bytes] transfer of len bytes (1-255)
+
+#pragma once
+
+#include "videomancer_fpga.hpp"
+#include "videomancer_abi.hpp"
+#include "videomancer_clock.hpp"
+#include "videomancer_video_model.hpp"
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define VIDEOMANCER_VIRTUAL_DEVICE_HAS_SOCKETS 1
+#ifdef MSG_NOSIGNAL
+#define VIDEOMANCER_SOCKET_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define VIDEOMANCER_SOCKET_SEND_FLAGS 0
+#endif
+#endif
+
+namespace lzx
+{
+    /// @brief Number of registers copied to the program on hsync (core_top)
+    constexpr uint8_t videomancer_latched_register_count = 9;
+
+    /// @brief Register write waiting for the next hsync latch
+    struct videomancer_register_write
+    {
+        uint64_t time_us;  // Arrival time (0 without a clock)
+        uint8_t address;
+        uint16_t value;
+    };
+
+    /// @brief Model of the FPGA SPI peripheral and register RAM
+    ///
+    /// Accepts one write frame per chip select assertion, as the RTL
+    /// spi_peripheral does; further bytes within the same assertion are
+    /// ignored. Writes land in the staged RAM at once and are queued with
+    /// their arrival time; they become visible to the program only when a
+    /// latch (the hsync copy in core_top) at or after that time takes them.
+    class videomancer_register_model : public videomancer_fpga
+    {
+    public:
+        /// @brief Queued writes kept before the oldest is latched early
+        static constexpr uint32_t write_queue_size = 256;
+
+        /// @brief Construct register model
+        /// @param clock Time source stamping each write as it arrives (nullptr stamps 0)
+        explicit videomancer_register_model(videomancer_clock* clock = nullptr)
+            : m_clock(clock)
+        {
+            reset();
+        }
+
+        /// @brief Clear all registers and counters
+        void reset()
+        {
+            for (uint8_t i = 0; i < 32; ++i)
+            {
+                m_staged[i] = 0;
+                m_active[i] = 0;
+            }
+            m_frame_bytes = 0;
+            m_cs_asserted = false;
+            m_accepted_writes = 0;
+            m_ignored_frames = 0;
+            m_queue_head = 0;
+            m_queue_count = 0;
+        }
+
+        size_t transfer_spi(const uint8_t* tx_buffer, uint8_t* rx_buffer, size_t size) override
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (m_cs_asserted && m_frame_bytes < 2 && tx_buffer)
+                    m_frame[m_frame_bytes] = tx_buffer[i];
+                if (m_cs_asserted && m_frame_bytes < 0xFF)
+                    ++m_frame_bytes;
+                if (rx_buffer)
+                    rx_buffer[i] = 0;  // SDO is not connected in core_top
+            }
+            return size;
+        }
+
+        void assert_chip_select_spi(bool assert) override
+        {
+            if (assert && !m_cs_asserted)
+            {
+                m_frame_bytes = 0;
+            }
+            else if (!assert && m_cs_asserted)
+            {
+                if (m_frame_bytes >= 2)
+                    decode_frame();
+                else
+                    ++m_ignored_frames;
+            }
+            m_cs_asserted = assert;
+        }
+
+        /// @brief Latch every write that arrived at or before a time (hsync)
+        /// @param until_us Latch time; later writes stay queued
+        /// @return Bit mask of latched registers whose value changed
+        uint32_t latch_registers(uint64_t until_us = ~0ull)
+        {
+            uint16_t before[videomancer_latched_register_count];
+            for (uint8_t i = 0; i < videomancer_latched_register_count; ++i)
+                before[i] = m_active[i];
+
+            videomancer_register_write write;
+            while (latch_next_write(until_us, write))
+            {
+            }
+
+            uint32_t changed = 0;
+            for (uint8_t i = 0; i < videomancer_latched_register_count; ++i)
+            {
+                if (m_active[i] != before[i])
+                    changed |= 1u << i;
+            }
+            return changed;
+        }
+
+        /// @brief Latch the oldest queued write if it arrived at or before a time
+        /// @param until_us Latch time
+        /// @param out_write Receives the latched write
+        /// @return false if the queue is empty or its oldest write is later
+        bool latch_next_write(uint64_t until_us, videomancer_register_write& out_write)
+        {
+            if (m_queue_count == 0 || m_queue[m_queue_head].time_us > until_us)
+                return false;
+            out_write = m_queue[m_queue_head];
+            apply(out_write);
+            m_queue_head = (m_queue_head + 1) % write_queue_size;
+            --m_queue_count;
+            return true;
+        }
+
+        /// @brief Value written over SPI, not yet necessarily visible
+        uint16_t get_staged_register(uint8_t address) const { return m_staged[address & 0x1F]; }
+
+        /// @brief Value currently seen by the program
+        uint16_t get_active_register(uint8_t address) const { return m_active[address & 0x1F]; }
+
+        /// @brief Program-visible register set
+        const uint16_t* active_registers() const { return m_active; }
+
+        /// @brief Bit mask of registers with a queued write
+        uint32_t pending_mask() const
+        {
+            uint32_t mask = 0;
+            for (uint32_t i = 0; i < m_queue_count; ++i)
+                mask |= 1u << m_queue[(m_queue_head + i) % write_queue_size].address;
+            return mask;
+        }
+
+        /// @brief Number of write frames accepted
+        uint32_t accepted_write_count() const { return m_accepted_writes; }
+
+        /// @brief Number of CS assertions that did not carry a usable write frame
+        uint32_t ignored_frame_count() const { return m_ignored_frames; }
+
+    private:
+        videomancer_clock* m_clock;
+        uint16_t m_staged[32];
+        uint16_t m_active[32];
+        uint8_t m_frame[2] = { 0, 0 };
+        uint8_t m_frame_bytes;
+        bool m_cs_asserted;
+        uint32_t m_accepted_writes;
+        uint32_t m_ignored_frames;
+        videomancer_register_write m_queue[write_queue_size];
+        uint32_t m_queue_head;
+        uint32_t m_queue_count;
+
+        void apply(const videomancer_register_write& write)
+        {
+            if (write.address < videomancer_latched_register_count)
+                m_active[write.address] = write.value;
+        }
+
+        void decode_frame()
+        {
+            const uint16_t frame = static_cast<uint16_t>((m_frame[0] << 8) | m_frame[1]);
+            if (frame & 0x8000)
+            {
+                ++m_ignored_frames;  // Reads are not wired in core_top
+                return;
+            }
+
+            const uint8_t address = static_cast<uint8_t>((frame >> 10) & 0x1F);
+            m_staged[address] = frame & 0x3FF;
+            ++m_accepted_writes;
+
+            // A full queue means nothing has latched for a long time: the oldest write goes early
+            if (m_queue_count == write_queue_size)
+            {
+                apply(m_queue[m_queue_head]);
+                m_queue_head = (m_queue_head + 1) % write_queue_size;
+                --m_queue_count;
+            }
+            videomancer_register_write& write = m_queue[(m_queue_head + m_queue_count) % write_queue_size];
+            write.time_us = m_clock ? m_clock->now_us() : 0;
+            write.address = address;
+            write.value = m_staged[address];
+            ++m_queue_count;
+        }
+    };
+
+    /// @brief One active line of 10-bit YUV 4:4:4 samples, processed in place
+    struct videomancer_line
+    {
+        uint16_t* y;
+        uint16_t* u;
+        uint16_t* v;
+        uint16_t width;
+        uint16_t line_number;  // Frame row (interlaced fields fill alternate rows)
+        bool field_n;          // Low in the first field of an interlaced frame, as video_field_detector
+    };
+
+    /// @brief C++ model of a program pipeline
+    ///
+    /// Implementations mirror a program_top entity: they see the latched
+    /// register set and transform one active line at a time.
+    class videomancer_program_model
+    {
+    public:
+        virtual ~videomancer_program_model() = default;
+
+        /// @brief Process one active line in place
+        /// @param registers Latched register set (videomancer_latched_register_count entries)
+        /// @param line Line samples
+        virtual void process_line(const uint16_t* registers, videomancer_line& line) = 0;
+
+        /// @brief Pipeline delay from input to output in pixel clocks
+        virtual uint32_t latency_clocks() const { return 0; }
+    };
+
+    /// @brief Program model that passes video through unchanged
+    class videomancer_passthru_model : public videomancer_program_model
+    {
+    public:
+        void process_line(const uint16_t*, videomancer_line&) override {}
+    };
+
+    /// @brief Register-to-pixel latency statistics in microseconds
+    struct videomancer_latency_stats
+    {
+        uint32_t sample_count;
+        uint64_t min_us;
+        uint64_t max_us;
+        uint64_t total_us;
+
+        /// @brief Mean latency, 0 when no samples were taken
+        uint64_t mean_us() const { return sample_count ? total_us / sample_count : 0; }
+    };
+
+    /// @brief Frame buffer supplied by the caller (one plane per component)
+    ///
+    /// Each plane holds frame_width * frame_height samples of the selected
+    /// timing mode. Planes are filled with a luma ramp and neutral chroma
+    /// before each frame, then processed by the program model.
+    struct videomancer_frame_buffer
+    {
+        uint16_t* y;
+        uint16_t* u;
+        uint16_t* v;
+    };
+
+    /// @brief Virtual Videomancer unit
+    ///
+    /// Combines the register model with a raster clocked from a
+    /// videomancer_clock. Writes are stamped from the same clock as they
+    /// arrive. advance() runs every line whose start time has passed: each
+    /// line start latches the writes that arrived before it, active lines go
+    /// through the program model, and the first line to carry a newly written
+    /// value produces a register-to-pixel latency sample. Interlaced modes are run
+    /// field by field in transmission order, so each line reaches the
+    /// program as it arrives and lands on its own frame row.
+    class videomancer_virtual_device
+    {
+    public:
+        /// @brief Construct device
+        /// @param clock Time source shared with the control software under test
+        /// @param program Program model (nullptr for registers and latency only)
+        /// @param frame Frame buffer for rendering (nullptr planes to skip rendering)
+        videomancer_virtual_device(videomancer_clock& clock,
+                                   videomancer_program_model* program = nullptr,
+                                   videomancer_frame_buffer frame = { nullptr, nullptr, nullptr })
+            : m_clock(clock)
+            , m_program(program)
+            , m_frame(frame)
+            , m_registers(&clock)
+        {
+            reset(videomancer_abi_v1_0::video_timing_id::ntsc);
+        }
+
+        /// @brief SPI endpoint for a controller or socket server
+        videomancer_register_model& registers() { return m_registers; }
+
+        /// @brief Restart the raster at the current time
+        /// @param timing Timing mode of the incoming video
+        void reset(videomancer_abi_v1_0::video_timing_id timing)
+        {
+            m_timing = timing;
+            m_start_us = m_clock.now_us();
+            m_lines_done = 0;
+            m_frames_done = 0;
+            m_fields_done = 0;
+            m_latency = { 0, ~0ull, 0, 0 };
+        }
+
+        /// @brief Run the raster up to the current time
+        /// @return Number of lines processed
+        uint32_t advance()
+        {
+            const uint64_t now = m_clock.now_us();
+            const auto& info = videomancer_abi_v1_0::get_video_timing_info(m_timing);
+            if (info.lines_per_frame == 0)
+                return 0;
+
+            // Line n starts at n * den * 1e6 / (num * lines_per_frame) microseconds
+            const uint64_t lines_per_second_num = static_cast<uint64_t>(info.frame_rate_num) * info.lines_per_frame;
+            const uint64_t elapsed = now - m_start_us;
+            const uint64_t target_lines = elapsed * lines_per_second_num / (1000000ull * info.frame_rate_den) + 1;
+
+            uint32_t processed = 0;
+            while (m_lines_done < target_lines)
+            {
+                const uint64_t line_start_us = m_start_us +
+                    m_lines_done * 1000000ull * info.frame_rate_den / lines_per_second_num;
+                run_line(info, line_start_us);
+                ++m_lines_done;
+                ++processed;
+            }
+            return processed;
+        }
+
+        /// @brief Latency statistics since the last reset
+        const videomancer_latency_stats& latency() const { return m_latency; }
+
+        /// @brief Number of complete frames rendered
+        uint32_t frame_count() const { return m_frames_done; }
+
+        /// @brief Number of complete fields rendered (equal to frames when progressive)
+        uint32_t field_count() const { return m_fields_done; }
+
+        /// @brief Number of lines run since reset
+        uint64_t line_count() const { return m_lines_done; }
+
+    private:
+        videomancer_clock& m_clock;
+        videomancer_program_model* m_program;
+        videomancer_frame_buffer m_frame;
+        videomancer_register_model m_registers;
+        videomancer_abi_v1_0::video_timing_id m_timing;
+        uint64_t m_start_us;
+        uint64_t m_lines_done;
+        uint32_t m_frames_done;
+        uint32_t m_fields_done;
+        videomancer_latency_stats m_latency;
+
+        void run_line(const videomancer_abi_v1_0::video_timing_info& info, uint64_t line_start_us)
+        {
+            // Pixels of this line leave the pipeline after the program's delay
+            const uint32_t pixel_clock = static_cast<uint32_t>(
+                static_cast<uint64_t>(info.clocks_per_line) * info.lines_per_frame *
+                info.frame_rate_num / info.frame_rate_den);
+            const uint64_t pixel_us = line_start_us +
+                (m_program && pixel_clock ? static_cast<uint64_t>(m_program->latency_clocks()) * 1000000ull / pixel_clock : 0);
+
+            // Latch writes that arrived by the line start; one sample per register, from its oldest write
+            uint32_t latched = 0;
+            videomancer_register_write write;
+            while (m_registers.latch_next_write(line_start_us, write))
+            {
+                if (latched & (1u << write.address))
+                    continue;
+                latched |= 1u << write.address;
+                const uint64_t latency = pixel_us - write.time_us;
+                ++m_latency.sample_count;
+                m_latency.total_us += latency;
+                if (latency < m_latency.min_us) m_latency.min_us = latency;
+                if (latency > m_latency.max_us) m_latency.max_us = latency;
+            }
+
+            const uint16_t line = static_cast<uint16_t>(m_lines_done % info.lines_per_frame);
+            const video_field_layout layout = make_video_field_layout(m_timing);
+            const uint8_t field = (layout.field_count == 2 && line >= layout.field_lines[0]) ? 1 : 0;
+            const uint16_t field_line = static_cast<uint16_t>(field ? line - layout.field_lines[0] : line);
+            if (m_program && m_frame.y && m_frame.u && m_frame.v && field_line < layout.active_lines)
+            {
+                const uint16_t row = video_field_row(layout, field, field_line);
+                const size_t offset = static_cast<size_t>(row) * info.frame_width;
+                videomancer_line view = { m_frame.y + offset, m_frame.u + offset, m_frame.v + offset,
+                                          info.frame_width, row, layout.field_count == 1 || field == 1 };
+                for (uint16_t x = 0; x < info.frame_width; ++x)
+                {
+                    view.y[x] = static_cast<uint16_t>(64 + (static_cast<uint32_t>(x) * 876) / info.frame_width);
+                    view.u[x] = 512;
+                    view.v[x] = 512;
+                }
+                m_program->process_line(m_registers.active_registers(), view);
+            }
+
+            if (field_line == layout.field_lines[field] - 1)
+                ++m_fields_done;
+            if (line == info.lines_per_frame - 1)
+                ++m_frames_done;
+        }
+    };
+
+#ifdef VIDEOMANCER_VIRTUAL_DEVICE_HAS_SOCKETS
+
+    /// @brief videomancer_fpga implementation that forwards SPI calls over a socket
+    ///
+    /// Control software links this in place of the hardware driver; a
+    /// videomancer_socket_server on the other end feeds a virtual device.
+    class videomancer_socket_fpga : public videomancer_fpga
+    {
+    public:
+        /// @brief Construct on an already connected stream socket (not owned)
+        explicit videomancer_socket_fpga(int fd)
+            : m_fd(fd)
+        {}
+
+        size_t transfer_spi(const uint8_t* tx_buffer, uint8_t* rx_buffer, size_t size) override
+        {
+            uint8_t packet[2 + 255];
+            size_t done = 0;
+            while (done < size)
+            {
+                const size_t n = (size - done) < 255 ? (size - done) : 255;
+                packet[0] = 0x03;
+                packet[1] = static_cast<uint8_t>(n);
+                for (size_t i = 0; i < n; ++i)
+                    packet[2 + i] = tx_buffer ? tx_buffer[done + i] : 0;
+                if (!send_all(packet, 2 + n))
+                    break;
+                if (rx_buffer)
+                    memset(rx_buffer + done, 0, n);
+                done += n;
+            }
+            return done;
+        }
+
+        void assert_chip_select_spi(bool assert) override
+        {
+            const uint8_t tag = assert ? 0x01 : 0x02;
+            send_all(&tag, 1);
+        }
+
+    private:
+        int m_fd;
+
+        bool send_all(const uint8_t* data, size_t size)
+        {
+            while (size > 0)
+            {
+                const ssize_t n = ::send(m_fd, data, size, VIDEOMANCER_SOCKET_SEND_FLAGS);
+                if (n < 0 && errno == EINTR)
+                    continue;
+                if (n <= 0)
+                    return false;
+                data += n;
+                size -= static_cast<size_t>(n);
+            }
+            return true;
+        }
+    };
+
+    /// @brief Decodes the socket wire format into a videomancer_fpga
+    class videomancer_socket_server
+    {
+    public:
+        /// @brief Construct on an already connected stream socket (not owned)
+        /// @param fd Socket descriptor; switched to non-blocking mode
+        /// @param target Interface receiving decoded calls (usually a register model)
+        videomancer_socket_server(int fd, videomancer_fpga& target)
+            : m_fd(fd)
+            , m_target(target)
+        {
+            const int flags = ::fcntl(fd, F_GETFL, 0);
+            ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+        }
+
+        /// @brief Drain all bytes currently available on the socket
+        /// @return Number of bytes consumed, or -1 if the peer closed or the stream is malformed
+        int poll_once()
+        {
+            int consumed = 0;
+            for (;;)
+            {
+                const ssize_t n = ::recv(m_fd, m_buffer + m_size, sizeof(m_buffer) - m_size, 0);
+                if (n < 0 && errno == EINTR)
+                    continue;
+                if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                    return consumed;
+                if (n <= 0)
+                    return -1;
+
+                m_size += static_cast<size_t>(n);
+                consumed += static_cast<int>(n);
+                if (!dispatch())
+                    return -1;
+            }
+        }
+
+    private:
+        int m_fd;
+        videomancer_fpga& m_target;
+        uint8_t m_buffer[1024];
+        size_t m_size = 0;
+
+        bool dispatch()
+        {
+            size_t pos = 0;
+            while (pos < m_size)
+            {
+                const uint8_t tag = m_buffer[pos];
+                if (tag == 0x01 || tag == 0x02)
+                {
+                    m_target.assert_chip_select_spi(tag == 0x01);
+                    pos += 1;
+                }
+                else if (tag == 0x03)
+                {
+                    if (m_size - pos < 2 || m_size - pos < 2u + m_buffer[pos + 1])
+                        break;  // Wait for the rest of the packet
+                    m_target.transfer_spi(m_buffer + pos + 2, nullptr, m_buffer[pos + 1]);
+                    pos += 2u + m_buffer[pos + 1];
+                }
+                else
+                {
+                    return false;
+                }
+            }
+
+            memmove(m_buffer, m_buffer + pos, m_size - pos);
+            m_size -= pos;
+            return true;
+        }
+    };
+
+    /// @brief Create a listening Unix domain socket
+    /// @param path Filesystem path (removed first if it exists)
+    /// @return Listening descriptor, or -1 on failure
+    inline int videomancer_socket_listen(const char* path)
+    {
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        if (strlen(path) >= sizeof(addr.sun_path))
+            return -1;
+        strcpy(addr.sun_path, path);
+
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0)
+            return -1;
+        ::unlink(path);
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(fd, 16) != 0)
+        {
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    /// @brief Connect to a virtual device listening on a Unix domain socket
+    /// @param path Filesystem path of the listening socket
+    /// @return Connected descriptor, or -1 on failure
+    inline int videomancer_socket_connect(const char* path)
+    {
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        if (strlen(path) >= sizeof(addr.sun_path))
+            return -1;
+        strcpy(addr.sun_path, path);
+
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0)
+            return -1;
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+        {
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+#endif // VIDEOMANCER_VIRTUAL_DEVICE_HAS_SOCKETS
+
+} // namespace lzx
@@ -0,0 +1,405 @@
+// Videomancer SDK - Open source FPGA-based video effects development kit
+// Copyright (C) 2025 LZX Industries LLC
+// File: vmprog_compact_config.hpp - Compact Program Config Encoding
+// License: GNU General Public License v3.0
+// https://github.com/lzxindustries/videomancer-sdk
+//
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// Compact Config Overview:
+//   - vmprog_program_config_v1_0 is a fixed 7372 bytes, mostly zero padding
+//     (12 parameters x 16 value labels x 32 chars, long string fields)
+//   - The config_compact payload stores the same config as fixed numeric
+//     records plus a deduplicated string table; shipped programs encode to
+//     a few hundred bytes (layout in vmprog_format.hpp)
+//   - Packages carry it in addition to the fixed config, as a signed
+//     descriptor artifact, so v1.0 readers keep working. The package grows
+//     by the compact size; the saving is in what a reader has to load and
+//     keep in RAM to list or show a program
+//   - validate_vmprog_package(), validate_vmprog_package_stream() and
+//     validate_vmprog_package_selective_stream() reject a package whose
+//     compact entry does not decode to exactly its fixed config; the stream
+//     paths also require it to be a signed artifact of a signed package
+//   - read_vmprog_compact_config() checks the payload against the descriptor
+//     artifact, never the unsigned TOC hash
+//   - vmprog_compact_config_view reads the payload in place. Its parameter
+//     views have the field names of vmprog_parameter_config_v1_0, so they
+//     work with apply_parameter_control_curve_and_scaling() and
+//     generate_parameter_value_display_string() unchanged
+//   - expand() rebuilds the fixed struct for code that needs it
+//
+// Usage (MCU, program browser):
+//   // descriptor from read_and_verify_signed_descriptor_stream()
+//   uint8_t buffer[1024];
+//   vmprog_compact_config_view view;
+//   if (read_vmprog_compact_config(stream, *entry, descriptor, buffer, sizeof(buffer), view) == vmprog_validation_result::ok) {
+//       show(view.program_name());
+//       generate_parameter_value_display_string(value, view.parameter(0), text, sizeof(text));
+//   }
+
+#pragma once
+
+#include "vmprog_stream_reader.hpp"
+
+namespace lzx {
+
+    /**
+     * @brief Value labels of one compact parameter.
+     *
+     * Indexing returns a pointer into the payload's string table.
+     */
+    struct vmprog_compact_labels {
+        const char* strings = nullptr;  // String table
+        const uint8_t* index = nullptr; // This parameter's slice of the value label index
+
+        const char* operator[](uint32_t i) const {
+            return strings + (index[2 * i] | (index[2 * i + 1] << 8));
+        }
+    };
+
+    /**
+     * @brief Parameter of a compact config, read in place.
+     *
+     * Field names match vmprog_parameter_config_v1_0; strings point into the
+     * payload, which must outlive the view.
+     */
+    struct vmprog_compact_parameter_view {
+        vmprog_parameter_id_v1_0 parameter_id = vmprog_parameter_id_v1_0::none;
+        vmprog_parameter_control_mode_v1_0 control_mode = vmprog_parameter_control_mode_v1_0::linear;
+        uint16_t min_value = 0;
+        uint16_t max_value = 0;
+        uint16_t initial_value = 0;
+        int16_t display_min_value = 0;
+        int16_t display_max_value = 0;
+        uint8_t display_float_digits = 0;
+        uint8_t value_label_count = 0;
+        const char* name_label = "";
+        const char* suffix_label = "";
+        vmprog_compact_labels value_labels;
+    };
+
+    /**
+     * @brief Zero-copy reader for a config_compact payload.
+     *
+     * open() validates the payload once; the accessors then read it in place.
+     */
+    class vmprog_compact_config_view {
+    public:
+        /**
+         * @brief Validate a payload and attach to it.
+         *
+         * @param data Payload bytes (must stay valid while the view is used)
+         * @param size Payload size in bytes
+         * @return Validation result; the view is empty unless ok
+         */
+        vmprog_validation_result open(const uint8_t* data, uint32_t size) {
+            data_ = nullptr;
+            auto result = validate_vmprog_compact_config_v1_0(data, size);
+            if (result != vmprog_validation_result::ok) {
+                return result;
+            }
+            data_ = data;
+            size_ = size;
+            return result;
+        }
+
+        /** @brief Whether a valid payload is attached. */
+        bool is_open() const { return data_ != nullptr; }
+
+        /** @brief Payload size in bytes. */
+        uint32_t size() const { return size_; }
+
+        const char* program_id() const { return string(header().program_id); }
+        const char* program_name() const { return string(header().program_name); }
+        const char* author() const { return string(header().author); }
+        const char* license() const { return string(header().license); }
+        const char* category() const { return string(header().category); }
+        const char* description() const { return string(header().description); }
+        const char* url() const { return string(header().url); }
+
+        uint16_t program_version_major() const { return header().program_version_major; }
+        uint16_t program_version_minor() const { return header().program_version_minor; }
+        uint16_t program_version_patch() const { return header().program_version_patch; }
+        uint16_t abi_min_major() const { return header().abi_min_major; }
+        uint16_t abi_min_minor() const { return header().abi_min_minor; }
+        uint16_t abi_max_major() const { return header().abi_max_major; }
+        uint16_t abi_max_minor() const { return header().abi_max_minor; }
+        vmprog_hardware_flags_v1_0 hw_mask() const { return header().hw_mask; }
+        vmprog_core_id_v1_0 core_id() const { return header().core_id; }
+        uint16_t parameter_count() const { return header().parameter_count; }
+
+        /**
+         * @brief Parameter by position.
+         * @param i Index (< parameter_count())
+         */
+        vmprog_compact_parameter_view parameter(uint32_t i) const {
+            const auto& record = reinterpret_cast<const vmprog_compact_parameter_v1_0*>(
+                data_ + sizeof(vmprog_compact_config_header_v1_0))[i];
+
+            vmprog_compact_parameter_view view;
+            view.parameter_id = static_cast<vmprog_parameter_id_v1_0>(record.parameter_id);
+            view.control_mode = static_cast<vmprog_parameter_control_mode_v1_0>(record.control_mode);
+            view.min_value = record.min_value;
+            view.max_value = record.max_value;
+            view.initial_value = record.initial_value;
+            view.display_min_value = record.display_min_value;
+            view.display_max_value = record.display_max_value;
+            view.display_float_digits = record.display_float_digits;
+            view.value_label_count = record.value_label_count;
+            view.name_label = string(record.name_label);
+            view.suffix_label = string(record.suffix_label);
+            view.value_labels.strings = strings();
+            view.value_labels.index = label_index() + 2 * record.first_value_label;
+            return view;
+        }
+
+        /**
+         * @brief Parameter by control.
+         * @return false if the program does not use the control
+         */
+        bool find_parameter(vmprog_parameter_id_v1_0 id, vmprog_compact_parameter_view& out) const {
+            const auto* records = reinterpret_cast<const vmprog_compact_parameter_v1_0*>(
+                data_ + sizeof(vmprog_compact_config_header_v1_0));
+            for (uint32_t i = 0; i < parameter_count(); ++i) {
+                if (records[i].parameter_id == static_cast<uint32_t>(id)) {
+                    out = parameter(i);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Rebuild the fixed config.
+         *
+         * The result equals the config the payload was encoded from.
+         * @param out Destination (fully overwritten)
+         */
+        void expand(vmprog_program_config_v1_0& out) const {
+            init_vmprog_config(out);
+            safe_strncpy(out.program_id, program_id(), sizeof(out.program_id));
+            out.program_version_major = program_version_major();
+            out.program_version_minor = program_version_minor();
+            out.program_version_patch = program_version_patch();
+            out.abi_min_major = abi_min_major();
+            out.abi_min_minor = abi_min_minor();
+            out.abi_max_major = abi_max_major();
+            out.abi_max_minor = abi_max_minor();
+            out.hw_mask = hw_mask();
+            out.core_id = core_id();
+            safe_strncpy(out.program_name, program_name(), sizeof(out.program_name));
+            safe_strncpy(out.author, author(), sizeof(out.author));
+            safe_strncpy(out.license, license(), sizeof(out.license));
+            safe_strncpy(out.category, category(), sizeof(out.category));
+            safe_strncpy(out.description, description(), sizeof(out.description));
+            safe_strncpy(out.url, url(), sizeof(out.url));
+            out.parameter_count = parameter_count();
+
+            for (uint32_t i = 0; i < parameter_count(); ++i) {
+                const vmprog_compact_parameter_view param = parameter(i);
+                vmprog_parameter_config_v1_0& dst = out.parameters[i];
+                dst.parameter_id = param.parameter_id;
+                dst.control_mode = param.control_mode;
+                dst.min_value = param.min_value;
+                dst.max_value = param.max_value;
+                dst.initial_value = param.initial_value;
+                dst.display_min_value = param.display_min_value;
+                dst.display_max_value = param.display_max_value;
+                dst.display_float_digits = param.display_float_digits;
+                dst.value_label_count = param.value_label_count;
+                safe_strncpy(dst.name_label, param.name_label, sizeof(dst.name_label));
+                safe_strncpy(dst.suffix_label, param.suffix_label, sizeof(dst.suffix_label));
+                for (uint32_t j = 0; j < param.value_label_count; ++j) {
+                    safe_strncpy(dst.value_labels[j], param.value_labels[j], sizeof(dst.value_labels[j]));
+                }
+            }
+        }
+
+    private:
+        const uint8_t* data_ = nullptr;
+        uint32_t size_ = 0;
+
+        const vmprog_compact_config_header_v1_0& header() const {
+            return *reinterpret_cast<const vmprog_compact_config_header_v1_0*>(data_);
+        }
+
+        const uint8_t* label_index() const {
+            return data_ + sizeof(vmprog_compact_config_header_v1_0) +
+                header().parameter_count * sizeof(vmprog_compact_parameter_v1_0);
+        }
+
+        const char* strings() const {
+            return reinterpret_cast<const char*>(label_index() + header().value_label_count * sizeof(uint16_t));
+        }
+
+        const char* string(uint16_t offset) const {
+            return strings() + offset;
+        }
+    };
+
+    /**
+     * @brief Append a string to a compact string table, reusing any existing copy.
+     *
+     * Any NUL-terminated run already in the table matches, so a string that
+     * is the tail of another (or empty) costs nothing.
+     *
+     * @return Offset of the string, or -1 if the table is full
+     */
+    inline int32_t add_compact_string(char* table, uint32_t& used, uint32_t capacity, const char* str, size_t max_length) {
+        const size_t length = safe_strlen(str, max_length);
+        for (uint32_t pos = 0; pos + length < used; ++pos) {
+            if (table[pos + length] == '\0' && memcmp(table + pos, str, length) == 0) {
+                return static_cast<int32_t>(pos);
+            }
+        }
+        if (used + length + 1 > capacity || used + length + 1 > 0xFFFFu) {
+            return -1;
+        }
+        const uint32_t offset = used;
+        memcpy(table + used, str, length);
+        table[used + length] = '\0';
+        used += static_cast<uint32_t>(length + 1);
+        return static_cast<int32_t>(offset);
+    }
+
+    /**
+     * @brief Encode a config as a config_compact payload.
+     *
+     * @param config Valid fixed config
+     * @param out Destination
+     * @param capacity Size of out (vmprog_compact_config_max_size always suffices)
+     * @return Payload size, or 0 if the config is invalid or out is too small
+     */
+    inline uint32_t encode_vmprog_compact_config(const vmprog_program_config_v1_0& config, uint8_t* out, uint32_t capacity) {
+        if (!out || validate_vmprog_program_config_v1_0(config) != vmprog_validation_result::ok) {
+            return 0;
+        }
+
+        uint32_t label_count = 0;
+        for (uint32_t i = 0; i < config.parameter_count; ++i) {
+            label_count += config.parameters[i].value_label_count;
+        }
+
+        const uint32_t records_offset = sizeof(vmprog_compact_config_header_v1_0);
+        const uint32_t labels_offset = records_offset + config.parameter_count * sizeof(vmprog_compact_parameter_v1_0);
+        const uint32_t strings_offset = labels_offset + label_count * sizeof(uint16_t);
+        const uint32_t limit = capacity < vmprog_compact_config_max_size ? capacity : vmprog_compact_config_max_size;
+        if (strings_offset + 1 > limit) {
+            return 0;
+        }
+        memset(out, 0, strings_offset + 1);
+
+        char* table = reinterpret_cast<char*>(out + strings_offset);
+        const uint32_t table_capacity = limit - strings_offset;
+        uint32_t used = 1;  // Offset 0 is the empty string
+        bool full = false;
+        auto add = [&](const char* str, size_t max_length) -> uint16_t {
+            const int32_t offset = add_compact_string(table, used, table_capacity, str, max_length);
+            full |= offset < 0;
+            return static_cast<uint16_t>(offset < 0 ? 0 : offset);
+        };
+
+        auto& header = *reinterpret_cast<vmprog_compact_config_header_v1_0*>(out);
+        header.magic = vmprog_compact_config_header_v1_0::expected_magic;
+        header.version = vmprog_compact_config_header_v1_0::default_version;
+        header.parameter_count = config.parameter_count;
+        header.value_label_count = static_cast<uint16_t>(label_count);
+        header.program_version_major = config.program_version_major;
+        header.program_version_minor = config.program_version_minor;
+        header.program_version_patch = config.program_version_patch;
+        header.abi_min_major = config.abi_min_major;
+        header.abi_min_minor = config.abi_min_minor;
+        header.abi_max_major = config.abi_max_major;
+        header.abi_max_minor = config.abi_max_minor;
+        header.hw_mask = config.hw_mask;
+        header.core_id = config.core_id;
+        header.program_id = add(config.program_id, sizeof(config.program_id));
+        header.program_name = add(config.program_name, sizeof(config.program_name));
+        header.author = add(config.author, sizeof(config.author));
+        header.license = add(config.license, sizeof(config.license));
+        header.category = add(config.category, sizeof(config.category));
+        header.description = add(config.description, sizeof(config.description));
+        // The fixed validator does not require url to be terminated; keep what safe_strncpy would
+        header.url = add(config.url, sizeof(config.url) - 1);
+
+        auto* records = reinterpret_cast<vmprog_compact_parameter_v1_0*>(out + records_offset);
+        uint8_t* labels = out + labels_offset;
+        uint32_t next_label = 0;
+        for (uint32_t i = 0; i < config.parameter_count; ++i) {
+            const vmprog_parameter_config_v1_0& param = config.parameters[i];
+            vmprog_compact_parameter_v1_0& record = records[i];
+            record.parameter_id = static_cast<uint8_t>(param.parameter_id);
+            record.control_mode = static_cast<uint8_t>(param.control_mode);
+            record.display_float_digits = param.display_float_digits;
+            record.value_label_count = param.value_label_count;
+            record.min_value = param.min_value;
+            record.max_value = param.max_value;
+            record.initial_value = param.initial_value;
+            record.display_min_value = param.display_min_value;
+            record.display_max_value = param.display_max_value;
+            record.name_label = add(param.name_label, sizeof(param.name_label));
+            record.suffix_label = add(param.suffix_label, sizeof(param.suffix_label));
+            record.first_value_label = static_cast<uint16_t>(next_label);
+            for (uint32_t j = 0; j < param.value_label_count; ++j, ++next_label) {
+                const uint16_t offset = add(param.value_labels[j], sizeof(param.value_labels[j]));
+                labels[2 * next_label] = static_cast<uint8_t>(offset);
+                labels[2 * next_label + 1] = static_cast<uint8_t>(offset >> 8);
+            }
+        }
+
+        if (full) {
+            return 0;
+        }
+        header.string_table_size = static_cast<uint16_t>(used);
+        return strings_offset + used;
+    }
+
+    /**
+     * @brief Read, authenticate and open a config_compact payload from a stream.
+     *
+     * @param stream Package stream
+     * @param entry config_compact TOC entry (offset and size)
+     * @param descriptor Signed descriptor whose signature has been verified; the
+     *        payload is checked against its config_compact artifact
+     * @param buffer Payload storage; the view points into it
+     * @param capacity Size of buffer
+     * @param out_view View over buffer on success
+     * @return Validation result code
+     */
+    inline vmprog_validation_result read_vmprog_compact_config(
+        vmprog_stream& stream,
+        const vmprog_toc_entry_v1_0& entry,
+        const vmprog_signed_descriptor_v1_0& descriptor,
+        uint8_t* buffer,
+        uint32_t capacity,
+        vmprog_compact_config_view& out_view
+    ) {
+        const vmprog_artifact_hash_v1_0* artifact = find_descriptor_artifact(
+            descriptor, vmprog_toc_entry_type_v1_0::config_compact);
+        if (!artifact) {
+            return vmprog_validation_result::invalid_toc_entry;
+        }
+        if (entry.type != vmprog_toc_entry_type_v1_0::config_compact || entry.size > vmprog_compact_config_max_size) {
+            return vmprog_validation_result::invalid_toc_entry;
+        }
+        if (!read_payload(stream, entry, buffer, capacity)) {
+            return vmprog_validation_result::invalid_payload_offset;
+        }
+        if (!verify_payload_hash(buffer, entry.size, artifact->sha256)) {
+            return vmprog_validation_result::invalid_hash;
+        }
+        return out_view.open(buffer, entry.size);
+    }
+
+} // namespace lzx
@@ -106,6 +106,7 @@ namespace lzx {
         bitstream_hd_analog = 8,
         bitstream_hd_hdmi = 9,
         bitstream_hd_dual = 10,
+        config_compact = 11,  // Compact encoding of the config (see vmprog_compact_config_header_v1_0)
     };
 
     // Package header flags
@@ -403,6 +404,68 @@ namespace lzx {
 
 #pragma pack(pop)
 
+    // Compact config payload (TOC type config_compact):
+    //   header | parameter records | value label index (uint16) | string table
+    // Strings are offsets into the string table, which starts with '\0' (the
+    // empty string) and ends with '\0'. A parameter's value labels are
+    // value_label_index[first_value_label .. first_value_label + value_label_count).
+    // Packages carry it next to the fixed config and list it as a signed
+    // descriptor artifact; it must decode to exactly that config.
+#pragma pack(push, 1)
+    struct vmprog_compact_config_header_v1_0
+    {
+        static constexpr uint32_t expected_magic = 0x43434D56u;  // 'VMCC' (little-endian)
+        static constexpr uint16_t default_version = 1;
+        static constexpr uint32_t struct_size = 52;
+
+        uint32_t magic;                      // 'VMCC'
+        uint16_t version;                    // 1
+        uint16_t parameter_count;            // Parameter records (0 to num_parameters)
+        uint16_t value_label_count;          // Entries in the value label index
+        uint16_t string_table_size;          // Bytes in the string table
+        uint16_t program_version_major;
+        uint16_t program_version_minor;
+        uint16_t program_version_patch;
+        uint16_t abi_min_major;
+        uint16_t abi_min_minor;
+        uint16_t abi_max_major;
+        uint16_t abi_max_minor;
+        vmprog_hardware_flags_v1_0 hw_mask;
+        vmprog_core_id_v1_0 core_id;
+        uint16_t program_id;                 // String offsets
+        uint16_t program_name;
+        uint16_t author;
+        uint16_t license;
+        uint16_t category;
+        uint16_t description;
+        uint16_t url;
+        uint16_t reserved[2];                // Must be zero
+    };
+#pragma pack(pop)
+
+#pragma pack(push, 1)
+    struct vmprog_compact_parameter_v1_0
+    {
+        static constexpr uint32_t struct_size = 20;
+
+        uint8_t parameter_id;                // vmprog_parameter_id_v1_0
+        uint8_t control_mode;                // vmprog_parameter_control_mode_v1_0
+        uint8_t display_float_digits;
+        uint8_t value_label_count;
+        uint16_t min_value;
+        uint16_t max_value;
+        uint16_t initial_value;
+        int16_t display_min_value;
+        int16_t display_max_value;
+        uint16_t name_label;                 // String offset
+        uint16_t suffix_label;               // String offset
+        uint16_t first_value_label;          // Index into the value label index
+    };
+#pragma pack(pop)
+
+    /// Largest compact payload accepted: never larger than the fixed config it replaces.
+    constexpr uint32_t vmprog_compact_config_max_size = vmprog_program_config_v1_0::struct_size;
+
     static_assert(sizeof(vmprog_artifact_hash_v1_0) == vmprog_artifact_hash_v1_0::struct_size,
         "vmprog_artifact_hash_v1_0 size mismatch - check struct packing and alignment");
 
@@ -421,6 +484,12 @@ namespace lzx {
     static_assert(sizeof(vmprog_program_config_v1_0) == vmprog_program_config_v1_0::struct_size,
         "vmprog_program_config_v1_0 size mismatch - check struct packing and alignment");
 
+    static_assert(sizeof(vmprog_compact_config_header_v1_0) == vmprog_compact_config_header_v1_0::struct_size,
+        "vmprog_compact_config_header_v1_0 size mismatch - check struct packing and alignment");
+
+    static_assert(sizeof(vmprog_compact_parameter_v1_0) == vmprog_compact_parameter_v1_0::struct_size,
+        "vmprog_compact_parameter_v1_0 size mismatch - check struct packing and alignment");
+
     // Additional static assertions for array bounds
     static_assert(vmprog_signed_descriptor_v1_0::max_artifacts == 8,
         "max_artifacts must be 8 - this is part of the format specification");
@@ -814,7 +883,7 @@ namespace lzx {
     ) {
         // Check artifact type is valid (none is only allowed for unused slots)
         uint32_t type_value = static_cast<uint32_t>(artifact.type);
-        if (type_value > static_cast<uint32_t>(vmprog_toc_entry_type_v1_0::bitstream_hd_dual)) {
+        if (type_value > static_cast<uint32_t>(vmprog_toc_entry_type_v1_0::config_compact)) {
             return vmprog_validation_result::invalid_enum_value;
         }
 
@@ -1016,6 +1085,234 @@ namespace lzx {
         return vmprog_validation_result::ok;
     }
 
+    /**
+     * @brief Check a compact config string reference.
+     *
+     * @param strings String table (last byte is '\0')
+     * @param strings_size String table size in bytes
+     * @param offset String offset
+     * @param max_length Size of the matching fixed-config field, terminator included
+     * @return true if the offset is inside the table and the string fits the field
+     */
+    inline bool is_compact_string_valid(const char* strings, uint32_t strings_size, uint16_t offset, uint32_t max_length) {
+        if (offset >= strings_size) {
+            return false;
+        }
+        const uint32_t limit = (strings_size - offset < max_length) ? strings_size - offset : max_length;
+        return is_string_terminated(strings + offset, limit);
+    }
+
+    /**
+     * @brief Validate a compact config payload.
+     *
+     * Applies the checks of validate_vmprog_program_config_v1_0() to the
+     * compact encoding, plus its layout: exact payload size, string offsets
+     * inside the string table and strings no longer than the fixed fields,
+     * so the payload always decodes to a valid vmprog_program_config_v1_0.
+     *
+     * @param data Payload bytes
+     * @param size Payload size in bytes
+     * @return Validation result code
+     */
+    inline vmprog_validation_result validate_vmprog_compact_config_v1_0(
+        const uint8_t* data,
+        uint32_t size
+    ) {
+        if (!data || size < sizeof(vmprog_compact_config_header_v1_0) || size > vmprog_compact_config_max_size) {
+            return vmprog_validation_result::invalid_file_size;
+        }
+
+        const auto& header = *reinterpret_cast<const vmprog_compact_config_header_v1_0*>(data);
+        if (header.magic != vmprog_compact_config_header_v1_0::expected_magic) {
+            return vmprog_validation_result::invalid_magic;
+        }
+        if (header.version != vmprog_compact_config_header_v1_0::default_version) {
+            return vmprog_validation_result::invalid_version;
+        }
+        if (header.parameter_count > vmprog_program_config_v1_0::num_parameters) {
+            return vmprog_validation_result::invalid_parameter_count;
+        }
+
+        const uint32_t records_offset = sizeof(vmprog_compact_config_header_v1_0);
+        const uint32_t labels_offset = records_offset + header.parameter_count * sizeof(vmprog_compact_parameter_v1_0);
+        const uint32_t strings_offset = labels_offset + header.value_label_count * sizeof(uint16_t);
+        if (static_cast<uint64_t>(strings_offset) + header.string_table_size != size) {
+            return vmprog_validation_result::invalid_file_size;
+        }
+
+        const char* strings = reinterpret_cast<const char*>(data + strings_offset);
+        const uint32_t strings_size = header.string_table_size;
+        if (strings_size == 0 || strings[0] != '\0' || strings[strings_size - 1] != '\0') {
+            return vmprog_validation_result::string_not_terminated;
+        }
+
+        // Same program-level checks as the fixed config
+        if (header.abi_min_major > header.abi_max_major ||
+            (header.abi_min_major == header.abi_max_major && header.abi_min_minor > header.abi_max_minor) ||
+            header.abi_min_major == 0 || header.abi_max_major == 0) {
+            return vmprog_validation_result::invalid_abi_range;
+        }
+        if (!is_compact_string_valid(strings, strings_size, header.program_id, vmprog_program_config_v1_0::program_id_max_length) ||
+            !is_compact_string_valid(strings, strings_size, header.program_name, vmprog_program_config_v1_0::program_name_max_length) ||
+            !is_compact_string_valid(strings, strings_size, header.author, vmprog_program_config_v1_0::author_max_length) ||
+            !is_compact_string_valid(strings, strings_size, header.license, vmprog_program_config_v1_0::license_max_length) ||
+            !is_compact_string_valid(strings, strings_size, header.category, vmprog_program_config_v1_0::category_max_length) ||
+            !is_compact_string_valid(strings, strings_size, header.description, vmprog_program_config_v1_0::description_max_length) ||
+            !is_compact_string_valid(strings, strings_size, header.url, vmprog_program_config_v1_0::url_max_length)) {
+            return vmprog_validation_result::string_not_terminated;
+        }
+        if (strings[header.program_id] == '\0' || strings[header.program_name] == '\0') {
+            return vmprog_validation_result::string_not_terminated;
+        }
+        if (header.hw_mask == vmprog_hardware_flags_v1_0::none || header.core_id == vmprog_core_id_v1_0::none) {
+            return vmprog_validation_result::invalid_enum_value;
+        }
+        if (header.reserved[0] != 0 || header.reserved[1] != 0) {
+            return vmprog_validation_result::reserved_field_not_zero;
+        }
+
+        const auto* labels = reinterpret_cast<const uint8_t*>(data + labels_offset);
+        for (uint32_t i = 0; i < header.value_label_count; ++i) {
+            const uint16_t offset = static_cast<uint16_t>(labels[2 * i] | (labels[2 * i + 1] << 8));
+            if (!is_compact_string_valid(strings, strings_size, offset, vmprog_parameter_config_v1_0::value_label_max_length)) {
+                return vmprog_validation_result::string_not_terminated;
+            }
+        }
+
+        const auto* records = reinterpret_cast<const vmprog_compact_parameter_v1_0*>(data + records_offset);
+        for (uint32_t i = 0; i < header.parameter_count; ++i) {
+            const vmprog_compact_parameter_v1_0& param = records[i];
+            if (param.parameter_id > static_cast<uint32_t>(vmprog_parameter_id_v1_0::linear_potentiometer_12) ||
+                param.control_mode > static_cast<uint32_t>(vmprog_parameter_control_mode_v1_0::expo_in_out)) {
+                return vmprog_validation_result::invalid_enum_value;
+            }
+            if (param.value_label_count > vmprog_parameter_config_v1_0::max_value_labels ||
+                static_cast<uint32_t>(param.first_value_label) + param.value_label_count > header.value_label_count) {
+                return vmprog_validation_result::invalid_value_label_count;
+            }
+            if (param.min_value > param.max_value ||
+                param.initial_value < param.min_value || param.initial_value > param.max_value ||
+                param.display_min_value > param.display_max_value) {
+                return vmprog_validation_result::invalid_parameter_values;
+            }
+            if (!is_compact_string_valid(strings, strings_size, param.name_label, vmprog_parameter_config_v1_0::name_label_max_length) ||
+                !is_compact_string_valid(strings, strings_size, param.suffix_label, vmprog_parameter_config_v1_0::suffix_label_max_length)) {
+                return vmprog_validation_result::string_not_terminated;
+            }
+        }
+
+        return vmprog_validation_result::ok;
+    }
+
+    /**
+     * @brief Check a fixed-config string field against a compact string.
+     *
+     * @param str Compact string (shorter than field_size)
+     * @param field Fixed-config field
+     * @param field_size Size of the field
+     * @return true if the field holds str followed by zero padding
+     */
+    inline bool is_compact_string_match(const char* str, const char* field, uint32_t field_size) {
+        uint32_t i = 0;
+        for (; i < field_size && str[i] != '\0'; ++i) {
+            if (field[i] != str[i]) return false;
+        }
+        for (; i < field_size; ++i) {
+            if (field[i] != '\0') return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Check that a byte range is all zero.
+     *
+     * @param data Bytes to check
+     * @param size Number of bytes
+     * @return true if every byte is zero
+     */
+    inline bool is_zero_filled(const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            if (bytes[i] != 0) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Check that a compact config decodes to a fixed config.
+     *
+     * Byte-exact: equivalent to expanding the payload and comparing it with
+     * config, without the 7 KB temporary. Padding after strings, unused value
+     * labels, unused parameter slots and reserved fields must be zero.
+     *
+     * @param data Payload bytes, already accepted by validate_vmprog_compact_config_v1_0()
+     * @param config Fixed config from the same package
+     * @return true if the two encode the same config
+     */
+    inline bool is_compact_config_match(const uint8_t* data, const vmprog_program_config_v1_0& config) {
+        const auto& header = *reinterpret_cast<const vmprog_compact_config_header_v1_0*>(data);
+        const auto* records = reinterpret_cast<const vmprog_compact_parameter_v1_0*>(
+            data + sizeof(vmprog_compact_config_header_v1_0));
+        const auto* label_index = reinterpret_cast<const uint8_t*>(records + header.parameter_count);
+        const char* strings = reinterpret_cast<const char*>(label_index + header.value_label_count * sizeof(uint16_t));
+
+        if (config.program_version_major != header.program_version_major ||
+            config.program_version_minor != header.program_version_minor ||
+            config.program_version_patch != header.program_version_patch ||
+            config.abi_min_major != header.abi_min_major || config.abi_min_minor != header.abi_min_minor ||
+            config.abi_max_major != header.abi_max_major || config.abi_max_minor != header.abi_max_minor ||
+            config.hw_mask != header.hw_mask || config.core_id != header.core_id ||
+            config.parameter_count != header.parameter_count ||
+            config.reserved_pad != 0 || !is_zero_filled(config.reserved, sizeof(config.reserved))) {
+            return false;
+        }
+        if (!is_compact_string_match(strings + header.program_id, config.program_id, sizeof(config.program_id)) ||
+            !is_compact_string_match(strings + header.program_name, config.program_name, sizeof(config.program_name)) ||
+            !is_compact_string_match(strings + header.author, config.author, sizeof(config.author)) ||
+            !is_compact_string_match(strings + header.license, config.license, sizeof(config.license)) ||
+            !is_compact_string_match(strings + header.category, config.category, sizeof(config.category)) ||
+            !is_compact_string_match(strings + header.description, config.description, sizeof(config.description)) ||
+            !is_compact_string_match(strings + header.url, config.url, sizeof(config.url))) {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < vmprog_program_config_v1_0::num_parameters; ++i) {
+            const vmprog_parameter_config_v1_0& param = config.parameters[i];
+            if (i >= header.parameter_count) {
+                if (!is_zero_filled(&param, sizeof(param))) return false;
+                continue;
+            }
+
+            const vmprog_compact_parameter_v1_0& record = records[i];
+            if (static_cast<uint32_t>(param.parameter_id) != record.parameter_id ||
+                static_cast<uint32_t>(param.control_mode) != record.control_mode ||
+                param.min_value != record.min_value || param.max_value != record.max_value ||
+                param.initial_value != record.initial_value ||
+                param.display_min_value != record.display_min_value ||
+                param.display_max_value != record.display_max_value ||
+                param.display_float_digits != record.display_float_digits ||
+                param.value_label_count != record.value_label_count ||
+                !is_zero_filled(param.reserved_pad, sizeof(param.reserved_pad)) ||
+                !is_zero_filled(param.reserved, sizeof(param.reserved)) ||
+                !is_compact_string_match(strings + record.name_label, param.name_label, sizeof(param.name_label)) ||
+                !is_compact_string_match(strings + record.suffix_label, param.suffix_label, sizeof(param.suffix_label))) {
+                return false;
+            }
+            for (uint32_t j = 0; j < vmprog_parameter_config_v1_0::max_value_labels; ++j) {
+                if (j >= record.value_label_count) {
+                    if (!is_zero_filled(param.value_labels[j], sizeof(param.value_labels[j]))) return false;
+                    continue;
+                }
+                const uint8_t* entry = label_index + 2 * (record.first_value_label + j);
+                const uint16_t offset = static_cast<uint16_t>(entry[0] | (entry[1] << 8));
+                if (!is_compact_string_match(strings + offset, param.value_labels[j], sizeof(param.value_labels[j]))) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
     // =============================================================================
     // Hash Calculation Helpers
     // =============================================================================
@@ -1293,6 +1590,111 @@ namespace lzx {
         return (header.flags & vmprog_header_flags_v1_0::signed_pkg) != vmprog_header_flags_v1_0::none;
     }
 
+    /**
+     * @brief Refresh every hash covering one payload after it was edited in place.
+     *
+     * Only the edited payload is re-hashed: its TOC hash, the matching hash
+     * in the signed descriptor (artifact or config) and the descriptor's own
+     * TOC hash are updated. A signed package is re-signed when secret_key is
+     * given; without it the signature is left stale, out_signature_stale is
+     * set, and the signature must be replaced before the package will verify.
+     * The optional whole-file hash is recomputed only when the header
+     * carries one.
+     *
+     * @param file_data Complete file data (updated in place)
+     * @param file_size File size in bytes
+     * @param toc_index Index of the TOC entry whose payload changed
+     * @param secret_key Ed25519 secret key (64 bytes) to re-sign with, or nullptr
+     * @param out_signature_stale Set to true when the signature no longer matches
+     * @return Validation result
+     */
+    inline vmprog_validation_result rehash_vmprog_payload(
+        uint8_t* file_data,
+        uint32_t file_size,
+        uint32_t toc_index,
+        const uint8_t* secret_key,
+        bool& out_signature_stale
+    ) {
+        out_signature_stale = false;
+        if (file_size < sizeof(vmprog_header_v1_0)) {
+            return vmprog_validation_result::invalid_file_size;
+        }
+
+        auto& header = *reinterpret_cast<vmprog_header_v1_0*>(file_data);
+        auto result = validate_vmprog_header_v1_0(header, file_size);
+        if (result != vmprog_validation_result::ok) {
+            return result;
+        }
+        if (toc_index >= header.toc_count) {
+            return vmprog_validation_result::invalid_toc_entry;
+        }
+
+        auto* toc = reinterpret_cast<vmprog_toc_entry_v1_0*>(file_data + header.toc_offset);
+        auto& entry = toc[toc_index];
+        result = validate_vmprog_toc_entry_v1_0(entry, file_size);
+        if (result != vmprog_validation_result::ok) {
+            return result;
+        }
+        calculate_data_hash(file_data + entry.offset, entry.size, entry.sha256);
+
+        // Carry the new hash into the signed descriptor
+        uint32_t descriptor_index = 0;
+        const bool has_descriptor = find_toc_entry(
+            toc, header.toc_count, vmprog_toc_entry_type_v1_0::signed_descriptor, &descriptor_index) != nullptr;
+        if (has_descriptor && entry.type != vmprog_toc_entry_type_v1_0::signed_descriptor &&
+            entry.type != vmprog_toc_entry_type_v1_0::signature) {
+            auto& descriptor_entry = toc[descriptor_index];
+            result = validate_vmprog_toc_entry_v1_0(descriptor_entry, file_size);
+            if (result != vmprog_validation_result::ok) {
+                return result;
+            }
+            if (descriptor_entry.size != sizeof(vmprog_signed_descriptor_v1_0)) {
+                return vmprog_validation_result::invalid_toc_entry;
+            }
+
+            auto& descriptor = *reinterpret_cast<vmprog_signed_descriptor_v1_0*>(file_data + descriptor_entry.offset);
+            bool covered = false;
+            if (entry.type == vmprog_toc_entry_type_v1_0::config) {
+                memcpy(descriptor.config_sha256, entry.sha256, 32);
+                covered = true;
+            }
+            for (uint8_t i = 0; i < descriptor.artifact_count && i < vmprog_signed_descriptor_v1_0::max_artifacts; ++i) {
+                if (descriptor.artifacts[i].type == entry.type) {
+                    memcpy(descriptor.artifacts[i].sha256, entry.sha256, 32);
+                    covered = true;
+                }
+            }
+
+            if (covered) {
+                calculate_data_hash(file_data + descriptor_entry.offset, descriptor_entry.size, descriptor_entry.sha256);
+
+                uint32_t signature_index = 0;
+                const bool has_signature = find_toc_entry(
+                    toc, header.toc_count, vmprog_toc_entry_type_v1_0::signature, &signature_index) != nullptr;
+                if (is_package_signed(header) && has_signature && secret_key) {
+                    auto& signature_entry = toc[signature_index];
+                    result = validate_vmprog_toc_entry_v1_0(signature_entry, file_size);
+                    if (result != vmprog_validation_result::ok) {
+                        return result;
+                    }
+                    if (signature_entry.size != VMPROG_SIGNATURE_SIZE) {
+                        return vmprog_validation_result::invalid_toc_entry;
+                    }
+                    crypto_ed25519_sign(file_data + signature_entry.offset, secret_key,
+                                        file_data + descriptor_entry.offset, descriptor_entry.size);
+                    calculate_data_hash(file_data + signature_entry.offset, signature_entry.size, signature_entry.sha256);
+                } else if (is_package_signed(header)) {
+                    out_signature_stale = true;
+                }
+            }
+        }
+
+        if (!is_hash_zero(header.sha256_package)) {
+            calculate_package_sha256(file_data, file_size, header.sha256_package);
+        }
+        return vmprog_validation_result::ok;
+    }
+
     /**
      * @brief Get human-readable validation result string.
      *
@@ -1439,6 +1841,7 @@ namespace lzx {
      * 4. Package hash verification (if present)
      * 5. Signed descriptor validation (if present)
      * 6. Config validation (if present)
+     * 7. Compact config validation (if present), including that it decodes to the config
      *
      * @param file_data Complete file data
      * @param file_size File size in bytes
@@ -1495,8 +1898,9 @@ namespace lzx {
         const vmprog_toc_entry_v1_0* config_entry = find_toc_entry(
             toc, header->toc_count, vmprog_toc_entry_type_v1_0::config);
 
+        const vmprog_program_config_v1_0* config = nullptr;
         if (config_entry && config_entry->size == sizeof(vmprog_program_config_v1_0)) {
-            const auto* config = reinterpret_cast<const vmprog_program_config_v1_0*>(
+            config = reinterpret_cast<const vmprog_program_config_v1_0*>(
                 file_data + config_entry->offset);
             result = validate_vmprog_program_config_v1_0(*config);
             if (result != vmprog_validation_result::ok) {
@@ -1504,6 +1908,20 @@ namespace lzx {
             }
         }
 
+        // Validate the compact config if present; it must decode to the fixed config
+        const vmprog_toc_entry_v1_0* compact_entry = find_toc_entry(
+            toc, header->toc_count, vmprog_toc_entry_type_v1_0::config_compact);
+
+        if (compact_entry) {
+            result = validate_vmprog_compact_config_v1_0(file_data + compact_entry->offset, compact_entry->size);
+            if (result != vmprog_validation_result::ok) {
+                return result;
+            }
+            if (config && !is_compact_config_match(file_data + compact_entry->offset, *config)) {
+                return vmprog_validation_result::invalid_toc_entry;
+            }
+        }
+
         // Find and validate signed descriptor if present
         const vmprog_toc_entry_v1_0* desc_entry = find_toc_entry(
             toc, header->toc_count, vmprog_toc_entry_type_v1_0::signed_descriptor);
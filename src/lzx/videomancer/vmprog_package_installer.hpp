@@ -0,0 +1,544 @@
+// Videomancer SDK - Open source FPGA-based video effects development kit
+// Copyright (C) 2025 LZX Industries LLC
+// File: vmprog_package_installer.hpp - Streaming Package Installer
+// License: GNU General Public License v3.0
+// https://github.com/lzxindustries/videomancer-sdk
+//
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// Installation Overview:
+//   - The transport pushes package bytes in arbitrary chunks as they arrive
+//     (USB, serial); nothing needs the whole file in RAM
+//   - The header and TOC are parsed and validated as soon as their bytes are
+//     complete; each payload is hashed while it streams past and checked at
+//     its last byte, so corrupt packages are rejected mid-transfer
+//   - The signature is checked once the signed descriptor and signature have
+//     arrived, which is before the bitstreams in the standard layout
+//   - Bytes are written to a staging area in sector-sized, sector-aligned
+//     writes; the target commits the staged package only after every check
+//     has passed, otherwise it is told to abort
+//
+// Streaming Constraints:
+//   - All non-empty payloads must lie after the TOC and must not overlap
+//   - At most vmprog_stream_max_toc_entries TOC entries
+//   - A config payload is required
+
+#pragma once
+
+#include "vmprog_stream_reader.hpp"
+
+namespace lzx {
+
+    /**
+     * @brief Storage that receives a package being installed.
+     *
+     * Writes go to a staging area (a spare flash slot); commit() makes the
+     * staged package current in one atomic step, such as updating a slot
+     * pointer after the data is durable.
+     */
+    class vmprog_install_target {
+    public:
+        virtual ~vmprog_install_target() = default;
+
+        /**
+         * @brief Prepare the staging area (erase flash).
+         * @param size Package size in bytes
+         * @return true if the package fits
+         */
+        virtual bool begin(uint32_t size) = 0;
+
+        /**
+         * @brief Write staged bytes.
+         *
+         * offset is a multiple of the sector size and size equals the sector
+         * size, except for the final write which may be shorter.
+         * @return true on success
+         */
+        virtual bool write(uint32_t offset, const uint8_t* data, uint32_t size) = 0;
+
+        /**
+         * @brief Make the fully written and verified package current.
+         * @return true on success
+         */
+        virtual bool commit() = 0;
+
+        /**
+         * @brief Discard the staged package.
+         */
+        virtual void abort() {}
+    };
+
+    /**
+     * @brief Installer state.
+     */
+    enum class vmprog_install_state : uint8_t {
+        idle = 0,       // begin() not called
+        receiving = 1,  // Waiting for more bytes
+        committed = 2,  // Verified and committed
+        failed = 3,     // See result()
+    };
+
+    /**
+     * @brief Push-style package installer with on-the-fly verification.
+     *
+     * Example:
+     *   uint8_t sector[4096];
+     *   vmprog_package_installer installer(sector, sizeof(sector));
+     *   installer.begin(flash_slot);
+     *   while (installer.state() == vmprog_install_state::receiving) {
+     *       size_t n = usb_read(packet, sizeof(packet));
+     *       installer.feed(packet, n);
+     *   }
+     */
+    class vmprog_package_installer {
+    public:
+        /**
+         * @brief Construct installer.
+         *
+         * @param sector_buffer Write buffer of one flash sector
+         * @param sector_size Size of sector_buffer (at least the header size)
+         */
+        vmprog_package_installer(uint8_t* sector_buffer, uint32_t sector_size)
+            : sector_(sector_buffer), sector_size_(sector_size) {}
+
+        /**
+         * @brief Start a new installation.
+         *
+         * Any installation in progress is aborted.
+         *
+         * @param target Storage for the package
+         * @param public_key Public key (32 bytes), nullptr for built-in keys
+         * @param allow_unsigned Accept unsigned packages, verified against TOC hashes
+         * @return false if the sector buffer is unusable
+         */
+        bool begin(vmprog_install_target& target, const uint8_t* public_key = nullptr, bool allow_unsigned = false) {
+            abort();
+            if (!sector_ || sector_size_ < sizeof(vmprog_header_v1_0)) return false;
+
+            target_ = &target;
+            public_key_ = public_key;
+            allow_unsigned_ = allow_unsigned;
+            position_ = 0;
+            sector_fill_ = 0;
+            sector_offset_ = 0;
+            target_begun_ = false;
+            payload_count_ = 0;
+            next_payload_ = 0;
+            payload_started_ = false;
+            signature_checked_ = false;
+            config_entry_ = nullptr;
+            descriptor_entry_ = nullptr;
+            signature_entry_ = nullptr;
+            memset(&header_, 0, sizeof(header_));
+            sha256_init(package_hash_);
+            result_ = vmprog_validation_result::ok;
+            state_ = vmprog_install_state::receiving;
+            return true;
+        }
+
+        /**
+         * @brief Consume the next bytes of the package.
+         *
+         * The package commits when its last byte arrives. Bytes beyond the
+         * header's file_size fail the installation.
+         *
+         * @return State after the bytes are processed
+         */
+        vmprog_install_state feed(const uint8_t* data, uint32_t size) {
+            while (size > 0 && state_ == vmprog_install_state::receiving && !is_complete()) {
+                const uint32_t n = segment_length(size);
+                consume(data, n);
+                data += n;
+                size -= n;
+            }
+            if (state_ == vmprog_install_state::receiving && is_complete()) {
+                if (size > 0) {
+                    fail(vmprog_validation_result::invalid_file_size);
+                } else {
+                    on_complete();
+                }
+            }
+            return state_;
+        }
+
+        /**
+         * @brief Abandon the installation (e.g. the transfer was cut short).
+         */
+        void abort() {
+            if (state_ == vmprog_install_state::receiving && target_begun_) {
+                target_->abort();
+            }
+            state_ = vmprog_install_state::idle;
+            target_ = nullptr;
+        }
+
+        /**
+         * @brief Current state.
+         */
+        vmprog_install_state state() const { return state_; }
+
+        /**
+         * @brief Whether the package was verified and committed.
+         */
+        bool is_committed() const { return state_ == vmprog_install_state::committed; }
+
+        /**
+         * @brief Failure reason (ok unless failed).
+         */
+        vmprog_validation_result result() const { return result_; }
+
+        /**
+         * @brief Bytes consumed so far.
+         */
+        uint32_t bytes_received() const { return position_; }
+
+        /**
+         * @brief Package size from the header (0 until the header arrives).
+         */
+        uint32_t file_size() const { return target_begun_ ? header_.file_size : 0; }
+
+        /**
+         * @brief Installed program configuration (valid when committed).
+         */
+        const vmprog_program_config_v1_0& config() const { return config_; }
+
+    private:
+        uint8_t* sector_;
+        uint32_t sector_size_;
+        vmprog_install_target* target_ = nullptr;
+        const uint8_t* public_key_ = nullptr;
+        bool allow_unsigned_ = false;
+        vmprog_install_state state_ = vmprog_install_state::idle;
+        vmprog_validation_result result_ = vmprog_validation_result::ok;
+
+        uint32_t position_ = 0;
+        uint32_t sector_fill_ = 0;
+        uint32_t sector_offset_ = 0;
+        bool target_begun_ = false;
+
+        vmprog_header_v1_0 header_ = {};
+        vmprog_toc_entry_v1_0 toc_[vmprog_stream_max_toc_entries] = {};
+        const vmprog_toc_entry_v1_0* payloads_[vmprog_stream_max_toc_entries] = {};
+        uint32_t payload_count_ = 0;
+        uint32_t next_payload_ = 0;
+        bool payload_started_ = false;
+        sha256_ctx payload_hash_ = {};
+        sha256_ctx package_hash_ = {};
+
+        const vmprog_toc_entry_v1_0* config_entry_ = nullptr;
+        const vmprog_toc_entry_v1_0* descriptor_entry_ = nullptr;
+        const vmprog_toc_entry_v1_0* signature_entry_ = nullptr;
+        vmprog_program_config_v1_0 config_ = {};
+        vmprog_signed_descriptor_v1_0 descriptor_ = {};
+        uint8_t signature_[VMPROG_SIGNATURE_SIZE] = {};
+        bool signature_checked_ = false;
+
+        uint32_t toc_end() const { return header_.toc_offset + header_.toc_bytes; }
+
+        bool is_complete() const { return target_begun_ && position_ == header_.file_size; }
+
+        void fail(vmprog_validation_result result) {
+            if (target_begun_) {
+                target_->abort();
+            }
+            result_ = result;
+            state_ = vmprog_install_state::failed;
+        }
+
+        /**
+         * @brief Bytes until the next point where parsing has to act.
+         */
+        uint32_t segment_length(uint32_t available) const {
+            uint32_t boundary;
+            if (position_ < sizeof(vmprog_header_v1_0)) {
+                boundary = sizeof(vmprog_header_v1_0);
+            } else if (position_ < header_.toc_offset) {
+                boundary = header_.toc_offset;
+            } else if (position_ < toc_end()) {
+                boundary = toc_end();
+            } else if (next_payload_ < payload_count_) {
+                const vmprog_toc_entry_v1_0& entry = *payloads_[next_payload_];
+                boundary = (position_ < entry.offset) ? entry.offset : entry.offset + entry.size;
+            } else {
+                boundary = header_.file_size;
+            }
+            const uint32_t length = boundary - position_;
+            return (available < length) ? available : length;
+        }
+
+        /**
+         * @brief Process bytes that lie within a single parsing region.
+         */
+        void consume(const uint8_t* data, uint32_t size) {
+            const uint32_t start = position_;
+            hash_package_bytes(data, size);
+
+            if (start < sizeof(vmprog_header_v1_0)) {
+                memcpy(reinterpret_cast<uint8_t*>(&header_) + start, data, size);
+            } else if (start >= header_.toc_offset && start < toc_end()) {
+                memcpy(reinterpret_cast<uint8_t*>(toc_) + (start - header_.toc_offset), data, size);
+            } else if (next_payload_ < payload_count_ && start >= payloads_[next_payload_]->offset) {
+                consume_payload(*payloads_[next_payload_], start, data, size);
+            }
+
+            position_ += size;
+            if (position_ == sizeof(vmprog_header_v1_0)) {
+                on_header();
+                if (state_ != vmprog_install_state::receiving) return;
+            }
+            if (!stage(data, size)) {
+                fail(vmprog_validation_result::invalid_file_size);
+                return;
+            }
+
+            if (state_ == vmprog_install_state::receiving && position_ == toc_end()) {
+                on_toc();
+            }
+            if (state_ == vmprog_install_state::receiving && next_payload_ < payload_count_ &&
+                position_ == payloads_[next_payload_]->offset + payloads_[next_payload_]->size) {
+                on_payload(*payloads_[next_payload_]);
+                ++next_payload_;
+                payload_started_ = false;
+            }
+        }
+
+        void hash_package_bytes(const uint8_t* data, uint32_t size) {
+            // sha256_package (header bytes 32-63) is hashed as zeros
+            const uint32_t field_begin = 32;
+            const uint32_t field_end = sizeof(vmprog_header_v1_0);
+            if (position_ >= field_end || position_ + size <= field_begin) {
+                sha256_update(package_hash_, data, size);
+                return;
+            }
+            static const uint8_t zeros[32] = {};
+            for (uint32_t i = 0; i < size; ++i) {
+                const uint32_t at = position_ + i;
+                sha256_update(package_hash_, (at >= field_begin && at < field_end) ? zeros : data + i, 1);
+            }
+        }
+
+        void consume_payload(const vmprog_toc_entry_v1_0& entry, uint32_t start, const uint8_t* data, uint32_t size) {
+            if (!payload_started_) {
+                sha256_init(payload_hash_);
+                payload_started_ = true;
+            }
+            sha256_update(payload_hash_, data, size);
+
+            const uint32_t at = start - entry.offset;
+            if (&entry == config_entry_) {
+                memcpy(reinterpret_cast<uint8_t*>(&config_) + at, data, size);
+            } else if (&entry == descriptor_entry_) {
+                memcpy(reinterpret_cast<uint8_t*>(&descriptor_) + at, data, size);
+            } else if (&entry == signature_entry_) {
+                memcpy(signature_ + at, data, size);
+            }
+        }
+
+        bool stage(const uint8_t* data, uint32_t size) {
+            while (size > 0) {
+                const uint32_t space = sector_size_ - sector_fill_;
+                const uint32_t n = (size < space) ? size : space;
+                memcpy(sector_ + sector_fill_, data, n);
+                sector_fill_ += n;
+                data += n;
+                size -= n;
+                if (sector_fill_ == sector_size_ && !flush_sector()) return false;
+            }
+            return true;
+        }
+
+        bool flush_sector() {
+            // The sector buffer holds at least the header, so the target
+            // has been started by the time anything is written
+            if (sector_fill_ == 0) return true;
+            if (!target_begun_ || !target_->write(sector_offset_, sector_, sector_fill_)) return false;
+            sector_offset_ += sector_fill_;
+            sector_fill_ = 0;
+            return true;
+        }
+
+        void on_header() {
+            auto result = validate_vmprog_header_v1_0(header_, header_.file_size);
+            if (result != vmprog_validation_result::ok) {
+                fail(result);
+                return;
+            }
+            if (header_.toc_count > vmprog_stream_max_toc_entries) {
+                fail(vmprog_validation_result::invalid_toc_count);
+                return;
+            }
+            if (!is_package_signed(header_) && !allow_unsigned_) {
+                fail(vmprog_validation_result::invalid_hash);
+                return;
+            }
+            if (!target_->begin(header_.file_size)) {
+                fail(vmprog_validation_result::invalid_file_size);
+                return;
+            }
+            target_begun_ = true;
+        }
+
+        void on_toc() {
+            const uint32_t count = header_.toc_count;
+            payload_count_ = 0;
+            for (uint32_t i = 0; i < count; ++i) {
+                auto result = validate_vmprog_toc_entry_v1_0(toc_[i], header_.file_size);
+                if (result != vmprog_validation_result::ok) {
+                    fail(result);
+                    return;
+                }
+
+                if (toc_[i].size == 0) {
+                    // Nothing will stream past; check the empty hash now
+                    if (!verify_hash(nullptr, 0, toc_[i].sha256)) {
+                        fail(vmprog_validation_result::invalid_hash);
+                        return;
+                    }
+                    continue;
+                }
+
+                // Insertion sort by offset
+                uint32_t j = payload_count_++;
+                while (j > 0 && payloads_[j - 1]->offset > toc_[i].offset) {
+                    payloads_[j] = payloads_[j - 1];
+                    --j;
+                }
+                payloads_[j] = &toc_[i];
+            }
+
+            uint32_t end = toc_end();
+            for (uint32_t i = 0; i < payload_count_; ++i) {
+                if (payloads_[i]->offset < end) {
+                    fail(vmprog_validation_result::invalid_payload_offset);
+                    return;
+                }
+                end = payloads_[i]->offset + payloads_[i]->size;
+            }
+
+            config_entry_ = find_toc_entry(toc_, count, vmprog_toc_entry_type_v1_0::config);
+            if (!config_entry_ || config_entry_->size != sizeof(vmprog_program_config_v1_0)) {
+                fail(vmprog_validation_result::invalid_toc_entry);
+                return;
+            }
+
+            if (is_package_signed(header_)) {
+                descriptor_entry_ = find_toc_entry(toc_, count, vmprog_toc_entry_type_v1_0::signed_descriptor);
+                signature_entry_ = find_toc_entry(toc_, count, vmprog_toc_entry_type_v1_0::signature);
+                if (!descriptor_entry_ || descriptor_entry_->size != sizeof(vmprog_signed_descriptor_v1_0) ||
+                    !signature_entry_ || signature_entry_->size != VMPROG_SIGNATURE_SIZE) {
+                    fail(vmprog_validation_result::invalid_toc_entry);
+                    return;
+                }
+            }
+        }
+
+        void on_payload(const vmprog_toc_entry_v1_0& entry) {
+            uint8_t actual[32];
+            sha256_final(payload_hash_, actual);
+            if (!secure_compare_hash(actual, entry.sha256)) {
+                fail(vmprog_validation_result::invalid_hash);
+                return;
+            }
+
+            if (&entry == config_entry_) {
+                auto result = validate_vmprog_program_config_v1_0(config_);
+                if (result != vmprog_validation_result::ok) {
+                    fail(result);
+                    return;
+                }
+            }
+
+            const bool have_descriptor = descriptor_entry_ &&
+                position_ >= descriptor_entry_->offset + descriptor_entry_->size;
+            const bool have_signature = signature_entry_ &&
+                position_ >= signature_entry_->offset + signature_entry_->size;
+            if (!signature_checked_ && have_descriptor && have_signature) {
+                check_signature();
+            }
+        }
+
+        void check_signature() {
+            signature_checked_ = true;
+
+            auto result = validate_vmprog_signed_descriptor_v1_0(descriptor_);
+            if (result != vmprog_validation_result::ok) {
+                fail(result);
+                return;
+            }
+
+            const bool verified = public_key_
+                ? verify_ed25519_signature(signature_, public_key_, descriptor_)
+                : verify_with_builtin_keys(signature_, descriptor_);
+            if (!verified) {
+                fail(vmprog_validation_result::invalid_hash);
+                return;
+            }
+
+            // TOC hashes are checked against the data as it streams, so
+            // binding them to the descriptor binds the data to the signature
+            if (!secure_compare_hash(descriptor_.config_sha256, config_entry_->sha256)) {
+                fail(vmprog_validation_result::invalid_hash);
+                return;
+            }
+            for (uint32_t i = 0; i < descriptor_.artifact_count; ++i) {
+                const vmprog_toc_entry_v1_0* entry = find_toc_entry(toc_, header_.toc_count, descriptor_.artifacts[i].type);
+                if (!entry) {
+                    fail(vmprog_validation_result::invalid_toc_entry);
+                    return;
+                }
+                if (!secure_compare_hash(descriptor_.artifacts[i].sha256, entry->sha256)) {
+                    fail(vmprog_validation_result::invalid_hash);
+                    return;
+                }
+            }
+
+            // No bitstream the device could load may be left unsigned
+            for (uint32_t i = 0; i < header_.toc_count; ++i) {
+                const auto type = static_cast<uint32_t>(toc_[i].type);
+                if (type < static_cast<uint32_t>(vmprog_toc_entry_type_v1_0::fpga_bitstream) ||
+                    type > static_cast<uint32_t>(vmprog_toc_entry_type_v1_0::bitstream_hd_dual)) {
+                    continue;
+                }
+                if (!find_descriptor_artifact(descriptor_, toc_[i].type)) {
+                    fail(vmprog_validation_result::invalid_toc_entry);
+                    return;
+                }
+            }
+        }
+
+        void on_complete() {
+            if (!flush_sector()) {
+                fail(vmprog_validation_result::invalid_file_size);
+                return;
+            }
+
+            uint8_t actual[32];
+            sha256_final(package_hash_, actual);
+            if (!is_hash_zero(header_.sha256_package) && !secure_compare_hash(actual, header_.sha256_package)) {
+                fail(vmprog_validation_result::invalid_hash);
+                return;
+            }
+            if (is_package_signed(header_) && !signature_checked_) {
+                fail(vmprog_validation_result::invalid_hash);
+                return;
+            }
+            if (!target_->commit()) {
+                fail(vmprog_validation_result::invalid_file_size);
+                return;
+            }
+            state_ = vmprog_install_state::committed;
+        }
+    };
+
+} // namespace lzx
@@ -444,11 +444,14 @@ namespace lzx {
      * First applies the control curve transformation, then scales the result
      * from 0-1023 to the parameter's configured min/max range.
      *
+     * @tparam ParameterConfig vmprog_parameter_config_v1_0 or a type with the same
+     *         fields, such as vmprog_compact_parameter_view
      * @param value Input value (any int32_t, will be wrapped for polar modes or clamped for others)
      * @param mode Parameter configuration including control mode and min/max
      * @return Scaled output value within parameter's min/max range
      */
-    constexpr uint16_t apply_parameter_control_curve_and_scaling(int32_t value, const vmprog_parameter_config_v1_0& mode)
+    template<typename ParameterConfig>
+    constexpr uint16_t apply_parameter_control_curve_and_scaling(int32_t value, const ParameterConfig& mode)
     {
         const uint16_t curved = apply_parameter_control_curve(value, mode.control_mode);
         const uint32_t scaled = mode.min_value + ((static_cast<uint32_t>(curved) * (mode.max_value - mode.min_value)) / 1023);
@@ -473,12 +476,15 @@ namespace lzx {
      * and appending any suffix label. Uses integer-based fixed-point
      * arithmetic for embedded systems compatibility.
      *
+     * @tparam ParameterConfig vmprog_parameter_config_v1_0 or a type with the same
+     *         fields, such as vmprog_compact_parameter_view
      * @param value Raw parameter value (0-1023)
      * @param config Parameter configuration including display settings
      * @param out_str Output string buffer
      * @param out_str_size Size of output string buffer
      */
-    constexpr void generate_parameter_value_display_string(int32_t value, const vmprog_parameter_config_v1_0& config, char* out_str, size_t out_str_size)
+    template<typename ParameterConfig>
+    constexpr void generate_parameter_value_display_string(int32_t value, const ParameterConfig& config, char* out_str, size_t out_str_size)
     {
         if (out_str_size == 0) return;
 
@@ -0,0 +1,419 @@
+// Videomancer SDK - Open source FPGA-based video effects development kit
+// Copyright (C) 2025 LZX Industries LLC
+// File: vmprog_program_preloader.hpp - Background Program Preloading
+// License: GNU General Public License v3.0
+// https://github.com/lzxindustries/videomancer-sdk
+//
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// Preloading Overview:
+//   - While the current program runs, the preloader opens the next likely
+//     package, verifies it and stages its config and one bitstream variant
+//   - Work is split into bounded steps (one chunk of I/O each) so the caller
+//     can interleave preloading with its main loop
+//   - Signed packages are verified against the signed descriptor; unsigned
+//     packages against their TOC hashes when explicitly allowed
+//   - Bitstream bytes go to a vmprog_preload_sink (RAM buffer or a reserved
+//     flash region); the switch itself only pushes the staged bitstream
+
+#pragma once
+
+#include "vmprog_stream_reader.hpp"
+
+namespace lzx {
+
+    /**
+     * @brief Destination for a staged bitstream.
+     *
+     * Bytes are written sequentially. abort() is called if verification fails
+     * after some bytes have been written.
+     */
+    class vmprog_preload_sink {
+    public:
+        virtual ~vmprog_preload_sink() = default;
+
+        /**
+         * @brief Prepare to receive a bitstream (reserve RAM, erase flash).
+         * @param size Bitstream size in bytes
+         * @return true if the sink can hold size bytes
+         */
+        virtual bool begin(uint32_t size) = 0;
+
+        /**
+         * @brief Append bitstream bytes.
+         * @return true on success
+         */
+        virtual bool write(const uint8_t* data, uint32_t size) = 0;
+
+        /**
+         * @brief Discard a partially staged bitstream.
+         */
+        virtual void abort() {}
+    };
+
+    /**
+     * @brief Preload sink backed by a caller-provided RAM buffer.
+     */
+    class vmprog_preload_buffer : public vmprog_preload_sink {
+    public:
+        vmprog_preload_buffer(uint8_t* buffer, uint32_t capacity)
+            : buffer_(buffer), capacity_(capacity) {}
+
+        bool begin(uint32_t size) override {
+            size_ = 0;
+            return buffer_ != nullptr && size <= capacity_;
+        }
+
+        bool write(const uint8_t* data, uint32_t size) override {
+            if (size > capacity_ - size_) return false;
+            memcpy(buffer_ + size_, data, size);
+            size_ += size;
+            return true;
+        }
+
+        void abort() override { size_ = 0; }
+
+        /**
+         * @brief Staged bitstream data.
+         */
+        const uint8_t* data() const { return buffer_; }
+
+        /**
+         * @brief Number of bytes staged.
+         */
+        uint32_t size() const { return size_; }
+
+    private:
+        uint8_t* buffer_;
+        uint32_t capacity_;
+        uint32_t size_ = 0;
+    };
+
+    /**
+     * @brief Preloader state.
+     */
+    enum class vmprog_preload_state : uint8_t {
+        idle = 0,       // Nothing requested
+        header = 1,     // Next step reads header and TOC
+        signature = 2,  // Next step verifies the signed descriptor
+        config = 3,     // Next step reads and verifies the config
+        bitstream = 4,  // Steps stage one bitstream chunk each
+        ready = 5,      // Config and bitstream staged and verified
+        failed = 6,     // See result()
+    };
+
+    /**
+     * @brief Step-driven background program preloader.
+     *
+     * Example:
+     *   vmprog_preload_buffer staging(flash_window, sizeof(flash_window));
+     *   preloader.begin(next_stream, next_size, vmprog_toc_entry_type_v1_0::bitstream_hd_analog, staging);
+     *   while (running) {
+     *       process_video_and_controls();
+     *       preloader.step();   // bounded: at most one chunk of I/O and hashing
+     *   }
+     *   // On switch: if preloader.is_ready(), push staging.data() to the FPGA
+     */
+    class vmprog_program_preloader {
+    public:
+        /**
+         * @brief Construct preloader.
+         *
+         * @param chunk_buffer Scratch buffer; its size sets the bytes staged per step
+         * @param chunk_size Size of chunk_buffer
+         */
+        vmprog_program_preloader(uint8_t* chunk_buffer, uint32_t chunk_size)
+            : chunk_(chunk_buffer), chunk_size_(chunk_size) {}
+
+        /**
+         * @brief Start preloading a package.
+         *
+         * Any preload in progress is cancelled. No I/O happens until step().
+         *
+         * @param stream Package stream (must stay valid until ready, failed or cancel)
+         * @param file_size Package size in bytes
+         * @param bitstream_type Bitstream variant to stage
+         * @param sink Destination for the bitstream
+         * @param public_key Public key (32 bytes), nullptr for built-in keys
+         * @param allow_unsigned Accept unsigned packages, verified against TOC hashes
+         * @return false if the chunk buffer is unusable
+         */
+        bool begin(
+            vmprog_stream& stream,
+            uint32_t file_size,
+            vmprog_toc_entry_type_v1_0 bitstream_type,
+            vmprog_preload_sink& sink,
+            const uint8_t* public_key = nullptr,
+            bool allow_unsigned = false
+        ) {
+            cancel();
+            if (!chunk_ || chunk_size_ == 0) return false;
+
+            stream_ = &stream;
+            sink_ = &sink;
+            file_size_ = file_size;
+            bitstream_type_ = bitstream_type;
+            public_key_ = public_key;
+            allow_unsigned_ = allow_unsigned;
+            bitstream_offset_ = 0;
+            result_ = vmprog_validation_result::ok;
+            state_ = vmprog_preload_state::header;
+            return true;
+        }
+
+        /**
+         * @brief Perform one bounded unit of work.
+         *
+         * @return State after the step
+         */
+        vmprog_preload_state step() {
+            switch (state_) {
+                case vmprog_preload_state::header: step_header(); break;
+                case vmprog_preload_state::signature: step_signature(); break;
+                case vmprog_preload_state::config: step_config(); break;
+                case vmprog_preload_state::bitstream: step_bitstream(); break;
+                default: break;
+            }
+            return state_;
+        }
+
+        /**
+         * @brief Step until ready or failed (foreground preload).
+         */
+        vmprog_preload_state run() {
+            while (is_busy()) step();
+            return state_;
+        }
+
+        /**
+         * @brief Abandon the current preload.
+         */
+        void cancel() {
+            if (state_ == vmprog_preload_state::bitstream && sink_) {
+                sink_->abort();
+            }
+            state_ = vmprog_preload_state::idle;
+            stream_ = nullptr;
+        }
+
+        /**
+         * @brief Current state.
+         */
+        vmprog_preload_state state() const { return state_; }
+
+        /**
+         * @brief Whether more steps are needed.
+         */
+        bool is_busy() const {
+            return state_ != vmprog_preload_state::idle &&
+                   state_ != vmprog_preload_state::ready &&
+                   state_ != vmprog_preload_state::failed;
+        }
+
+        /**
+         * @brief Whether a verified program is staged.
+         */
+        bool is_ready() const { return state_ == vmprog_preload_state::ready; }
+
+        /**
+         * @brief Failure reason (ok unless failed).
+         */
+        vmprog_validation_result result() const { return result_; }
+
+        /**
+         * @brief Staged program configuration (valid when ready).
+         */
+        const vmprog_program_config_v1_0& config() const { return config_; }
+
+        /**
+         * @brief Staged bitstream variant.
+         */
+        vmprog_toc_entry_type_v1_0 bitstream_type() const { return bitstream_type_; }
+
+        /**
+         * @brief Total bitstream size (valid once config is staged).
+         */
+        uint32_t bitstream_size() const { return bitstream_entry_.size; }
+
+        /**
+         * @brief Bitstream bytes staged so far.
+         */
+        uint32_t bitstream_staged() const { return bitstream_offset_; }
+
+        /**
+         * @brief Verified SHA-256 of the staged bitstream (valid when ready).
+         *
+         * Pass to videomancer_program_switcher to skip reconfiguration when
+         * the FPGA already runs this bitstream.
+         */
+        const uint8_t* bitstream_sha256() const { return expected_bitstream_hash_; }
+
+    private:
+        uint8_t* chunk_;
+        uint32_t chunk_size_;
+        vmprog_stream* stream_ = nullptr;
+        vmprog_preload_sink* sink_ = nullptr;
+        uint32_t file_size_ = 0;
+        vmprog_toc_entry_type_v1_0 bitstream_type_ = vmprog_toc_entry_type_v1_0::none;
+        const uint8_t* public_key_ = nullptr;
+        bool allow_unsigned_ = false;
+        vmprog_preload_state state_ = vmprog_preload_state::idle;
+        vmprog_validation_result result_ = vmprog_validation_result::ok;
+
+        vmprog_header_v1_0 header_ = {};
+        vmprog_toc_entry_v1_0 toc_[vmprog_stream_max_toc_entries] = {};
+        vmprog_toc_entry_v1_0 config_entry_ = {};
+        vmprog_toc_entry_v1_0 bitstream_entry_ = {};
+        uint8_t expected_config_hash_[32] = {};
+        uint8_t expected_bitstream_hash_[32] = {};
+        vmprog_program_config_v1_0 config_ = {};
+        sha256_ctx hash_ = {};
+        uint32_t bitstream_offset_ = 0;
+
+        void fail(vmprog_validation_result result) {
+            if (state_ == vmprog_preload_state::bitstream) {
+                sink_->abort();
+            }
+            result_ = result;
+            state_ = vmprog_preload_state::failed;
+        }
+
+        void step_header() {
+            auto result = read_and_validate_vmprog_header(*stream_, file_size_, header_);
+            if (result == vmprog_validation_result::ok) {
+                result = read_and_validate_vmprog_toc(*stream_, header_, file_size_, toc_, vmprog_stream_max_toc_entries);
+            }
+            if (result != vmprog_validation_result::ok) {
+                fail(result);
+                return;
+            }
+
+            const vmprog_toc_entry_v1_0* config = find_toc_entry(toc_, header_.toc_count, vmprog_toc_entry_type_v1_0::config);
+            const vmprog_toc_entry_v1_0* bitstream = find_toc_entry(toc_, header_.toc_count, bitstream_type_);
+            if (!config || !bitstream) {
+                fail(vmprog_validation_result::invalid_toc_entry);
+                return;
+            }
+            config_entry_ = *config;
+            bitstream_entry_ = *bitstream;
+
+            if (is_package_signed(header_)) {
+                state_ = vmprog_preload_state::signature;
+            } else if (allow_unsigned_) {
+                memcpy(expected_config_hash_, config_entry_.sha256, 32);
+                memcpy(expected_bitstream_hash_, bitstream_entry_.sha256, 32);
+                state_ = vmprog_preload_state::config;
+            } else {
+                fail(vmprog_validation_result::invalid_hash);
+            }
+        }
+
+        void step_signature() {
+            const vmprog_toc_entry_v1_0* desc_entry = find_toc_entry(
+                toc_, header_.toc_count, vmprog_toc_entry_type_v1_0::signed_descriptor);
+            const vmprog_toc_entry_v1_0* sig_entry = find_toc_entry(
+                toc_, header_.toc_count, vmprog_toc_entry_type_v1_0::signature);
+            if (!desc_entry || !sig_entry) {
+                fail(vmprog_validation_result::invalid_toc_entry);
+                return;
+            }
+
+            vmprog_signed_descriptor_v1_0 descriptor;
+            auto result = read_and_validate_signed_descriptor(*stream_, *desc_entry, descriptor);
+            if (result != vmprog_validation_result::ok) {
+                fail(result);
+                return;
+            }
+
+            uint8_t signature[64];
+            if (!read_signature(*stream_, *sig_entry, signature)) {
+                fail(vmprog_validation_result::invalid_hash);
+                return;
+            }
+
+            const bool verified = public_key_
+                ? verify_ed25519_signature(signature, public_key_, descriptor)
+                : verify_with_builtin_keys(signature, descriptor);
+            const vmprog_artifact_hash_v1_0* artifact = find_descriptor_artifact(descriptor, bitstream_type_);
+            if (!verified) {
+                fail(vmprog_validation_result::invalid_hash);
+                return;
+            }
+            if (!artifact) {
+                fail(vmprog_validation_result::invalid_toc_entry);
+                return;
+            }
+
+            memcpy(expected_config_hash_, descriptor.config_sha256, 32);
+            memcpy(expected_bitstream_hash_, artifact->sha256, 32);
+            state_ = vmprog_preload_state::config;
+        }
+
+        void step_config() {
+            auto result = read_vmprog_config(*stream_, config_entry_, config_);
+            if (result != vmprog_validation_result::ok) {
+                fail(result);
+                return;
+            }
+            if (!verify_hash(reinterpret_cast<const uint8_t*>(&config_), sizeof(config_), expected_config_hash_)) {
+                fail(vmprog_validation_result::invalid_hash);
+                return;
+            }
+            result = validate_vmprog_program_config_v1_0(config_);
+            if (result != vmprog_validation_result::ok) {
+                fail(result);
+                return;
+            }
+
+            if (!sink_->begin(bitstream_entry_.size)) {
+                fail(vmprog_validation_result::invalid_file_size);
+                return;
+            }
+            sha256_init(hash_);
+            bitstream_offset_ = 0;
+            state_ = vmprog_preload_state::bitstream;
+        }
+
+        void step_bitstream() {
+            const uint32_t remaining = bitstream_entry_.size - bitstream_offset_;
+            const uint32_t chunk = (remaining < chunk_size_) ? remaining : chunk_size_;
+
+            // Seek every step: the caller may share the stream between steps
+            if (chunk > 0) {
+                if (!stream_->seek(bitstream_entry_.offset + bitstream_offset_) ||
+                    stream_->read(chunk_, chunk) != chunk) {
+                    fail(vmprog_validation_result::invalid_payload_offset);
+                    return;
+                }
+                sha256_update(hash_, chunk_, chunk);
+                if (!sink_->write(chunk_, chunk)) {
+                    fail(vmprog_validation_result::invalid_file_size);
+                    return;
+                }
+                bitstream_offset_ += chunk;
+            }
+
+            if (bitstream_offset_ == bitstream_entry_.size) {
+                uint8_t actual[32];
+                sha256_final(hash_, actual);
+                if (!secure_compare_hash(actual, expected_bitstream_hash_)) {
+                    fail(vmprog_validation_result::invalid_hash);
+                    return;
+                }
+                state_ = vmprog_preload_state::ready;
+            }
+        }
+    };
+
+} // namespace lzx
@@ -449,6 +449,25 @@ inline vmprog_validation_result verify_all_payload_hashes_stream(
     return vmprog_validation_result::ok;
 }
 
+/**
+ * @brief Find the signed hash for an artifact type in a descriptor.
+ *
+ * @param descriptor Validated signed descriptor
+ * @param type Artifact type to look up
+ * @return Pointer to artifact entry, or nullptr if not listed
+ */
+inline const vmprog_artifact_hash_v1_0* find_descriptor_artifact(
+    const vmprog_signed_descriptor_v1_0& descriptor,
+    vmprog_toc_entry_type_v1_0 type
+) {
+    for (uint32_t i = 0; i < descriptor.artifact_count && i < vmprog_signed_descriptor_v1_0::max_artifacts; ++i) {
+        if (descriptor.artifacts[i].type == type) {
+            return &descriptor.artifacts[i];
+        }
+    }
+    return nullptr;
+}
+
 /**
  * @brief Read and verify package signature using stream.
  *
@@ -549,6 +568,106 @@ inline vmprog_validation_result verify_package_signature_builtin_keys_stream(
     return vmprog_validation_result::ok;
 }
 
+/**
+ * @brief Read the signed descriptor and check its Ed25519 signature.
+ *
+ * @param stream Input stream
+ * @param toc TOC entries array
+ * @param toc_count Number of TOC entries
+ * @param public_key Public key for verification (32 bytes, nullptr for built-in keys)
+ * @param out_descriptor Output descriptor, trusted only if ok is returned
+ * @param out_key_index Optional output parameter for which built-in key succeeded
+ * @return Validation result code
+ */
+inline vmprog_validation_result read_and_verify_signed_descriptor_stream(
+    vmprog_stream& stream,
+    const vmprog_toc_entry_v1_0* toc,
+    uint32_t toc_count,
+    const uint8_t* public_key,
+    vmprog_signed_descriptor_v1_0& out_descriptor,
+    size_t* out_key_index = nullptr
+) {
+    // Find signed descriptor
+    const vmprog_toc_entry_v1_0* desc_entry = find_toc_entry(
+        toc, toc_count, vmprog_toc_entry_type_v1_0::signed_descriptor);
+    if (!desc_entry) {
+        return vmprog_validation_result::invalid_toc_entry;
+    }
+
+    // Read descriptor
+    auto result = read_and_validate_signed_descriptor(stream, *desc_entry, out_descriptor);
+    if (result != vmprog_validation_result::ok) {
+        return result;
+    }
+
+    // Find and read signature
+    const vmprog_toc_entry_v1_0* sig_entry = find_toc_entry(
+        toc, toc_count, vmprog_toc_entry_type_v1_0::signature);
+    if (!sig_entry) {
+        return vmprog_validation_result::invalid_toc_entry;
+    }
+
+    uint8_t signature[64];
+    if (!read_signature(stream, *sig_entry, signature)) {
+        return vmprog_validation_result::invalid_hash;
+    }
+
+    if (public_key) {
+        if (!verify_ed25519_signature(signature, public_key, out_descriptor)) {
+            return vmprog_validation_result::invalid_hash;
+        }
+    } else if (!verify_with_builtin_keys(signature, out_descriptor, out_key_index)) {
+        return vmprog_validation_result::invalid_hash;
+    }
+
+    return vmprog_validation_result::ok;
+}
+
+/**
+ * @brief Read a config_compact payload and check it against a hash and the fixed config.
+ *
+ * The payload is read once into buffer; the hash, layout and decode checks all
+ * run on that copy.
+ *
+ * @param stream Input stream
+ * @param entry config_compact TOC entry
+ * @param expected_hash Hash the payload must match (32 bytes), or nullptr to skip
+ * @param config Fixed config it must decode to, or nullptr to skip
+ * @param buffer Payload storage (at least entry.size bytes)
+ * @param capacity Size of buffer
+ * @return Validation result code
+ */
+inline vmprog_validation_result read_and_validate_compact_config_stream(
+    vmprog_stream& stream,
+    const vmprog_toc_entry_v1_0& entry,
+    const uint8_t* expected_hash,
+    const vmprog_program_config_v1_0* config,
+    uint8_t* buffer,
+    uint32_t capacity
+) {
+    if (entry.type != vmprog_toc_entry_type_v1_0::config_compact || entry.size > vmprog_compact_config_max_size) {
+        return vmprog_validation_result::invalid_toc_entry;
+    }
+    if (!buffer || entry.size > capacity) {
+        return vmprog_validation_result::invalid_file_size;
+    }
+    if (!read_payload(stream, entry, buffer, capacity)) {
+        return vmprog_validation_result::invalid_payload_offset;
+    }
+    if (expected_hash && !verify_payload_hash(buffer, entry.size, expected_hash)) {
+        return vmprog_validation_result::invalid_hash;
+    }
+
+    auto result = validate_vmprog_compact_config_v1_0(buffer, entry.size);
+    if (result != vmprog_validation_result::ok) {
+        return result;
+    }
+    if (config && !is_compact_config_match(buffer, *config)) {
+        return vmprog_validation_result::invalid_toc_entry;
+    }
+    return vmprog_validation_result::ok;
+}
+
 /**
  * @brief Comprehensively validate a vmprog package using stream-based reading.
  *
@@ -556,14 +675,16 @@ inline vmprog_validation_result verify_package_signature_builtin_keys_stream(
  * 1. Read and validate header
  * 2. Read and validate TOC
  * 3. Optionally verify all payload hashes
- * 4. Optionally verify package signature
+ * 4. Validate the config and, if present, the compact config against it
+ * 5. Optionally verify package signature; a compact config must be a signed artifact
  *
  * @param stream Input stream positioned at start of file
  * @param file_size Total file size in bytes
  * @param verify_hashes If true, verify all payload hashes
  * @param verify_signature If true and package is signed, verify signature
  * @param public_key Public key for signature verification (32 bytes, optional)
- * @param scratch_buffer Temporary buffer for hash verification (required if verify_hashes=true)
+ * @param scratch_buffer Temporary buffer for hash verification (required if verify_hashes=true
+ *                       or the package has a compact config)
  * @param scratch_buffer_size Size of scratch buffer (should be at least max expected payload size)
  * @return Validation result code
  */
@@ -604,30 +725,294 @@ inline vmprog_validation_result validate_vmprog_package_stream(
     // Find and validate config if present
     const vmprog_toc_entry_v1_0* config_entry = find_toc_entry(
         toc, header.toc_count, vmprog_toc_entry_type_v1_0::config);
+    const vmprog_toc_entry_v1_0* compact_entry = find_toc_entry(
+        toc, header.toc_count, vmprog_toc_entry_type_v1_0::config_compact);
 
-    if (config_entry && config_entry->size == sizeof(vmprog_program_config_v1_0)) {
+    {
+        // Scoped so the signature check below can reuse the config's stack space
         vmprog_program_config_v1_0 config;
-        result = read_and_validate_vmprog_config(stream, *config_entry, config, verify_hashes);
-        if (result != vmprog_validation_result::ok) {
-            return result;
+        const vmprog_program_config_v1_0* validated_config = nullptr;
+        if (config_entry && config_entry->size == sizeof(vmprog_program_config_v1_0)) {
+            result = read_and_validate_vmprog_config(stream, *config_entry, config, verify_hashes);
+            if (result != vmprog_validation_result::ok) {
+                return result;
+            }
+            validated_config = &config;
+        }
+
+        // Validate the compact config if present; it must decode to the fixed config
+        if (compact_entry) {
+            result = read_and_validate_compact_config_stream(
+                stream, *compact_entry, verify_hashes ? compact_entry->sha256 : nullptr, validated_config,
+                scratch_buffer, scratch_buffer_size);
+            if (result != vmprog_validation_result::ok) {
+                return result;
+            }
         }
     }
 
     // Verify signature if requested
     if (verify_signature && is_package_signed(header)) {
-        if (public_key) {
-            result = verify_package_signature_stream(stream, toc, header.toc_count, public_key);
-        } else {
-            result = verify_package_signature_builtin_keys_stream(stream, toc, header.toc_count);
-        }
+        vmprog_signed_descriptor_v1_0 descriptor;
+        result = read_and_verify_signed_descriptor_stream(stream, toc, header.toc_count, public_key, descriptor);
         if (result != vmprog_validation_result::ok) {
             return result;
         }
+
+        // The compact config bytes are still in the scratch buffer
+        if (compact_entry) {
+            const vmprog_artifact_hash_v1_0* artifact = find_descriptor_artifact(
+                descriptor, vmprog_toc_entry_type_v1_0::config_compact);
+            if (!artifact) {
+                return vmprog_validation_result::invalid_toc_entry;
+            }
+            if (!verify_payload_hash(scratch_buffer, compact_entry->size, artifact->sha256)) {
+                return vmprog_validation_result::invalid_hash;
+            }
+        }
+    }
+
+    return vmprog_validation_result::ok;
+}
+
+// =============================================================================
+// Selective Verification
+// =============================================================================
+
+/**
+ * @brief Hash a payload from stream in chunks and compare against a hash.
+ *
+ * Unlike read_and_verify_payload(), the scratch buffer only needs to hold one
+ * chunk, so payloads larger than available RAM can be verified.
+ *
+ * @param stream Input stream
+ * @param entry TOC entry describing the payload
+ * @param expected_hash Expected hash (32 bytes)
+ * @param scratch_buffer Temporary buffer for one chunk
+ * @param scratch_buffer_size Size of scratch buffer
+ * @return Validation result code
+ */
+inline vmprog_validation_result verify_payload_hash_chunked_stream(
+    vmprog_stream& stream,
+    const vmprog_toc_entry_v1_0& entry,
+    const uint8_t expected_hash[32],
+    uint8_t* scratch_buffer,
+    uint32_t scratch_buffer_size
+) {
+    if (!scratch_buffer || scratch_buffer_size == 0) {
+        return vmprog_validation_result::invalid_file_size;
+    }
+
+    if (!stream.seek(entry.offset)) {
+        return vmprog_validation_result::invalid_payload_offset;
+    }
+
+    sha256_ctx ctx;
+    sha256_init(ctx);
+    uint32_t remaining = entry.size;
+    while (remaining > 0) {
+        uint32_t chunk = (remaining < scratch_buffer_size) ? remaining : scratch_buffer_size;
+        if (stream.read(scratch_buffer, chunk) != chunk) {
+            return vmprog_validation_result::invalid_payload_offset;
+        }
+        sha256_update(ctx, scratch_buffer, chunk);
+        remaining -= chunk;
+    }
+
+    uint8_t actual_hash[32];
+    sha256_final(ctx, actual_hash);
+    if (!secure_compare_hash(actual_hash, expected_hash)) {
+        return vmprog_validation_result::invalid_hash;
     }
 
     return vmprog_validation_result::ok;
 }
 
+/**
+ * @brief Hash one bitstream variant against its signed descriptor artifact.
+ *
+ * @param stream Input stream
+ * @param toc TOC entries array
+ * @param toc_count Number of TOC entries
+ * @param descriptor Signed descriptor whose signature has been verified
+ * @param bitstream_type Bitstream variant that will be loaded
+ * @param scratch_buffer Temporary buffer for chunked hashing (any non-zero size)
+ * @param scratch_buffer_size Size of scratch buffer
+ * @return Validation result code
+ */
+inline vmprog_validation_result verify_signed_bitstream_stream(
+    vmprog_stream& stream,
+    const vmprog_toc_entry_v1_0* toc,
+    uint32_t toc_count,
+    const vmprog_signed_descriptor_v1_0& descriptor,
+    vmprog_toc_entry_type_v1_0 bitstream_type,
+    uint8_t* scratch_buffer,
+    uint32_t scratch_buffer_size
+) {
+    // The variant must be covered by the signature
+    const vmprog_artifact_hash_v1_0* artifact = find_descriptor_artifact(descriptor, bitstream_type);
+    const vmprog_toc_entry_v1_0* bitstream_entry = find_toc_entry(toc, toc_count, bitstream_type);
+    if (!artifact || !bitstream_entry) {
+        return vmprog_validation_result::invalid_toc_entry;
+    }
+    return verify_payload_hash_chunked_stream(
+        stream, *bitstream_entry, artifact->sha256, scratch_buffer, scratch_buffer_size);
+}
+
+/**
+ * @brief Verify only what the device will load, anchored on the signature.
+ *
+ * This performs verification in order of cost:
+ * 1. Read the signed descriptor and check its Ed25519 signature
+ * 2. Hash the config and compare against descriptor.config_sha256
+ * 3. Hash the selected bitstream and compare against its descriptor artifact
+ *
+ * Other payloads are never read, so verification time depends on the
+ * selected bitstream rather than on package size. TOC hashes are not used;
+ * the signed descriptor is the only trust anchor.
+ *
+ * @param stream Input stream
+ * @param toc TOC entries array
+ * @param toc_count Number of TOC entries
+ * @param bitstream_type Bitstream variant that will be loaded
+ * @param public_key Public key for verification (32 bytes, nullptr for built-in keys)
+ * @param scratch_buffer Temporary buffer for chunked hashing (any non-zero size)
+ * @param scratch_buffer_size Size of scratch buffer
+ * @param out_key_index Optional output parameter for which built-in key succeeded
+ * @return Validation result code
+ */
+inline vmprog_validation_result verify_package_selective_stream(
+    vmprog_stream& stream,
+    const vmprog_toc_entry_v1_0* toc,
+    uint32_t toc_count,
+    vmprog_toc_entry_type_v1_0 bitstream_type,
+    const uint8_t* public_key,
+    uint8_t* scratch_buffer,
+    uint32_t scratch_buffer_size,
+    size_t* out_key_index = nullptr
+) {
+    // Signature first: nothing else is trusted until the descriptor is
+    vmprog_signed_descriptor_v1_0 descriptor;
+    auto result = read_and_verify_signed_descriptor_stream(
+        stream, toc, toc_count, public_key, descriptor, out_key_index);
+    if (result != vmprog_validation_result::ok) {
+        return result;
+    }
+
+    // Config
+    const vmprog_toc_entry_v1_0* config_entry = find_toc_entry(
+        toc, toc_count, vmprog_toc_entry_type_v1_0::config);
+    if (!config_entry) {
+        return vmprog_validation_result::invalid_toc_entry;
+    }
+    result = verify_payload_hash_chunked_stream(
+        stream, *config_entry, descriptor.config_sha256, scratch_buffer, scratch_buffer_size);
+    if (result != vmprog_validation_result::ok) {
+        return result;
+    }
+
+    return verify_signed_bitstream_stream(
+        stream, toc, toc_count, descriptor, bitstream_type, scratch_buffer, scratch_buffer_size);
+}
+
+/**
+ * @brief Validate a signed vmprog package for loading one bitstream variant.
+ *
+ * Secure boot counterpart to validate_vmprog_package_stream(): validates the
+ * header and TOC, checks the signature, then hashes the config, the compact
+ * config if present and the selected bitstream against the signed descriptor.
+ * A compact config must also decode to the fixed config. Unsigned packages
+ * are rejected.
+ *
+ * The config is read once into out_config, and both the hash and the
+ * structural checks run on that copy, so the stream cannot change it between
+ * the two. Use out_config rather than reading the config again.
+ *
+ * @param stream Input stream positioned at start of file
+ * @param file_size Total file size in bytes
+ * @param bitstream_type Bitstream variant that will be loaded
+ * @param public_key Public key for verification (32 bytes, nullptr for built-in keys)
+ * @param scratch_buffer Temporary buffer for chunked hashing (any non-zero size, but at
+ *                       least the compact config size if the package has one)
+ * @param scratch_buffer_size Size of scratch buffer
+ * @param out_config Output configuration, authenticated and validated if ok is returned
+ * @param out_key_index Optional output parameter for which built-in key succeeded
+ * @return Validation result code
+ */
+inline vmprog_validation_result validate_vmprog_package_selective_stream(
+    vmprog_stream& stream,
+    uint32_t file_size,
+    vmprog_toc_entry_type_v1_0 bitstream_type,
+    const uint8_t* public_key,
+    uint8_t* scratch_buffer,
+    uint32_t scratch_buffer_size,
+    vmprog_program_config_v1_0& out_config,
+    size_t* out_key_index = nullptr
+) {
+    // Read and validate header
+    vmprog_header_v1_0 header;
+    auto result = read_and_validate_vmprog_header(stream, file_size, header);
+    if (result != vmprog_validation_result::ok) {
+        return result;
+    }
+    if (!is_package_signed(header)) {
+        return vmprog_validation_result::invalid_toc_entry;
+    }
+
+    // Read and validate TOC
+    vmprog_toc_entry_v1_0 toc[vmprog_stream_max_toc_entries];
+    result = read_and_validate_vmprog_toc(stream, header, file_size, toc, vmprog_stream_max_toc_entries);
+    if (result != vmprog_validation_result::ok) {
+        return result;
+    }
+
+    vmprog_signed_descriptor_v1_0 descriptor;
+    result = read_and_verify_signed_descriptor_stream(
+        stream, toc, header.toc_count, public_key, descriptor, out_key_index);
+    if (result != vmprog_validation_result::ok) {
+        return result;
+    }
+
+    // Config: authenticate, then validate the same bytes
+    const vmprog_toc_entry_v1_0* config_entry = find_toc_entry(
+        toc, header.toc_count, vmprog_toc_entry_type_v1_0::config);
+    if (!config_entry) {
+        return vmprog_validation_result::invalid_toc_entry;
+    }
+    result = read_vmprog_config(stream, *config_entry, out_config);
+    if (result != vmprog_validation_result::ok) {
+        return result;
+    }
+    if (!verify_hash(reinterpret_cast<const uint8_t*>(&out_config),
+                     sizeof(vmprog_program_config_v1_0),
+                     descriptor.config_sha256)) {
+        return vmprog_validation_result::invalid_hash;
+    }
+    result = validate_vmprog_program_config_v1_0(out_config);
+    if (result != vmprog_validation_result::ok) {
+        return result;
+    }
+
+    // Compact config: signed like the fixed config and decoding to it
+    const vmprog_toc_entry_v1_0* compact_entry = find_toc_entry(
+        toc, header.toc_count, vmprog_toc_entry_type_v1_0::config_compact);
+    if (compact_entry) {
+        const vmprog_artifact_hash_v1_0* artifact = find_descriptor_artifact(
+            descriptor, vmprog_toc_entry_type_v1_0::config_compact);
+        if (!artifact) {
+            return vmprog_validation_result::invalid_toc_entry;
+        }
+        result = read_and_validate_compact_config_stream(
+            stream, *compact_entry, artifact->sha256, &out_config, scratch_buffer, scratch_buffer_size);
+        if (result != vmprog_validation_result::ok) {
+            return result;
+        }
+    }
+
+    return verify_signed_bitstream_stream(
+        stream, toc, header.toc_count, descriptor, bitstream_type, scratch_buffer, scratch_buffer_size);
+}
+
 // =============================================================================
 // High-level Package Reading Helper Class
 // =============================================================================
@@ -786,6 +1171,33 @@ public:
         }
     }
 
+    /**
+     * @brief Verify signature, config and one bitstream variant only.
+     *
+     * Open with verify_hashes=false and call this instead to make verification
+     * cost independent of the other payloads in the package.
+     *
+     * @param bitstream_type Bitstream variant that will be loaded
+     * @param public_key Public key for verification (32 bytes, optional)
+     * @param scratch_buffer Temporary buffer for chunked hashing
+     * @param scratch_buffer_size Size of scratch buffer
+     * @param out_key_index Optional output parameter for which built-in key succeeded
+     * @return Validation result code
+     */
+    vmprog_validation_result verify_selective(
+        vmprog_toc_entry_type_v1_0 bitstream_type,
+        const uint8_t* public_key,
+        uint8_t* scratch_buffer,
+        uint32_t scratch_buffer_size,
+        size_t* out_key_index = nullptr
+    ) {
+        if (!is_open_) return vmprog_validation_result::invalid_file_size;
+        if (!is_signed()) return vmprog_validation_result::invalid_toc_entry;
+
+        return verify_package_selective_stream(*stream_, toc_, header_.toc_count, bitstream_type,
+                                               public_key, scratch_buffer, scratch_buffer_size, out_key_index);
+    }
+
 private:
     vmprog_stream* stream_ = nullptr;
     uint32_t file_size_ = 0;
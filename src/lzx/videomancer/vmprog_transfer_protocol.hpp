@@ -0,0 +1,876 @@
+// Videomancer SDK - Open source FPGA-based video effects development kit
+// Copyright (C) 2025 LZX Industries LLC
+// File: vmprog_transfer_protocol.hpp - Windowed Package Transfer Protocol
+// License: GNU General Public License v3.0
+// https://github.com/lzxindustries/videomancer-sdk
+//
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// Protocol Overview:
+//   - Runs over any byte pipe (USB CDC, UART, pty, socket); frames carry a
+//     magic prefix so the parser resynchronizes after lost or corrupt bytes
+//   - The sender splits the package into chunks that never cross a TOC
+//     region (header + TOC, then each payload), keeps up to `window` chunks
+//     in flight and retransmits only chunks that are reported missing or
+//     time out
+//   - The receiver reorders chunks in a caller-provided window buffer and
+//     delivers bytes strictly in order, so a vmprog_package_installer can
+//     verify them as they arrive
+//   - Each START names the package by a hash of its header and TOC; a
+//     receiver that already holds a prefix of that package answers with the
+//     first missing chunk and the sender resumes from there
+//
+// Frame Format (little-endian):
+//   [0x56 'V'] [0x54 'T'] [type u8] [reserved u8] [length u16] [payload] [tag 16]
+//   tag = first 16 bytes of BLAKE2b-256 over type, reserved, length, payload
+//
+// Payloads:
+//   start      file_size u32, chunk_count u32, chunk_size u32, package_id[16]
+//   start_ack  resume_index u32, window u32
+//   data       index u32, offset u32, bytes
+//   ack        next_index u32, sack u32 (bit i: chunk next_index + 1 + i held)
+//   error      vmprog_validation_result u8
+
+#pragma once
+
+#include "vmprog_package_installer.hpp"
+#include "videomancer_clock.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define VMPROG_TRANSFER_HAS_FD_LINK 1
+#endif
+
+namespace lzx {
+
+    constexpr uint32_t vmprog_transfer_max_chunk_size = 1024;
+    constexpr uint32_t vmprog_transfer_max_window = 32;
+    constexpr uint32_t vmprog_transfer_tag_size = 16;
+    constexpr uint32_t vmprog_transfer_header_size = 6;
+    constexpr uint32_t vmprog_transfer_max_payload = 8 + vmprog_transfer_max_chunk_size;
+    constexpr uint32_t vmprog_transfer_max_frame_size =
+        vmprog_transfer_header_size + vmprog_transfer_max_payload + vmprog_transfer_tag_size;
+
+    /**
+     * @brief Frame types.
+     */
+    enum class vmprog_transfer_frame_type : uint8_t {
+        start = 1,      // Sender announces a package
+        start_ack = 2,  // Receiver accepts and names the first chunk it needs
+        data = 3,       // One chunk
+        ack = 4,        // Cumulative and selective acknowledgement
+        error = 5,      // Receiver gave up; payload is the reason
+    };
+
+    /**
+     * @brief Transfer endpoint state.
+     */
+    enum class vmprog_transfer_state : uint8_t {
+        idle = 0,          // Not started (receiver: waiting for START)
+        connecting = 1,    // Sender waiting for START_ACK
+        transferring = 2,  // Chunks moving
+        done = 3,          // Every chunk delivered and acknowledged
+        failed = 4,        // See result()
+    };
+
+    /**
+     * @brief Non-blocking byte pipe.
+     */
+    class vmprog_transfer_link {
+    public:
+        virtual ~vmprog_transfer_link() = default;
+
+        /**
+         * @brief Queue bytes for sending.
+         * @return Bytes accepted (may be fewer than size, 0 if the pipe is full)
+         */
+        virtual size_t write(const uint8_t* data, size_t size) = 0;
+
+        /**
+         * @brief Read available bytes.
+         * @return Bytes read, 0 if none are available
+         */
+        virtual size_t read(uint8_t* buffer, size_t size) = 0;
+    };
+
+    /**
+     * @brief In-order destination for received package bytes.
+     */
+    class vmprog_transfer_sink {
+    public:
+        virtual ~vmprog_transfer_sink() = default;
+
+        /**
+         * @brief Start a new package.
+         * @return false to refuse the package
+         */
+        virtual bool begin(uint32_t file_size) = 0;
+
+        /**
+         * @brief Append the next bytes of the package.
+         * @return false to abort the transfer
+         */
+        virtual bool write(const uint8_t* data, uint32_t size) = 0;
+    };
+
+    /**
+     * @brief Sink that installs received bytes with a vmprog_package_installer.
+     */
+    class vmprog_transfer_install_sink : public vmprog_transfer_sink {
+    public:
+        vmprog_transfer_install_sink(
+            vmprog_package_installer& installer,
+            vmprog_install_target& target,
+            const uint8_t* public_key = nullptr,
+            bool allow_unsigned = false
+        ) : installer_(installer), target_(target), public_key_(public_key), allow_unsigned_(allow_unsigned) {}
+
+        bool begin(uint32_t file_size) override {
+            (void)file_size;
+            return installer_.begin(target_, public_key_, allow_unsigned_);
+        }
+
+        bool write(const uint8_t* data, uint32_t size) override {
+            return installer_.feed(data, size) != vmprog_install_state::failed;
+        }
+
+    private:
+        vmprog_package_installer& installer_;
+        vmprog_install_target& target_;
+        const uint8_t* public_key_;
+        bool allow_unsigned_;
+    };
+
+#if defined(VMPROG_TRANSFER_HAS_FD_LINK)
+    /**
+     * @brief Link over a POSIX file descriptor (tty, pty, pipe or socket).
+     *
+     * The descriptor is switched to non-blocking mode and is not closed.
+     */
+    class vmprog_transfer_fd_link : public vmprog_transfer_link {
+    public:
+        explicit vmprog_transfer_fd_link(int fd) : fd_(fd) {
+            const int flags = fcntl(fd_, F_GETFL, 0);
+            if (flags >= 0) fcntl(fd_, F_SETFL, flags | O_NONBLOCK);
+        }
+
+        size_t write(const uint8_t* data, size_t size) override {
+            const ssize_t n = ::write(fd_, data, size);
+            return (n > 0) ? static_cast<size_t>(n) : 0;
+        }
+
+        size_t read(uint8_t* buffer, size_t size) override {
+            const ssize_t n = ::read(fd_, buffer, size);
+            return (n > 0) ? static_cast<size_t>(n) : 0;
+        }
+
+    private:
+        int fd_;
+    };
+#endif
+
+    // =============================================================================
+    // Framing
+    // =============================================================================
+
+    inline void vmprog_transfer_store_u32(uint8_t* out, uint32_t value) {
+        out[0] = static_cast<uint8_t>(value);
+        out[1] = static_cast<uint8_t>(value >> 8);
+        out[2] = static_cast<uint8_t>(value >> 16);
+        out[3] = static_cast<uint8_t>(value >> 24);
+    }
+
+    inline uint32_t vmprog_transfer_load_u32(const uint8_t* in) {
+        return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+               (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+    }
+
+    /**
+     * @brief Compute the tag of a frame whose header and payload are in place.
+     */
+    inline void compute_vmprog_transfer_tag(const uint8_t* frame, uint32_t length, uint8_t out_tag[vmprog_transfer_tag_size]) {
+        uint8_t hash[32];
+        sha256_oneshot(frame + 2, vmprog_transfer_header_size - 2 + length, hash);
+        memcpy(out_tag, hash, vmprog_transfer_tag_size);
+    }
+
+    /**
+     * @brief Incremental frame parser with resynchronization.
+     */
+    class vmprog_transfer_frame_parser {
+    public:
+        /**
+         * @brief Consume one byte.
+         * @return true when a complete frame with a valid tag is available
+         */
+        bool push(uint8_t byte) {
+            if (fill_ == 0) {
+                if (byte == 0x56) buffer_[fill_++] = byte;
+                return false;
+            }
+            if (fill_ == 1) {
+                if (byte == 0x54) {
+                    buffer_[fill_++] = byte;
+                } else {
+                    fill_ = (byte == 0x56) ? 1 : 0;
+                }
+                return false;
+            }
+
+            buffer_[fill_++] = byte;
+            if (fill_ == vmprog_transfer_header_size) {
+                const uint32_t length = buffer_[4] | (static_cast<uint32_t>(buffer_[5]) << 8);
+                if (length > vmprog_transfer_max_payload) {
+                    ++rejected_;
+                    fill_ = 0;
+                    return false;
+                }
+                expected_ = vmprog_transfer_header_size + length + vmprog_transfer_tag_size;
+                return false;
+            }
+            if (fill_ < vmprog_transfer_header_size || fill_ < expected_) return false;
+
+            fill_ = 0;
+            uint8_t tag[vmprog_transfer_tag_size];
+            compute_vmprog_transfer_tag(buffer_, length(), tag);
+            if (!secure_compare(tag, buffer_ + expected_ - vmprog_transfer_tag_size, vmprog_transfer_tag_size)) {
+                ++rejected_;
+                return false;
+            }
+            return true;
+        }
+
+        vmprog_transfer_frame_type type() const { return static_cast<vmprog_transfer_frame_type>(buffer_[2]); }
+        const uint8_t* payload() const { return buffer_ + vmprog_transfer_header_size; }
+        uint32_t length() const { return buffer_[4] | (static_cast<uint32_t>(buffer_[5]) << 8); }
+
+        /**
+         * @brief Frames dropped for a bad length or tag.
+         */
+        uint32_t rejected() const { return rejected_; }
+
+    private:
+        uint8_t buffer_[vmprog_transfer_max_frame_size] = {};
+        uint32_t fill_ = 0;
+        uint32_t expected_ = 0;
+        uint32_t rejected_ = 0;
+    };
+
+    /**
+     * @brief Shared frame I/O for both endpoints.
+     */
+    class vmprog_transfer_endpoint {
+    public:
+        /**
+         * @brief Frames dropped for a bad length or tag.
+         */
+        uint32_t frames_rejected() const { return parser_.rejected(); }
+
+        /**
+         * @brief Frames handed to the link.
+         */
+        uint32_t frames_sent() const { return frames_sent_; }
+
+    protected:
+        explicit vmprog_transfer_endpoint(vmprog_transfer_link& link) : link_(link) {}
+
+        vmprog_transfer_link& link_;
+        vmprog_transfer_frame_parser parser_;
+        uint8_t tx_[vmprog_transfer_max_frame_size] = {};
+        uint32_t tx_size_ = 0;
+        uint32_t tx_sent_ = 0;
+        uint32_t frames_sent_ = 0;
+
+        /**
+         * @brief Push out the rest of the current frame.
+         * @return true once nothing is pending
+         */
+        bool flush() {
+            while (tx_sent_ < tx_size_) {
+                const size_t n = link_.write(tx_ + tx_sent_, tx_size_ - tx_sent_);
+                if (n == 0) return false;
+                tx_sent_ += static_cast<uint32_t>(n);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Payload area of the next frame (valid while flush() is true).
+         */
+        uint8_t* frame_payload() { return tx_ + vmprog_transfer_header_size; }
+
+        /**
+         * @brief Finish the frame in tx_ and start sending it.
+         */
+        void send_frame(vmprog_transfer_frame_type type, uint32_t length) {
+            tx_[0] = 0x56;
+            tx_[1] = 0x54;
+            tx_[2] = static_cast<uint8_t>(type);
+            tx_[3] = 0;
+            tx_[4] = static_cast<uint8_t>(length);
+            tx_[5] = static_cast<uint8_t>(length >> 8);
+            compute_vmprog_transfer_tag(tx_, length, tx_ + vmprog_transfer_header_size + length);
+            tx_size_ = vmprog_transfer_header_size + length + vmprog_transfer_tag_size;
+            tx_sent_ = 0;
+            ++frames_sent_;
+            flush();
+        }
+
+        /**
+         * @brief Read the link and dispatch complete frames.
+         */
+        template <typename Handler>
+        void receive(Handler&& handler) {
+            uint8_t buffer[256];
+            size_t n;
+            while ((n = link_.read(buffer, sizeof(buffer))) > 0) {
+                for (size_t i = 0; i < n; ++i) {
+                    if (parser_.push(buffer[i])) handler(parser_.type(), parser_.payload(), parser_.length());
+                }
+            }
+        }
+    };
+
+    // =============================================================================
+    // Sender
+    // =============================================================================
+
+    /**
+     * @brief Sending side: reads a package from a stream and pushes chunks.
+     *
+     * Example:
+     *   vmprog_transfer_sender sender(serial_link, host_clock);
+     *   sender.begin(file_stream, file_size);
+     *   while (sender.poll() != vmprog_transfer_state::done) wait_for_io();
+     */
+    class vmprog_transfer_sender : public vmprog_transfer_endpoint {
+    public:
+        vmprog_transfer_sender(vmprog_transfer_link& link, videomancer_clock& clock)
+            : vmprog_transfer_endpoint(link), clock_(clock) {}
+
+        /**
+         * @brief Start sending a package.
+         *
+         * @param stream Package stream (must stay valid until done or failed)
+         * @param file_size Package size in bytes
+         * @param chunk_size Maximum chunk size (1 to vmprog_transfer_max_chunk_size)
+         * @param window Chunks in flight (1 to vmprog_transfer_max_window; 1 is stop-and-wait)
+         * @param timeout_us Minimum retransmit timeout; the timeout adapts to the
+         *                   measured round trip, including link queueing
+         * @return Validation result of the header and TOC
+         */
+        vmprog_validation_result begin(
+            vmprog_stream& stream,
+            uint32_t file_size,
+            uint32_t chunk_size = vmprog_transfer_max_chunk_size,
+            uint32_t window = 16,
+            uint32_t timeout_us = 100000
+        ) {
+            state_ = vmprog_transfer_state::idle;
+            if (chunk_size == 0 || chunk_size > vmprog_transfer_max_chunk_size ||
+                window == 0 || window > vmprog_transfer_max_window) {
+                return vmprog_validation_result::invalid_file_size;
+            }
+
+            vmprog_header_v1_0 header;
+            vmprog_toc_entry_v1_0 toc[vmprog_stream_max_toc_entries];
+            auto result = read_and_validate_vmprog_header(stream, file_size, header);
+            if (result == vmprog_validation_result::ok) {
+                result = read_and_validate_vmprog_toc(stream, header, file_size, toc, vmprog_stream_max_toc_entries);
+            }
+            if (result != vmprog_validation_result::ok) return result;
+
+            // The package is identified by its header and TOC, which carry every payload hash
+            sha256_ctx ctx;
+            sha256_init(ctx);
+            sha256_update(ctx, reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+            sha256_update(ctx, reinterpret_cast<const uint8_t*>(toc), header.toc_count * sizeof(vmprog_toc_entry_v1_0));
+            uint8_t id[32];
+            sha256_final(ctx, id);
+            memcpy(package_id_, id, sizeof(package_id_));
+
+            stream_ = &stream;
+            file_size_ = file_size;
+            chunk_size_ = chunk_size;
+            plan_regions(header, toc);
+            window_ = window;
+            timeout_us_ = timeout_us;
+            rto_us_ = timeout_us;
+            srtt_us_ = 0;
+            rttvar_us_ = 0;
+            base_ = 0;
+            next_new_ = 0;
+            retransmits_ = 0;
+            start_sent_us_ = 0;
+            start_pending_ = true;
+            result_ = vmprog_validation_result::ok;
+            state_ = vmprog_transfer_state::connecting;
+            return vmprog_validation_result::ok;
+        }
+
+        /**
+         * @brief Process incoming frames and send what the window allows.
+         * @return State after polling
+         */
+        vmprog_transfer_state poll() {
+            receive([this](vmprog_transfer_frame_type type, const uint8_t* payload, uint32_t length) {
+                handle_frame(type, payload, length);
+            });
+            if (!flush()) return state_;
+
+            const uint64_t now = clock_.now_us();
+            if (state_ == vmprog_transfer_state::connecting) {
+                if (start_pending_ || now - start_sent_us_ >= timeout_us_) send_start(now);
+                return state_;
+            }
+            if (state_ != vmprog_transfer_state::transferring) return state_;
+
+            // Selective retransmit: reported holes first, then timeouts
+            for (uint32_t index = base_; index < next_new_; ++index) {
+                slot& s = slots_[index % window_];
+                if (s.acked) continue;
+                const bool timed_out = now - s.sent_us >= rto_us_;
+                if (!s.retransmit && !timed_out) continue;
+                if (timed_out) s.fast_done = false;
+                s.retransmit = false;
+                s.resent = true;
+                ++retransmits_;
+                if (!send_chunk(index, now)) return state_;
+            }
+
+            while (next_new_ < chunk_count_ && next_new_ < base_ + window_) {
+                slots_[next_new_ % window_] = slot();
+                if (!send_chunk(next_new_++, now)) break;
+            }
+            return state_;
+        }
+
+        vmprog_transfer_state state() const { return state_; }
+
+        /**
+         * @brief Failure reason (ok unless failed).
+         */
+        vmprog_validation_result result() const { return result_; }
+
+        uint32_t chunk_count() const { return chunk_count_; }
+
+        /**
+         * @brief Chunks acknowledged in order.
+         */
+        uint32_t chunks_acked() const { return base_; }
+
+        /**
+         * @brief Chunk the receiver asked to resume from.
+         */
+        uint32_t resume_index() const { return resume_index_; }
+
+        uint32_t retransmits() const { return retransmits_; }
+
+    private:
+        struct slot {
+            uint64_t sent_us = 0;
+            bool acked = false;
+            bool retransmit = false;
+            bool resent = false;  // Excluded from round-trip samples (Karn)
+            bool fast_done = false;
+        };
+
+        static constexpr uint32_t max_regions = 2 * vmprog_stream_max_toc_entries + 2;
+
+        videomancer_clock& clock_;
+        vmprog_stream* stream_ = nullptr;
+        vmprog_transfer_state state_ = vmprog_transfer_state::idle;
+        vmprog_validation_result result_ = vmprog_validation_result::ok;
+        uint8_t package_id_[16] = {};
+        uint32_t file_size_ = 0;
+        uint32_t chunk_size_ = 0;
+        uint32_t window_ = 0;
+        uint32_t timeout_us_ = 0;
+        uint32_t rto_us_ = 0;
+        uint32_t srtt_us_ = 0;
+        uint32_t rttvar_us_ = 0;
+
+        uint32_t region_end_[max_regions] = {};
+        uint32_t region_count_ = 0;
+        uint32_t chunk_count_ = 0;
+
+        slot slots_[vmprog_transfer_max_window];
+        uint32_t base_ = 0;
+        uint32_t next_new_ = 0;
+        uint32_t resume_index_ = 0;
+        uint32_t retransmits_ = 0;
+        uint64_t start_sent_us_ = 0;
+        bool start_pending_ = false;
+
+        /**
+         * @brief Split the file at the TOC end and every payload boundary.
+         *
+         * Chunks never straddle a region, so each retransmitted or verified
+         * chunk belongs to exactly one TOC entry.
+         */
+        void plan_regions(const vmprog_header_v1_0& header, const vmprog_toc_entry_v1_0* toc) {
+            const uint32_t file_size = header.file_size;
+            uint32_t points[max_regions];
+            uint32_t count = 0;
+            points[count++] = header.toc_offset + header.toc_bytes;
+            for (uint32_t i = 0; i < header.toc_count; ++i) {
+                points[count++] = toc[i].offset;
+                points[count++] = toc[i].offset + toc[i].size;
+            }
+
+            // Insertion sort, then keep unique interior points followed by the file end
+            for (uint32_t i = 1; i < count; ++i) {
+                const uint32_t v = points[i];
+                uint32_t j = i;
+                while (j > 0 && points[j - 1] > v) {
+                    points[j] = points[j - 1];
+                    --j;
+                }
+                points[j] = v;
+            }
+            region_count_ = 0;
+            uint32_t last = 0;
+            for (uint32_t i = 0; i < count; ++i) {
+                if (points[i] > last && points[i] < file_size) {
+                    region_end_[region_count_++] = points[i];
+                    last = points[i];
+                }
+            }
+            region_end_[region_count_++] = file_size;
+
+            chunk_count_ = 0;
+            uint32_t start = 0;
+            for (uint32_t i = 0; i < region_count_; ++i) {
+                chunk_count_ += (region_end_[i] - start + chunk_size_ - 1) / chunk_size_;
+                start = region_end_[i];
+            }
+        }
+
+        /**
+         * @brief Locate a chunk by walking the regions.
+         */
+        void locate_chunk(uint32_t index, uint32_t& out_offset, uint32_t& out_size) const {
+            uint32_t start = 0;
+            for (uint32_t i = 0; i < region_count_; ++i) {
+                const uint32_t chunks = (region_end_[i] - start + chunk_size_ - 1) / chunk_size_;
+                if (index < chunks) {
+                    out_offset = start + index * chunk_size_;
+                    const uint32_t remaining = region_end_[i] - out_offset;
+                    out_size = (remaining < chunk_size_) ? remaining : chunk_size_;
+                    return;
+                }
+                index -= chunks;
+                start = region_end_[i];
+            }
+            out_offset = file_size_;
+            out_size = 0;
+        }
+
+        void send_start(uint64_t now) {
+            uint8_t* p = frame_payload();
+            vmprog_transfer_store_u32(p, file_size_);
+            vmprog_transfer_store_u32(p + 4, chunk_count_);
+            vmprog_transfer_store_u32(p + 8, chunk_size_);
+            memcpy(p + 12, package_id_, sizeof(package_id_));
+            send_frame(vmprog_transfer_frame_type::start, 12 + sizeof(package_id_));
+            start_sent_us_ = now;
+            start_pending_ = false;
+        }
+
+        /**
+         * @brief Send one chunk.
+         * @return false if the link is full (the frame stays queued)
+         */
+        bool send_chunk(uint32_t index, uint64_t now) {
+            uint32_t offset, size;
+            locate_chunk(index, offset, size);
+            uint8_t* p = frame_payload();
+            vmprog_transfer_store_u32(p, index);
+            vmprog_transfer_store_u32(p + 4, offset);
+            if (!stream_->seek(offset) || stream_->read(p + 8, size) != size) {
+                result_ = vmprog_validation_result::invalid_payload_offset;
+                state_ = vmprog_transfer_state::failed;
+                return false;
+            }
+            send_frame(vmprog_transfer_frame_type::data, 8 + size);
+            slots_[index % window_].sent_us = now;
+            return tx_sent_ == tx_size_;
+        }
+
+        void handle_frame(vmprog_transfer_frame_type type, const uint8_t* payload, uint32_t length) {
+            if (type == vmprog_transfer_frame_type::error && length >= 1) {
+                result_ = static_cast<vmprog_validation_result>(payload[0]);
+                state_ = vmprog_transfer_state::failed;
+            } else if (type == vmprog_transfer_frame_type::start_ack && length >= 8 &&
+                       state_ == vmprog_transfer_state::connecting) {
+                const uint32_t resume = vmprog_transfer_load_u32(payload);
+                const uint32_t window = vmprog_transfer_load_u32(payload + 4);
+                resume_index_ = (resume < chunk_count_) ? resume : chunk_count_;
+                base_ = resume_index_;
+                next_new_ = resume_index_;
+                if (window > 0 && window < window_) window_ = window;
+                state_ = (base_ == chunk_count_) ? vmprog_transfer_state::done : vmprog_transfer_state::transferring;
+            } else if (type == vmprog_transfer_frame_type::ack && length >= 8 &&
+                       state_ == vmprog_transfer_state::transferring) {
+                handle_ack(vmprog_transfer_load_u32(payload), vmprog_transfer_load_u32(payload + 4), clock_.now_us());
+            }
+        }
+
+        void handle_ack(uint32_t next, uint32_t sack, uint64_t now) {
+            if (next > next_new_) return;  // Not from this session
+            if (next > base_) {
+                const slot& newest = slots_[(next - 1) % window_];
+                if (!newest.resent) sample_rtt(static_cast<uint32_t>(now - newest.sent_us));
+                base_ = next;
+            }
+
+            uint32_t highest = base_;
+            for (uint32_t bit = 0; bit < 32; ++bit) {
+                const uint32_t index = next + 1 + bit;
+                if (index >= next_new_) break;
+                if (sack & (1u << bit)) {
+                    slots_[index % window_].acked = true;
+                    highest = index;
+                }
+            }
+
+            // Anything below a selectively acknowledged chunk was lost; resend it once
+            for (uint32_t index = base_; index < highest; ++index) {
+                slot& s = slots_[index % window_];
+                if (!s.acked && !s.fast_done) {
+                    s.retransmit = true;
+                    s.fast_done = true;
+                }
+            }
+
+            if (base_ == chunk_count_) state_ = vmprog_transfer_state::done;
+        }
+
+        /**
+         * @brief Update the retransmit timeout from a round-trip sample (RFC 6298).
+         */
+        void sample_rtt(uint32_t rtt_us) {
+            if (srtt_us_ == 0) {
+                srtt_us_ = rtt_us;
+                rttvar_us_ = rtt_us / 2;
+            } else {
+                const uint32_t error = (rtt_us > srtt_us_) ? rtt_us - srtt_us_ : srtt_us_ - rtt_us;
+                rttvar_us_ = (3 * rttvar_us_ + error) / 4;
+                srtt_us_ = (7 * srtt_us_ + rtt_us) / 8;
+            }
+            const uint32_t rto = srtt_us_ + 4 * rttvar_us_;
+            rto_us_ = (rto > timeout_us_) ? rto : timeout_us_;
+        }
+    };
+
+    // =============================================================================
+    // Receiver
+    // =============================================================================
+
+    /**
+     * @brief Receiving side: reorders chunks and delivers bytes in order.
+     *
+     * Keep the same receiver across reconnects to resume: a START for the
+     * package it is already receiving continues at the first missing chunk.
+     *
+     * Example:
+     *   vmprog_transfer_install_sink sink(installer, flash_slot);
+     *   vmprog_transfer_receiver receiver(usb_link, sink, window, sizeof(window));
+     *   while (receiver.poll() != vmprog_transfer_state::done) service_usb();
+     */
+    class vmprog_transfer_receiver : public vmprog_transfer_endpoint {
+    public:
+        /**
+         * @brief Construct receiver.
+         *
+         * @param link Byte pipe to the sender
+         * @param sink Destination for package bytes
+         * @param window_buffer Reorder buffer; holds window_buffer_size / chunk_size chunks
+         * @param window_buffer_size Size of window_buffer
+         */
+        vmprog_transfer_receiver(
+            vmprog_transfer_link& link,
+            vmprog_transfer_sink& sink,
+            uint8_t* window_buffer,
+            uint32_t window_buffer_size
+        ) : vmprog_transfer_endpoint(link), sink_(sink), buffer_(window_buffer), buffer_size_(window_buffer_size) {}
+
+        /**
+         * @brief Process incoming frames and acknowledge them.
+         * @return State after polling
+         */
+        vmprog_transfer_state poll() {
+            need_ack_ = false;
+            receive([this](vmprog_transfer_frame_type type, const uint8_t* payload, uint32_t length) {
+                handle_frame(type, payload, length);
+            });
+            if (need_ack_ && flush()) send_ack();
+            return state_;
+        }
+
+        vmprog_transfer_state state() const { return state_; }
+
+        /**
+         * @brief Failure reason (ok unless failed).
+         */
+        vmprog_validation_result result() const { return result_; }
+
+        uint32_t chunk_count() const { return chunk_count_; }
+
+        /**
+         * @brief Chunks delivered to the sink.
+         */
+        uint32_t chunks_delivered() const { return next_; }
+
+        /**
+         * @brief Bytes delivered to the sink.
+         */
+        uint32_t bytes_delivered() const { return delivered_; }
+
+    private:
+        vmprog_transfer_sink& sink_;
+        uint8_t* buffer_;
+        uint32_t buffer_size_;
+        vmprog_transfer_state state_ = vmprog_transfer_state::idle;
+        vmprog_validation_result result_ = vmprog_validation_result::ok;
+
+        uint8_t package_id_[16] = {};
+        uint32_t file_size_ = 0;
+        uint32_t chunk_count_ = 0;
+        uint32_t chunk_size_ = 0;
+        uint32_t window_ = 0;
+        uint32_t next_ = 0;
+        uint32_t delivered_ = 0;
+        bool need_ack_ = false;
+
+        bool present_[vmprog_transfer_max_window] = {};
+        uint32_t offset_[vmprog_transfer_max_window] = {};
+        uint32_t size_[vmprog_transfer_max_window] = {};
+
+        void fail(vmprog_validation_result result) {
+            result_ = result;
+            state_ = vmprog_transfer_state::failed;
+            if (flush()) {
+                frame_payload()[0] = static_cast<uint8_t>(result);
+                send_frame(vmprog_transfer_frame_type::error, 1);
+            }
+        }
+
+        void handle_frame(vmprog_transfer_frame_type type, const uint8_t* payload, uint32_t length) {
+            if (type == vmprog_transfer_frame_type::start && length >= 28) {
+                handle_start(payload);
+            } else if (type == vmprog_transfer_frame_type::data && length >= 8) {
+                handle_data(vmprog_transfer_load_u32(payload), vmprog_transfer_load_u32(payload + 4),
+                            payload + 8, length - 8);
+            }
+        }
+
+        void handle_start(const uint8_t* payload) {
+            const uint32_t file_size = vmprog_transfer_load_u32(payload);
+            const uint32_t chunk_count = vmprog_transfer_load_u32(payload + 4);
+            const uint32_t chunk_size = vmprog_transfer_load_u32(payload + 8);
+            const uint8_t* id = payload + 12;
+
+            const bool same_package =
+                (state_ == vmprog_transfer_state::transferring || state_ == vmprog_transfer_state::done) &&
+                file_size == file_size_ && chunk_count == chunk_count_ && chunk_size == chunk_size_ &&
+                memcmp(id, package_id_, sizeof(package_id_)) == 0;
+
+            if (!same_package) {
+                if (chunk_size == 0 || chunk_size > vmprog_transfer_max_chunk_size || !buffer_ ||
+                    buffer_size_ < chunk_size) {
+                    fail(vmprog_validation_result::invalid_file_size);
+                    return;
+                }
+                if (!sink_.begin(file_size)) {
+                    fail(vmprog_validation_result::invalid_file_size);
+                    return;
+                }
+                memcpy(package_id_, id, sizeof(package_id_));
+                file_size_ = file_size;
+                chunk_count_ = chunk_count;
+                chunk_size_ = chunk_size;
+                window_ = buffer_size_ / chunk_size;
+                if (window_ > vmprog_transfer_max_window) window_ = vmprog_transfer_max_window;
+                next_ = 0;
+                delivered_ = 0;
+                for (uint32_t i = 0; i < vmprog_transfer_max_window; ++i) present_[i] = false;
+                result_ = vmprog_validation_result::ok;
+                state_ = (chunk_count_ == 0) ? vmprog_transfer_state::done : vmprog_transfer_state::transferring;
+            }
+
+            if (flush()) {
+                uint8_t* p = frame_payload();
+                vmprog_transfer_store_u32(p, next_);
+                vmprog_transfer_store_u32(p + 4, window_);
+                send_frame(vmprog_transfer_frame_type::start_ack, 8);
+            }
+        }
+
+        void handle_data(uint32_t index, uint32_t offset, const uint8_t* data, uint32_t size) {
+            if (state_ == vmprog_transfer_state::done) {
+                need_ack_ = true;  // The final ACK may have been lost
+                return;
+            }
+            if (state_ != vmprog_transfer_state::transferring) return;
+
+            need_ack_ = true;
+            if (index < next_ || index >= next_ + window_ || index >= chunk_count_ || size > chunk_size_) return;
+
+            const uint32_t slot = index % window_;
+            if (!present_[slot]) {
+                memcpy(buffer_ + slot * chunk_size_, data, size);
+                present_[slot] = true;
+                offset_[slot] = offset;
+                size_[slot] = size;
+            }
+
+            while (state_ == vmprog_transfer_state::transferring && present_[next_ % window_]) {
+                const uint32_t s = next_ % window_;
+                if (offset_[s] != delivered_ || size_[s] > file_size_ - delivered_) {
+                    fail(vmprog_validation_result::invalid_payload_offset);
+                    return;
+                }
+                if (!sink_.write(buffer_ + s * chunk_size_, size_[s])) {
+                    fail(vmprog_validation_result::invalid_hash);
+                    return;
+                }
+                present_[s] = false;
+                delivered_ += size_[s];
+                ++next_;
+                if (next_ == chunk_count_) {
+                    if (delivered_ != file_size_) {
+                        fail(vmprog_validation_result::invalid_file_size);
+                        return;
+                    }
+                    state_ = vmprog_transfer_state::done;
+                }
+            }
+        }
+
+        void send_ack() {
+            uint32_t sack = 0;
+            for (uint32_t bit = 0; bit < 32 && bit + 1 < window_; ++bit) {
+                const uint32_t index = next_ + 1 + bit;
+                if (index < chunk_count_ && present_[index % window_]) sack |= (1u << bit);
+            }
+            uint8_t* p = frame_payload();
+            vmprog_transfer_store_u32(p, next_);
+            vmprog_transfer_store_u32(p + 4, sack);
+            send_frame(vmprog_transfer_frame_type::ack, 8);
+        }
+    };
+
+} // namespace lzx
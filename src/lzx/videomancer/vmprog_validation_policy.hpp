@@ -0,0 +1,565 @@
+// Videomancer SDK - Open source FPGA-based video effects development kit
+// Copyright (C) 2025 LZX Industries LLC
+// File: vmprog_validation_policy.hpp - VMProg Package Validation Policies
+// License: GNU General Public License v3.0
+// https://github.com/lzxindustries/videomancer-sdk
+//
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// Policy Overview:
+//   - A policy is a bitmask of checks plus signature key options
+//   - make_vmprog_validation_plan() orders the checks by estimated cost,
+//     so cheap structural checks run before hashing and Ed25519
+//   - The plan stops at the first failing check
+//   - Structure is always checked first: later checks rely on it for bounds
+//
+// Predefined Profiles:
+//   - boot:   structure, strings, signature, payload hashes
+//   - ingest: structure, reserved fields, strings, payload and package hashes
+//   - strict: every check (CI and release tooling)
+//   - browse: structure and strings (listing packages in a UI)
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "vmprog_format.hpp"
+
+namespace lzx {
+
+    // =============================================================================
+    // Validation Checks
+    // =============================================================================
+
+    // Individual package checks (bitmask)
+    enum class vmprog_validation_checks_v1_0 : uint32_t
+    {
+        none = 0x00000000,
+        structure = 0x00000001,       // Header, TOC bounds, counts, enums and value ranges
+        reserved_zero = 0x00000002,   // Reserved and padding fields are zeroed
+        strings = 0x00000004,         // String fields are null-terminated, required ones non-empty
+        payload_hashes = 0x00000008,  // Every TOC payload matches its hash
+        package_hash = 0x00000010,    // Whole-file hash matches header (if present)
+        signature = 0x00000020,       // Ed25519 signature, and the config and artifacts it covers
+        all = 0x0000003F,
+    };
+
+    template<> struct enable_bitmask_operators<vmprog_validation_checks_v1_0> { static constexpr bool enable = true; };
+
+    /**
+     * @brief Validation policy: which checks to run and how to verify signatures.
+     */
+    struct vmprog_validation_policy_v1_0 {
+        vmprog_validation_checks_v1_0 checks;
+        const uint8_t* public_key;    // Ed25519 public key (32 bytes), nullptr for built-in keys
+        bool require_signed;          // Reject unsigned packages when signature is checked
+    };
+
+    // Predefined profiles (public_key may be set after copying)
+    constexpr vmprog_validation_policy_v1_0 vmprog_validation_profile_boot = {
+        vmprog_validation_checks_v1_0::structure | vmprog_validation_checks_v1_0::strings |
+        vmprog_validation_checks_v1_0::signature | vmprog_validation_checks_v1_0::payload_hashes,
+        nullptr, true
+    };
+
+    constexpr vmprog_validation_policy_v1_0 vmprog_validation_profile_ingest = {
+        vmprog_validation_checks_v1_0::structure | vmprog_validation_checks_v1_0::reserved_zero |
+        vmprog_validation_checks_v1_0::strings | vmprog_validation_checks_v1_0::payload_hashes |
+        vmprog_validation_checks_v1_0::package_hash,
+        nullptr, false
+    };
+
+    constexpr vmprog_validation_policy_v1_0 vmprog_validation_profile_strict = {
+        vmprog_validation_checks_v1_0::all,
+        nullptr, true
+    };
+
+    constexpr vmprog_validation_policy_v1_0 vmprog_validation_profile_browse = {
+        vmprog_validation_checks_v1_0::structure | vmprog_validation_checks_v1_0::strings,
+        nullptr, false
+    };
+
+    /**
+     * @brief Approximate cost of one Ed25519 verification, in bytes hashed.
+     *
+     * Calibrated with bench_vmprog_validation_policy, which prints the measured
+     * ratio: one check costs about as much as hashing 120 KB with BLAKE2b, so
+     * small packages hash before verifying and large ones verify first.
+     */
+    constexpr uint32_t vmprog_signature_cost_bytes = 131072;
+
+    /**
+     * @brief Estimate the cost of a single check, in bytes hashed.
+     *
+     * The signature check binds the signed hashes to the TOC hashes when
+     * payload_hashes is also requested, and hashes the signed payloads
+     * itself otherwise.
+     *
+     * @param check Single check bit
+     * @param file_size Package size in bytes
+     * @param checks Every check in the same plan
+     * @return Estimated cost
+     */
+    inline uint32_t estimate_vmprog_check_cost(
+        vmprog_validation_checks_v1_0 check,
+        uint32_t file_size,
+        vmprog_validation_checks_v1_0 checks = vmprog_validation_checks_v1_0::all
+    ) {
+        switch (check) {
+            case vmprog_validation_checks_v1_0::structure: return 64;
+            case vmprog_validation_checks_v1_0::reserved_zero: return 512;
+            case vmprog_validation_checks_v1_0::strings: return 1024;
+            case vmprog_validation_checks_v1_0::payload_hashes: return file_size;
+            case vmprog_validation_checks_v1_0::package_hash: return file_size + 1;
+            case vmprog_validation_checks_v1_0::signature:
+                return (checks & vmprog_validation_checks_v1_0::payload_hashes) != vmprog_validation_checks_v1_0::none
+                    ? vmprog_signature_cost_bytes
+                    : vmprog_signature_cost_bytes + file_size;
+            default: return 0;
+        }
+    }
+
+    // =============================================================================
+    // Execution Plan
+    // =============================================================================
+
+    /**
+     * @brief Ordered list of checks to run.
+     */
+    struct vmprog_validation_plan_v1_0 {
+        static constexpr uint32_t max_steps = 6;
+
+        vmprog_validation_checks_v1_0 steps[max_steps];
+        uint32_t step_count;
+    };
+
+    /**
+     * @brief Build a cheapest-first execution plan.
+     *
+     * Structure is always included and always runs first, since the other
+     * checks index into the package using header and TOC fields.
+     *
+     * @param checks Requested checks
+     * @param file_size Package size in bytes (used for hash cost estimates)
+     * @return Execution plan
+     */
+    inline vmprog_validation_plan_v1_0 make_vmprog_validation_plan(
+        vmprog_validation_checks_v1_0 checks,
+        uint32_t file_size
+    ) {
+        vmprog_validation_plan_v1_0 plan = {};
+        plan.steps[plan.step_count++] = vmprog_validation_checks_v1_0::structure;
+
+        for (uint32_t bit = 1; bit < vmprog_validation_plan_v1_0::max_steps; ++bit) {
+            const auto check = static_cast<vmprog_validation_checks_v1_0>(1u << bit);
+            if ((checks & check) == vmprog_validation_checks_v1_0::none) continue;
+
+            // Insertion sort by estimated cost (stable for equal costs)
+            const uint32_t cost = estimate_vmprog_check_cost(check, file_size, checks);
+            uint32_t i = plan.step_count++;
+            while (i > 1 && estimate_vmprog_check_cost(plan.steps[i - 1], file_size, checks) > cost) {
+                plan.steps[i] = plan.steps[i - 1];
+                --i;
+            }
+            plan.steps[i] = check;
+        }
+
+        return plan;
+    }
+
+    // =============================================================================
+    // Individual Checks
+    // =============================================================================
+
+    /**
+     * @brief Find a TOC entry of a given type that has the expected payload size.
+     */
+    inline const uint8_t* find_sized_payload(
+        const uint8_t* file_data,
+        const vmprog_header_v1_0& header,
+        vmprog_toc_entry_type_v1_0 type,
+        uint32_t expected_size
+    ) {
+        const auto* toc = reinterpret_cast<const vmprog_toc_entry_v1_0*>(file_data + header.toc_offset);
+        const vmprog_toc_entry_v1_0* entry = find_toc_entry(toc, header.toc_count, type);
+        if (!entry || entry->size != expected_size) return nullptr;
+        return file_data + entry->offset;
+    }
+
+    /**
+     * @brief Structural checks: header, TOC bounds, counts, enums and value ranges.
+     *
+     * Excludes reserved-field and string checks, which have their own bits.
+     *
+     * @param file_data Complete file data
+     * @param file_size File size in bytes
+     * @return Validation result
+     */
+    inline vmprog_validation_result check_vmprog_structure_v1_0(const uint8_t* file_data, uint32_t file_size) {
+        if (file_size < sizeof(vmprog_header_v1_0)) {
+            return vmprog_validation_result::invalid_file_size;
+        }
+
+        const auto& header = *reinterpret_cast<const vmprog_header_v1_0*>(file_data);
+        auto result = validate_vmprog_header_v1_0(header, file_size);
+        if (result != vmprog_validation_result::ok) {
+            return result;
+        }
+
+        // TOC entries: type and bounds
+        const auto* toc = reinterpret_cast<const vmprog_toc_entry_v1_0*>(file_data + header.toc_offset);
+        for (uint32_t i = 0; i < header.toc_count; ++i) {
+            if (toc[i].type == vmprog_toc_entry_type_v1_0::none) {
+                return vmprog_validation_result::invalid_toc_entry;
+            }
+            if (toc[i].offset < sizeof(vmprog_header_v1_0) || toc[i].offset >= file_size) {
+                return vmprog_validation_result::invalid_payload_offset;
+            }
+            if (toc[i].size > 0 && (toc[i].offset > file_size - toc[i].size)) {
+                return vmprog_validation_result::invalid_payload_offset;
+            }
+        }
+
+        // Config: counts, ABI range, enums, parameter values
+        const auto* config = reinterpret_cast<const vmprog_program_config_v1_0*>(find_sized_payload(
+            file_data, header, vmprog_toc_entry_type_v1_0::config, sizeof(vmprog_program_config_v1_0)));
+        if (config) {
+            if (config->parameter_count > vmprog_program_config_v1_0::num_parameters) {
+                return vmprog_validation_result::invalid_parameter_count;
+            }
+            if (config->abi_min_major > config->abi_max_major ||
+                (config->abi_min_major == config->abi_max_major && config->abi_min_minor > config->abi_max_minor) ||
+                config->abi_min_major == 0 || config->abi_max_major == 0) {
+                return vmprog_validation_result::invalid_abi_range;
+            }
+            if (config->hw_mask == vmprog_hardware_flags_v1_0::none ||
+                config->core_id == vmprog_core_id_v1_0::none) {
+                return vmprog_validation_result::invalid_enum_value;
+            }
+            for (uint32_t i = 0; i < config->parameter_count; ++i) {
+                const auto& param = config->parameters[i];
+                if (static_cast<uint32_t>(param.parameter_id) > static_cast<uint32_t>(vmprog_parameter_id_v1_0::linear_potentiometer_12) ||
+                    static_cast<uint32_t>(param.control_mode) > static_cast<uint32_t>(vmprog_parameter_control_mode_v1_0::expo_in_out)) {
+                    return vmprog_validation_result::invalid_enum_value;
+                }
+                if (param.value_label_count > vmprog_parameter_config_v1_0::max_value_labels) {
+                    return vmprog_validation_result::invalid_value_label_count;
+                }
+                if (param.min_value > param.max_value ||
+                    param.initial_value < param.min_value || param.initial_value > param.max_value ||
+                    param.display_min_value > param.display_max_value) {
+                    return vmprog_validation_result::invalid_parameter_values;
+                }
+            }
+        }
+
+        // Signed descriptor: artifact count and types
+        const auto* descriptor = reinterpret_cast<const vmprog_signed_descriptor_v1_0*>(find_sized_payload(
+            file_data, header, vmprog_toc_entry_type_v1_0::signed_descriptor, sizeof(vmprog_signed_descriptor_v1_0)));
+        if (descriptor) {
+            if (descriptor->artifact_count > vmprog_signed_descriptor_v1_0::max_artifacts) {
+                return vmprog_validation_result::invalid_artifact_count;
+            }
+            for (uint32_t i = 0; i < vmprog_signed_descriptor_v1_0::max_artifacts; ++i) {
+                const bool used = i < descriptor->artifact_count;
+                if (used == (descriptor->artifacts[i].type == vmprog_toc_entry_type_v1_0::none)) {
+                    return vmprog_validation_result::invalid_artifact_count;
+                }
+                result = validate_vmprog_artifact_hash_v1_0(descriptor->artifacts[i]);
+                if (result != vmprog_validation_result::ok) {
+                    return result;
+                }
+            }
+        }
+
+        return vmprog_validation_result::ok;
+    }
+
+    /**
+     * @brief Reserved-field checks: TOC, config, parameters and descriptor.
+     *
+     * Requires check_vmprog_structure_v1_0() to have passed.
+     *
+     * @param file_data Complete file data
+     * @return Validation result
+     */
+    inline vmprog_validation_result check_vmprog_reserved_fields_v1_0(const uint8_t* file_data) {
+        const auto& header = *reinterpret_cast<const vmprog_header_v1_0*>(file_data);
+
+        const auto* toc = reinterpret_cast<const vmprog_toc_entry_v1_0*>(file_data + header.toc_offset);
+        for (uint32_t i = 0; i < header.toc_count; ++i) {
+            for (uint32_t j = 0; j < 4; ++j) {
+                if (toc[i].reserved[j] != 0) {
+                    return vmprog_validation_result::reserved_field_not_zero;
+                }
+            }
+        }
+
+        const auto* config = reinterpret_cast<const vmprog_program_config_v1_0*>(find_sized_payload(
+            file_data, header, vmprog_toc_entry_type_v1_0::config, sizeof(vmprog_program_config_v1_0)));
+        if (config) {
+            if (config->reserved_pad != 0 || config->reserved[0] != 0 || config->reserved[1] != 0) {
+                return vmprog_validation_result::reserved_field_not_zero;
+            }
+            for (uint32_t i = 0; i < config->parameter_count; ++i) {
+                const auto& param = config->parameters[i];
+                if (param.reserved_pad[0] != 0 || param.reserved_pad[1] != 0 ||
+                    param.reserved[0] != 0 || param.reserved[1] != 0) {
+                    return vmprog_validation_result::reserved_field_not_zero;
+                }
+            }
+        }
+
+        const auto* descriptor = reinterpret_cast<const vmprog_signed_descriptor_v1_0*>(find_sized_payload(
+            file_data, header, vmprog_toc_entry_type_v1_0::signed_descriptor, sizeof(vmprog_signed_descriptor_v1_0)));
+        if (descriptor) {
+            for (uint32_t i = 0; i < 3; ++i) {
+                if (descriptor->reserved_pad[i] != 0) {
+                    return vmprog_validation_result::reserved_field_not_zero;
+                }
+            }
+            for (uint32_t i = descriptor->artifact_count; i < vmprog_signed_descriptor_v1_0::max_artifacts; ++i) {
+                if (!is_hash_zero(descriptor->artifacts[i].sha256)) {
+                    return vmprog_validation_result::reserved_field_not_zero;
+                }
+            }
+        }
+
+        return vmprog_validation_result::ok;
+    }
+
+    /**
+     * @brief String checks: config and parameter strings.
+     *
+     * Requires check_vmprog_structure_v1_0() to have passed.
+     *
+     * @param file_data Complete file data
+     * @return Validation result
+     */
+    inline vmprog_validation_result check_vmprog_strings_v1_0(const uint8_t* file_data) {
+        const auto& header = *reinterpret_cast<const vmprog_header_v1_0*>(file_data);
+        const auto* config = reinterpret_cast<const vmprog_program_config_v1_0*>(find_sized_payload(
+            file_data, header, vmprog_toc_entry_type_v1_0::config, sizeof(vmprog_program_config_v1_0)));
+        if (!config) {
+            return vmprog_validation_result::ok;
+        }
+
+        if (!is_string_terminated(config->program_id, sizeof(config->program_id)) ||
+            !is_string_terminated(config->program_name, sizeof(config->program_name)) ||
+            !is_string_terminated(config->author, sizeof(config->author)) ||
+            !is_string_terminated(config->license, sizeof(config->license)) ||
+            !is_string_terminated(config->category, sizeof(config->category)) ||
+            !is_string_terminated(config->description, sizeof(config->description))) {
+            return vmprog_validation_result::string_not_terminated;
+        }
+        if (config->program_id[0] == '\0' || config->program_name[0] == '\0') {
+            return vmprog_validation_result::string_not_terminated;
+        }
+
+        for (uint32_t i = 0; i < config->parameter_count; ++i) {
+            const auto& param = config->parameters[i];
+            if (!is_string_terminated(param.name_label, sizeof(param.name_label)) ||
+                !is_string_terminated(param.suffix_label, sizeof(param.suffix_label))) {
+                return vmprog_validation_result::string_not_terminated;
+            }
+            for (uint32_t j = 0; j < param.value_label_count; ++j) {
+                if (!is_string_terminated(param.value_labels[j], sizeof(param.value_labels[j]))) {
+                    return vmprog_validation_result::string_not_terminated;
+                }
+            }
+        }
+
+        return vmprog_validation_result::ok;
+    }
+
+    /**
+     * @brief Signature check over the signed descriptor, and the payloads it covers.
+     *
+     * After the Ed25519 signature verifies, the config and every artifact the
+     * descriptor lists must match the descriptor's signed hashes, and every
+     * bitstream in the TOC must be listed. TOC hashes are not signed, so
+     * payload_hashes alone cannot detect a swapped payload with a rewritten
+     * TOC hash. Same trust anchor as verify_package_selective_stream().
+     *
+     * When payload_hashes runs in the same plan, the signed hashes are
+     * compared with the TOC hashes it verifies, as vmprog_package_installer
+     * does, so no payload is hashed twice. Otherwise the payloads are hashed
+     * here.
+     *
+     * Requires check_vmprog_structure_v1_0() to have passed.
+     *
+     * @param file_data Complete file data
+     * @param policy Policy supplying the key and unsigned-package handling
+     * @param payload_hashes_checked Whether payload_hashes also runs in the plan
+     * @return Validation result
+     */
+    inline vmprog_validation_result check_vmprog_signature_v1_0(
+        const uint8_t* file_data,
+        const vmprog_validation_policy_v1_0& policy,
+        bool payload_hashes_checked = false
+    ) {
+        const auto& header = *reinterpret_cast<const vmprog_header_v1_0*>(file_data);
+        if (!is_package_signed(header)) {
+            return policy.require_signed ? vmprog_validation_result::invalid_hash : vmprog_validation_result::ok;
+        }
+
+        const auto* descriptor = reinterpret_cast<const vmprog_signed_descriptor_v1_0*>(find_sized_payload(
+            file_data, header, vmprog_toc_entry_type_v1_0::signed_descriptor, sizeof(vmprog_signed_descriptor_v1_0)));
+        const uint8_t* signature = find_sized_payload(
+            file_data, header, vmprog_toc_entry_type_v1_0::signature, VMPROG_SIGNATURE_SIZE);
+        if (!descriptor || !signature) {
+            return vmprog_validation_result::invalid_hash;
+        }
+
+        const bool verified = policy.public_key
+            ? verify_ed25519_signature(signature, policy.public_key, *descriptor)
+            : verify_with_builtin_keys(signature, *descriptor);
+        if (!verified) {
+            return vmprog_validation_result::invalid_hash;
+        }
+
+        // A payload matches a signed hash through its verified TOC hash, or by hashing it here
+        const auto matches_signed_hash = [&](const vmprog_toc_entry_v1_0& entry, const uint8_t* signed_hash) {
+            return payload_hashes_checked
+                ? secure_compare_hash(signed_hash, entry.sha256)
+                : verify_hash(file_data + entry.offset, entry.size, signed_hash);
+        };
+
+        // Config, against the signed config hash
+        const auto* toc = reinterpret_cast<const vmprog_toc_entry_v1_0*>(file_data + header.toc_offset);
+        const vmprog_toc_entry_v1_0* config_entry = find_toc_entry(toc, header.toc_count, vmprog_toc_entry_type_v1_0::config);
+        if (!config_entry || config_entry->size != sizeof(vmprog_program_config_v1_0)) {
+            return vmprog_validation_result::invalid_toc_entry;
+        }
+        if (!matches_signed_hash(*config_entry, descriptor->config_sha256)) {
+            return vmprog_validation_result::invalid_hash;
+        }
+
+        // Every listed artifact, against its signed hash
+        for (uint32_t i = 0; i < descriptor->artifact_count && i < vmprog_signed_descriptor_v1_0::max_artifacts; ++i) {
+            const vmprog_toc_entry_v1_0* entry = find_toc_entry(toc, header.toc_count, descriptor->artifacts[i].type);
+            if (!entry) {
+                return vmprog_validation_result::invalid_toc_entry;
+            }
+            if (!matches_signed_hash(*entry, descriptor->artifacts[i].sha256)) {
+                return vmprog_validation_result::invalid_hash;
+            }
+        }
+
+        // No bitstream the device could load may be left unsigned
+        for (uint32_t i = 0; i < header.toc_count; ++i) {
+            const auto type = static_cast<uint32_t>(toc[i].type);
+            if (type < static_cast<uint32_t>(vmprog_toc_entry_type_v1_0::fpga_bitstream) ||
+                type > static_cast<uint32_t>(vmprog_toc_entry_type_v1_0::bitstream_hd_dual)) {
+                continue;
+            }
+            bool listed = false;
+            for (uint32_t j = 0; j < descriptor->artifact_count && j < vmprog_signed_descriptor_v1_0::max_artifacts; ++j) {
+                listed = listed || descriptor->artifacts[j].type == toc[i].type;
+            }
+            if (!listed) {
+                return vmprog_validation_result::invalid_toc_entry;
+            }
+        }
+
+        return vmprog_validation_result::ok;
+    }
+
+    // =============================================================================
+    // Plan Execution
+    // =============================================================================
+
+    /**
+     * @brief Run an execution plan, stopping at the first failure.
+     *
+     * @param plan Execution plan from make_vmprog_validation_plan()
+     * @param policy Policy supplying signature options
+     * @param file_data Complete file data
+     * @param file_size File size in bytes
+     * @param out_failed_check Optional output: the check that failed (none on success)
+     * @return Validation result
+     */
+    inline vmprog_validation_result run_vmprog_validation_plan(
+        const vmprog_validation_plan_v1_0& plan,
+        const vmprog_validation_policy_v1_0& policy,
+        const uint8_t* file_data,
+        uint32_t file_size,
+        vmprog_validation_checks_v1_0* out_failed_check = nullptr
+    ) {
+        if (out_failed_check) *out_failed_check = vmprog_validation_checks_v1_0::none;
+
+        bool payload_hashes_checked = false;
+        for (uint32_t i = 0; i < plan.step_count; ++i) {
+            payload_hashes_checked = payload_hashes_checked || plan.steps[i] == vmprog_validation_checks_v1_0::payload_hashes;
+        }
+
+        for (uint32_t i = 0; i < plan.step_count; ++i) {
+            auto result = vmprog_validation_result::ok;
+            const auto& header = *reinterpret_cast<const vmprog_header_v1_0*>(file_data);
+
+            switch (plan.steps[i]) {
+                case vmprog_validation_checks_v1_0::structure:
+                    result = check_vmprog_structure_v1_0(file_data, file_size);
+                    break;
+                case vmprog_validation_checks_v1_0::reserved_zero:
+                    result = check_vmprog_reserved_fields_v1_0(file_data);
+                    break;
+                case vmprog_validation_checks_v1_0::strings:
+                    result = check_vmprog_strings_v1_0(file_data);
+                    break;
+                case vmprog_validation_checks_v1_0::payload_hashes:
+                    result = verify_all_payload_hashes(file_data, file_size, header);
+                    break;
+                case vmprog_validation_checks_v1_0::package_hash:
+                    if (!is_hash_zero(header.sha256_package) && !verify_package_sha256(file_data, file_size)) {
+                        result = vmprog_validation_result::invalid_hash;
+                    }
+                    break;
+                case vmprog_validation_checks_v1_0::signature:
+                    result = check_vmprog_signature_v1_0(file_data, policy, payload_hashes_checked);
+                    break;
+                default:
+                    break;
+            }
+
+            if (result != vmprog_validation_result::ok) {
+                if (out_failed_check) *out_failed_check = plan.steps[i];
+                return result;
+            }
+        }
+
+        return vmprog_validation_result::ok;
+    }
+
+    /**
+     * @brief Validate a package according to a policy.
+     *
+     * @param file_data Complete file data
+     * @param file_size File size in bytes
+     * @param policy Validation policy (e.g. vmprog_validation_profile_boot)
+     * @param out_failed_check Optional output: the check that failed (none on success)
+     * @return Validation result
+     */
+    inline vmprog_validation_result validate_vmprog_package_with_policy(
+        const uint8_t* file_data,
+        uint32_t file_size,
+        const vmprog_validation_policy_v1_0& policy,
+        vmprog_validation_checks_v1_0* out_failed_check = nullptr
+    ) {
+        const auto plan = make_vmprog_validation_plan(policy.checks, file_size);
+        return run_vmprog_validation_plan(plan, policy, file_data, file_size, out_failed_check);
+    }
+
+} // namespace lzx
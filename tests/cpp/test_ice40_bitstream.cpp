@@ -0,0 +1,224 @@
+// Videomancer SDK - Unit Tests for ice40_bitstream.hpp
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <lzx/videomancer/ice40_bitstream.hpp>
+#include "test_ice40_image.hpp"
+#include "test_vmprog_package.hpp"
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace lzx;
+
+static void make_table(uint16_t words[ice40_bram_block_words], uint16_t seed) {
+    for (uint32_t i = 0; i < ice40_bram_block_words; ++i) {
+        words[i] = static_cast<uint16_t>(i * 0x9E37u + seed);
+    }
+}
+
+// Test CRC-16/CCITT against its check value
+bool test_crc() {
+    const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    if (ice40_crc16(0xFFFF, check, sizeof(check)) != 0x29B1) {
+        std::cerr << "FAILED: CRC check value" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: CRC test" << std::endl;
+    return true;
+}
+
+// Test section indexing and error reporting
+bool test_parse() {
+    std::vector<uint8_t> image = build_test_ice40_banked_image();
+    ice40_bitstream bitstream;
+    if (bitstream.parse(image.data(), static_cast<uint32_t>(image.size())) != ice40_parse_result::ok) {
+        std::cerr << "FAILED: Valid image rejected" << std::endl;
+        return false;
+    }
+    if (bitstream.section_count() != 12 || bitstream.bram_block_count(0) != test_ice40_bram_width / 16 ||
+        bitstream.bram_block_count(3) != test_ice40_bram_width / 16) {
+        std::cerr << "FAILED: Expected 12 sections, got " << bitstream.section_count() << std::endl;
+        return false;
+    }
+    const ice40_section& cram = bitstream.section(1);
+    const ice40_section& bram = bitstream.section(5);
+    if (cram.kind != ice40_section_kind::cram || cram.bank != 1 || cram.width != test_ice40_cram_width ||
+        bram.kind != ice40_section_kind::bram || bram.bank != 0 || bram.row_offset != test_ice40_bram_chunk ||
+        bram.height != test_ice40_bram_chunk || image[bram.data_offset] != 0x41) {
+        std::cerr << "FAILED: Section fields incorrect" << std::endl;
+        return false;
+    }
+
+    std::vector<uint8_t> corrupt = image;
+    corrupt[bram.data_offset + 7] ^= 0x10;
+    if (bitstream.parse(corrupt.data(), static_cast<uint32_t>(corrupt.size())) != ice40_parse_result::crc_mismatch) {
+        std::cerr << "FAILED: Corrupt data not detected" << std::endl;
+        return false;
+    }
+
+    std::vector<uint8_t> truncated(image.begin(), image.begin() + bram.data_offset + 10);
+    if (bitstream.parse(truncated.data(), static_cast<uint32_t>(truncated.size())) != ice40_parse_result::truncated) {
+        std::cerr << "FAILED: Truncated image not detected" << std::endl;
+        return false;
+    }
+
+    std::vector<uint8_t> no_sync(64, 0xFF);
+    if (bitstream.parse(no_sync.data(), static_cast<uint32_t>(no_sync.size())) != ice40_parse_result::no_preamble) {
+        std::cerr << "FAILED: Missing preamble not detected" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Parse test" << std::endl;
+    return true;
+}
+
+// Test BRAM block writes, the word-to-bit mapping and CRC fixup
+bool test_bram_patch() {
+    std::vector<uint8_t> image = build_test_ice40_banked_image();
+    const std::vector<uint8_t> original = image;
+    ice40_bitstream bitstream;
+    bitstream.parse(image.data(), static_cast<uint32_t>(image.size()));
+
+    uint16_t table[ice40_bram_block_words];
+    make_table(table, 0x1234);
+    if (!bitstream.write_bram_block(2, 5, table) || bitstream.write_bram_block(2, test_ice40_bram_width / 16, table)) {
+        std::cerr << "FAILED: Block range checks" << std::endl;
+        return false;
+    }
+
+    uint16_t readback[ice40_bram_block_words];
+    bitstream.read_bram_block(2, 5, readback);
+    if (memcmp(readback, table, sizeof(table)) != 0) {
+        std::cerr << "FAILED: Block readback differs" << std::endl;
+        return false;
+    }
+
+    // Word 17 bit 3 is INIT_1 bit 19: column 16 * 5 + 1, row 19 (first chunk)
+    // Word 200 bit 15 is INIT_12 bit 143: column 16 * 5 + 12, row 143 (second chunk)
+    bool bit = false;
+    if (!bitstream.get_bram_bit(2, 81, 19, bit) || bit != (((table[17] >> 3) & 1) != 0) ||
+        !bitstream.get_bram_bit(2, 92, 143, bit) || bit != (((table[200] >> 15) & 1) != 0)) {
+        std::cerr << "FAILED: Word-to-bit mapping" << std::endl;
+        return false;
+    }
+
+    // Only bank 2 BRAM data may change
+    for (uint32_t i = 0; i < bitstream.section_count(); ++i) {
+        const ice40_section& s = bitstream.section(i);
+        const uint32_t size = static_cast<uint32_t>(s.width) * s.height / 8;
+        const bool changed = memcmp(image.data() + s.data_offset, original.data() + s.data_offset, size) != 0;
+        if (changed != (s.kind == ice40_section_kind::bram && s.bank == 2)) {
+            std::cerr << "FAILED: Section " << i << " modified unexpectedly" << std::endl;
+            return false;
+        }
+    }
+
+    if (bitstream.compute_crc() == bitstream.stored_crc()) {
+        std::cerr << "FAILED: CRC should be stale before update" << std::endl;
+        return false;
+    }
+    bitstream.update_crc();
+    ice40_bitstream reparsed;
+    if (reparsed.parse(image.data(), static_cast<uint32_t>(image.size())) != ice40_parse_result::ok) {
+        std::cerr << "FAILED: Patched image rejected" << std::endl;
+        return false;
+    }
+
+    uint8_t bank = 0;
+    uint16_t block = 0;
+    if (!reparsed.find_bram_block(table, bank, block) || bank != 2 || block != 5) {
+        std::cerr << "FAILED: Placeholder search" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: BRAM patch test" << std::endl;
+    return true;
+}
+
+// Test patching a bitstream inside a package and refreshing only its hashes
+bool test_package_patch() {
+    const test_keys keys(0x50);
+    const uint8_t* secret_key = keys.secret_key;
+    const uint8_t* public_key = keys.public_key;
+
+    test_package_spec spec;
+    spec.program_id = "test.ice40";
+    spec.program_name = "iCE40 Test";
+    spec.variants = { vmprog_toc_entry_type_v1_0::bitstream_sd_analog };
+    spec.bitstream = build_test_ice40_banked_image();
+    spec.package_hash = true;
+    std::vector<uint8_t> package = create_test_package(keys, spec);
+    const uint32_t size = static_cast<uint32_t>(package.size());
+    const auto* toc = reinterpret_cast<const vmprog_toc_entry_v1_0*>(package.data() + sizeof(vmprog_header_v1_0));
+    uint8_t config_hash[32];
+    memcpy(config_hash, toc[0].sha256, 32);
+
+    auto patch = [&](uint16_t seed_value) {
+        ice40_bitstream bitstream;
+        bitstream.parse(package.data() + toc[3].offset, toc[3].size);
+        uint16_t table[ice40_bram_block_words];
+        make_table(table, seed_value);
+        bitstream.write_bram_block(1, 0, table);
+        bitstream.update_crc();
+    };
+
+    // Re-signed with the key: everything verifies
+    patch(0x0101);
+    bool stale = true;
+    if (rehash_vmprog_payload(package.data(), size, 3, secret_key, stale) != vmprog_validation_result::ok || stale ||
+        validate_vmprog_package(package.data(), size, true, true, public_key) != vmprog_validation_result::ok ||
+        !verify_package_sha256(package.data(), size) || memcmp(config_hash, toc[0].sha256, 32) != 0) {
+        std::cerr << "FAILED: Re-signed package does not verify" << std::endl;
+        return false;
+    }
+
+    // Without the key: hashes verify, the signature is reported stale
+    patch(0x0202);
+    if (rehash_vmprog_payload(package.data(), size, 3, nullptr, stale) != vmprog_validation_result::ok || !stale ||
+        validate_vmprog_package(package.data(), size, true, false) != vmprog_validation_result::ok ||
+        validate_vmprog_package(package.data(), size, true, true, public_key) == vmprog_validation_result::ok) {
+        std::cerr << "FAILED: Stale signature not reported" << std::endl;
+        return false;
+    }
+
+    if (rehash_vmprog_payload(package.data(), size, 4, nullptr, stale) != vmprog_validation_result::invalid_toc_entry) {
+        std::cerr << "FAILED: Out-of-range TOC index accepted" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Package patch test" << std::endl;
+    return true;
+}
+
+// Main test runner
+int main() {
+    std::cout << "======================================" << std::endl;
+    std::cout << "Videomancer ice40_bitstream.hpp Tests" << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << std::endl;
+
+    int passed = 0;
+    int total = 0;
+
+    #define RUN_TEST(test_func) \
+        do { \
+            total++; \
+            if (test_func()) { \
+                passed++; \
+            } \
+        } while(0)
+
+    RUN_TEST(test_crc);
+    RUN_TEST(test_parse);
+    RUN_TEST(test_bram_patch);
+    RUN_TEST(test_package_patch);
+
+    std::cout << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
+    std::cout << "======================================" << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
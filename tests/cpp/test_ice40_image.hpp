@@ -0,0 +1,111 @@
+// Videomancer SDK - Shared iCE40 Image Fixture for Unit Tests
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <lzx/videomancer/ice40_bitstream.hpp>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Minimal icepack image: one 256-bit-wide CRAM section of data_size bytes whose content depends on seed
+//
+// Sized once and written in place: growing the vector from an initializer list
+// trips a GCC 12 -Wstringop-overread/-Warray-bounds false positive.
+inline std::vector<uint8_t> build_test_ice40_image(uint32_t data_size, uint8_t seed) {
+    const uint16_t width = 256;
+    const uint16_t height = static_cast<uint16_t>(data_size * 8 / width);
+    const uint8_t preamble[] = { 0xFF, 0x00, 0x00, 0xFF, 0x7E, 0xAA, 0x99, 0x7E, 0x51, 0x00, 0x01, 0x05 };
+    const uint8_t setup[] = { 0x62, static_cast<uint8_t>((width - 1) >> 8), static_cast<uint8_t>(width - 1),
+                              0x72, static_cast<uint8_t>(height >> 8), static_cast<uint8_t>(height),
+                              0x82, 0x00, 0x00, 0x11, 0x00, 0x01, 0x01 };
+    const uint8_t section_end[] = { 0x00, 0x00, 0x22 };
+
+    std::vector<uint8_t> image(sizeof(preamble) + sizeof(setup) + data_size + sizeof(section_end) + 5);
+    uint8_t* out = image.data();
+    memcpy(out, preamble, sizeof(preamble));
+    out += sizeof(preamble);
+    const uint8_t* crc_start = out;
+    memcpy(out, setup, sizeof(setup));
+    out += sizeof(setup);
+    for (uint32_t i = 0; i < data_size; ++i) *out++ = static_cast<uint8_t>(i * seed + 1);
+    memcpy(out, section_end, sizeof(section_end));
+    out += sizeof(section_end);
+    const uint16_t crc = lzx::ice40_crc16(0xFFFF, crc_start, static_cast<uint32_t>(out - crc_start));
+    *out++ = static_cast<uint8_t>(crc >> 8);
+    *out++ = static_cast<uint8_t>(crc);
+    *out++ = 0x01;
+    *out++ = 0x06;
+    *out++ = 0x00;
+    return image;
+}
+
+// Geometry of build_test_ice40_banked_image(): small CRAM banks, HX8K-style BRAM banks
+constexpr uint16_t test_ice40_cram_width = 48;
+constexpr uint16_t test_ice40_cram_height = 16;
+constexpr uint16_t test_ice40_bram_width = 128;
+constexpr uint16_t test_ice40_bram_chunk = 128;
+
+// icepack command writer with running CRC
+struct test_ice40_writer {
+    std::vector<uint8_t> bytes;
+    uint16_t crc = 0;
+
+    void byte(uint8_t b) {
+        bytes.push_back(b);
+        crc = lzx::ice40_crc16(crc, &b, 1);
+    }
+
+    void command(uint8_t opcode, uint32_t payload, uint8_t length) {
+        byte(static_cast<uint8_t>(opcode << 4 | length));
+        for (int i = length - 1; i >= 0; --i) byte(static_cast<uint8_t>(payload >> (8 * i)));
+    }
+
+    void data(uint32_t size, uint8_t seed) {
+        for (uint32_t i = 0; i < size; ++i) byte(static_cast<uint8_t>(i * 31 + seed));
+        byte(0);
+        byte(0);
+    }
+};
+
+// Image laid out as icepack writes it: 4 CRAM sections, then 4 BRAM banks of 2 chunks.
+// CRAM bank b is filled from seed b, BRAM chunk c of bank b from seed 0x40 + 2b + c.
+inline std::vector<uint8_t> build_test_ice40_banked_image() {
+    test_ice40_writer w;
+    const uint8_t comment[] = { 0xFF, 0x00, 't', 'e', 's', 't', 0x00, 0xFF };
+    w.bytes.assign(comment, comment + sizeof(comment));
+    const uint8_t preamble[] = { 0x7E, 0xAA, 0x99, 0x7E };
+    w.bytes.insert(w.bytes.end(), preamble, preamble + 4);
+
+    w.command(0x5, 0x00, 1);
+    w.command(0x0, 0x05, 1);
+    w.crc = 0xFFFF;
+    w.command(0x9, 0x0000, 2);
+    w.command(0x6, test_ice40_cram_width - 1, 2);
+    w.command(0x7, test_ice40_cram_height, 2);
+    w.command(0x8, 0, 2);
+    for (uint8_t bank = 0; bank < 4; ++bank) {
+        w.command(0x1, bank, 1);
+        w.command(0x0, 0x01, 1);
+        w.data(test_ice40_cram_width * test_ice40_cram_height / 8, bank);
+    }
+    w.command(0x6, test_ice40_bram_width - 1, 2);
+    for (uint8_t bank = 0; bank < 4; ++bank) {
+        for (uint16_t offset = 0; offset < 256; offset += test_ice40_bram_chunk) {
+            w.command(0x1, bank, 1);
+            w.command(0x7, test_ice40_bram_chunk, 2);
+            w.command(0x8, offset, 2);
+            w.command(0x0, 0x03, 1);
+            w.data(test_ice40_bram_width * test_ice40_bram_chunk / 8,
+                   static_cast<uint8_t>(0x40 + bank * 2 + offset / test_ice40_bram_chunk));
+        }
+    }
+    w.byte(0x22);
+    const uint16_t crc = w.crc;
+    w.byte(static_cast<uint8_t>(crc >> 8));
+    w.byte(static_cast<uint8_t>(crc));
+    w.command(0x0, 0x06, 1);
+    w.byte(0x00);
+    return w.bytes;
+}
@@ -0,0 +1,151 @@
+// Videomancer SDK - Unit Tests for ice40_multiboot.hpp
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <lzx/videomancer/ice40_multiboot.hpp>
+#include <iostream>
+#include <vector>
+
+using namespace lzx;
+
+// Test image placement
+bool test_plan() {
+    const uint32_t sizes[] = { 104090, 5000, 32220 };
+    ice40_multiboot_layout layout;
+    if (!plan_ice40_multiboot(sizes, 3, 1, ice40_multiboot_default_alignment, layout)) {
+        std::cerr << "FAILED: Valid layout rejected" << std::endl;
+        return false;
+    }
+    // 160 header bytes round up to 4096; 4096 + 104090 = 108186 -> 110592; +5000 -> 118784
+    if (layout.offset[0] != 4096 || layout.offset[1] != 110592 || layout.offset[2] != 118784 ||
+        layout.total_size != 118784 + 32220 || layout.power_on_image != 1) {
+        std::cerr << "FAILED: Unexpected offsets " << layout.offset[0] << ", " << layout.offset[1]
+                  << ", " << layout.offset[2] << std::endl;
+        return false;
+    }
+
+    if (!plan_ice40_multiboot(sizes, 1, 0, 256, layout) || layout.offset[0] != 256) {
+        std::cerr << "FAILED: 256-byte alignment" << std::endl;
+        return false;
+    }
+
+    const uint32_t five[] = { 1, 1, 1, 1, 1 };
+    const uint32_t huge[] = { 1u << 24 };
+    if (plan_ice40_multiboot(five, 5, 0, 256, layout) ||
+        plan_ice40_multiboot(sizes, 0, 0, 256, layout) ||
+        plan_ice40_multiboot(sizes, 2, 2, 256, layout) ||
+        plan_ice40_multiboot(sizes, 2, 0, 3000, layout) ||
+        plan_ice40_multiboot(huge, 1, 0, 256, layout)) {
+        std::cerr << "FAILED: Invalid layout accepted" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Plan test" << std::endl;
+    return true;
+}
+
+// Test header bytes against the icemulti format
+bool test_headers() {
+    const uint32_t sizes[] = { 1000, 2000 };
+    ice40_multiboot_layout layout;
+    plan_ice40_multiboot(sizes, 2, 1, 256, layout);
+
+    uint8_t headers[ice40_multiboot_headers_size];
+    write_ice40_multiboot_headers(layout, headers);
+
+    const uint8_t expected_power_on[32] = {
+        0x7E, 0xAA, 0x99, 0x7E, 0x92, 0x00, 0x00, 0x44, 0x03, 0x00, 0x05, 0x00,
+        0x82, 0x00, 0x00, 0x01, 0x08,
+    };
+    if (memcmp(headers, expected_power_on, sizeof(expected_power_on)) != 0) {
+        std::cerr << "FAILED: Power-on header bytes" << std::endl;
+        return false;
+    }
+
+    uint32_t addresses[ice40_multiboot_header_count];
+    if (!read_ice40_multiboot_headers(headers, sizeof(headers), addresses)) {
+        std::cerr << "FAILED: Headers not readable" << std::endl;
+        return false;
+    }
+    // Power-on image 1, warmboot 0 and 1, unused slots 2 and 3 fall back to image 0
+    const uint32_t expected[] = { 0x500, 0x100, 0x500, 0x100, 0x100 };
+    if (memcmp(addresses, expected, sizeof(expected)) != 0) {
+        std::cerr << "FAILED: Boot addresses" << std::endl;
+        return false;
+    }
+
+    headers[32 + 7] = 0x00;
+    if (read_ice40_multiboot_headers(headers, sizeof(headers), addresses)) {
+        std::cerr << "FAILED: Malformed header accepted" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Header test" << std::endl;
+    return true;
+}
+
+// Test a full flash image
+bool test_pack() {
+    std::vector<uint8_t> a(3000, 0xA5);
+    std::vector<uint8_t> b(7000, 0x5A);
+    const uint8_t* images[] = { a.data(), b.data() };
+    const uint32_t sizes[] = { static_cast<uint32_t>(a.size()), static_cast<uint32_t>(b.size()) };
+
+    std::vector<uint8_t> flash(16384, 0x00);
+    ice40_multiboot_layout layout;
+    if (pack_ice40_multiboot(images, sizes, 2, 0, flash.data(), 8192, layout)) {
+        std::cerr << "FAILED: Undersized flash buffer accepted" << std::endl;
+        return false;
+    }
+    if (!pack_ice40_multiboot(images, sizes, 2, 0, flash.data(), static_cast<uint32_t>(flash.size()), layout) ||
+        layout.total_size != 8192 + 7000) {
+        std::cerr << "FAILED: Pack" << std::endl;
+        return false;
+    }
+
+    uint32_t addresses[ice40_multiboot_header_count];
+    read_ice40_multiboot_headers(flash.data(), layout.total_size, addresses);
+    if (memcmp(flash.data() + addresses[1], a.data(), a.size()) != 0 ||
+        memcmp(flash.data() + addresses[2], b.data(), b.size()) != 0) {
+        std::cerr << "FAILED: Images not at their boot addresses" << std::endl;
+        return false;
+    }
+    // Gaps are erased flash
+    if (flash[ice40_multiboot_headers_size] != 0xFF || flash[4096 + 3000] != 0xFF || flash[8191] != 0xFF) {
+        std::cerr << "FAILED: Gaps not 0xFF" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Pack test" << std::endl;
+    return true;
+}
+
+// Main test runner
+int main() {
+    std::cout << "======================================" << std::endl;
+    std::cout << "Videomancer ice40_multiboot.hpp Tests" << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << std::endl;
+
+    int passed = 0;
+    int total = 0;
+
+    #define RUN_TEST(test_func) \
+        do { \
+            total++; \
+            if (test_func()) { \
+                passed++; \
+            } \
+        } while(0)
+
+    RUN_TEST(test_plan);
+    RUN_TEST(test_headers);
+    RUN_TEST(test_pack);
+
+    std::cout << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
+    std::cout << "======================================" << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
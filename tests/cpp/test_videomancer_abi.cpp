@@ -204,6 +204,65 @@ bool test_video_timing_completeness() {
     return true;
 }
 
+// Test video timing table geometry and frame rates
+bool test_video_timing_table() {
+    const video_timing_info& ntsc = get_video_timing_info(video_timing_id::ntsc);
+    if (ntsc.clocks_per_line != 858 || ntsc.lines_per_frame != 525 ||
+        !ntsc.is_interlaced || ntsc.top_field_first ||
+        ntsc.frame_rate_num != 30000 || ntsc.frame_rate_den != 1001) {
+        std::cerr << "FAILED: Video timing table test - NTSC entry incorrect" << std::endl;
+        return false;
+    }
+
+    const video_timing_info& hd = get_video_timing_info(video_timing_id::_1080p30);
+    if (hd.frame_width != 1920 || hd.frame_height != 1080 || hd.is_interlaced) {
+        std::cerr << "FAILED: Video timing table test - 1080p30 entry incorrect" << std::endl;
+        return false;
+    }
+
+    // Every defined mode must fit its active area inside the total raster
+    for (uint8_t i = 0; i < 15; ++i) {
+        const video_timing_id id = static_cast<video_timing_id>(i);
+        const video_timing_info& info = get_video_timing_info(id);
+        if (!is_video_timing_defined(id) ||
+            info.frame_width >= info.clocks_per_line ||
+            info.frame_height >= info.lines_per_frame ||
+            info.frame_rate_den == 0) {
+            std::cerr << "FAILED: Video timing table test - invalid entry 0x"
+                      << std::hex << static_cast<int>(i) << std::dec << std::endl;
+            return false;
+        }
+    }
+
+    if (is_video_timing_defined(video_timing_id::reserved)) {
+        std::cerr << "FAILED: Video timing table test - reserved mode reported as defined" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Video timing table test" << std::endl;
+    return true;
+}
+
+// Test pixel clock derivation from the timing table
+bool test_video_timing_pixel_clock() {
+    static_assert(get_pixel_clock_hz(video_timing_id::_1080p30) == 74250000,
+                  "1080p30 pixel clock must be 74.25 MHz");
+    static_assert(get_pixel_clock_hz(video_timing_id::_720p50) == 74250000,
+                  "720p50 pixel clock must be 74.25 MHz");
+
+    if (get_pixel_clock_hz(video_timing_id::ntsc) != 13500000 ||
+        get_pixel_clock_hz(video_timing_id::pal) != 13500000 ||
+        get_pixel_clock_hz(video_timing_id::_480p) != 27000000 ||
+        get_pixel_clock_hz(video_timing_id::_1080i5994) != 74175824 ||
+        get_pixel_clock_hz(video_timing_id::reserved) != 0) {
+        std::cerr << "FAILED: Pixel clock test - unexpected frequency" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Pixel clock derivation test" << std::endl;
+    return true;
+}
+
 // Main test runner
 int main() {
     std::cout << "======================================" << std::endl;
@@ -228,6 +287,8 @@ int main() {
     RUN_TEST(test_toggle_switch_masks);
     RUN_TEST(test_video_timing_ids);
     RUN_TEST(test_video_timing_completeness);
+    RUN_TEST(test_video_timing_table);
+    RUN_TEST(test_video_timing_pixel_clock);
 
     std::cout << std::endl;
     std::cout << "======================================" << std::endl;
@@ -0,0 +1,190 @@
+// Videomancer SDK - Unit Tests for videomancer_colorimetry.hpp
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <lzx/videomancer/videomancer_colorimetry.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace lzx;
+
+// Floating-point reference for one pixel
+static void reference_rgb(uint16_t y, uint16_t u, uint16_t v, double kr, double kb, double out[3]) {
+    const double kg = 1.0 - kr - kb;
+    const double luma = (y - 64.0) / 876.0;
+    const double pb = (u - 512.0) / 896.0;
+    const double pr = (v - 512.0) / 896.0;
+    out[0] = luma + 2.0 * (1.0 - kr) * pr;
+    out[1] = luma - 2.0 * kb * (1.0 - kb) / kg * pb - 2.0 * kr * (1.0 - kr) / kg * pr;
+    out[2] = luma + 2.0 * (1.0 - kb) * pb;
+    for (int c = 0; c < 3; ++c) {
+        out[c] = std::round(out[c] * 255.0);
+        out[c] = out[c] < 0.0 ? 0.0 : (out[c] > 255.0 ? 255.0 : out[c]);
+    }
+}
+
+// Test matrix selection by timing mode
+bool test_matrix_selection() {
+    using id = videomancer_abi_v1_0::video_timing_id;
+    const id sd[] = { id::ntsc, id::_480p, id::pal, id::_576p };
+    const id hd[] = { id::_1080i50, id::_1080p24, id::_720p50, id::_720p60, id::_1080p2997 };
+    for (id t : sd) {
+        if (get_videomancer_color_matrix(t) != videomancer_color_matrix::bt601) {
+            std::cerr << "FAILED: SD timing " << int(t) << " not BT.601" << std::endl;
+            return false;
+        }
+    }
+    for (id t : hd) {
+        if (get_videomancer_color_matrix(t) != videomancer_color_matrix::bt709) {
+            std::cerr << "FAILED: HD timing " << int(t) << " not BT.709" << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "PASSED: Matrix selection test" << std::endl;
+    return true;
+}
+
+// Test black, white and 100% colour bars against the floating-point reference
+bool test_reference_colors() {
+    struct matrix { videomancer_color_matrix id; double kr, kb; };
+    const matrix matrices[] = {
+        { videomancer_color_matrix::bt601, 0.299, 0.114 },
+        { videomancer_color_matrix::bt709, 0.2126, 0.0722 },
+    };
+    const double bars[8][3] = {
+        { 1, 1, 1 }, { 1, 1, 0 }, { 0, 1, 1 }, { 0, 1, 0 },
+        { 1, 0, 1 }, { 1, 0, 0 }, { 0, 0, 1 }, { 0, 0, 0 },
+    };
+
+    for (const matrix& m : matrices) {
+        const double kg = 1.0 - m.kr - m.kb;
+        for (const auto& bar : bars) {
+            // Encode the bar to 10-bit limited range
+            const double luma = m.kr * bar[0] + kg * bar[1] + m.kb * bar[2];
+            const double pb = (bar[2] - luma) / (2.0 * (1.0 - m.kb));
+            const double pr = (bar[0] - luma) / (2.0 * (1.0 - m.kr));
+            const uint16_t y = static_cast<uint16_t>(std::lround(64 + 876 * luma));
+            const uint16_t u = static_cast<uint16_t>(std::lround(512 + 896 * pb));
+            const uint16_t v = static_cast<uint16_t>(std::lround(512 + 896 * pr));
+
+            uint8_t rgba[4];
+            convert_yuv444_to_rgba8(&y, &u, &v, rgba, 1, get_videomancer_yuv_coefficients(m.id));
+            for (int c = 0; c < 3; ++c) {
+                const int expected = bar[c] > 0.5 ? 255 : 0;
+                if (std::abs(rgba[c] - expected) > 1) {
+                    std::cerr << "FAILED: Bar " << bar[0] << bar[1] << bar[2] << " channel " << c
+                              << " = " << int(rgba[c]) << std::endl;
+                    return false;
+                }
+            }
+            if (rgba[3] != 255) {
+                std::cerr << "FAILED: Alpha not opaque" << std::endl;
+                return false;
+            }
+        }
+
+        // Whole 10-bit range within one code of the reference
+        std::mt19937 rng(7);
+        for (int i = 0; i < 20000; ++i) {
+            const uint16_t y = static_cast<uint16_t>(rng() & 0x3FF);
+            const uint16_t u = static_cast<uint16_t>(rng() & 0x3FF);
+            const uint16_t v = static_cast<uint16_t>(rng() & 0x3FF);
+            uint8_t rgba[4];
+            double ref[3];
+            convert_yuv444_to_rgba8_scalar(&y, &u, &v, rgba, 1, get_videomancer_yuv_coefficients(m.id));
+            reference_rgb(y, u, v, m.kr, m.kb, ref);
+            for (int c = 0; c < 3; ++c) {
+                if (std::abs(rgba[c] - ref[c]) > 1.0) {
+                    std::cerr << "FAILED: (" << y << "," << u << "," << v << ") channel " << c << " = "
+                              << int(rgba[c]) << ", reference " << ref[c] << std::endl;
+                    return false;
+                }
+            }
+        }
+    }
+
+    std::cout << "PASSED: Reference colour test" << std::endl;
+    return true;
+}
+
+// Test that the vector kernel matches the scalar kernel bit for bit, including tails
+bool test_vector_matches_scalar() {
+    std::mt19937 rng(42);
+    for (size_t count : { size_t(1), size_t(7), size_t(8), size_t(9), size_t(31), size_t(1920) }) {
+        std::vector<uint16_t> y(count), u(count), v(count);
+        for (size_t i = 0; i < count; ++i) {
+            y[i] = static_cast<uint16_t>(rng() & 0x3FF);
+            u[i] = static_cast<uint16_t>(rng() & 0x3FF);
+            v[i] = static_cast<uint16_t>(rng() & 0x3FF);
+        }
+        for (auto matrix : { videomancer_color_matrix::bt601, videomancer_color_matrix::bt709 }) {
+            const auto& k = get_videomancer_yuv_coefficients(matrix);
+            std::vector<uint8_t> fast(count * 4, 0), slow(count * 4, 1);
+            convert_yuv444_to_rgba8(y.data(), u.data(), v.data(), fast.data(), count, k);
+            convert_yuv444_to_rgba8_scalar(y.data(), u.data(), v.data(), slow.data(), count, k);
+            if (fast != slow) {
+                std::cerr << "FAILED: Vector kernel differs from scalar for " << count << " pixels" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    std::cout << "PASSED: Vector/scalar equivalence test" << std::endl;
+    return true;
+}
+
+// Test whole-frame conversion for an SD and an HD mode
+bool test_frame_conversion() {
+    using id = videomancer_abi_v1_0::video_timing_id;
+    for (id t : { id::ntsc, id::_1080p30 }) {
+        const auto& info = videomancer_abi_v1_0::get_video_timing_info(t);
+        const size_t size = static_cast<size_t>(info.frame_width) * info.frame_height;
+        std::vector<uint16_t> y(size, 940), u(size, 512), v(size, 512);
+        y[size - 1] = 64;
+        std::vector<uint8_t> rgba(size * 4, 0);
+        convert_yuv444_frame_to_rgba8(y.data(), u.data(), v.data(), rgba.data(), t);
+        if (rgba[0] != 255 || rgba[1] != 255 || rgba[2] != 255 ||
+            rgba[(size - 1) * 4] != 0 || rgba[size * 4 - 1] != 255) {
+            std::cerr << "FAILED: Frame conversion for timing " << int(t) << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "PASSED: Frame conversion test" << std::endl;
+    return true;
+}
+
+// Main test runner
+int main() {
+    std::cout << "======================================" << std::endl;
+    std::cout << "Videomancer videomancer_colorimetry.hpp Tests" << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << std::endl;
+
+    int passed = 0;
+    int total = 0;
+
+    #define RUN_TEST(test_func) \
+        do { \
+            total++; \
+            if (test_func()) { \
+                passed++; \
+            } \
+        } while(0)
+
+    RUN_TEST(test_matrix_selection);
+    RUN_TEST(test_reference_colors);
+    RUN_TEST(test_vector_matches_scalar);
+    RUN_TEST(test_frame_conversion);
+
+    std::cout << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
+    std::cout << "======================================" << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
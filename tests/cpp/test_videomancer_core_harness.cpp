@@ -0,0 +1,312 @@
+// Videomancer SDK - Unit Tests for videomancer_core_harness.hpp
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <lzx/videomancer/videomancer_core_harness.hpp>
+#include <lzx/videomancer/videomancer_fpga_controller.hpp>
+#include <lzx/videomancer/videomancer_timing_detector.hpp>
+#include <iostream>
+#include <vector>
+
+using namespace lzx;
+
+// Behavioural stand-in for a generated core_top model: synchronized SPI
+// peripheral, hsync-latched registers, syncs delayed by sync_delay clocks and
+// pixels by two more, and a program that adds rotary pot 1 to luma.
+class behavioural_core : public videomancer_core_model {
+public:
+    static constexpr int sync_delay = 6;
+
+    uint32_t writes = 0;
+
+    void clock(const videomancer_core_inputs& in, videomancer_core_outputs& out) override {
+        // SPI through a 2-flop synchronizer, sampled on SCK rising
+        const bool sck = m_sck[1];
+        const bool cs_n = m_cs_n[1];
+        if (!cs_n && sck && !m_sck_d) {
+            m_shift = static_cast<uint16_t>((m_shift << 1) | (m_sdi[1] ? 1 : 0));
+            ++m_bits;
+        }
+        if (cs_n && !m_cs_n_d) {
+            if (m_bits == 16 && !(m_shift & 0x8000)) {
+                m_staged[(m_shift >> 10) & 0x1F] = m_shift & 0x3FF;
+                ++writes;
+            }
+        }
+        if (!cs_n && m_cs_n_d)
+            m_bits = 0;
+        m_sck_d = sck;
+        m_cs_n_d = cs_n;
+        m_sck[1] = m_sck[0]; m_sck[0] = in.spi_sck;
+        m_sdi[1] = m_sdi[0]; m_sdi[0] = in.spi_sdi;
+        m_cs_n[1] = m_cs_n[0]; m_cs_n[0] = in.spi_cs_n;
+
+        // Register shadow copy on the input hsync fall
+        if (!in.hsync_n && m_hsync_n_d) {
+            for (int i = 0; i < 9; ++i)
+                m_active[i] = m_staged[i];
+        }
+        m_hsync_n_d = in.hsync_n;
+
+        uint32_t luma = in.y + m_active[0];
+        if (luma > 1023)
+            luma = 1023;
+
+        // Delay lines
+        for (int i = depth - 1; i > 0; --i) {
+            m_y[i] = m_y[i - 1];
+            m_c[i] = m_c[i - 1];
+            m_h[i] = m_h[i - 1];
+            m_v[i] = m_v[i - 1];
+        }
+        m_y[0] = static_cast<uint16_t>(in.avid ? luma : 0);
+        m_c[0] = static_cast<uint16_t>(in.avid ? in.c : 512);
+        m_h[0] = in.hsync_n;
+        m_v[0] = in.vsync_n;
+
+        out.y = m_y[sync_delay + 2];
+        out.c = m_c[sync_delay + 2];
+        out.hsync_n = m_h[sync_delay];
+        out.vsync_n = m_v[sync_delay];
+    }
+
+private:
+    bool m_sck[2] = { false, false };
+    bool m_sdi[2] = { false, false };
+    bool m_cs_n[2] = { true, true };
+    bool m_sck_d = false;
+    bool m_cs_n_d = true;
+    uint16_t m_shift = 0;
+    int m_bits = 0;
+    uint16_t m_staged[32] = {};
+    uint16_t m_active[32] = {};
+    bool m_hsync_n_d = true;
+    static constexpr int depth = sync_delay + 3;
+    uint16_t m_y[depth] = {};
+    uint16_t m_c[depth] = {};
+    bool m_h[depth] = { true, true, true, true, true, true, true, true, true };
+    bool m_v[depth] = { true, true, true, true, true, true, true, true, true };
+};
+
+struct planes {
+    std::vector<uint16_t> y, u, v;
+
+    explicit planes(size_t size, uint16_t fill) : y(size, fill), u(size, fill), v(size, fill) {}
+
+    videomancer_frame_buffer view() { return { y.data(), u.data(), v.data() }; }
+};
+
+// Test raster geometry for progressive and interlaced modes
+bool test_raster() {
+    const videomancer_core_raster progressive(videomancer_abi_v1_0::video_timing_id::_480p);
+    const auto& info = progressive.info();
+    uint32_t active = 0;
+    uint32_t vsync_lines = 0;
+    std::vector<uint8_t> rows(info.frame_height, 0);
+    for (uint32_t clock = 0; clock < progressive.frame_clocks(); ++clock) {
+        const videomancer_raster_position pos = progressive.at(clock);
+        if (pos.avid) {
+            ++active;
+            if (pos.column == 0)
+                ++rows[pos.row];
+        }
+        if (!pos.vsync_n && clock % info.clocks_per_line == 0)
+            ++vsync_lines;
+        if (pos.avid && (!pos.hsync_n || !pos.vsync_n)) {
+            std::cerr << "FAILED: Active video overlaps sync at clock " << clock << std::endl;
+            return false;
+        }
+    }
+    if (active != static_cast<uint32_t>(info.frame_width) * info.frame_height || vsync_lines != 3) {
+        std::cerr << "FAILED: Progressive raster has " << active << " active pixels, "
+                  << vsync_lines << " vsync lines" << std::endl;
+        return false;
+    }
+
+    const videomancer_core_raster interlaced(videomancer_abi_v1_0::video_timing_id::ntsc);
+    const auto& ntsc = interlaced.info();
+    std::vector<uint8_t> seen(ntsc.frame_height, 0);
+    uint16_t first_row = 0xFFFF;
+    for (uint32_t clock = 0; clock < interlaced.frame_clocks(); ++clock) {
+        const videomancer_raster_position pos = interlaced.at(clock);
+        if (pos.avid && pos.column == 0) {
+            if (first_row == 0xFFFF)
+                first_row = pos.row;
+            ++seen[pos.row];
+        }
+    }
+    for (uint16_t row = 0; row < ntsc.frame_height; ++row) {
+        if (seen[row] != 1) {
+            std::cerr << "FAILED: Interlaced row " << row << " seen " << int(seen[row]) << " times" << std::endl;
+            return false;
+        }
+    }
+    if (first_row != 1) {
+        std::cerr << "FAILED: Bottom-field-first NTSC should start on row 1, got " << first_row << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Raster test" << std::endl;
+    return true;
+}
+
+// Test that the interlaced raster drives the RTL field detector: field_n low
+// through the first field of each frame and high through the second
+bool test_field_detection() {
+    const videomancer_core_raster raster(videomancer_abi_v1_0::video_timing_id::ntsc);
+    video_field_detector_model<12> detector;
+    for (int frame = 0; frame < 3; ++frame) {
+        uint32_t rows_seen = 0;
+        for (uint32_t clock = 0; clock < raster.frame_clocks(); ++clock) {
+            const videomancer_raster_position pos = raster.at(clock);
+            detector.step(pos.hsync_n, pos.vsync_n);
+            if (frame == 0 || !pos.avid || pos.column != 0)
+                continue;
+            // Bottom field first: odd rows arrive in the first field
+            const bool first_field = (pos.row & 1u) != 0;
+            if (detector.field_n() == first_field || !detector.is_interlaced()) {
+                std::cerr << "FAILED: Field detection - row " << pos.row << " field_n "
+                          << detector.field_n() << " in frame " << frame << std::endl;
+                return false;
+            }
+            ++rows_seen;
+        }
+        if (frame != 0 && rows_seen != raster.info().frame_height) {
+            std::cerr << "FAILED: Field detection - " << rows_seen << " rows in frame " << frame << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "PASSED: Field detection test" << std::endl;
+    return true;
+}
+
+// Test that a full frame round-trips through the model and lines up with the input
+bool test_frame_capture() {
+    const auto timing = videomancer_abi_v1_0::video_timing_id::_480p;
+    const auto& info = videomancer_abi_v1_0::get_video_timing_info(timing);
+    const size_t size = static_cast<size_t>(info.frame_width) * info.frame_height;
+
+    planes input(size, 0);
+    for (size_t i = 0; i < size; ++i) {
+        const size_t x = i % info.frame_width;
+        input.y[i] = static_cast<uint16_t>((i * 7) & 0x3FF);
+        input.u[i] = static_cast<uint16_t>(100 + (x / 2) % 800);   // Constant across each 4:2:2 pair
+        input.v[i] = static_cast<uint16_t>(900 - (x / 2) % 800);
+    }
+    planes output(size, 0xFFFF);
+
+    behavioural_core core;
+    videomancer_core_harness harness(core, timing);
+    harness.set_input_frame(input.view());
+    harness.set_output_frame(output.view());
+
+    if (harness.run_frames(1) != 1) {
+        std::cerr << "FAILED: No frame captured" << std::endl;
+        return false;
+    }
+    if (harness.sync_latency_clocks() != behavioural_core::sync_delay) {
+        std::cerr << "FAILED: Latency " << harness.sync_latency_clocks() << std::endl;
+        return false;
+    }
+    if (output.y != input.y || output.u != input.u || output.v != input.v) {
+        std::cerr << "FAILED: Captured frame differs from input" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Frame capture test" << std::endl;
+    return true;
+}
+
+// Test controller writes bit-banged over SPI while video runs
+bool test_register_writes() {
+    const auto timing = videomancer_abi_v1_0::video_timing_id::_480p;
+    const auto& info = videomancer_abi_v1_0::get_video_timing_info(timing);
+    const size_t size = static_cast<size_t>(info.frame_width) * info.frame_height;
+
+    planes output(size, 0);
+    behavioural_core core;
+    videomancer_core_harness harness(core, timing);
+    harness.set_output_frame(output.view());
+    videomancer_fpga_controller controller(harness);
+
+    const uint64_t before = harness.clock_count();
+    controller.set_rotary_pot_1(100);
+    controller.set_rotary_pot_2(200);
+    const uint64_t spi_clocks = harness.clock_count() - before;
+    if (core.writes != 2 || spi_clocks < 2 * 16 * 8) {
+        std::cerr << "FAILED: " << core.writes << " writes in " << spi_clocks << " clocks" << std::endl;
+        return false;
+    }
+
+    harness.run_frames(2);
+    for (uint16_t x = 0; x < info.frame_width; x += 97) {
+        const uint16_t expected = static_cast<uint16_t>(64 + (static_cast<uint32_t>(x) * 876) / info.frame_width + 100);
+        if (output.y[static_cast<size_t>(240) * info.frame_width + x] != expected) {
+            std::cerr << "FAILED: Luma at x=" << x << " is " << output.y[240 * info.frame_width + x]
+                      << ", expected " << expected << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "PASSED: Register write test" << std::endl;
+    return true;
+}
+
+// Test that every row of an interlaced frame is captured
+bool test_interlaced_capture() {
+    const auto timing = videomancer_abi_v1_0::video_timing_id::pal;
+    const auto& info = videomancer_abi_v1_0::get_video_timing_info(timing);
+    const size_t size = static_cast<size_t>(info.frame_width) * info.frame_height;
+
+    planes output(size, 0xFFFF);
+    behavioural_core core;
+    videomancer_core_harness harness(core, timing);
+    harness.set_output_frame(output.view());
+
+    if (harness.run_frames(1) != 1) {
+        std::cerr << "FAILED: No interlaced frame captured" << std::endl;
+        return false;
+    }
+    for (size_t i = 0; i < size; ++i) {
+        if (output.y[i] == 0xFFFF || output.u[i] != 512 || output.v[i] != 512) {
+            std::cerr << "FAILED: Pixel " << i << " not captured" << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "PASSED: Interlaced capture test" << std::endl;
+    return true;
+}
+
+// Main test runner
+int main() {
+    std::cout << "======================================" << std::endl;
+    std::cout << "Videomancer videomancer_core_harness.hpp Tests" << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << std::endl;
+
+    int passed = 0;
+    int total = 0;
+
+    #define RUN_TEST(test_func) \
+        do { \
+            total++; \
+            if (test_func()) { \
+                passed++; \
+            } \
+        } while(0)
+
+    RUN_TEST(test_raster);
+    RUN_TEST(test_field_detection);
+    RUN_TEST(test_frame_capture);
+    RUN_TEST(test_register_writes);
+    RUN_TEST(test_interlaced_capture);
+
+    std::cout << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
+    std::cout << "======================================" << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
@@ -0,0 +1,239 @@
+// Videomancer SDK - Unit Tests for videomancer_fpga_configurator.hpp
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <lzx/videomancer/videomancer_fpga_configurator.hpp>
+#include "test_ice40_image.hpp"
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace lzx;
+
+// Package stream over a byte vector; each read charges flash time to the model
+class flash_stream : public vmprog_stream {
+public:
+    flash_stream(const std::vector<uint8_t>& data, videomancer_fpga_config_model* model, double bytes_per_us)
+        : data_(data), model_(model), bytes_per_us_(bytes_per_us) {}
+
+    size_t read(uint8_t* buffer, size_t size) override {
+        if (position_ + size > data_.size()) return 0;
+        memcpy(buffer, data_.data() + position_, size);
+        position_ += size;
+        if (model_) model_->advance_us(static_cast<double>(size) / bytes_per_us_);
+        return size;
+    }
+
+    bool seek(size_t position) override {
+        if (position > data_.size()) return false;
+        position_ = position;
+        return true;
+    }
+
+private:
+    const std::vector<uint8_t>& data_;
+    videomancer_fpga_config_model* model_;
+    double bytes_per_us_;
+    size_t position_ = 0;
+};
+
+// FPGA without configuration pins
+class spi_only_fpga : public videomancer_fpga {
+public:
+    size_t transfer_spi(const uint8_t*, uint8_t*, size_t size) override { return size; }
+    void assert_chip_select_spi(bool) override {}
+};
+
+// Package-like file: image at a non-zero offset, described by a TOC entry
+struct test_package {
+    std::vector<uint8_t> file;
+    std::vector<uint8_t> image;
+    vmprog_toc_entry_v1_0 entry;
+
+    explicit test_package(uint32_t data_size) : image(build_test_ice40_image(data_size, 7)) {
+        file.assign(1000, 0xEE);
+        file.insert(file.end(), image.begin(), image.end());
+        init_toc_entry(entry);
+        entry.type = vmprog_toc_entry_type_v1_0::bitstream_sd_analog;
+        entry.offset = 1000;
+        entry.size = static_cast<uint32_t>(image.size());
+        sha256_oneshot(image.data(), entry.size, entry.sha256);
+    }
+};
+
+// Test a full configuration from a package stream with DMA overlap
+bool test_stream_configuration() {
+    test_package package(32768);
+    std::vector<uint8_t> capture(65536);
+    std::vector<uint8_t> buffer(8192);
+    videomancer_fpga_config_model model(capture.data(), static_cast<uint32_t>(capture.size()), 25000000, true);
+    flash_stream stream(package.file, &model, 20.0);
+    videomancer_fpga_configurator configurator(buffer.data(), static_cast<uint32_t>(buffer.size()));
+
+    const auto result = configurator.configure(model, stream, package.entry);
+    if (result != videomancer_configuration_result::ok || !model.user_mode() ||
+        model.error() != videomancer_config_model_error::none) {
+        std::cerr << "FAILED: Configuration result " << int(result) << ", model error " << int(model.error()) << std::endl;
+        return false;
+    }
+    if (model.received_bytes() != package.entry.size ||
+        memcmp(capture.data(), package.image.data(), package.image.size()) != 0 ||
+        configurator.chunks_written() != (package.entry.size + 4095) / 4096) {
+        std::cerr << "FAILED: Image not received intact in 4 KB chunks" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Stream configuration test" << std::endl;
+    return true;
+}
+
+// Test that DMA overlaps flash reads with the SPI transfer
+bool test_dma_overlap() {
+    test_package package(131072);
+    std::vector<uint8_t> capture(262144);
+    std::vector<uint8_t> buffer(8192);
+    double times[2] = { 0.0, 0.0 };
+    for (int dma = 0; dma < 2; ++dma) {
+        videomancer_fpga_config_model model(capture.data(), static_cast<uint32_t>(capture.size()), 25000000, dma != 0);
+        flash_stream stream(package.file, &model, 20.0);
+        videomancer_fpga_configurator configurator(buffer.data(), static_cast<uint32_t>(buffer.size()));
+        if (configurator.configure(model, stream, package.entry) != videomancer_configuration_result::ok ||
+            !model.user_mode()) {
+            std::cerr << "FAILED: Configuration failed with dma=" << dma << std::endl;
+            return false;
+        }
+        times[dma] = model.configuration_us();
+    }
+
+    // 25 MHz SPI moves 3.125 bytes/us and flash 20 bytes/us: with DMA only
+    // the first chunk's read is exposed
+    const double spi_us = package.image.size() * 8.0 / 25.0;
+    const double read_us = package.image.size() / 20.0;
+    const double clear_us = videomancer_fpga_configurator::clear_wait_us;
+    if (times[0] < clear_us + spi_us + read_us - 1.0 || times[1] > clear_us + spi_us + 4096 / 20.0 + 100.0) {
+        std::cerr << "FAILED: Unexpected times " << times[0] << " us (sync), " << times[1] << " us (DMA)" << std::endl;
+        return false;
+    }
+    std::cout << "  Configuration time: " << times[0] / 1000.0 << " ms synchronous, "
+              << times[1] / 1000.0 << " ms with DMA" << std::endl;
+
+    std::cout << "PASSED: DMA overlap test" << std::endl;
+    return true;
+}
+
+// Test failures: missing interface, hash mismatch, corrupt image, memory source
+bool test_failures() {
+    test_package package(4096);
+    std::vector<uint8_t> capture(16384);
+    std::vector<uint8_t> buffer(1024);
+    videomancer_fpga_configurator configurator(buffer.data(), static_cast<uint32_t>(buffer.size()));
+
+    spi_only_fpga plain;
+    flash_stream plain_stream(package.file, nullptr, 1.0);
+    if (configurator.configure(plain, plain_stream, package.entry) != videomancer_configuration_result::no_interface) {
+        std::cerr << "FAILED: Missing interface not reported" << std::endl;
+        return false;
+    }
+
+    // Wrong TOC hash: the device must stay in reset
+    videomancer_fpga_config_model model(capture.data(), static_cast<uint32_t>(capture.size()), 25000000, true);
+    flash_stream stream(package.file, nullptr, 1.0);
+    vmprog_toc_entry_v1_0 bad_hash = package.entry;
+    bad_hash.sha256[0] ^= 1;
+    if (configurator.configure(model, stream, bad_hash) != videomancer_configuration_result::hash_mismatch ||
+        model.user_mode() || model.get_cdone()) {
+        std::cerr << "FAILED: Hash mismatch did not hold the device in reset" << std::endl;
+        return false;
+    }
+
+    // Corrupt image with a matching hash: CDONE never rises
+    std::vector<uint8_t> corrupt = package.image;
+    corrupt[100] ^= 0x40;
+    if (configurator.configure(model, corrupt.data(), static_cast<uint32_t>(corrupt.size())) !=
+            videomancer_configuration_result::cdone_timeout ||
+        model.error() != videomancer_config_model_error::invalid_image) {
+        std::cerr << "FAILED: Corrupt image not rejected" << std::endl;
+        return false;
+    }
+
+    // Memory source into a fresh device
+    videomancer_fpga_config_model fresh(capture.data(), static_cast<uint32_t>(capture.size()), 25000000, false);
+    if (configurator.configure(fresh, package.image.data(), static_cast<uint32_t>(package.image.size())) !=
+            videomancer_configuration_result::ok || !fresh.user_mode() ||
+        configurator.chunks_written() != (package.entry.size + 511) / 512) {
+        std::cerr << "FAILED: Memory configuration" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Failure handling test" << std::endl;
+    return true;
+}
+
+// Test that the model flags sequence violations
+bool test_model_protocol_checks() {
+    std::vector<uint8_t> capture(1024);
+    const uint8_t dummy = 0;
+
+    videomancer_fpga_config_model master(capture.data(), 1024, 25000000, false);
+    master.set_creset(false);
+    master.set_creset(true);  // SPI_SS_B still high
+    if (master.error() != videomancer_config_model_error::slave_mode_not_selected) {
+        std::cerr << "FAILED: Master-mode boot not flagged" << std::endl;
+        return false;
+    }
+
+    videomancer_fpga_config_model hasty(capture.data(), 1024, 25000000, false);
+    hasty.select_config(true);
+    hasty.set_creset(false);
+    hasty.set_creset(true);
+    hasty.delay_us(300);
+    hasty.select_config(false);
+    if (hasty.error() != videomancer_config_model_error::clear_wait_too_short) {
+        std::cerr << "FAILED: Short clear wait not flagged" << std::endl;
+        return false;
+    }
+
+    videomancer_fpga_config_model early(capture.data(), 1024, 25000000, false);
+    early.select_config(true);
+    early.set_creset(false);
+    early.set_creset(true);
+    early.write_config(&dummy, 1);
+    if (early.error() != videomancer_config_model_error::data_out_of_sequence) {
+        std::cerr << "FAILED: Data during clear wait not flagged" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Model protocol check test" << std::endl;
+    return true;
+}
+
+// Main test runner
+int main() {
+    std::cout << "======================================" << std::endl;
+    std::cout << "Videomancer videomancer_fpga_configurator.hpp Tests" << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << std::endl;
+
+    int passed = 0;
+    int total = 0;
+
+    #define RUN_TEST(test_func) \
+        do { \
+            total++; \
+            if (test_func()) { \
+                passed++; \
+            } \
+        } while(0)
+
+    RUN_TEST(test_stream_configuration);
+    RUN_TEST(test_dma_overlap);
+    RUN_TEST(test_failures);
+    RUN_TEST(test_model_protocol_checks);
+
+    std::cout << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
+    std::cout << "======================================" << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
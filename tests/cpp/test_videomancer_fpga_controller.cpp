@@ -83,6 +83,24 @@ public:
     }
 };
 
+// FPGA that sends frame bursts in one call and can fail partway
+class burst_fpga : public mock_videomancer_fpga {
+public:
+    size_t transfer_spi_frames(const uint8_t* frames, size_t frame_size, size_t count) override {
+        burst_calls++;
+        const size_t n = count < frame_limit ? count : frame_limit;
+        for (size_t i = 0; i < n; ++i) {
+            assert_chip_select_spi(true);
+            transfer_spi(frames + i * frame_size, nullptr, frame_size);
+            assert_chip_select_spi(false);
+        }
+        return n;
+    }
+
+    int burst_calls = 0;
+    size_t frame_limit = 64;
+};
+
 // Test controller initialization
 bool test_controller_init() {
     mock_videomancer_fpga fpga;
@@ -260,17 +278,28 @@ bool test_shadow_reset() {
     // Set some values
     controller.set_rotary_pot_1(500);
     controller.set_toggle_switches(0x1F);
+    controller.begin_batch();
+    controller.set_rotary_pot_2(300);
 
     // Reset shadow registers
     controller.reset_shadow_registers();
 
-    // Verify all reset to zero
+    // Verify all reset to zero, with nothing pending and no batch left open
     if (controller.get_rotary_pot_1() != 0 ||
-        controller.get_toggle_switches() != 0) {
+        controller.get_toggle_switches() != 0 ||
+        controller.get_dirty_mask() != 0 || controller.is_batching()) {
         std::cerr << "FAILED: Shadow reset test - registers not zeroed" << std::endl;
         return false;
     }
 
+    // Writes after the reset go out immediately
+    fpga.clear_transactions();
+    controller.set_rotary_pot_3(100);
+    if (fpga.transaction_count() == 0) {
+        std::cerr << "FAILED: Shadow reset test - write held in a stale batch" << std::endl;
+        return false;
+    }
+
     std::cout << "PASSED: Shadow register reset test" << std::endl;
     return true;
 }
@@ -338,6 +367,179 @@ bool test_chip_select() {
     return true;
 }
 
+// Test writes by program parameter ID
+bool test_set_parameter() {
+    mock_videomancer_fpga fpga;
+    videomancer_fpga_controller controller(fpga);
+
+    if (!controller.set_parameter(vmprog_parameter_id_v1_0::rotary_potentiometer_4, 300) ||
+        !controller.set_parameter(vmprog_parameter_id_v1_0::linear_potentiometer_12, 900) ||
+        !controller.set_parameter(vmprog_parameter_id_v1_0::toggle_switch_10, 1)) {
+        std::cerr << "FAILED: Set parameter test - write failed" << std::endl;
+        return false;
+    }
+
+    if (controller.get_rotary_pot_4() != 300 ||
+        controller.get_linear_pot_12() != 900 ||
+        !controller.get_toggle_switch(10)) {
+        std::cerr << "FAILED: Set parameter test - wrong register updated" << std::endl;
+        return false;
+    }
+
+    if (controller.set_parameter(vmprog_parameter_id_v1_0::none, 1) || fpga.transaction_count() != 3) {
+        std::cerr << "FAILED: Set parameter test - none parameter accepted" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Set parameter test" << std::endl;
+    return true;
+}
+
+// Test that batched updates coalesce into one write per register
+bool test_batch_flush() {
+    mock_videomancer_fpga fpga;
+    videomancer_fpga_controller controller(fpga);
+
+    controller.begin_batch();
+    for (uint16_t v = 1; v <= 50; ++v) {
+        controller.set_rotary_pot_2(v);
+    }
+    controller.set_toggle_switch_7(true);
+    controller.set_toggle_switch_8(true);
+    controller.set_video_timing(videomancer_abi_v1_0::video_timing_id::pal);
+
+    if (fpga.transaction_count() != 0 || !controller.is_batching() ||
+        controller.get_dirty_mask() != ((1u << 1) | (1u << 6) | (1u << 8))) {
+        std::cerr << "FAILED: Batch flush test - writes not deferred" << std::endl;
+        return false;
+    }
+
+    if (!controller.flush() || fpga.transaction_count() != 3 ||
+        controller.is_batching() || controller.get_dirty_mask() != 0) {
+        std::cerr << "FAILED: Batch flush test - expected 3 writes, got "
+                  << fpga.transaction_count() << std::endl;
+        return false;
+    }
+
+    auto frame = fpga.decode_last_frame();
+    if (frame.address != 8 || frame.data != static_cast<uint16_t>(videomancer_abi_v1_0::video_timing_id::pal) ||
+        controller.get_rotary_pot_2() != 50 || controller.get_toggle_switches() != 0x3) {
+        std::cerr << "FAILED: Batch flush test - incorrect flushed values" << std::endl;
+        return false;
+    }
+
+    // Writes after flush are immediate again
+    controller.set_rotary_pot_2(51);
+    if (fpga.transaction_count() != 4) {
+        std::cerr << "FAILED: Batch flush test - batch not closed" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Batch flush test" << std::endl;
+    return true;
+}
+
+// Test warmboot request frame and shadow reset
+bool test_warmboot() {
+    mock_videomancer_fpga fpga;
+    videomancer_fpga_controller controller(fpga);
+
+    controller.set_rotary_pot_1(500);
+    controller.set_video_timing_id(6);
+    controller.begin_batch();
+    controller.set_rotary_pot_2(300);
+    fpga.clear_transactions();
+
+    if (controller.warmboot(4) || fpga.transaction_count() != 0) {
+        std::cerr << "FAILED: Invalid warmboot image accepted" << std::endl;
+        return false;
+    }
+
+    if (!controller.warmboot(3) || fpga.transaction_count() != 1) {
+        std::cerr << "FAILED: Warmboot request not sent" << std::endl;
+        return false;
+    }
+    auto frame = fpga.decode_last_frame();
+    if (!frame.is_write || frame.address != videomancer_abi_v1_0::register_address::warmboot || frame.data != 0x007) {
+        std::cerr << "FAILED: Warmboot frame addr=" << int(frame.address) << " data=" << frame.data << std::endl;
+        return false;
+    }
+
+    // The new image starts from reset: shadows cleared, batch dropped, timing kept for the resync
+    const uint16_t timing_bit = 1u << videomancer_abi_v1_0::register_address::video_timing_id;
+    if (controller.get_rotary_pot_1() != 0 || controller.get_rotary_pot_2() != 0 ||
+        controller.is_batching() || controller.get_dirty_mask() != timing_bit ||
+        controller.get_video_timing_id() != 6 || fpga.transaction_count() != 1) {
+        std::cerr << "FAILED: Shadow state not reset after warmboot" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Warmboot test" << std::endl;
+    return true;
+}
+
+// Test full-state resync after reconfiguration
+bool test_resync() {
+    burst_fpga fpga;
+    videomancer_fpga_controller controller(fpga);
+
+    controller.set_rotary_pot_3(700);
+    controller.set_video_timing_id(5);
+    fpga.clear_transactions();
+    fpga.burst_calls = 0;
+
+    if (!controller.resync() || fpga.burst_calls != 1 || fpga.transaction_count() != 9) {
+        std::cerr << "FAILED: Resync was not one burst of 9 frames" << std::endl;
+        return false;
+    }
+    for (uint8_t address = 0; address < 9; ++address) {
+        const auto& tx = fpga.get_transaction(address).tx_data;
+        const uint16_t frame = static_cast<uint16_t>((tx[0] << 8) | tx[1]);
+        const uint16_t expected = (address == 2) ? 700 : (address == 8) ? 5 : 0;
+        if (((frame >> 10) & 0x1F) != address || (frame & 0x3FF) != expected) {
+            std::cerr << "FAILED: Resync frame " << int(address) << std::endl;
+            return false;
+        }
+    }
+
+    // Program initial values: unlisted controls to zero, timing kept
+    vmprog_program_config_v1_0 config;
+    init_vmprog_config(config);
+    config.parameter_count = 2;
+    init_parameter_config(config.parameters[0]);
+    config.parameters[0].parameter_id = vmprog_parameter_id_v1_0::rotary_potentiometer_1;
+    config.parameters[0].initial_value = 256;
+    init_parameter_config(config.parameters[1]);
+    config.parameters[1].parameter_id = vmprog_parameter_id_v1_0::toggle_switch_9;
+    config.parameters[1].initial_value = 1;
+    fpga.clear_transactions();
+    fpga.burst_calls = 0;
+    if (!controller.resync(config) || fpga.burst_calls != 1 || fpga.transaction_count() != 9 ||
+        controller.get_rotary_pot_1() != 256 || controller.get_rotary_pot_3() != 0 ||
+        controller.get_toggle_switches() != 0x04 || controller.get_video_timing_id() != 5 ||
+        controller.is_batching()) {
+        std::cerr << "FAILED: Resync with program config" << std::endl;
+        return false;
+    }
+
+    // Same program again through apply_initial_values(): nothing changes, nothing sent
+    fpga.clear_transactions();
+    if (!controller.apply_initial_values(config) || fpga.transaction_count() != 0) {
+        std::cerr << "FAILED: Unchanged initial values were sent" << std::endl;
+        return false;
+    }
+
+    // A short burst leaves the unsent registers dirty
+    fpga.frame_limit = 4;
+    if (controller.resync() || controller.get_dirty_mask() != 0x1F0) {
+        std::cerr << "FAILED: Partial burst dirty mask " << controller.get_dirty_mask() << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Resync test" << std::endl;
+    return true;
+}
+
 // Main test runner
 int main() {
     std::cout << "======================================================" << std::endl;
@@ -367,6 +569,10 @@ int main() {
     RUN_TEST(test_toggle_switch_read);
     RUN_TEST(test_spi_frame_format);
     RUN_TEST(test_chip_select);
+    RUN_TEST(test_set_parameter);
+    RUN_TEST(test_batch_flush);
+    RUN_TEST(test_warmboot);
+    RUN_TEST(test_resync);
 
     std::cout << std::endl;
     std::cout << "======================================================" << std::endl;
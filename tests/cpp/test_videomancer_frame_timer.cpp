@@ -0,0 +1,140 @@
+// Videomancer SDK - Unit Tests for videomancer_frame_timer.hpp
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <lzx/videomancer/videomancer_frame_timer.hpp>
+#include <iostream>
+
+using namespace lzx;
+using namespace lzx::videomancer_abi_v1_0;
+
+// Test rational frame and field rates
+bool test_rates() {
+    static_assert(get_frame_rate(video_timing_id::_1080p2398).num == 24000 &&
+                  get_frame_rate(video_timing_id::_1080p2398).den == 1001, "23.98 Hz");
+    static_assert(get_field_rate(video_timing_id::ntsc).num == 60000, "NTSC field rate");
+    static_assert(get_field_rate(video_timing_id::_720p5994).num == 60000, "Progressive field = frame");
+    static_assert(get_field_rate(video_timing_id::pal).num == 50 && get_field_rate(video_timing_id::pal).den == 1, "PAL");
+    static_assert(get_tick_time_ns(get_field_rate(video_timing_id::ntsc), 60000) == 1001000000000ull, "Exact");
+
+    // 1 / 59.94 Hz = 16683333.33 ns, rounded down per tick without accumulating
+    const video_rate rate = get_field_rate(video_timing_id::_1080i5994);
+    if (get_tick_time_ns(rate, 1) != 16683333 || get_tick_time_ns(rate, 3) != 50050000 ||
+        get_tick_time_ns(rate, 1000000007ull) != 16683333450116666ull) {
+        std::cerr << "FAILED: 59.94 Hz tick times" << std::endl;
+        return false;
+    }
+    if (get_tick_time_ns(get_frame_rate(video_timing_id::reserved), 10) != 0) {
+        std::cerr << "FAILED: Reserved rate" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Rate test" << std::endl;
+    return true;
+}
+
+// Test that ticks_until() inverts deadline_ns() exactly
+bool test_schedule() {
+    const videomancer_frame_schedule schedule(video_timing_id::_1080p2997, videomancer_tick_kind::frame, 5000);
+    const uint64_t ticks[] = { 0, 1, 2, 29, 30, 29999, 30000, 30001, 123456789ull };
+    for (uint64_t n : ticks) {
+        const uint64_t deadline = schedule.deadline_ns(n);
+        if (schedule.ticks_until(deadline) != n + 1 || (deadline > 0 && schedule.ticks_until(deadline - 1) != n)) {
+            std::cerr << "FAILED: ticks_until around tick " << n << std::endl;
+            return false;
+        }
+    }
+    if (schedule.ticks_until(4999) != 0 || schedule.deadline_ns(30000) != 5000 + 1001000000000ull) {
+        std::cerr << "FAILED: Origin handling" << std::endl;
+        return false;
+    }
+
+    const videomancer_frame_schedule reserved(video_timing_id::reserved, videomancer_tick_kind::field, 0);
+    if (reserved.is_valid() || reserved.ticks_until(1000000000ull) != 0) {
+        std::cerr << "FAILED: Reserved schedule" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Schedule test" << std::endl;
+    return true;
+}
+
+#ifdef VIDEOMANCER_HAS_TIMERFD
+// Test real ticks on a timerfd
+bool test_timer() {
+    videomancer_frame_timer timer;
+    if (timer.start(video_timing_id::reserved, videomancer_tick_kind::field)) {
+        std::cerr << "FAILED: Reserved mode started" << std::endl;
+        return false;
+    }
+    if (!timer.start(video_timing_id::_720p60, videomancer_tick_kind::field) || timer.fd() < 0) {
+        std::cerr << "FAILED: Timer did not start" << std::endl;
+        return false;
+    }
+
+    for (uint64_t expected = 1; expected <= 4; ++expected) {
+        const uint64_t tick = timer.wait();
+        const uint64_t now = videomancer_frame_timer::monotonic_ns();
+        if (tick != expected + timer.missed() || now < timer.deadline_ns(tick)) {
+            std::cerr << "FAILED: Tick " << tick << " woke before its deadline" << std::endl;
+            return false;
+        }
+    }
+
+    // Falling four periods behind skips ticks instead of firing back to back
+    const timespec late = { 0, 70000000 };
+    nanosleep(&late, nullptr);
+    const uint64_t tick = timer.wait();
+    if (tick < 8 || timer.missed() < 3 || timer.next_tick() != tick + 1) {
+        std::cerr << "FAILED: Late wake returned tick " << tick << ", missed " << timer.missed() << std::endl;
+        return false;
+    }
+
+    // Locking to a vsync moves every later deadline onto its grid
+    const uint64_t vsync = videomancer_frame_timer::monotonic_ns() - 5000000;
+    if (!timer.lock(vsync) || timer.next_tick() != 1) {
+        std::cerr << "FAILED: Lock" << std::endl;
+        return false;
+    }
+    const uint64_t locked = timer.wait();
+    if (locked < 1 || timer.deadline_ns(locked) != vsync + get_tick_time_ns(get_field_rate(video_timing_id::_720p60), locked)) {
+        std::cerr << "FAILED: Locked tick " << locked << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Timer test" << std::endl;
+    return true;
+}
+#endif
+
+// Main test runner
+int main() {
+    std::cout << "======================================" << std::endl;
+    std::cout << "Videomancer videomancer_frame_timer.hpp Tests" << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << std::endl;
+
+    int passed = 0;
+    int total = 0;
+
+    #define RUN_TEST(test_func) \
+        do { \
+            total++; \
+            if (test_func()) { \
+                passed++; \
+            } \
+        } while(0)
+
+    RUN_TEST(test_rates);
+    RUN_TEST(test_schedule);
+#ifdef VIDEOMANCER_HAS_TIMERFD
+    RUN_TEST(test_timer);
+#endif
+
+    std::cout << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
+    std::cout << "======================================" << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
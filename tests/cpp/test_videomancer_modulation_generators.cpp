@@ -0,0 +1,231 @@
+// Videomancer SDK - Unit Tests for videomancer_modulation_generators.hpp
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <lzx/videomancer/videomancer_modulation_generators.hpp>
+#include <iostream>
+#include <vector>
+
+using namespace lzx;
+using namespace lzx::videomancer_abi_v1_0;
+
+// FPGA that records register frames and counts bursts
+class recording_fpga : public videomancer_fpga {
+public:
+    size_t transfer_spi(const uint8_t* tx_buffer, uint8_t*, size_t size) override {
+        if (size == 2) frames.push_back(static_cast<uint16_t>((tx_buffer[0] << 8) | tx_buffer[1]));
+        return size;
+    }
+
+    void assert_chip_select_spi(bool) override {}
+
+    size_t transfer_spi_frames(const uint8_t* data, size_t frame_size, size_t count) override {
+        bursts++;
+        return videomancer_fpga::transfer_spi_frames(data, frame_size, count);
+    }
+
+    std::vector<uint16_t> frames;
+    int bursts = 0;
+};
+
+// Test LFO waveforms, curves and exact rational rates
+bool test_lfo() {
+    videomancer_modulation_generators generators;
+
+    // Frame-locked triangle: 64 ticks per cycle peaks at tick 32
+    generators.set_lfo(0, videomancer_lfo_wave::triangle);
+    generators.set_period_ticks(0, 64);
+    generators.set_lfo(1, videomancer_lfo_wave::triangle, vmprog_parameter_control_mode_v1_0::sine_in_out);
+    generators.set_period_ticks(1, 64);
+    generators.set_lfo(2, videomancer_lfo_wave::square);
+    generators.set_period_ticks(2, 64);
+    generators.advance(16);
+    const uint16_t quarter = generators.get_output(0);
+    const uint16_t sine_quarter = generators.get_output(1);
+    generators.advance(16);
+    if (quarter != 512 || sine_quarter != apply_parameter_control_curve(512, vmprog_parameter_control_mode_v1_0::sine_in_out) ||
+        generators.get_output(0) != 1023 || generators.get_output(2) != 0) {
+        std::cerr << "FAILED: Triangle gave " << quarter << ", " << generators.get_output(0) << std::endl;
+        return false;
+    }
+
+    // 1 Hz at 59.94 fields/s: exactly 1001 cycles in 60000 fields, however the ticks are split
+    if (!generators.set_timing(video_timing_id::_1080i5994, videomancer_tick_kind::field)) {
+        std::cerr << "FAILED: set_timing" << std::endl;
+        return false;
+    }
+    generators.set_lfo(3, videomancer_lfo_wave::ramp_up);
+    generators.set_rate_mhz(3, 1000);
+    generators.advance(30000);
+    const uint16_t half = generators.get_output(3);
+    for (int i = 0; i < 29999; ++i)
+        generators.advance();
+    generators.advance();
+    if (half != 512 || generators.get_output(3) != 0) {
+        std::cerr << "FAILED: 1 Hz ramp drifted: " << half << ", " << generators.get_output(3) << std::endl;
+        return false;
+    }
+
+    // Reserved modes are rejected and leave the rate alone
+    if (generators.set_timing(video_timing_id::reserved, videomancer_tick_kind::frame) ||
+        generators.tick_rate().num != 60000 || generators.tick_rate().den != 1001) {
+        std::cerr << "FAILED: Reserved mode accepted" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: LFO test" << std::endl;
+    return true;
+}
+
+// Test the ADSR envelope stages
+bool test_envelope() {
+    videomancer_modulation_generators generators;
+    generators.set_envelope(0, 4, 4, 511, 8);
+
+    generators.advance(10);
+    if (generators.get_output(0) != 0) {
+        std::cerr << "FAILED: Envelope moved with the gate closed" << std::endl;
+        return false;
+    }
+
+    generators.set_gate(0, true);
+    generators.advance(2);
+    const uint16_t half_attack = generators.get_output(0);
+    generators.advance(2);
+    const uint16_t peak = generators.get_output(0);
+    generators.advance(4);
+    const uint16_t sustain = generators.get_output(0);
+    generators.advance(100);
+    if (half_attack < 510 || half_attack > 512 || peak != 1023 || sustain != 511 || generators.get_output(0) != 511) {
+        std::cerr << "FAILED: Attack/decay gave " << half_attack << ", " << peak << ", " << sustain << std::endl;
+        return false;
+    }
+
+    generators.set_gate(0, false);
+    generators.advance(4);
+    const uint16_t half_release = generators.get_output(0);
+    generators.advance(4);
+    if (half_release < 254 || half_release > 256 || generators.get_output(0) != 0) {
+        std::cerr << "FAILED: Release gave " << half_release << ", " << generators.get_output(0) << std::endl;
+        return false;
+    }
+
+    // Retrigger mid-release attacks from the current level
+    generators.set_gate(0, true);
+    generators.advance(8);
+    generators.set_gate(0, false);
+    generators.advance(2);
+    generators.set_gate(0, true);
+    generators.advance(1);
+    if (generators.get_envelope_level(0) <= 383) {
+        std::cerr << "FAILED: Retrigger restarted from 0" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Envelope test" << std::endl;
+    return true;
+}
+
+// Test that sample-and-hold changes only once per cycle
+bool test_sample_hold() {
+    videomancer_modulation_generators generators;
+    generators.set_sample_hold(0, 12345);
+    generators.set_period_ticks(0, 10);
+    generators.set_sample_hold(1, 12345);
+    generators.set_period_ticks(1, 1);
+
+    int changes = 0;
+    int every_tick = 0;
+    uint16_t last = generators.get_output(0);
+    uint16_t last_fast = generators.get_output(1);
+    for (int i = 0; i < 100; ++i) {
+        generators.advance();
+        if (generators.get_output(0) != last) changes++;
+        if (generators.get_output(1) != last_fast) every_tick++;
+        last = generators.get_output(0);
+        last_fast = generators.get_output(1);
+    }
+    if (changes < 9 || changes > 10 || every_tick < 95) {
+        std::cerr << "FAILED: Sample-and-hold changed " << changes << " and " << every_tick << " times" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Sample-and-hold test" << std::endl;
+    return true;
+}
+
+// Test direct destinations and matrix feeding through one controller burst
+bool test_controller() {
+    recording_fpga fpga;
+    videomancer_fpga_controller controller(fpga);
+    videomancer_modulation_matrix matrix;
+    videomancer_modulation_generators generators;
+
+    // Slot 0 sweeps pot 6 between 100 and 300; slot 1 modulates pot 1 through the matrix
+    generators.set_lfo(0, videomancer_lfo_wave::ramp_up);
+    generators.set_period_ticks(0, 4);
+    generators.set_destination(0, vmprog_parameter_id_v1_0::rotary_potentiometer_6, 100, 300);
+    generators.set_lfo(1, videomancer_lfo_wave::square);
+    generators.set_period_ticks(1, 2);
+    matrix.add_route(videomancer_mod_source::automation_2, vmprog_parameter_id_v1_0::rotary_potentiometer_1, matrix.unity);
+
+    generators.tick(matrix, controller);
+    const uint16_t expected = static_cast<uint16_t>((register_address::rotary_pot_6 << 10) | (100 + 200 * 256 / 1023));
+    if (fpga.bursts != 1 || fpga.frames.size() != 1 || fpga.frames[0] != expected) {
+        std::cerr << "FAILED: First tick sent " << fpga.frames.size() << " frames" << std::endl;
+        return false;
+    }
+
+    // Square goes high, so pot 1 jumps: both changes share one burst
+    generators.tick(matrix, controller);
+    if (fpga.bursts != 2 || fpga.frames.size() != 3 || controller.get_rotary_pot_1() != 1023 ||
+        controller.get_rotary_pot_6() != 100 + 200 * 512 / 1023) {
+        std::cerr << "FAILED: Second tick sent " << fpga.frames.size() << " frames in " << fpga.bursts << " bursts" << std::endl;
+        return false;
+    }
+
+    // A stopped generator sends nothing
+    generators.disable(1);
+    generators.set_period_ticks(0, 0);
+    fpga.frames.clear();
+    generators.tick(controller);
+    generators.tick(controller);
+    if (fpga.frames.size() != 0) {
+        std::cerr << "FAILED: Idle generators sent " << fpga.frames.size() << " frames" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Controller test" << std::endl;
+    return true;
+}
+
+// Main test runner
+int main() {
+    std::cout << "======================================" << std::endl;
+    std::cout << "Videomancer videomancer_modulation_generators.hpp Tests" << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << std::endl;
+
+    int passed = 0;
+    int total = 0;
+
+    #define RUN_TEST(test_func) \
+        do { \
+            total++; \
+            if (test_func()) { \
+                passed++; \
+            } \
+        } while(0)
+
+    RUN_TEST(test_lfo);
+    RUN_TEST(test_envelope);
+    RUN_TEST(test_sample_hold);
+    RUN_TEST(test_controller);
+
+    std::cout << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
+    std::cout << "======================================" << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
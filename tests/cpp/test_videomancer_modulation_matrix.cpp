@@ -0,0 +1,211 @@
+// Videomancer SDK - Unit Tests for videomancer_modulation_matrix.hpp
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <lzx/videomancer/videomancer_modulation_matrix.hpp>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+using namespace lzx;
+
+using src = videomancer_mod_source;
+using dst = vmprog_parameter_id_v1_0;
+
+// FPGA that records register frames and counts bursts
+class recording_fpga : public videomancer_fpga {
+public:
+    size_t transfer_spi(const uint8_t* tx_buffer, uint8_t*, size_t size) override {
+        if (size == 2) frames.push_back(static_cast<uint16_t>((tx_buffer[0] << 8) | tx_buffer[1]));
+        return size;
+    }
+
+    void assert_chip_select_spi(bool) override {}
+
+    size_t transfer_spi_frames(const uint8_t* data, size_t frame_size, size_t count) override {
+        bursts++;
+        return videomancer_fpga::transfer_spi_frames(data, frame_size, count);
+    }
+
+    std::vector<uint16_t> frames;
+    int bursts = 0;
+};
+
+static uint16_t frame(uint8_t address, uint16_t value) {
+    return static_cast<uint16_t>((address << 10) | value);
+}
+
+// Test one knob driving three registers in one burst
+bool test_macro() {
+    recording_fpga fpga;
+    videomancer_fpga_controller controller(fpga);
+    videomancer_modulation_matrix matrix;
+
+    if (!matrix.add_route(src::rotary_potentiometer_1, dst::rotary_potentiometer_3, matrix.unity) ||
+        !matrix.add_route(src::rotary_potentiometer_1, dst::rotary_potentiometer_1, matrix.unity) ||
+        !matrix.add_route(src::rotary_potentiometer_1, dst::rotary_potentiometer_2, matrix.unity) ||
+        matrix.route_count() != 3) {
+        std::cerr << "FAILED: Routes not added" << std::endl;
+        return false;
+    }
+
+    matrix.set_source(src::rotary_potentiometer_1, 700);
+    if (!matrix.tick(controller) || controller.is_batching()) {
+        std::cerr << "FAILED: Tick" << std::endl;
+        return false;
+    }
+    using namespace videomancer_abi_v1_0;
+    const uint16_t expected[] = {
+        frame(register_address::rotary_pot_1, 700),
+        frame(register_address::rotary_pot_2, 700),
+        frame(register_address::rotary_pot_3, 700),
+    };
+    if (fpga.frames.size() != 3 || fpga.bursts != 1 ||
+        !std::equal(fpga.frames.begin(), fpga.frames.end(), expected)) {
+        std::cerr << "FAILED: Expected one burst of 3 frames, got " << fpga.frames.size()
+                  << " frames in " << fpga.bursts << " bursts" << std::endl;
+        return false;
+    }
+
+    // Nothing moved: no SPI traffic
+    fpga.frames.clear();
+    matrix.tick(controller);
+    if (!fpga.frames.empty() || !matrix.is_routed(dst::rotary_potentiometer_2) || matrix.is_routed(dst::rotary_potentiometer_4)) {
+        std::cerr << "FAILED: Idle tick sent " << fpga.frames.size() << " frames" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Macro test" << std::endl;
+    return true;
+}
+
+// Test amounts, curves, offsets and clamping
+bool test_mixing() {
+    videomancer_modulation_matrix matrix;
+
+    // Pot 4 keeps its own value and an automation slot adds +/- 25% around it
+    matrix.add_route(src::rotary_potentiometer_4, dst::rotary_potentiometer_4, matrix.unity);
+    matrix.add_route(src::automation_1, dst::rotary_potentiometer_4, to_mod_amount(0.5f));
+    matrix.set_offset(dst::rotary_potentiometer_4, -256);
+    matrix.set_source(src::rotary_potentiometer_4, 500);
+    matrix.set_source(to_automation_source(0), 512);
+    matrix.evaluate();
+    if (matrix.get_output(dst::rotary_potentiometer_4) != 500) {
+        std::cerr << "FAILED: Centered modulation gave " << matrix.get_output(dst::rotary_potentiometer_4) << std::endl;
+        return false;
+    }
+    matrix.set_source(src::automation_1, 1023);
+    matrix.evaluate();
+    if (matrix.get_output(dst::rotary_potentiometer_4) != 756) {
+        std::cerr << "FAILED: Positive modulation gave " << matrix.get_output(dst::rotary_potentiometer_4) << std::endl;
+        return false;
+    }
+
+    // Inverted route with a curve, clamped at both ends
+    matrix.add_route(src::linear_potentiometer_12, dst::rotary_potentiometer_5, -matrix.unity,
+                     vmprog_parameter_control_mode_v1_0::quad_in);
+    matrix.set_offset(dst::rotary_potentiometer_5, 1023);
+    matrix.set_source(src::linear_potentiometer_12, 512);
+    matrix.evaluate();
+    const uint16_t curved = apply_parameter_control_curve(512, vmprog_parameter_control_mode_v1_0::quad_in);
+    if (matrix.get_output(dst::rotary_potentiometer_5) != 1023 - curved) {
+        std::cerr << "FAILED: Inverted curve gave " << matrix.get_output(dst::rotary_potentiometer_5) << std::endl;
+        return false;
+    }
+    matrix.add_route(src::linear_potentiometer_12, dst::rotary_potentiometer_5, to_mod_amount(-2.0f));
+    matrix.set_source(src::linear_potentiometer_12, 1023);
+    matrix.evaluate();
+    if (matrix.get_output(dst::rotary_potentiometer_5) != 0) {
+        std::cerr << "FAILED: Output not clamped at 0" << std::endl;
+        return false;
+    }
+
+    // Removing routes restores the earlier result and keeps the others intact
+    if (matrix.remove_route(src::linear_potentiometer_12, dst::rotary_potentiometer_5) != 2 ||
+        matrix.route_count() != 2 || matrix.is_routed(dst::rotary_potentiometer_5)) {
+        std::cerr << "FAILED: remove_route" << std::endl;
+        return false;
+    }
+    matrix.evaluate();
+    if (matrix.get_output(dst::rotary_potentiometer_4) != 756) {
+        std::cerr << "FAILED: Remaining routes changed" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Mixing test" << std::endl;
+    return true;
+}
+
+// Test switch destinations, limits and an open caller batch
+bool test_switches_and_limits() {
+    recording_fpga fpga;
+    videomancer_fpga_controller controller(fpga);
+    videomancer_modulation_matrix matrix;
+
+    if (matrix.add_route(src::none, dst::rotary_potentiometer_1, matrix.unity) ||
+        matrix.add_route(src::automation_1, dst::none, matrix.unity) ||
+        matrix.add_route(static_cast<src>(21), dst::rotary_potentiometer_1, matrix.unity)) {
+        std::cerr << "FAILED: Invalid route accepted" << std::endl;
+        return false;
+    }
+    for (uint8_t i = 0; i < videomancer_modulation_matrix::max_routes; ++i)
+        matrix.add_route(src::automation_2, dst::rotary_potentiometer_6, 0);
+    if (matrix.add_route(src::automation_2, dst::rotary_potentiometer_6, 0)) {
+        std::cerr << "FAILED: Route added past max_routes" << std::endl;
+        return false;
+    }
+    matrix.clear();
+
+    // A pot turns two switches on past its midpoint
+    matrix.add_route(src::rotary_potentiometer_2, dst::toggle_switch_8, matrix.unity);
+    matrix.add_route(src::rotary_potentiometer_2, dst::toggle_switch_10, matrix.unity);
+    matrix.set_source(src::rotary_potentiometer_2, 600);
+
+    // Writes join the caller's batch and wait for its flush
+    controller.begin_batch();
+    matrix.tick(controller);
+    if (!controller.is_batching() || !fpga.frames.empty()) {
+        std::cerr << "FAILED: Caller batch was flushed" << std::endl;
+        return false;
+    }
+    controller.flush();
+    const uint16_t expected = frame(videomancer_abi_v1_0::register_address::toggle_switches, 0x0A);
+    if (fpga.frames.size() != 1 || fpga.frames[0] != expected ||
+        !controller.get_toggle_switch(8) || controller.get_toggle_switch(9)) {
+        std::cerr << "FAILED: Switch register" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Switches and limits test" << std::endl;
+    return true;
+}
+
+// Main test runner
+int main() {
+    std::cout << "======================================" << std::endl;
+    std::cout << "Videomancer videomancer_modulation_matrix.hpp Tests" << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << std::endl;
+
+    int passed = 0;
+    int total = 0;
+
+    #define RUN_TEST(test_func) \
+        do { \
+            total++; \
+            if (test_func()) { \
+                passed++; \
+            } \
+        } while(0)
+
+    RUN_TEST(test_macro);
+    RUN_TEST(test_mixing);
+    RUN_TEST(test_switches_and_limits);
+
+    std::cout << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
+    std::cout << "======================================" << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
@@ -0,0 +1,287 @@
+// Videomancer SDK - Unit Tests for videomancer_osc_server.hpp
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <lzx/videomancer/videomancer_osc_server.hpp>
+#include <iostream>
+#include <cstring>
+#include <vector>
+
+using namespace lzx;
+
+// Counts SPI write frames
+class counting_fpga : public videomancer_fpga {
+public:
+    size_t frames = 0;
+
+    size_t transfer_spi(const uint8_t*, uint8_t* rx_buffer, size_t size) override {
+        if (rx_buffer) {
+            memset(rx_buffer, 0, size);
+        }
+        frames += size / 2;
+        return size;
+    }
+
+    void assert_chip_select_spi(bool) override {}
+};
+
+// Append a padded OSC string
+static void put_osc_string(std::vector<uint8_t>& out, const char* s) {
+    const size_t length = strlen(s);
+    out.insert(out.end(), s, s + length);
+    const size_t padded = osc_padded_size(length);
+    out.insert(out.end(), padded - length, 0);
+}
+
+// Append a big-endian 32-bit word
+static void put_be32(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back(static_cast<uint8_t>(v >> 24));
+    out.push_back(static_cast<uint8_t>(v >> 16));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+// Build a single-argument OSC message
+static std::vector<uint8_t> osc_int(const char* address, int32_t value) {
+    std::vector<uint8_t> out;
+    put_osc_string(out, address);
+    put_osc_string(out, ",i");
+    put_be32(out, static_cast<uint32_t>(value));
+    return out;
+}
+
+static std::vector<uint8_t> osc_float(const char* address, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    std::vector<uint8_t> out;
+    put_osc_string(out, address);
+    put_osc_string(out, ",f");
+    put_be32(out, bits);
+    return out;
+}
+
+static std::vector<uint8_t> osc_bool(const char* address, bool value) {
+    std::vector<uint8_t> out;
+    put_osc_string(out, address);
+    put_osc_string(out, value ? ",T" : ",F");
+    return out;
+}
+
+// Test message parsing and argument conversion
+bool test_parse_message() {
+    std::vector<uint8_t> msg = osc_int("/videomancer/param/1", 512);
+    osc_message parsed;
+    int32_t value = 0;
+    if (!parse_osc_message(msg.data(), msg.size(), parsed) ||
+        strcmp(parsed.address, "/videomancer/param/1") != 0 ||
+        !osc_first_argument_as_control(parsed, value) || value != 512) {
+        std::cerr << "FAILED: Parse message test - int message" << std::endl;
+        return false;
+    }
+
+    msg = osc_float("/x", 0.5f);
+    if (!parse_osc_message(msg.data(), msg.size(), parsed) ||
+        !osc_first_argument_as_control(parsed, value) || value != 512) {
+        std::cerr << "FAILED: Parse message test - float message" << std::endl;
+        return false;
+    }
+
+    msg = osc_float("/x", 7.0f);
+    if (!parse_osc_message(msg.data(), msg.size(), parsed) ||
+        !osc_first_argument_as_control(parsed, value) || value != 1023) {
+        std::cerr << "FAILED: Parse message test - float not clamped" << std::endl;
+        return false;
+    }
+
+    msg = osc_bool("/x", true);
+    if (!parse_osc_message(msg.data(), msg.size(), parsed) ||
+        !osc_first_argument_as_control(parsed, value) || value != 1023) {
+        std::cerr << "FAILED: Parse message test - bool message" << std::endl;
+        return false;
+    }
+
+    // Malformed: missing type tags, unaligned, unterminated
+    std::vector<uint8_t> bad;
+    put_osc_string(bad, "/x");
+    put_be32(bad, 1);
+    const uint8_t unterminated[8] = { '/', 'a', 'b', 'c', 'd', 'e', 'f', 'g' };
+    if (parse_osc_message(bad.data(), bad.size(), parsed) ||
+        parse_osc_message(msg.data(), msg.size() - 1, parsed) ||
+        parse_osc_message(unterminated, sizeof(unterminated), parsed)) {
+        std::cerr << "FAILED: Parse message test - malformed message accepted" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Parse message test" << std::endl;
+    return true;
+}
+
+// Test routing with parameter curves and scaling
+bool test_router_curves() {
+    counting_fpga fpga;
+    videomancer_fpga_controller controller(fpga);
+    videomancer_osc_router router(controller);
+
+    vmprog_program_config_v1_0 config = {};
+    config.parameter_count = 2;
+    config.parameters[0].parameter_id = vmprog_parameter_id_v1_0::rotary_potentiometer_2;
+    config.parameters[0].control_mode = vmprog_parameter_control_mode_v1_0::linear;
+    config.parameters[0].min_value = 0;
+    config.parameters[0].max_value = 1023;
+    config.parameters[1].parameter_id = vmprog_parameter_id_v1_0::toggle_switch_11;
+    config.parameters[1].control_mode = vmprog_parameter_control_mode_v1_0::boolean;
+    config.parameters[1].min_value = 0;
+    config.parameters[1].max_value = 1023;
+
+    if (router.bind_program_config(config) != 2 || router.route_count() != 2) {
+        std::cerr << "FAILED: Router test - routes not bound" << std::endl;
+        return false;
+    }
+
+    std::vector<uint8_t> a = osc_int("/videomancer/param/2", 700);
+    std::vector<uint8_t> b = osc_bool("/videomancer/param/11", true);
+    std::vector<uint8_t> c = osc_int("/videomancer/param/3", 1);
+    router.handle_packet(a.data(), a.size());
+    router.handle_packet(b.data(), b.size());
+    router.handle_packet(c.data(), c.size());
+
+    if (controller.get_rotary_pot_2() != apply_parameter_control_curve_and_scaling(700, config.parameters[0]) ||
+        !controller.get_toggle_switch(11) ||
+        router.stats().applied != 2 || router.stats().unknown_address != 1) {
+        std::cerr << "FAILED: Router test - unexpected controller state" << std::endl;
+        return false;
+    }
+
+    // Raw route without configuration clamps to 10 bits
+    router.add_route("/raw/slider", vmprog_parameter_id_v1_0::linear_potentiometer_12);
+    std::vector<uint8_t> d = osc_int("/raw/slider", 5000);
+    router.handle_packet(d.data(), d.size());
+    if (controller.get_linear_pot_12() != 1023) {
+        std::cerr << "FAILED: Router test - raw route not clamped" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Router curves test" << std::endl;
+    return true;
+}
+
+// Test bundles coalesce into one flush
+bool test_bundle_batching() {
+    counting_fpga fpga;
+    videomancer_fpga_controller controller(fpga);
+    videomancer_osc_router router(controller);
+    router.add_route("/p1", vmprog_parameter_id_v1_0::rotary_potentiometer_1);
+    router.add_route("/p6", vmprog_parameter_id_v1_0::rotary_potentiometer_6);
+
+    std::vector<uint8_t> bundle;
+    put_osc_string(bundle, "#bundle");
+    put_be32(bundle, 0);
+    put_be32(bundle, 1);
+    for (int i = 1; i <= 20; ++i) {
+        std::vector<uint8_t> m = osc_int((i & 1) ? "/p1" : "/p6", i * 10);
+        put_be32(bundle, static_cast<uint32_t>(m.size()));
+        bundle.insert(bundle.end(), m.begin(), m.end());
+    }
+
+    controller.begin_batch();
+    const uint32_t applied = router.handle_packet(bundle.data(), bundle.size());
+    controller.flush();
+
+    if (applied != 20 || fpga.frames != 2 ||
+        controller.get_rotary_pot_1() != 190 || controller.get_rotary_pot_6() != 200) {
+        std::cerr << "FAILED: Bundle batching test - expected 2 writes, got " << fpga.frames << std::endl;
+        return false;
+    }
+
+    // Truncated bundle element is counted as malformed
+    bundle.resize(bundle.size() - 2);
+    router.reset_stats();
+    router.handle_packet(bundle.data(), bundle.size());
+    if (router.stats().malformed != 1) {
+        std::cerr << "FAILED: Bundle batching test - truncated bundle not reported" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Bundle batching test" << std::endl;
+    return true;
+}
+
+#ifdef VIDEOMANCER_OSC_HAS_EPOLL
+// Test UDP server drains a burst into one flush
+bool test_udp_server() {
+    counting_fpga fpga;
+    videomancer_fpga_controller controller(fpga);
+    videomancer_osc_router router(controller);
+    router.add_route("/p3", vmprog_parameter_id_v1_0::rotary_potentiometer_3);
+    router.add_route("/s7", vmprog_parameter_id_v1_0::toggle_switch_7);
+
+    videomancer_osc_udp_server server(router);
+    if (!server.open(0) || server.port() == 0) {
+        std::cerr << "FAILED: UDP server test - open failed" << std::endl;
+        return false;
+    }
+
+    const int sender = ::socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(server.port());
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    for (int i = 0; i < 100; ++i) {
+        std::vector<uint8_t> m = osc_int("/p3", i);
+        ::sendto(sender, m.data(), m.size(), 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    }
+    std::vector<uint8_t> s = osc_bool("/s7", true);
+    ::sendto(sender, s.data(), s.size(), 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    ::close(sender);
+
+    const int datagrams = server.run_once(1000);
+    if (datagrams != 101 || server.flush_count() != 1 || fpga.frames != 2 ||
+        controller.get_rotary_pot_3() != 99 || !controller.get_toggle_switch(7)) {
+        std::cerr << "FAILED: UDP server test - got " << datagrams << " datagrams, "
+                  << fpga.frames << " writes" << std::endl;
+        return false;
+    }
+
+    if (server.run_once(0) != 0) {
+        std::cerr << "FAILED: UDP server test - idle poll returned traffic" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: UDP server test" << std::endl;
+    return true;
+}
+#endif
+
+// Main test runner
+int main() {
+    std::cout << "======================================" << std::endl;
+    std::cout << "Videomancer videomancer_osc_server.hpp Tests" << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << std::endl;
+
+    int passed = 0;
+    int total = 0;
+
+    #define RUN_TEST(test_func) \
+        do { \
+            total++; \
+            if (test_func()) { \
+                passed++; \
+            } \
+        } while(0)
+
+    RUN_TEST(test_parse_message);
+    RUN_TEST(test_router_curves);
+    RUN_TEST(test_bundle_batching);
+#ifdef VIDEOMANCER_OSC_HAS_EPOLL
+    RUN_TEST(test_udp_server);
+#endif
+
+    std::cout << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
+    std::cout << "======================================" << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
@@ -0,0 +1,360 @@
+// Videomancer SDK - Unit Tests for videomancer_program_switcher.hpp
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <lzx/videomancer/videomancer_program_switcher.hpp>
+#include "test_ice40_image.hpp"
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace lzx;
+
+// Config model that records register frames
+class recording_fpga : public videomancer_fpga_config_model {
+public:
+    recording_fpga(uint8_t* capture, uint32_t capture_size)
+        : videomancer_fpga_config_model(capture, capture_size, 25000000, true) {}
+
+    size_t transfer_spi(const uint8_t* tx_buffer, uint8_t* rx_buffer, size_t size) override {
+        if (size == 2) frames.push_back(static_cast<uint16_t>((tx_buffer[0] << 8) | tx_buffer[1]));
+        return videomancer_fpga_config_model::transfer_spi(tx_buffer, rx_buffer, size);
+    }
+
+    std::vector<uint16_t> frames;
+};
+
+// Package stream over a byte vector that counts reads
+class counting_stream : public vmprog_stream {
+public:
+    explicit counting_stream(const std::vector<uint8_t>& data) : data_(data) {}
+
+    size_t read(uint8_t* buffer, size_t size) override {
+        if (position_ + size > data_.size()) return 0;
+        memcpy(buffer, data_.data() + position_, size);
+        position_ += size;
+        reads++;
+        return size;
+    }
+
+    bool seek(size_t position) override {
+        if (position > data_.size()) return false;
+        position_ = position;
+        return true;
+    }
+
+    int reads = 0;
+
+private:
+    const std::vector<uint8_t>& data_;
+    size_t position_ = 0;
+};
+
+static vmprog_toc_entry_v1_0 make_entry(const std::vector<uint8_t>& image) {
+    vmprog_toc_entry_v1_0 entry;
+    init_toc_entry(entry);
+    entry.type = vmprog_toc_entry_type_v1_0::bitstream_sd_analog;
+    entry.offset = 0;
+    entry.size = static_cast<uint32_t>(image.size());
+    sha256_oneshot(image.data(), entry.size, entry.sha256);
+    return entry;
+}
+
+// Descriptor signing one bitstream with the hash in its entry
+static vmprog_signed_descriptor_v1_0 make_descriptor(const vmprog_toc_entry_v1_0& entry) {
+    vmprog_signed_descriptor_v1_0 descriptor;
+    init_signed_descriptor(descriptor);
+    descriptor.artifact_count = 1;
+    descriptor.artifacts[0].type = entry.type;
+    memcpy(descriptor.artifacts[0].sha256, entry.sha256, 32);
+    return descriptor;
+}
+
+static void add_parameter(vmprog_program_config_v1_0& config, vmprog_parameter_id_v1_0 id, uint16_t value) {
+    vmprog_parameter_config_v1_0& param = config.parameters[config.parameter_count++];
+    init_parameter_config(param);
+    param.parameter_id = id;
+    param.max_value = 1023;
+    param.initial_value = value;
+}
+
+// Test that a shared bitstream skips configuration and sends only changed registers
+bool test_shared_bitstream() {
+    std::vector<uint8_t> capture(8192);
+    std::vector<uint8_t> buffer(1024);
+    recording_fpga fpga(capture.data(), static_cast<uint32_t>(capture.size()));
+    videomancer_fpga_controller controller(fpga);
+    videomancer_fpga_configurator configurator(buffer.data(), static_cast<uint32_t>(buffer.size()));
+    videomancer_program_switcher switcher(fpga, controller, configurator);
+
+    const std::vector<uint8_t> image = build_test_ice40_image(2048, 3);
+    const vmprog_toc_entry_v1_0 entry = make_entry(image);
+    const vmprog_signed_descriptor_v1_0 descriptor = make_descriptor(entry);
+    counting_stream stream(image);
+
+    vmprog_program_config_v1_0 first;
+    init_vmprog_config(first);
+    add_parameter(first, vmprog_parameter_id_v1_0::rotary_potentiometer_1, 512);
+    add_parameter(first, vmprog_parameter_id_v1_0::rotary_potentiometer_2, 100);
+    add_parameter(first, vmprog_parameter_id_v1_0::toggle_switch_7, 1);
+
+    if (switcher.switch_program(first, stream, entry, descriptor) != videomancer_configuration_result::ok ||
+        !switcher.reconfigured() || !fpga.user_mode() || !switcher.is_loaded(entry.sha256)) {
+        std::cerr << "FAILED: First switch did not configure" << std::endl;
+        return false;
+    }
+    controller.set_video_timing_id(5);
+
+    // Same bitstream, different labels and initial values
+    vmprog_program_config_v1_0 second;
+    init_vmprog_config(second);
+    add_parameter(second, vmprog_parameter_id_v1_0::rotary_potentiometer_1, 512);
+    add_parameter(second, vmprog_parameter_id_v1_0::rotary_potentiometer_3, 700);
+    strcpy(second.parameters[0].name_label, "Hue");
+
+    const int reads_before = stream.reads;
+    const double time_before = fpga.elapsed_us();
+    fpga.frames.clear();
+    if (switcher.switch_program(second, stream, entry, descriptor) != videomancer_configuration_result::ok ||
+        switcher.reconfigured() || stream.reads != reads_before || fpga.elapsed_us() != time_before) {
+        std::cerr << "FAILED: Shared bitstream was reconfigured" << std::endl;
+        return false;
+    }
+
+    // Pot 2 back to 0, pot 3 to 700, switches to 0; pot 1 and timing unchanged
+    const uint16_t expected[] = {
+        static_cast<uint16_t>((videomancer_abi_v1_0::register_address::rotary_pot_2 << 10) | 0),
+        static_cast<uint16_t>((videomancer_abi_v1_0::register_address::rotary_pot_3 << 10) | 700),
+        static_cast<uint16_t>((videomancer_abi_v1_0::register_address::toggle_switches << 10) | 0),
+    };
+    if (fpga.frames.size() != 3 || memcmp(fpga.frames.data(), expected, sizeof(expected)) != 0 ||
+        controller.get_video_timing_id() != 5 || controller.get_rotary_pot_1() != 512) {
+        std::cerr << "FAILED: Register burst has " << fpga.frames.size() << " frames" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Shared bitstream test" << std::endl;
+    return true;
+}
+
+// Test that a different bitstream reconfigures and restores the timing
+bool test_bitstream_change() {
+    std::vector<uint8_t> capture(8192);
+    std::vector<uint8_t> buffer(1024);
+    recording_fpga fpga(capture.data(), static_cast<uint32_t>(capture.size()));
+    videomancer_fpga_controller controller(fpga);
+    videomancer_fpga_configurator configurator(buffer.data(), static_cast<uint32_t>(buffer.size()));
+    videomancer_program_switcher switcher(fpga, controller, configurator);
+
+    const std::vector<uint8_t> image_a = build_test_ice40_image(2048, 3);
+    const std::vector<uint8_t> image_b = build_test_ice40_image(2048, 5);
+    uint8_t hash_a[32];
+    uint8_t hash_b[32];
+    sha256_oneshot(image_a.data(), static_cast<uint32_t>(image_a.size()), hash_a);
+    sha256_oneshot(image_b.data(), static_cast<uint32_t>(image_b.size()), hash_b);
+
+    vmprog_program_config_v1_0 config;
+    init_vmprog_config(config);
+    add_parameter(config, vmprog_parameter_id_v1_0::linear_potentiometer_12, 300);
+
+    if (switcher.switch_program(config, image_a.data(), static_cast<uint32_t>(image_a.size()), hash_a) !=
+            videomancer_configuration_result::ok || !switcher.reconfigured()) {
+        std::cerr << "FAILED: Memory switch did not configure" << std::endl;
+        return false;
+    }
+    controller.set_video_timing_id(2);
+
+    fpga.frames.clear();
+    if (switcher.switch_program(config, image_b.data(), static_cast<uint32_t>(image_b.size()), hash_b) !=
+            videomancer_configuration_result::ok || !switcher.reconfigured() ||
+        !switcher.is_loaded(hash_b) || switcher.is_loaded(hash_a)) {
+        std::cerr << "FAILED: New bitstream not configured" << std::endl;
+        return false;
+    }
+    // Configuration reset the registers: all nine are pushed, timing included
+    const uint16_t timing_frame = static_cast<uint16_t>((videomancer_abi_v1_0::register_address::video_timing_id << 10) | 2);
+    if (fpga.frames.size() != 9 || fpga.frames[8] != timing_frame ||
+        controller.get_video_timing_id() != 2 || controller.get_linear_pot_12() != 300) {
+        std::cerr << "FAILED: Registers not rewritten after configuration" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Bitstream change test" << std::endl;
+    return true;
+}
+
+// Test that a failed configuration forgets the loaded bitstream
+bool test_failed_configuration() {
+    std::vector<uint8_t> capture(8192);
+    std::vector<uint8_t> buffer(1024);
+    recording_fpga fpga(capture.data(), static_cast<uint32_t>(capture.size()));
+    videomancer_fpga_controller controller(fpga);
+    videomancer_fpga_configurator configurator(buffer.data(), static_cast<uint32_t>(buffer.size()));
+    videomancer_program_switcher switcher(fpga, controller, configurator);
+
+    const std::vector<uint8_t> image = build_test_ice40_image(2048, 3);
+    const vmprog_toc_entry_v1_0 entry = make_entry(image);
+    const vmprog_signed_descriptor_v1_0 descriptor = make_descriptor(entry);
+    vmprog_toc_entry_v1_0 bad = make_entry(build_test_ice40_image(2048, 7));
+    bad.size = entry.size;
+    const vmprog_signed_descriptor_v1_0 bad_descriptor = make_descriptor(bad);
+    counting_stream stream(image);
+
+    vmprog_program_config_v1_0 config;
+    init_vmprog_config(config);
+
+    if (switcher.switch_program(config, stream, entry, descriptor) != videomancer_configuration_result::ok ||
+        switcher.switch_program(config, stream, bad, bad_descriptor) != videomancer_configuration_result::hash_mismatch ||
+        switcher.loaded_sha256() != nullptr || fpga.user_mode()) {
+        std::cerr << "FAILED: Hash mismatch not handled" << std::endl;
+        return false;
+    }
+
+    // The original bitstream must be reloaded, not skipped
+    if (switcher.switch_program(config, stream, entry, descriptor) != videomancer_configuration_result::ok ||
+        !switcher.reconfigured() || !fpga.user_mode()) {
+        std::cerr << "FAILED: Reload after failure skipped configuration" << std::endl;
+        return false;
+    }
+
+    switcher.invalidate();
+    if (switcher.is_loaded(entry.sha256)) {
+        std::cerr << "FAILED: invalidate() kept the loaded hash" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Failed configuration test" << std::endl;
+    return true;
+}
+
+// Test that a warmboot replaces the loaded bitstream
+bool test_warmboot_then_switch() {
+    std::vector<uint8_t> capture(8192);
+    std::vector<uint8_t> buffer(1024);
+    recording_fpga fpga(capture.data(), static_cast<uint32_t>(capture.size()));
+    videomancer_fpga_controller controller(fpga);
+    videomancer_fpga_configurator configurator(buffer.data(), static_cast<uint32_t>(buffer.size()));
+    videomancer_program_switcher switcher(fpga, controller, configurator);
+
+    const std::vector<uint8_t> image_a = build_test_ice40_image(2048, 3);
+    const std::vector<uint8_t> image_b = build_test_ice40_image(2048, 5);
+    const vmprog_toc_entry_v1_0 entry_a = make_entry(image_a);
+    const vmprog_toc_entry_v1_0 entry_b = make_entry(image_b);
+    const vmprog_signed_descriptor_v1_0 descriptor_a = make_descriptor(entry_a);
+    const vmprog_signed_descriptor_v1_0 descriptor_b = make_descriptor(entry_b);
+    counting_stream stream(image_a);
+
+    vmprog_program_config_v1_0 config;
+    init_vmprog_config(config);
+    add_parameter(config, vmprog_parameter_id_v1_0::rotary_potentiometer_1, 400);
+
+    // Unknown image: the old bitstream must be configured again
+    switcher.switch_program(config, stream, entry_a, descriptor_a);
+    if (!switcher.warmboot(1) || switcher.loaded_sha256() != nullptr) {
+        std::cerr << "FAILED: Warmboot kept the loaded hash" << std::endl;
+        return false;
+    }
+    const int reads_before = stream.reads;
+    if (switcher.switch_program(config, stream, entry_a, descriptor_a) != videomancer_configuration_result::ok ||
+        !switcher.reconfigured() || stream.reads == reads_before) {
+        std::cerr << "FAILED: Switch after warmboot skipped configuration" << std::endl;
+        return false;
+    }
+
+    // Invalid slots are refused; a known image becomes the loaded bitstream
+    controller.set_video_timing_id(4);
+    if (switcher.warmboot(videomancer_abi_v1_0::warmboot_image_count, entry_b.sha256) ||
+        !switcher.warmboot(2, entry_b.sha256) || !switcher.is_loaded(entry_b.sha256) || switcher.is_loaded(entry_a.sha256)) {
+        std::cerr << "FAILED: Warmboot did not record the booted image" << std::endl;
+        return false;
+    }
+
+    // Switching onto the booted image skips configuration but resends every register
+    counting_stream stream_b(image_b);
+    fpga.frames.clear();
+    const uint16_t timing_frame = static_cast<uint16_t>((videomancer_abi_v1_0::register_address::video_timing_id << 10) | 4);
+    if (switcher.switch_program(config, stream_b, entry_b, descriptor_b) != videomancer_configuration_result::ok ||
+        switcher.reconfigured() || stream_b.reads != 0 || fpga.frames.size() != 9 ||
+        fpga.frames.back() != timing_frame || controller.get_rotary_pot_1() != 400) {
+        std::cerr << "FAILED: Switch after warmboot sent " << fpga.frames.size() << " frames" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Warmboot then switch test" << std::endl;
+    return true;
+}
+
+// Test that only the signed hash decides whether configuration is skipped
+bool test_unsigned_hash_ignored() {
+    std::vector<uint8_t> capture(8192);
+    std::vector<uint8_t> buffer(1024);
+    recording_fpga fpga(capture.data(), static_cast<uint32_t>(capture.size()));
+    videomancer_fpga_controller controller(fpga);
+    videomancer_fpga_configurator configurator(buffer.data(), static_cast<uint32_t>(buffer.size()));
+    videomancer_program_switcher switcher(fpga, controller, configurator);
+
+    const std::vector<uint8_t> image_a = build_test_ice40_image(2048, 3);
+    const std::vector<uint8_t> image_b = build_test_ice40_image(2048, 5);
+    const vmprog_toc_entry_v1_0 entry_a = make_entry(image_a);
+    const vmprog_signed_descriptor_v1_0 descriptor_b = make_descriptor(make_entry(image_b));
+    counting_stream stream_a(image_a);
+    counting_stream stream_b(image_b);
+
+    vmprog_program_config_v1_0 config;
+    init_vmprog_config(config);
+
+    // TOC of package B claims the hash of the loaded image A
+    vmprog_toc_entry_v1_0 forged = make_entry(image_b);
+    memcpy(forged.sha256, entry_a.sha256, 32);
+    if (switcher.switch_program(config, stream_a, entry_a, make_descriptor(entry_a)) != videomancer_configuration_result::ok ||
+        switcher.switch_program(config, stream_b, forged, descriptor_b) != videomancer_configuration_result::ok ||
+        !switcher.reconfigured() || stream_b.reads == 0 || !switcher.is_loaded(descriptor_b.artifacts[0].sha256)) {
+        std::cerr << "FAILED: Forged TOC hash skipped configuration" << std::endl;
+        return false;
+    }
+
+    // A variant the descriptor does not sign is refused before any read
+    vmprog_toc_entry_v1_0 unsigned_entry = make_entry(image_a);
+    unsigned_entry.type = vmprog_toc_entry_type_v1_0::bitstream_hd_analog;
+    const int reads_before = stream_a.reads;
+    if (switcher.switch_program(config, stream_a, unsigned_entry, descriptor_b) !=
+            videomancer_configuration_result::invalid_entry || stream_a.reads != reads_before) {
+        std::cerr << "FAILED: Unsigned variant accepted" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Unsigned hash ignored test" << std::endl;
+    return true;
+}
+
+// Main test runner
+int main() {
+    std::cout << "======================================" << std::endl;
+    std::cout << "Videomancer videomancer_program_switcher.hpp Tests" << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << std::endl;
+
+    int passed = 0;
+    int total = 0;
+
+    #define RUN_TEST(test_func) \
+        do { \
+            total++; \
+            if (test_func()) { \
+                passed++; \
+            } \
+        } while(0)
+
+    RUN_TEST(test_shared_bitstream);
+    RUN_TEST(test_bitstream_change);
+    RUN_TEST(test_failed_configuration);
+    RUN_TEST(test_warmboot_then_switch);
+    RUN_TEST(test_unsigned_hash_ignored);
+
+    std::cout << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
+    std::cout << "======================================" << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
@@ -0,0 +1,301 @@
+// Videomancer SDK - Unit Tests for videomancer_spi_trace.hpp
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <lzx/videomancer/videomancer_spi_trace.hpp>
+#include <iostream>
+#include <cstring>
+#include <vector>
+
+using namespace lzx;
+
+// Manually advanced clock
+class test_clock : public videomancer_clock {
+public:
+    uint64_t time_us = 1000;
+    uint64_t now_us() override { return time_us; }
+};
+
+// Captures raw SPI activity as a flat list of calls
+class capture_fpga : public videomancer_fpga {
+public:
+    std::vector<uint8_t> tx_bytes;
+    size_t cs_asserts = 0;
+    size_t cs_deasserts = 0;
+    size_t transfers = 0;
+
+    size_t transfer_spi(const uint8_t* tx_buffer, uint8_t* rx_buffer, size_t size) override {
+        ++transfers;
+        if (tx_buffer) {
+            tx_bytes.insert(tx_bytes.end(), tx_buffer, tx_buffer + size);
+        }
+        if (rx_buffer) {
+            memset(rx_buffer, 0, size);
+        }
+        return size;
+    }
+
+    void assert_chip_select_spi(bool assert) override {
+        if (assert) {
+            ++cs_asserts;
+        } else {
+            ++cs_deasserts;
+        }
+    }
+};
+
+// Test that recorded events decode back with the original timing and payload
+bool test_record_and_read() {
+    test_clock clock;
+    capture_fpga target;
+    uint8_t trace[256];
+    videomancer_fpga_recorder recorder(target, clock, trace, sizeof(trace));
+
+    const uint8_t frame[2] = { 0x04, 0x55 };
+    clock.time_us = 1010;
+    recorder.assert_chip_select_spi(true);
+    recorder.transfer_spi(frame, nullptr, 2);
+    clock.time_us = 1500;
+    recorder.assert_chip_select_spi(false);
+    // A clock that steps backwards records delta 0 and keeps the time base
+    clock.time_us = 1200;
+    recorder.assert_chip_select_spi(true);
+    clock.time_us = 1600;
+    recorder.assert_chip_select_spi(false);
+
+    if (target.cs_asserts != 2 || target.cs_deasserts != 2 || target.tx_bytes.size() != 2) {
+        std::cerr << "FAILED: Record/read test - calls not forwarded" << std::endl;
+        return false;
+    }
+
+    spi_trace_reader reader;
+    if (!reader.begin(trace, recorder.trace_size())) {
+        std::cerr << "FAILED: Record/read test - header rejected" << std::endl;
+        return false;
+    }
+
+    spi_trace_event event;
+    if (!reader.next(event) || event.type != spi_trace_event_type::cs_assert || event.timestamp_us != 10 ||
+        !reader.next(event) || event.type != spi_trace_event_type::transfer || event.size != 2 ||
+        event.data[0] != 0x04 || event.data[1] != 0x55 ||
+        !reader.next(event) || event.type != spi_trace_event_type::cs_deassert || event.timestamp_us != 500 ||
+        !reader.next(event) || event.timestamp_us != 500 ||
+        !reader.next(event) || event.timestamp_us != 600 ||
+        reader.next(event) || reader.has_error()) {
+        std::cerr << "FAILED: Record/read test - event mismatch" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Record and read test" << std::endl;
+    return true;
+}
+
+// Test that a full buffer drops events without corrupting the trace
+bool test_trace_overflow() {
+    test_clock clock;
+    capture_fpga target;
+    uint8_t trace[16];
+    videomancer_fpga_recorder recorder(target, clock, trace, sizeof(trace));
+
+    for (int i = 0; i < 10; ++i) {
+        recorder.assert_chip_select_spi(true);
+        recorder.assert_chip_select_spi(false);
+    }
+
+    if (!recorder.trace_overflowed() || target.cs_asserts != 10) {
+        std::cerr << "FAILED: Trace overflow test - overflow not reported" << std::endl;
+        return false;
+    }
+
+    spi_trace_stats stats;
+    if (!analyze_spi_trace(trace, recorder.trace_size(), stats) || stats.event_count != 4) {
+        std::cerr << "FAILED: Trace overflow test - truncated trace invalid" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Trace overflow test" << std::endl;
+    return true;
+}
+
+// Test byte-exact replay of controller traffic
+bool test_replay_to_fpga() {
+    test_clock clock;
+    capture_fpga original;
+    uint8_t trace[512];
+    videomancer_fpga_recorder recorder(original, clock, trace, sizeof(trace));
+    videomancer_fpga_controller controller(recorder);
+
+    controller.set_rotary_pot_1(512);
+    controller.set_toggle_switch_9(true);
+    controller.set_video_timing(videomancer_abi_v1_0::video_timing_id::_1080p30);
+
+    capture_fpga replayed;
+    size_t events = 0;
+    if (!replay_spi_trace(trace, recorder.trace_size(), replayed, &events)) {
+        std::cerr << "FAILED: Replay test - replay reported error" << std::endl;
+        return false;
+    }
+
+    if (events != 9 || replayed.tx_bytes != original.tx_bytes ||
+        replayed.cs_asserts != original.cs_asserts) {
+        std::cerr << "FAILED: Replay test - replayed traffic differs" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Replay to FPGA test" << std::endl;
+    return true;
+}
+
+// Test replay through a controller, which filters redundant writes
+bool test_replay_to_controller() {
+    // Hand-built trace with a repeated write to rotary_pot_2
+    uint8_t trace[128];
+    spi_trace_writer writer;
+    writer.begin(trace, sizeof(trace), 0);
+    const uint8_t frame[2] = { 0x05, 0x00 };  // addr 1, data 256
+    for (int i = 0; i < 3; ++i) {
+        writer.write_chip_select(i * 10, true);
+        writer.write_transfer(i * 10, frame, 2);
+        writer.write_chip_select(i * 10 + 1, false);
+    }
+
+    capture_fpga target;
+    videomancer_fpga_controller controller(target);
+    if (!replay_spi_trace_to_controller(trace, writer.size(), controller)) {
+        std::cerr << "FAILED: Controller replay test - replay reported error" << std::endl;
+        return false;
+    }
+
+    if (controller.get_rotary_pot_2() != 256 || target.cs_asserts != 1) {
+        std::cerr << "FAILED: Controller replay test - expected one filtered write" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Replay to controller test" << std::endl;
+    return true;
+}
+
+// Test traffic counters
+bool test_analyze_trace() {
+    uint8_t trace[128];
+    spi_trace_writer writer;
+    writer.begin(trace, sizeof(trace), 0);
+    const uint8_t pot_a[2] = { 0x01, 0x00 };  // addr 0, data 256
+    const uint8_t pot_b[2] = { 0x01, 0x01 };  // addr 0, data 257
+    writer.write_chip_select(0, true);
+    writer.write_transfer(0, pot_a, 2);
+    writer.write_chip_select(1, false);
+    writer.write_chip_select(100, true);
+    writer.write_transfer(100, pot_a, 2);
+    writer.write_chip_select(101, false);
+    writer.write_chip_select(200, true);
+    writer.write_transfer(200, pot_b, 2);
+    writer.write_chip_select(1000, false);
+
+    spi_trace_stats stats;
+    if (!analyze_spi_trace(trace, writer.size(), stats)) {
+        std::cerr << "FAILED: Analyze test - decode error" << std::endl;
+        return false;
+    }
+
+    if (stats.event_count != 9 || stats.transfer_count != 3 || stats.cs_assert_count != 3 ||
+        stats.frame_count != 3 || stats.write_frame_count != 3 || stats.redundant_write_count != 1 ||
+        stats.payload_bytes != 6 || stats.duration_us != 1000 || stats.register_write_counts[0] != 3) {
+        std::cerr << "FAILED: Analyze test - counters incorrect" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Analyze trace test" << std::endl;
+    return true;
+}
+
+// Test projection of counters onto a video timing mode
+bool test_bus_projection() {
+    spi_trace_stats stats = {};
+    stats.duration_us = 1000000;  // 1 s
+    stats.frame_count = 6000;
+    stats.cs_assert_count = 6000;
+    stats.payload_bytes = 12000;
+
+    // 1 MHz SPI: 96 ms of data + 0.72 ms of CS per second, 30 Hz video
+    spi_bus_projection p = project_spi_bus_occupancy(
+        stats, videomancer_abi_v1_0::video_timing_id::_1080p30, 1000000);
+
+    if (p.frames_per_second < 5999.0 || p.frames_per_second > 6001.0 ||
+        p.frames_per_video_frame < 199.9 || p.frames_per_video_frame > 200.1 ||
+        p.occupancy < 0.0967 || p.occupancy > 0.0968 ||
+        p.cs_per_frame != 1.0) {
+        std::cerr << "FAILED: Bus projection test - unexpected figures" << std::endl;
+        return false;
+    }
+
+    spi_bus_projection reserved = project_spi_bus_occupancy(
+        stats, videomancer_abi_v1_0::video_timing_id::reserved, 1000000);
+    if (reserved.occupancy != 0.0) {
+        std::cerr << "FAILED: Bus projection test - reserved timing not rejected" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Bus projection test" << std::endl;
+    return true;
+}
+
+// Test that malformed traces are rejected
+bool test_malformed_trace() {
+    uint8_t trace[32];
+    spi_trace_writer writer;
+    writer.begin(trace, sizeof(trace), 0);
+    const uint8_t frame[2] = { 0x00, 0x01 };
+    writer.write_transfer(0, frame, 2);
+
+    spi_trace_stats stats;
+    // Truncated payload
+    if (analyze_spi_trace(trace, writer.size() - 1, stats)) {
+        std::cerr << "FAILED: Malformed trace test - truncated payload accepted" << std::endl;
+        return false;
+    }
+
+    // Bad magic
+    trace[0] ^= 0xFF;
+    if (analyze_spi_trace(trace, writer.size(), stats)) {
+        std::cerr << "FAILED: Malformed trace test - bad magic accepted" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Malformed trace test" << std::endl;
+    return true;
+}
+
+// Main test runner
+int main() {
+    std::cout << "======================================" << std::endl;
+    std::cout << "Videomancer videomancer_spi_trace.hpp Tests" << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << std::endl;
+
+    int passed = 0;
+    int total = 0;
+
+    #define RUN_TEST(test_func) \
+        do { \
+            total++; \
+            if (test_func()) { \
+                passed++; \
+            } \
+        } while(0)
+
+    RUN_TEST(test_record_and_read);
+    RUN_TEST(test_trace_overflow);
+    RUN_TEST(test_replay_to_fpga);
+    RUN_TEST(test_replay_to_controller);
+    RUN_TEST(test_analyze_trace);
+    RUN_TEST(test_bus_projection);
+    RUN_TEST(test_malformed_trace);
+
+    std::cout << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
+    std::cout << "======================================" << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
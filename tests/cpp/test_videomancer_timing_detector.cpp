@@ -0,0 +1,199 @@
+// Videomancer SDK - Unit Tests for videomancer_timing_detector.hpp
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <lzx/videomancer/videomancer_timing_detector.hpp>
+#include <iostream>
+
+using namespace lzx;
+using videomancer_abi_v1_0::video_timing_id;
+
+// Synthetic sync generator: hsync low for the last 64 clocks of each line,
+// vsync low for the 3 lines before each field start. The second field of an
+// interlaced frame starts half a line late, as in video_sync_pkg.
+struct sync_generator {
+    const videomancer_abi_v1_0::video_timing_info& t;
+    uint32_t pos = 0;
+
+    explicit sync_generator(video_timing_id id)
+        : t(videomancer_abi_v1_0::get_video_timing_info(id)) {}
+
+    uint32_t frame_clocks() const { return static_cast<uint32_t>(t.clocks_per_line) * t.lines_per_frame; }
+
+    bool vsync_low_before(uint32_t start) const {
+        const uint32_t frame = frame_clocks();
+        const uint32_t distance = (start + frame - pos) % frame;  // Clocks until the field starts
+        return distance != 0 && distance <= 3u * t.clocks_per_line;
+    }
+
+    void next(bool& hsync, bool& vsync) {
+        const uint32_t clock = pos % t.clocks_per_line;
+        hsync = clock < t.clocks_per_line - 64u;
+        vsync = !vsync_low_before(0);
+        if (t.is_interlaced) {
+            const uint32_t second = (t.lines_per_frame / 2u) * t.clocks_per_line + t.clocks_per_line / 2u;
+            vsync = vsync && !vsync_low_before(second);
+        }
+        pos = (pos + 1) % frame_clocks();
+    }
+};
+
+// Run until locked or a frame limit is reached; returns frames consumed
+static uint32_t run_detector(video_timing_detector& detector, video_timing_id id, uint32_t max_frames) {
+    sync_generator gen(id);
+    const uint32_t frame = gen.frame_clocks();
+    for (uint32_t f = 0; f < max_frames; ++f) {
+        for (uint32_t i = 0; i < frame; ++i) {
+            bool hsync, vsync;
+            gen.next(hsync, vsync);
+            detector.step(hsync, vsync);
+        }
+        if (detector.is_locked())
+            return f + 1;
+    }
+    return max_frames;
+}
+
+// Test the field detector model on progressive and interlaced sync
+bool test_field_detector() {
+    video_field_detector_model<12> progressive;
+    sync_generator p(video_timing_id::_480p);
+    for (uint32_t i = 0; i < p.frame_clocks() * 5; ++i) {
+        bool h, v;
+        p.next(h, v);
+        progressive.step(h, v);
+        // Outputs settle after three vsync edges, as in the RTL
+        if (i >= p.frame_clocks() * 3 && (!progressive.field_n() || progressive.is_interlaced())) {
+            std::cerr << "FAILED: Field detector test - progressive reported as interlaced" << std::endl;
+            return false;
+        }
+    }
+
+    video_field_detector_model<12> interlaced;
+    sync_generator n(video_timing_id::ntsc);
+    uint32_t toggles = 0;
+    bool last_field_n = interlaced.field_n();
+    for (uint32_t i = 0; i < n.frame_clocks() * 4; ++i) {
+        bool h, v;
+        n.next(h, v);
+        interlaced.step(h, v);
+        if (interlaced.field_n() != last_field_n) {
+            ++toggles;
+            last_field_n = interlaced.field_n();
+        }
+    }
+    if (!interlaced.is_interlaced() || toggles < 4) {
+        std::cerr << "FAILED: Field detector test - NTSC fields not detected" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Field detector test" << std::endl;
+    return true;
+}
+
+// Test the constexpr signature table
+bool test_signature_table() {
+    static_assert(count_video_timing_signatures() == 7, "Seven distinct rasters");
+    static_assert(find_video_timing_candidates(858, 525, true) == (1u << 0), "NTSC signature");
+    static_assert(find_video_timing_candidates(858, 525, false) == (1u << 4), "480p signature");
+    static_assert(find_video_timing_candidates(2200, 1125, false) == ((1u << 0x7) | (1u << 0xD)),
+                  "1080p30 / 1080p29.97 share a raster");
+    static_assert(find_video_timing_candidates(1000, 500, false) == 0, "Unknown raster");
+
+    for (size_t i = 1; i < count_video_timing_signatures(); ++i) {
+        if (video_timing_signatures.entries[i - 1].key >= video_timing_signatures.entries[i].key) {
+            std::cerr << "FAILED: Signature table test - table not sorted" << std::endl;
+            return false;
+        }
+    }
+
+    // 1080i60 and 1080i59.94 are separated by frame rate only
+    const uint16_t both = find_video_timing_candidates(2200, 1125, true);
+    if (narrow_video_timing_candidates(both, 74250000, 2200, 1125) != (1u << 0xA) ||
+        narrow_video_timing_candidates(both, 74175824, 2200, 1125) != (1u << 0x2) ||
+        narrow_video_timing_candidates(both, 70000000, 2200, 1125) != 0) {
+        std::cerr << "FAILED: Signature table test - frame rate narrowing incorrect" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Signature table test" << std::endl;
+    return true;
+}
+
+// Test detection of every defined mode with a known sample clock
+bool test_detect_all_modes() {
+    for (uint8_t i = 0; i < 15; ++i) {
+        const video_timing_id id = static_cast<video_timing_id>(i);
+        video_timing_detector detector(videomancer_abi_v1_0::get_pixel_clock_hz(id));
+        // First vsync edge at the end of frame 0; lock after two matching frames
+        const uint32_t frames = run_detector(detector, id, 8);
+        const video_timing_detection& r = detector.result();
+        if (!r.locked || r.id != id || frames > 5) {
+            std::cerr << "FAILED: Detect all modes test - mode " << static_cast<int>(i)
+                      << " detected as " << static_cast<int>(r.id) << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "PASSED: Detect all modes test" << std::endl;
+    return true;
+}
+
+// Test that shared rasters stay unlocked without a sample clock
+bool test_ambiguous_without_clock() {
+    video_timing_detector detector;
+    run_detector(detector, video_timing_id::_1080p30, 5);
+    const video_timing_detection& r = detector.result();
+    if (r.locked || r.candidates != ((1u << 0x7) | (1u << 0xD)) ||
+        r.clocks_per_line != 2200 || r.lines_per_frame != 1125 || r.is_interlaced) {
+        std::cerr << "FAILED: Ambiguous without clock test - unexpected result" << std::endl;
+        return false;
+    }
+
+    video_timing_detector pal;
+    run_detector(pal, video_timing_id::pal, 5);
+    if (!pal.is_locked() || pal.result().id != video_timing_id::pal) {
+        std::cerr << "FAILED: Ambiguous without clock test - unique raster did not lock" << std::endl;
+        return false;
+    }
+
+    pal.reset();
+    if (pal.is_locked() || pal.result().candidates != 0) {
+        std::cerr << "FAILED: Ambiguous without clock test - reset did not clear result" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Ambiguous without clock test" << std::endl;
+    return true;
+}
+
+// Main test runner
+int main() {
+    std::cout << "======================================" << std::endl;
+    std::cout << "Videomancer videomancer_timing_detector.hpp Tests" << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << std::endl;
+
+    int passed = 0;
+    int total = 0;
+
+    #define RUN_TEST(test_func) \
+        do { \
+            total++; \
+            if (test_func()) { \
+                passed++; \
+            } \
+        } while(0)
+
+    RUN_TEST(test_field_detector);
+    RUN_TEST(test_signature_table);
+    RUN_TEST(test_detect_all_modes);
+    RUN_TEST(test_ambiguous_without_clock);
+
+    std::cout << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
+    std::cout << "======================================" << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
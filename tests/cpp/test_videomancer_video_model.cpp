@@ -0,0 +1,321 @@
+// Videomancer SDK - Unit Tests for videomancer_video_model.hpp
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <lzx/videomancer/videomancer_video_model.hpp>
+#include <iostream>
+#include <vector>
+
+using namespace lzx;
+using videomancer_abi_v1_0::video_timing_id;
+
+// Deterministic pseudo-random sample source
+static uint32_t next_random(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+// Build one clock of a synthetic raster: active region first, then blanking
+static yuv444_30b_sample raster_sample(const videomancer_abi_v1_0::video_timing_info& t,
+                                       uint32_t line, uint32_t clock, uint32_t frame) {
+    yuv444_30b_sample s;
+    s.avid = line < t.frame_height && clock < t.frame_width;
+    s.y = static_cast<uint16_t>((clock + line + frame) & 0x3FF);
+    s.u = static_cast<uint16_t>((clock * 3) & 0x3FF);
+    s.v = static_cast<uint16_t>((line * 5) & 0x3FF);
+    s.hsync_n = clock < t.clocks_per_line - 64u;
+    s.vsync_n = line < t.lines_per_frame - 3u;
+    s.field_n = true;
+    return s;
+}
+
+// Test the blanking model against a direct transcription of the RTL process
+bool test_blanking_bit_exact() {
+    yuv444_30b_blanking_model model;
+    uint32_t state = 12345;
+
+    // Reference: s_data_reg and data_out updated on each edge
+    yuv444_30b_sample ref_reg = model.output();
+    for (int i = 0; i < 100000; ++i) {
+        const uint32_t r = next_random(state);
+        yuv444_30b_sample in;
+        in.y = static_cast<uint16_t>(r & 0xFFFF);  // Upper bits must be ignored
+        in.u = static_cast<uint16_t>((r >> 3) & 0x3FF);
+        in.v = static_cast<uint16_t>((r >> 7) & 0x3FF);
+        in.avid = (r & 0x10000) != 0;
+        in.hsync_n = (r & 0x20000) != 0;
+        in.vsync_n = (r & 0x40000) != 0;
+        in.field_n = (r & 0x80000) != 0;
+
+        yuv444_30b_sample expected;
+        if (ref_reg.avid) {
+            expected.y = ref_reg.y & 0x3FF;
+            expected.u = ref_reg.u & 0x3FF;
+            expected.v = ref_reg.v & 0x3FF;
+        } else {
+            expected.y = 0;
+            expected.u = 512;
+            expected.v = 512;
+        }
+        expected.avid = ref_reg.avid;
+        expected.hsync_n = ref_reg.hsync_n;
+        expected.vsync_n = ref_reg.vsync_n;
+        expected.field_n = ref_reg.field_n;
+        ref_reg = in;
+
+        const yuv444_30b_sample out = model.step(in);
+        if (out.y != expected.y || out.u != expected.u || out.v != expected.v ||
+            out.avid != expected.avid || out.hsync_n != expected.hsync_n ||
+            out.vsync_n != expected.vsync_n || out.field_n != expected.field_n) {
+            std::cerr << "FAILED: Blanking bit-exact test - mismatch at clock " << i << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "PASSED: Blanking bit-exact test" << std::endl;
+    return true;
+}
+
+// Test blanking span table
+bool test_blanking_table() {
+    const video_blanking_info& ntsc = get_video_blanking_info(video_timing_id::ntsc);
+    if (ntsc.h_blank_clocks != 138 || ntsc.v_blank_lines != 39 ||
+        ntsc.raster_samples != 450450 || ntsc.active_samples != 349920) {
+        std::cerr << "FAILED: Blanking table test - NTSC spans incorrect" << std::endl;
+        return false;
+    }
+
+    // SD modes save at least 20% of samples by skipping blanking
+    const video_timing_id sd[] = { video_timing_id::ntsc, video_timing_id::pal,
+                                   video_timing_id::_480p, video_timing_id::_576p };
+    for (video_timing_id id : sd) {
+        const video_blanking_info& b = get_video_blanking_info(id);
+        if (b.active_samples * 100 > b.raster_samples * 80) {
+            std::cerr << "FAILED: Blanking table test - SD active ratio above 80%" << std::endl;
+            return false;
+        }
+    }
+
+    static_assert(get_video_blanking_info(video_timing_id::_1080p30).active_samples == 1920u * 1080u,
+                  "1080p active size");
+    if (get_video_blanking_info(video_timing_id::reserved).raster_samples != 0) {
+        std::cerr << "FAILED: Blanking table test - reserved mode not empty" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Blanking table test" << std::endl;
+    return true;
+}
+
+// Test that streaming a raster stores exactly the active region
+bool test_active_frame_stream() {
+    const video_timing_id id = video_timing_id::_480p;
+    const auto& t = videomancer_abi_v1_0::get_video_timing_info(id);
+    const size_t n = yuv444_30b_active_frame::required_samples(id);
+    std::vector<uint16_t> y(n), u(n), v(n);
+
+    yuv444_30b_active_frame frame;
+    if (frame.attach(id, y.data(), u.data(), v.data(), n - 1) ||
+        !frame.attach(id, y.data(), u.data(), v.data(), n)) {
+        std::cerr << "FAILED: Active frame stream test - attach capacity check" << std::endl;
+        return false;
+    }
+
+    // Two frames, starting mid-frame so the first partial frame is discarded
+    for (uint32_t f = 0; f < 3; ++f) {
+        const uint32_t first_line = (f == 0) ? t.lines_per_frame - 3 : 0;
+        for (uint32_t line = first_line; line < t.lines_per_frame; ++line) {
+            for (uint32_t clock = 0; clock < t.clocks_per_line; ++clock) {
+                frame.push(raster_sample(t, line, clock, f));
+            }
+        }
+    }
+
+    if (frame.frames_completed() != 2 || frame.overflow_samples() != 0) {
+        std::cerr << "FAILED: Active frame stream test - expected 2 frames, got "
+                  << frame.frames_completed() << std::endl;
+        return false;
+    }
+
+    for (uint32_t line = 0; line < t.frame_height; line += 37) {
+        for (uint32_t clock = 0; clock < t.frame_width; clock += 13) {
+            const yuv444_30b_sample expected = raster_sample(t, line, clock, 2);
+            const yuv444_30b_sample got = frame.read_raster(static_cast<uint16_t>(line), static_cast<uint16_t>(clock));
+            if (got.y != expected.y || got.u != expected.u || got.v != expected.v || !got.avid) {
+                std::cerr << "FAILED: Active frame stream test - sample mismatch" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    const yuv444_30b_sample blank = frame.read_raster(10, t.frame_width);
+    if (blank.avid || blank.y != 0 || blank.u != 512 || blank.v != 512) {
+        std::cerr << "FAILED: Active frame stream test - blanking not synthesized" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Active frame stream test" << std::endl;
+    return true;
+}
+
+// Test direct line writes
+bool test_active_frame_lines() {
+    const video_timing_id id = video_timing_id::ntsc;
+    const size_t n = yuv444_30b_active_frame::required_samples(id);
+    std::vector<uint16_t> y(n), u(n), v(n);
+    yuv444_30b_active_frame frame;
+    frame.attach(id, y.data(), u.data(), v.data(), n);
+
+    std::vector<uint16_t> line(frame.width(), 0xFFFF);
+    if (!frame.write_line(485, line.data(), line.data(), line.data()) ||
+        frame.write_line(486, line.data(), line.data(), line.data()) ||
+        frame.read_raster(485, 719).y != 0x3FF) {
+        std::cerr << "FAILED: Active frame lines test - line write incorrect" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Active frame lines test" << std::endl;
+    return true;
+}
+
+// Test field layouts derived from the timing table
+bool test_field_layout() {
+    const video_field_layout ntsc = make_video_field_layout(video_timing_id::ntsc);
+    const video_field_layout i1080 = make_video_field_layout(video_timing_id::_1080i50);
+    const video_field_layout p720 = make_video_field_layout(video_timing_id::_720p60);
+    if (ntsc.field_count != 2 || ntsc.field_lines[0] != 263 || ntsc.field_lines[1] != 262 ||
+        ntsc.active_lines != 243 || ntsc.first_field_top) {
+        std::cerr << "FAILED: Field layout test - NTSC layout incorrect" << std::endl;
+        return false;
+    }
+    if (i1080.field_count != 2 || i1080.field_lines[0] != 563 || i1080.active_lines != 540 ||
+        !i1080.first_field_top || video_field_row(i1080, 1, 3) != 7 || video_field_row(ntsc, 0, 3) != 7) {
+        std::cerr << "FAILED: Field layout test - 1080i layout incorrect" << std::endl;
+        return false;
+    }
+    if (p720.field_count != 1 || p720.field_lines[0] != 750 || p720.active_lines != 720 ||
+        video_field_row(p720, 0, 3) != 3) {
+        std::cerr << "FAILED: Field layout test - 720p layout incorrect" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Field layout test" << std::endl;
+    return true;
+}
+
+// Field processor that weaves fields into a frame and records their order
+class weaving_processor : public yuv444_30b_field_processor {
+public:
+    yuv444_30b_active_frame* frame = nullptr;
+    std::vector<bool> field_n;
+    std::vector<size_t> written_at_call;
+
+    void process_field(const yuv444_30b_active_field& field) override {
+        field_n.push_back(field.field_n());
+        written_at_call.push_back(field.samples_written());
+        field.weave_into(*frame);
+    }
+};
+
+// Test field-at-a-time streaming of an interlaced raster
+bool test_active_field_stream() {
+    const video_timing_id id = video_timing_id::pal;
+    const auto& t = videomancer_abi_v1_0::get_video_timing_info(id);
+    const video_field_layout layout = make_video_field_layout(id);
+    const size_t n = yuv444_30b_active_field::required_samples(id);
+    if (n * 2 != yuv444_30b_active_frame::required_samples(id)) {
+        std::cerr << "FAILED: Active field stream test - field is not half a frame" << std::endl;
+        return false;
+    }
+
+    std::vector<uint16_t> fy(n), fu(n), fv(n);
+    const size_t frame_n = yuv444_30b_active_frame::required_samples(id);
+    std::vector<uint16_t> y(frame_n, 0xFFFF), u(frame_n), v(frame_n);
+    yuv444_30b_active_frame frame;
+    frame.attach(id, y.data(), u.data(), v.data(), frame_n);
+
+    yuv444_30b_active_field field;
+    weaving_processor processor;
+    processor.frame = &frame;
+    if (field.attach(id, fy.data(), fu.data(), fv.data(), n - 1) ||
+        !field.attach(id, fy.data(), fu.data(), fv.data(), n)) {
+        std::cerr << "FAILED: Active field stream test - attach capacity check" << std::endl;
+        return false;
+    }
+    field.set_processor(&processor);
+
+    // Two frames of two fields: active lines first, vsync at the end of each
+    // field, field_n low in the first field. Sample values encode the frame row.
+    for (uint8_t i = 0; i < 4; ++i) {
+        const uint8_t f = i & 1;
+        for (uint32_t line = 0; line < layout.field_lines[f]; ++line) {
+            for (uint32_t clock = 0; clock < t.clocks_per_line; ++clock) {
+                yuv444_30b_sample s;
+                s.avid = line < layout.active_lines && clock < t.frame_width;
+                const uint16_t row = video_field_row(layout, f, static_cast<uint16_t>(line));
+                s.y = static_cast<uint16_t>(row);
+                s.u = static_cast<uint16_t>(clock & 0x3FF);
+                s.v = 512;
+                s.hsync_n = clock < t.clocks_per_line - 64u;
+                s.vsync_n = (f == 1 && line == 0) || line < layout.field_lines[f] - 3u;
+                s.field_n = f == 1;
+                field.push(s);
+            }
+        }
+    }
+
+    // The stream starts without a vsync, so the very first field is skipped
+    const std::vector<bool> expected_field_n = { true, false, true };
+    if (field.fields_completed() != 3 || processor.field_n != expected_field_n ||
+        processor.written_at_call[0] != n) {
+        std::cerr << "FAILED: Active field stream test - expected 3 fields, got "
+                  << field.fields_completed() << std::endl;
+        return false;
+    }
+    for (uint16_t row = 0; row < t.frame_height; ++row) {
+        if (y[static_cast<size_t>(row) * t.frame_width] != row) {
+            std::cerr << "FAILED: Active field stream test - frame row " << row << " misplaced" << std::endl;
+            return false;
+        }
+    }
+    if (field.is_top_field() || field.frame_row(0) != 1) {
+        std::cerr << "FAILED: Active field stream test - second PAL field should be the bottom field" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Active field stream test" << std::endl;
+    return true;
+}
+
+// Main test runner
+int main() {
+    std::cout << "======================================" << std::endl;
+    std::cout << "Videomancer videomancer_video_model.hpp Tests" << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << std::endl;
+
+    int passed = 0;
+    int total = 0;
+
+    #define RUN_TEST(test_func) \
+        do { \
+            total++; \
+            if (test_func()) { \
+                passed++; \
+            } \
+        } while(0)
+
+    RUN_TEST(test_blanking_bit_exact);
+    RUN_TEST(test_blanking_table);
+    RUN_TEST(test_active_frame_stream);
+    RUN_TEST(test_active_frame_lines);
+    RUN_TEST(test_field_layout);
+    RUN_TEST(test_active_field_stream);
+
+    std::cout << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
+    std::cout << "======================================" << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
@@ -0,0 +1,355 @@
+// Videomancer SDK - Unit Tests for videomancer_virtual_device.hpp
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <lzx/videomancer/videomancer_virtual_device.hpp>
+#include <lzx/videomancer/videomancer_fpga_controller.hpp>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace lzx;
+
+// Manually advanced clock
+class test_clock : public videomancer_clock {
+public:
+    uint64_t time_us = 0;
+    uint64_t now_us() override { return time_us; }
+};
+
+// Program model that replaces luma with rotary pot 1 after a fixed delay
+class level_model : public videomancer_program_model {
+public:
+    void process_line(const uint16_t* registers, videomancer_line& line) override {
+        for (uint16_t x = 0; x < line.width; ++x) {
+            line.y[x] = registers[videomancer_abi_v1_0::register_address::rotary_pot_1];
+        }
+    }
+
+    uint32_t latency_clocks() const override { return 1350; }  // 100 us at 13.5 MHz
+};
+
+// Test one-frame-per-CS decoding and hsync latch semantics
+bool test_register_model() {
+    videomancer_register_model regs;
+    videomancer_fpga_controller controller(regs);
+
+    controller.set_rotary_pot_3(700);
+    if (regs.get_staged_register(2) != 700 || regs.get_active_register(2) != 0 ||
+        regs.pending_mask() != (1u << 2)) {
+        std::cerr << "FAILED: Register model test - write not staged" << std::endl;
+        return false;
+    }
+
+    if (regs.latch_registers() != (1u << 2) || regs.get_active_register(2) != 700 ||
+        regs.pending_mask() != 0) {
+        std::cerr << "FAILED: Register model test - latch incorrect" << std::endl;
+        return false;
+    }
+
+    // Two frames in one CS assertion: only the first is accepted
+    const uint8_t burst[4] = { 0x00, 0x11, 0x04, 0x22 };
+    regs.assert_chip_select_spi(true);
+    regs.transfer_spi(burst, nullptr, 4);
+    regs.assert_chip_select_spi(false);
+
+    // Read frame and short frame are ignored
+    const uint8_t read_frame[2] = { 0x80, 0x00 };
+    regs.assert_chip_select_spi(true);
+    regs.transfer_spi(read_frame, nullptr, 2);
+    regs.assert_chip_select_spi(false);
+    regs.assert_chip_select_spi(true);
+    regs.transfer_spi(read_frame, nullptr, 1);
+    regs.assert_chip_select_spi(false);
+
+    if (regs.get_staged_register(0) != 0x11 || regs.get_staged_register(1) != 0 ||
+        regs.accepted_write_count() != 2 || regs.ignored_frame_count() != 2) {
+        std::cerr << "FAILED: Register model test - CS framing incorrect" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Register model test" << std::endl;
+    return true;
+}
+
+// Test register-to-pixel latency against the NTSC line clock
+bool test_latency_measurement() {
+    test_clock clock;
+    level_model program;
+    videomancer_virtual_device device(clock, &program);
+    videomancer_fpga_controller controller(device.registers());
+
+    device.advance();  // Line 0 at t=0
+
+    // Write mid-line; next line starts at 63.56 us, pixels leave 100 us later
+    clock.time_us = 20;
+    controller.set_rotary_pot_1(300);
+    device.advance();
+    clock.time_us = 200;
+    device.advance();
+
+    const videomancer_latency_stats& lat = device.latency();
+    if (lat.sample_count != 1 || lat.min_us != 143 || lat.max_us != 143 ||
+        device.registers().get_active_register(0) != 300) {
+        std::cerr << "FAILED: Latency test - unexpected latency " << lat.min_us << " us" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Latency measurement test" << std::endl;
+    return true;
+}
+
+// Test that a late advance() latches writes at the line after their arrival
+bool test_latency_catch_up() {
+    test_clock clock;
+    level_model program;
+    videomancer_virtual_device device(clock, &program);
+    videomancer_fpga_controller controller(device.registers());
+
+    device.advance();  // Line 0 at t=0
+
+    // Written after line 2 starts (127.1 us): lines 1 and 2 run without it
+    clock.time_us = 130;
+    controller.set_rotary_pot_1(300);
+    clock.time_us = 150;
+    device.advance();
+    if (device.registers().get_active_register(0) != 0 || device.latency().sample_count != 0) {
+        std::cerr << "FAILED: Catch-up test - write latched before it arrived" << std::endl;
+        return false;
+    }
+
+    // Polled late: line 3 (190.7 us) takes it, pixels leave 100 us later
+    clock.time_us = 400;
+    device.advance();
+    const videomancer_latency_stats& lat = device.latency();
+    if (lat.sample_count != 1 || lat.min_us != 160 || device.registers().get_active_register(0) != 300) {
+        std::cerr << "FAILED: Catch-up test - unexpected latency " << lat.min_us << " us" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Latency catch-up test" << std::endl;
+    return true;
+}
+
+// Test frame rendering through a program model
+bool test_frame_rendering() {
+    const auto& info = videomancer_abi_v1_0::get_video_timing_info(videomancer_abi_v1_0::video_timing_id::ntsc);
+    const size_t samples = static_cast<size_t>(info.frame_width) * info.frame_height;
+    std::vector<uint16_t> y(samples, 0), u(samples, 0), v(samples, 0);
+
+    test_clock clock;
+    level_model program;
+    videomancer_virtual_device device(clock, &program, { y.data(), u.data(), v.data() });
+    videomancer_fpga_controller controller(device.registers());
+    controller.set_rotary_pot_1(940);
+
+    // One full NTSC frame is 33366.7 us
+    clock.time_us = 33367;
+    device.advance();
+
+    if (device.frame_count() != 1 || device.line_count() != 526) {
+        std::cerr << "FAILED: Frame rendering test - expected one frame, got "
+                  << device.line_count() << " lines" << std::endl;
+        return false;
+    }
+
+    for (size_t i = 0; i < samples; ++i) {
+        if (y[i] != 940 || u[i] != 512 || v[i] != 512) {
+            std::cerr << "FAILED: Frame rendering test - sample " << i << " incorrect" << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "PASSED: Frame rendering test" << std::endl;
+    return true;
+}
+
+// Program model that records the frame row and field of each line
+class field_recorder_model : public videomancer_program_model {
+public:
+    std::vector<uint16_t> rows;
+    std::vector<bool> field_n;
+
+    void process_line(const uint16_t*, videomancer_line& line) override {
+        rows.push_back(line.line_number);
+        field_n.push_back(line.field_n);
+    }
+};
+
+// Test that interlaced frames run field by field onto alternate frame rows
+bool test_field_rendering() {
+    const auto& info = videomancer_abi_v1_0::get_video_timing_info(videomancer_abi_v1_0::video_timing_id::ntsc);
+    const size_t samples = static_cast<size_t>(info.frame_width) * info.frame_height;
+    std::vector<uint16_t> y(samples, 0), u(samples, 0), v(samples, 0);
+
+    test_clock clock;
+    field_recorder_model program;
+    videomancer_virtual_device device(clock, &program, { y.data(), u.data(), v.data() });
+    clock.time_us = 33367;
+    device.advance();
+
+    // The advance also runs line 0 of the next frame, so keep only the first frame
+    if (device.field_count() != 2 || program.rows.size() < info.frame_height) {
+        std::cerr << "FAILED: Field rendering test - expected 2 fields, got " << device.field_count() << std::endl;
+        return false;
+    }
+
+    // NTSC is bottom field first: the first field covers the odd rows with field_n low
+    std::vector<int> hits(info.frame_height, 0);
+    program.rows.resize(info.frame_height);
+    const size_t first_field = program.rows.size() / 2;
+    for (size_t i = 0; i < program.rows.size(); ++i) {
+        const bool second = i >= first_field;
+        if (program.field_n[i] != second || (program.rows[i] & 1u) != (second ? 0u : 1u)) {
+            std::cerr << "FAILED: Field rendering test - line " << i << " on row " << program.rows[i] << std::endl;
+            return false;
+        }
+        ++hits[program.rows[i]];
+    }
+    for (uint16_t row = 0; row < info.frame_height; ++row) {
+        if (hits[row] != 1) {
+            std::cerr << "FAILED: Field rendering test - row " << row << " hit " << hits[row] << " times" << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "PASSED: Field rendering test" << std::endl;
+    return true;
+}
+
+#ifdef VIDEOMANCER_VIRTUAL_DEVICE_HAS_SOCKETS
+// Test many virtual units driven through socket pairs
+bool test_socket_units() {
+    const size_t unit_count = 32;
+    test_clock clock;
+
+    struct unit {
+        int fds[2];
+        std::unique_ptr<videomancer_virtual_device> device;
+        std::unique_ptr<videomancer_socket_server> server;
+        std::unique_ptr<videomancer_socket_fpga> client;
+        std::unique_ptr<videomancer_fpga_controller> controller;
+    };
+
+    std::vector<unit> units(unit_count);
+    for (size_t i = 0; i < unit_count; ++i) {
+        unit& u = units[i];
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, u.fds) != 0) {
+            std::cerr << "FAILED: Socket units test - socketpair failed" << std::endl;
+            return false;
+        }
+        u.device = std::make_unique<videomancer_virtual_device>(clock);
+        u.server = std::make_unique<videomancer_socket_server>(u.fds[0], u.device->registers());
+        u.client = std::make_unique<videomancer_socket_fpga>(u.fds[1]);
+        u.controller = std::make_unique<videomancer_fpga_controller>(*u.client);
+    }
+
+    for (size_t i = 0; i < unit_count; ++i) {
+        units[i].controller->set_rotary_pot_1(static_cast<uint16_t>(i * 10));
+        units[i].controller->set_linear_pot_12(static_cast<uint16_t>(1023 - i));
+        units[i].controller->set_video_timing(videomancer_abi_v1_0::video_timing_id::_720p60);
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < unit_count; ++i) {
+        unit& u = units[i];
+        if (u.server->poll_once() <= 0 ||
+            u.device->registers().get_staged_register(0) != i * 10 ||
+            u.device->registers().get_staged_register(7) != 1023 - i ||
+            u.device->registers().get_staged_register(8) != 0xE) {
+            std::cerr << "FAILED: Socket units test - unit " << i << " registers incorrect" << std::endl;
+            ok = false;
+        }
+    }
+
+    // Peer close is reported
+    ::close(units[0].fds[1]);
+    if (units[0].server->poll_once() != -1) {
+        std::cerr << "FAILED: Socket units test - peer close not reported" << std::endl;
+        ok = false;
+    }
+
+    for (size_t i = 0; i < unit_count; ++i) {
+        ::close(units[i].fds[0]);
+        if (i != 0) {
+            ::close(units[i].fds[1]);
+        }
+    }
+
+    if (ok) {
+        std::cout << "PASSED: Socket units test" << std::endl;
+    }
+    return ok;
+}
+
+// Test listen/connect over a filesystem socket
+bool test_socket_listen_connect() {
+    const std::string path = "/tmp/videomancer_test_" + std::to_string(::getpid());
+    const int listen_fd = videomancer_socket_listen(path.c_str());
+    const int client_fd = listen_fd >= 0 ? videomancer_socket_connect(path.c_str()) : -1;
+    const int server_fd = client_fd >= 0 ? ::accept(listen_fd, nullptr, nullptr) : -1;
+    if (server_fd < 0) {
+        std::cerr << "FAILED: Listen/connect test - connection failed" << std::endl;
+        return false;
+    }
+
+    test_clock clock;
+    videomancer_virtual_device device(clock);
+    videomancer_socket_server server(server_fd, device.registers());
+    videomancer_socket_fpga spi(client_fd);
+    videomancer_fpga_controller controller(spi);
+    controller.set_toggle_switches(0x15);
+
+    const bool ok = server.poll_once() > 0 && device.registers().get_staged_register(6) == 0x15;
+
+    ::close(server_fd);
+    ::close(client_fd);
+    ::close(listen_fd);
+    ::unlink(path.c_str());
+
+    if (!ok) {
+        std::cerr << "FAILED: Listen/connect test - write not received" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Listen/connect test" << std::endl;
+    return true;
+}
+#endif
+
+// Main test runner
+int main() {
+    std::cout << "======================================" << std::endl;
+    std::cout << "Videomancer videomancer_virtual_device.hpp Tests" << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << std::endl;
+
+    int passed = 0;
+    int total = 0;
+
+    #define RUN_TEST(test_func) \
+        do { \
+            total++; \
+            if (test_func()) { \
+                passed++; \
+            } \
+        } while(0)
+
+    RUN_TEST(test_register_model);
+    RUN_TEST(test_latency_measurement);
+    RUN_TEST(test_latency_catch_up);
+    RUN_TEST(test_frame_rendering);
+    RUN_TEST(test_field_rendering);
+#ifdef VIDEOMANCER_VIRTUAL_DEVICE_HAS_SOCKETS
+    RUN_TEST(test_socket_units);
+    RUN_TEST(test_socket_listen_connect);
+#endif
+
+    std::cout << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
+    std::cout << "======================================" << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
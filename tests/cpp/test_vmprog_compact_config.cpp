@@ -0,0 +1,439 @@
+// Videomancer SDK - Unit Tests for vmprog_compact_config.hpp
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <lzx/videomancer/vmprog_compact_config.hpp>
+#include <lzx/videomancer/vmprog_parameter_utils.hpp>
+#include "test_vmprog_package.hpp"
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace lzx;
+
+class memory_stream : public vmprog_stream {
+public:
+    std::vector<uint8_t> data;
+    size_t position = 0;
+
+    size_t read(uint8_t* buffer, size_t size) override {
+        if (position >= data.size()) return 0;
+        size_t n = (size < data.size() - position) ? size : data.size() - position;
+        memcpy(buffer, data.data() + position, n);
+        position += n;
+        return n;
+    }
+
+    bool seek(size_t offset) override {
+        if (offset > data.size()) return false;
+        position = offset;
+        return true;
+    }
+};
+
+static void add_parameter(vmprog_program_config_v1_0& config, vmprog_parameter_id_v1_0 id, const char* name,
+                          int16_t display_min, int16_t display_max, const char* suffix) {
+    vmprog_parameter_config_v1_0& param = config.parameters[config.parameter_count++];
+    init_parameter_config(param);
+    param.parameter_id = id;
+    param.max_value = 1023;
+    param.initial_value = 512;
+    param.display_min_value = display_min;
+    param.display_max_value = display_max;
+    param.display_float_digits = 1;
+    safe_strncpy(param.name_label, name, sizeof(param.name_label));
+    safe_strncpy(param.suffix_label, suffix, sizeof(param.suffix_label));
+}
+
+// Config shaped like programs/yuv_amplifier
+static vmprog_program_config_v1_0 make_config() {
+    vmprog_program_config_v1_0 config;
+    init_vmprog_config(config);
+    safe_strncpy(config.program_id, "com.lzxindustries.yuv_amplifier", sizeof(config.program_id));
+    safe_strncpy(config.program_name, "YUV Amplifier", sizeof(config.program_name));
+    safe_strncpy(config.author, "Lars Larsen", sizeof(config.author));
+    safe_strncpy(config.license, "GPL-3.0", sizeof(config.license));
+    safe_strncpy(config.category, "Video Processing", sizeof(config.category));
+    safe_strncpy(config.description, "YUV Amplifier video processing program", sizeof(config.description));
+    config.program_version_major = 1;
+
+    add_parameter(config, vmprog_parameter_id_v1_0::rotary_potentiometer_1, "Y Gain", 0, 200, "%");
+    add_parameter(config, vmprog_parameter_id_v1_0::rotary_potentiometer_2, "U Gain", 0, 200, "%");
+    add_parameter(config, vmprog_parameter_id_v1_0::rotary_potentiometer_4, "Y Offset", -100, 100, "%");
+    add_parameter(config, vmprog_parameter_id_v1_0::rotary_potentiometer_5, "Offset", -100, 100, "%");
+    config.parameters[3].control_mode = vmprog_parameter_control_mode_v1_0::sine_in_out;
+
+    add_parameter(config, vmprog_parameter_id_v1_0::toggle_switch_7, "Y Invert", 0, 0, "");
+    vmprog_parameter_config_v1_0& toggle = config.parameters[config.parameter_count - 1];
+    toggle.max_value = 1;
+    toggle.initial_value = 0;
+    toggle.value_label_count = 2;
+    safe_strncpy(toggle.value_labels[0], "Off", sizeof(toggle.value_labels[0]));
+    safe_strncpy(toggle.value_labels[1], "On", sizeof(toggle.value_labels[1]));
+
+    add_parameter(config, vmprog_parameter_id_v1_0::toggle_switch_8, "U Invert", 0, 0, "");
+    config.parameters[config.parameter_count - 1] = toggle;
+    config.parameters[config.parameter_count - 1].parameter_id = vmprog_parameter_id_v1_0::toggle_switch_8;
+    safe_strncpy(config.parameters[config.parameter_count - 1].name_label, "U Invert", 32);
+    return config;
+}
+
+// Test that encoding and expanding gives back the same config
+bool test_round_trip() {
+    const vmprog_program_config_v1_0 config = make_config();
+    uint8_t payload[vmprog_compact_config_max_size];
+    const uint32_t size = encode_vmprog_compact_config(config, payload, sizeof(payload));
+    if (size == 0 || size > 512) {
+        std::cerr << "FAILED: Compact size " << size << std::endl;
+        return false;
+    }
+
+    vmprog_compact_config_view view;
+    if (view.open(payload, size) != vmprog_validation_result::ok || view.parameter_count() != 6 ||
+        strcmp(view.program_name(), "YUV Amplifier") != 0 || view.url()[0] != '\0') {
+        std::cerr << "FAILED: View" << std::endl;
+        return false;
+    }
+
+    vmprog_program_config_v1_0 expanded;
+    memset(&expanded, 0xA5, sizeof(expanded));
+    view.expand(expanded);
+    if (memcmp(&expanded, &config, sizeof(config)) != 0 || !is_compact_config_match(payload, config)) {
+        std::cerr << "FAILED: Expanded config differs" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Round trip test (" << size << " of " << sizeof(config) << " bytes)" << std::endl;
+    return true;
+}
+
+// Test that parameter views work with the parameter utilities
+bool test_parameter_views() {
+    const vmprog_program_config_v1_0 config = make_config();
+    uint8_t payload[vmprog_compact_config_max_size];
+    vmprog_compact_config_view view;
+    view.open(payload, encode_vmprog_compact_config(config, payload, sizeof(payload)));
+
+    for (uint32_t i = 0; i < config.parameter_count; ++i) {
+        const vmprog_compact_parameter_view param = view.parameter(i);
+        for (int32_t value = 0; value < 1024; value += 7) {
+            char expected[32];
+            char actual[32];
+            generate_parameter_value_display_string(value, config.parameters[i], expected, sizeof(expected));
+            generate_parameter_value_display_string(value, param, actual, sizeof(actual));
+            if (strcmp(expected, actual) != 0 ||
+                apply_parameter_control_curve_and_scaling(value, config.parameters[i]) !=
+                    apply_parameter_control_curve_and_scaling(value, param)) {
+                std::cerr << "FAILED: Parameter " << i << " value " << value << ": " << actual << std::endl;
+                return false;
+            }
+        }
+    }
+
+    // Shared strings are stored once: "%" suffixes, "Off"/"On", and "Offset" reuses "Y Offset"
+    vmprog_compact_parameter_view a, b, c, d, y_offset, unused;
+    if (!view.find_parameter(vmprog_parameter_id_v1_0::rotary_potentiometer_1, a) ||
+        !view.find_parameter(vmprog_parameter_id_v1_0::rotary_potentiometer_5, b) ||
+        !view.find_parameter(vmprog_parameter_id_v1_0::toggle_switch_7, c) ||
+        !view.find_parameter(vmprog_parameter_id_v1_0::toggle_switch_8, d) ||
+        !view.find_parameter(vmprog_parameter_id_v1_0::rotary_potentiometer_4, y_offset) ||
+        view.find_parameter(vmprog_parameter_id_v1_0::linear_potentiometer_12, unused)) {
+        std::cerr << "FAILED: find_parameter" << std::endl;
+        return false;
+    }
+    if (a.suffix_label != b.suffix_label || c.value_labels[1] != d.value_labels[1] ||
+        b.name_label != y_offset.name_label + 2 || strcmp(d.value_labels[0], "Off") != 0) {
+        std::cerr << "FAILED: Strings not shared" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Parameter view test" << std::endl;
+    return true;
+}
+
+// Test that malformed payloads are rejected
+bool test_validation() {
+    const vmprog_program_config_v1_0 config = make_config();
+    uint8_t payload[vmprog_compact_config_max_size];
+    const uint32_t size = encode_vmprog_compact_config(config, payload, sizeof(payload));
+
+    struct mutation {
+        const char* name;
+        void (*apply)(uint8_t* data, uint32_t size);
+        vmprog_validation_result expected;
+    };
+    const mutation mutations[] = {
+        { "magic", [](uint8_t* d, uint32_t) { d[0] ^= 1; }, vmprog_validation_result::invalid_magic },
+        { "string offset", [](uint8_t* d, uint32_t) {
+              reinterpret_cast<vmprog_compact_config_header_v1_0*>(d)->author = 0xFFF0; },
+          vmprog_validation_result::string_not_terminated },
+        { "table end", [](uint8_t* d, uint32_t size) { d[size - 1] = 'x'; },
+          vmprog_validation_result::string_not_terminated },
+        { "label range", [](uint8_t* d, uint32_t) {
+              reinterpret_cast<vmprog_compact_parameter_v1_0*>(d + sizeof(vmprog_compact_config_header_v1_0))[5].first_value_label = 3; },
+          vmprog_validation_result::invalid_value_label_count },
+        { "suffix length", [](uint8_t* d, uint32_t) {
+              // Point a suffix at "YUV Amplifier", which does not fit the 4-byte field
+              auto* h = reinterpret_cast<vmprog_compact_config_header_v1_0*>(d);
+              reinterpret_cast<vmprog_compact_parameter_v1_0*>(d + sizeof(vmprog_compact_config_header_v1_0))[0].suffix_label = h->program_name; },
+          vmprog_validation_result::string_not_terminated },
+        { "initial value", [](uint8_t* d, uint32_t) {
+              reinterpret_cast<vmprog_compact_parameter_v1_0*>(d + sizeof(vmprog_compact_config_header_v1_0))[0].initial_value = 2000; },
+          vmprog_validation_result::invalid_parameter_values },
+        { "control mode", [](uint8_t* d, uint32_t) {
+              reinterpret_cast<vmprog_compact_parameter_v1_0*>(d + sizeof(vmprog_compact_config_header_v1_0))[0].control_mode = 36; },
+          vmprog_validation_result::invalid_enum_value },
+        { "reserved", [](uint8_t* d, uint32_t) {
+              reinterpret_cast<vmprog_compact_config_header_v1_0*>(d)->reserved[1] = 1; },
+          vmprog_validation_result::reserved_field_not_zero },
+    };
+
+    for (const mutation& m : mutations) {
+        uint8_t copy[vmprog_compact_config_max_size];
+        memcpy(copy, payload, size);
+        m.apply(copy, size);
+        vmprog_compact_config_view view;
+        if (view.open(copy, size) != m.expected || view.is_open()) {
+            std::cerr << "FAILED: Mutation '" << m.name << "' not rejected" << std::endl;
+            return false;
+        }
+    }
+
+    vmprog_compact_config_view view;
+    if (view.open(payload, size - 1) != vmprog_validation_result::invalid_file_size ||
+        view.open(payload, 10) != vmprog_validation_result::invalid_file_size) {
+        std::cerr << "FAILED: Truncated payload accepted" << std::endl;
+        return false;
+    }
+
+    // Encoder refuses invalid configs and short buffers
+    vmprog_program_config_v1_0 invalid = config;
+    invalid.program_name[0] = '\0';
+    if (encode_vmprog_compact_config(invalid, payload, sizeof(payload)) != 0 ||
+        encode_vmprog_compact_config(config, payload, size - 1) != 0) {
+        std::cerr << "FAILED: Encoder accepted bad input" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Validation test" << std::endl;
+    return true;
+}
+
+// Test a package carrying both encodings
+bool test_package() {
+    const vmprog_program_config_v1_0 config = make_config();
+    uint8_t compact[vmprog_compact_config_max_size];
+    const uint32_t compact_size = encode_vmprog_compact_config(config, compact, sizeof(compact));
+
+    const uint32_t toc_count = 2;
+    const uint32_t config_offset = sizeof(vmprog_header_v1_0) + toc_count * sizeof(vmprog_toc_entry_v1_0);
+    const uint32_t compact_offset = config_offset + sizeof(config);
+    memory_stream stream;
+    stream.data.resize(compact_offset + compact_size);
+
+    vmprog_header_v1_0 header;
+    init_vmprog_header(header);
+    header.file_size = static_cast<uint32_t>(stream.data.size());
+    header.toc_offset = sizeof(vmprog_header_v1_0);
+    header.toc_bytes = toc_count * sizeof(vmprog_toc_entry_v1_0);
+    header.toc_count = toc_count;
+
+    vmprog_toc_entry_v1_0 toc[2];
+    init_toc_entry(toc[0]);
+    toc[0].type = vmprog_toc_entry_type_v1_0::config;
+    toc[0].offset = config_offset;
+    toc[0].size = sizeof(config);
+    sha256_oneshot(reinterpret_cast<const uint8_t*>(&config), sizeof(config), toc[0].sha256);
+    init_toc_entry(toc[1]);
+    toc[1].type = vmprog_toc_entry_type_v1_0::config_compact;
+    toc[1].offset = compact_offset;
+    toc[1].size = compact_size;
+    sha256_oneshot(compact, compact_size, toc[1].sha256);
+
+    memcpy(stream.data.data(), &header, sizeof(header));
+    memcpy(stream.data.data() + header.toc_offset, toc, sizeof(toc));
+    memcpy(stream.data.data() + config_offset, &config, sizeof(config));
+    memcpy(stream.data.data() + compact_offset, compact, compact_size);
+
+    if (validate_vmprog_package(stream.data.data(), header.file_size) != vmprog_validation_result::ok) {
+        std::cerr << "FAILED: Package with compact config rejected" << std::endl;
+        return false;
+    }
+
+    // Reads check the payload against the signed descriptor artifact
+    vmprog_signed_descriptor_v1_0 descriptor;
+    init_signed_descriptor(descriptor);
+    descriptor.artifact_count = 1;
+    descriptor.artifacts[0].type = vmprog_toc_entry_type_v1_0::config_compact;
+    memcpy(descriptor.artifacts[0].sha256, toc[1].sha256, 32);
+    vmprog_signed_descriptor_v1_0 no_compact;
+    init_signed_descriptor(no_compact);
+
+    uint8_t buffer[512];
+    vmprog_compact_config_view view;
+    if (read_vmprog_compact_config(stream, toc[1], descriptor, buffer, sizeof(buffer), view) != vmprog_validation_result::ok ||
+        strcmp(view.program_id(), config.program_id) != 0) {
+        std::cerr << "FAILED: Stream read" << std::endl;
+        return false;
+    }
+    if (read_vmprog_compact_config(stream, toc[0], descriptor, buffer, sizeof(buffer), view) != vmprog_validation_result::invalid_toc_entry ||
+        read_vmprog_compact_config(stream, toc[1], descriptor, buffer, 64, view) != vmprog_validation_result::invalid_payload_offset ||
+        read_vmprog_compact_config(stream, toc[1], no_compact, buffer, sizeof(buffer), view) != vmprog_validation_result::invalid_toc_entry) {
+        std::cerr << "FAILED: Wrong entry, small buffer or unsigned payload accepted" << std::endl;
+        return false;
+    }
+
+    // A compact config that decodes to a different config fails the package
+    auto* packed_config = reinterpret_cast<vmprog_program_config_v1_0*>(stream.data.data() + config_offset);
+    packed_config->parameters[1].initial_value = 600;
+    const vmprog_validation_result changed_value = validate_vmprog_package(stream.data.data(), header.file_size, false);
+    packed_config->parameters[1].initial_value = 512;
+    packed_config->description[60] = 'x';
+    const vmprog_validation_result string_padding = validate_vmprog_package(stream.data.data(), header.file_size, false);
+    packed_config->description[60] = '\0';
+    packed_config->parameters[4].value_labels[2][0] = 'x';
+    const vmprog_validation_result extra_label = validate_vmprog_package(stream.data.data(), header.file_size, false);
+    packed_config->parameters[4].value_labels[2][0] = '\0';
+    if (changed_value != vmprog_validation_result::invalid_toc_entry ||
+        string_padding != vmprog_validation_result::invalid_toc_entry ||
+        extra_label != vmprog_validation_result::invalid_toc_entry ||
+        validate_vmprog_package(stream.data.data(), header.file_size) != vmprog_validation_result::ok) {
+        std::cerr << "FAILED: Mismatched compact config accepted" << std::endl;
+        return false;
+    }
+
+    // A bad compact payload fails the whole package, and its hash check fails on read
+    stream.data[compact_offset + compact_size - 1] = 'x';
+    if (validate_vmprog_package(stream.data.data(), header.file_size, false) != vmprog_validation_result::string_not_terminated ||
+        read_vmprog_compact_config(stream, toc[1], descriptor, buffer, sizeof(buffer), view) != vmprog_validation_result::invalid_hash) {
+        std::cerr << "FAILED: Corrupt compact config accepted" << std::endl;
+        return false;
+    }
+
+    // Signed descriptors may list the compact config as an artifact
+    vmprog_artifact_hash_v1_0 artifact;
+    memset(&artifact, 0, sizeof(artifact));
+    artifact.type = vmprog_toc_entry_type_v1_0::config_compact;
+    if (validate_vmprog_artifact_hash_v1_0(artifact) != vmprog_validation_result::ok) {
+        std::cerr << "FAILED: Compact config artifact rejected" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Package test" << std::endl;
+    return true;
+}
+
+// Signed package with both encodings, checked by the stream validators
+static std::vector<uint8_t> create_compact_package(const test_keys& keys, const vmprog_program_config_v1_0& compact_source,
+                                                   bool sign_compact) {
+    test_package_spec spec;
+    spec.variants = { vmprog_toc_entry_type_v1_0::bitstream_sd_analog };
+    spec.bitstream_size = 1024;
+    spec.compact_config.resize(vmprog_compact_config_max_size);
+    spec.compact_config.resize(encode_vmprog_compact_config(compact_source, spec.compact_config.data(),
+                                                            vmprog_compact_config_max_size));
+    spec.sign_compact_config = sign_compact;
+    return create_test_package(keys, spec);
+}
+
+// Test the compact config checks of the stream and selective validators
+bool test_signed_package_stream() {
+    const test_keys keys(0x60);
+    const vmprog_program_config_v1_0 config = create_test_config(test_package_spec());
+    const vmprog_toc_entry_type_v1_0 variant = vmprog_toc_entry_type_v1_0::bitstream_sd_analog;
+    static uint8_t scratch[sizeof(vmprog_program_config_v1_0)];  // Whole-payload hashing reads the fixed config
+    vmprog_program_config_v1_0 out_config;
+
+    memory_stream stream;
+    stream.data = create_compact_package(keys, config, true);
+    uint32_t file_size = static_cast<uint32_t>(stream.data.size());
+    if (validate_vmprog_package_stream(stream, file_size, true, true, keys.public_key, scratch, sizeof(scratch)) !=
+            vmprog_validation_result::ok ||
+        validate_vmprog_package_selective_stream(stream, file_size, variant, keys.public_key, scratch, sizeof(scratch),
+                                                 out_config) != vmprog_validation_result::ok) {
+        std::cerr << "FAILED: Signed package with compact config rejected" << std::endl;
+        return false;
+    }
+
+    // A browser reads the compact config with the descriptor it verified
+    const auto* toc = reinterpret_cast<const vmprog_toc_entry_v1_0*>(stream.data.data() + sizeof(vmprog_header_v1_0));
+    vmprog_signed_descriptor_v1_0 descriptor;
+    uint8_t buffer[512];
+    vmprog_compact_config_view view;
+    if (read_and_verify_signed_descriptor_stream(stream, toc, 5, keys.public_key, descriptor) != vmprog_validation_result::ok ||
+        read_vmprog_compact_config(stream, toc[4], descriptor, buffer, sizeof(buffer), view) != vmprog_validation_result::ok ||
+        strcmp(view.program_name(), config.program_name) != 0) {
+        std::cerr << "FAILED: Compact config read with verified descriptor" << std::endl;
+        return false;
+    }
+
+    // The compact config must fit the scratch buffer
+    if (validate_vmprog_package_stream(stream, file_size, false, false, nullptr, nullptr, 0) !=
+            vmprog_validation_result::invalid_file_size ||
+        validate_vmprog_package_selective_stream(stream, file_size, variant, keys.public_key, scratch, 64, out_config) !=
+            vmprog_validation_result::invalid_file_size) {
+        std::cerr << "FAILED: Compact config read past scratch buffer" << std::endl;
+        return false;
+    }
+
+    // Signed and hashed, but decoding to a different config
+    vmprog_program_config_v1_0 other = config;
+    safe_strncpy(other.parameters[0].name_label, "Hue", sizeof(other.parameters[0].name_label));
+    stream.data = create_compact_package(keys, other, true);
+    file_size = static_cast<uint32_t>(stream.data.size());
+    if (validate_vmprog_package_stream(stream, file_size, true, true, keys.public_key, scratch, sizeof(scratch)) !=
+            vmprog_validation_result::invalid_toc_entry ||
+        validate_vmprog_package_selective_stream(stream, file_size, variant, keys.public_key, scratch, sizeof(scratch),
+                                                 out_config) != vmprog_validation_result::invalid_toc_entry) {
+        std::cerr << "FAILED: Mismatched compact config accepted by stream validators" << std::endl;
+        return false;
+    }
+
+    // Correct, but left out of the descriptor: only the signature checks notice
+    stream.data = create_compact_package(keys, config, false);
+    file_size = static_cast<uint32_t>(stream.data.size());
+    if (validate_vmprog_package_stream(stream, file_size, true, false, nullptr, scratch, sizeof(scratch)) !=
+            vmprog_validation_result::ok ||
+        validate_vmprog_package_stream(stream, file_size, true, true, keys.public_key, scratch, sizeof(scratch)) !=
+            vmprog_validation_result::invalid_toc_entry ||
+        validate_vmprog_package_selective_stream(stream, file_size, variant, keys.public_key, scratch, sizeof(scratch),
+                                                 out_config) != vmprog_validation_result::invalid_toc_entry) {
+        std::cerr << "FAILED: Unsigned compact config accepted" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Signed package stream test" << std::endl;
+    return true;
+}
+
+// Main test runner
+int main() {
+    std::cout << "======================================" << std::endl;
+    std::cout << "Videomancer vmprog_compact_config.hpp Tests" << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << std::endl;
+
+    int passed = 0;
+    int total = 0;
+
+    #define RUN_TEST(test_func) \
+        do { \
+            total++; \
+            if (test_func()) { \
+                passed++; \
+            } \
+        } while(0)
+
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_parameter_views);
+    RUN_TEST(test_validation);
+    RUN_TEST(test_package);
+    RUN_TEST(test_signed_package_stream);
+
+    std::cout << std::endl;
+    std::cout << "======================================" << std::endl;
+    std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
+    std::cout << "======================================" << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
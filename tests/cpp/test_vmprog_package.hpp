@@ -0,0 +1,147 @@
+// Videomancer SDK - Shared vmprog Package Fixtures for Unit Tests
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <lzx/videomancer/vmprog_format.hpp>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Test key pair derived from a fixed seed
+struct test_keys {
+    uint8_t secret_key[64];
+    uint8_t public_key[32];
+
+    explicit test_keys(uint8_t seed_base = 0x40) {
+        uint8_t seed[32];
+        for (int i = 0; i < 32; i++) seed[i] = static_cast<uint8_t>(seed_base + i);
+        lzx::crypto_ed25519_key_pair(secret_key, public_key, seed);
+    }
+};
+
+// Bitstream payload with a deterministic pattern; different salts give different contents
+inline std::vector<uint8_t> make_test_bitstream(uint32_t size, uint8_t salt) {
+    std::vector<uint8_t> bitstream(size);
+    for (uint32_t i = 0; i < size; ++i) bitstream[i] = static_cast<uint8_t>(i * 11 + salt);
+    return bitstream;
+}
+
+// What create_test_package() puts in the package
+struct test_package_spec {
+    const char* program_id = "test.package";
+    const char* program_name = "Test Package";
+    uint32_t bitstream_size = 4096;
+    // Bitstream i uses make_test_bitstream(bitstream_size, salt + i), or this payload when set
+    std::vector<uint8_t> bitstream;
+    std::vector<lzx::vmprog_toc_entry_type_v1_0> variants = { lzx::vmprog_toc_entry_type_v1_0::bitstream_hd_analog };
+    // The descriptor lists the first signed_variants bitstreams; the rest are in the TOC only
+    size_t signed_variants = SIZE_MAX;
+    uint8_t salt = 0;
+    bool sign = true;
+    bool package_hash = false;
+    // config_compact payload placed after the bitstreams when set, signed unless sign_compact_config is false
+    std::vector<uint8_t> compact_config;
+    bool sign_compact_config = true;
+};
+
+// Config with one "Gain" parameter on rotary pot 1
+inline lzx::vmprog_program_config_v1_0 create_test_config(const test_package_spec& spec) {
+    using namespace lzx;
+
+    vmprog_program_config_v1_0 config;
+    init_vmprog_config(config);
+    safe_strncpy(config.program_id, spec.program_id, sizeof(config.program_id));
+    safe_strncpy(config.program_name, spec.program_name, sizeof(config.program_name));
+    config.parameter_count = 1;
+    init_parameter_config(config.parameters[0]);
+    config.parameters[0].parameter_id = vmprog_parameter_id_v1_0::rotary_potentiometer_1;
+    safe_strncpy(config.parameters[0].name_label, "Gain", sizeof(config.parameters[0].name_label));
+    return config;
+}
+
+// Package with config, descriptor, signature, one bitstream per variant and the optional compact
+// config, in that order. The config comes from create_test_config() and the descriptor signs the
+// bitstreams spec.signed_variants allows (all of them by default).
+inline std::vector<uint8_t> create_test_package(const test_keys& keys, const test_package_spec& spec) {
+    using namespace lzx;
+
+    const vmprog_program_config_v1_0 config = create_test_config(spec);
+
+    std::vector<std::vector<uint8_t>> bitstreams;
+    for (size_t i = 0; i < spec.variants.size(); ++i) {
+        bitstreams.push_back(spec.bitstream.empty()
+            ? make_test_bitstream(spec.bitstream_size, static_cast<uint8_t>(spec.salt + i))
+            : spec.bitstream);
+    }
+
+    vmprog_signed_descriptor_v1_0 descriptor;
+    init_signed_descriptor(descriptor);
+    sha256_oneshot(reinterpret_cast<const uint8_t*>(&config), sizeof(config), descriptor.config_sha256);
+    const size_t signed_count = spec.signed_variants < spec.variants.size() ? spec.signed_variants : spec.variants.size();
+    descriptor.artifact_count = static_cast<uint8_t>(signed_count);
+    for (size_t i = 0; i < signed_count; ++i) {
+        descriptor.artifacts[i].type = spec.variants[i];
+        sha256_oneshot(bitstreams[i].data(), static_cast<uint32_t>(bitstreams[i].size()), descriptor.artifacts[i].sha256);
+    }
+    if (!spec.compact_config.empty() && spec.sign_compact_config) {
+        vmprog_artifact_hash_v1_0& artifact = descriptor.artifacts[descriptor.artifact_count++];
+        artifact.type = vmprog_toc_entry_type_v1_0::config_compact;
+        sha256_oneshot(spec.compact_config.data(), static_cast<uint32_t>(spec.compact_config.size()), artifact.sha256);
+    }
+
+    uint8_t signature[64];
+    crypto_ed25519_sign(signature, keys.secret_key, reinterpret_cast<const uint8_t*>(&descriptor), sizeof(descriptor));
+
+    std::vector<const uint8_t*> payloads = {
+        reinterpret_cast<const uint8_t*>(&config), reinterpret_cast<const uint8_t*>(&descriptor), signature,
+    };
+    std::vector<vmprog_toc_entry_type_v1_0> types = {
+        vmprog_toc_entry_type_v1_0::config, vmprog_toc_entry_type_v1_0::signed_descriptor,
+        vmprog_toc_entry_type_v1_0::signature,
+    };
+    std::vector<uint32_t> sizes = { sizeof(config), sizeof(descriptor), 64 };
+    for (size_t i = 0; i < spec.variants.size(); ++i) {
+        payloads.push_back(bitstreams[i].data());
+        types.push_back(spec.variants[i]);
+        sizes.push_back(static_cast<uint32_t>(bitstreams[i].size()));
+    }
+    if (!spec.compact_config.empty()) {
+        payloads.push_back(spec.compact_config.data());
+        types.push_back(vmprog_toc_entry_type_v1_0::config_compact);
+        sizes.push_back(static_cast<uint32_t>(spec.compact_config.size()));
+    }
+
+    const uint32_t toc_count = static_cast<uint32_t>(payloads.size());
+    const uint32_t toc_bytes = toc_count * sizeof(vmprog_toc_entry_v1_0);
+    std::vector<vmprog_toc_entry_v1_0> toc(toc_count);
+    uint32_t offset = sizeof(vmprog_header_v1_0) + toc_bytes;
+    for (uint32_t i = 0; i < toc_count; ++i) {
+        init_toc_entry(toc[i]);
+        toc[i].type = types[i];
+        toc[i].offset = offset;
+        toc[i].size = sizes[i];
+        sha256_oneshot(payloads[i], sizes[i], toc[i].sha256);
+        offset += sizes[i];
+    }
+
+    vmprog_header_v1_0 header;
+    init_vmprog_header(header);
+    header.flags = spec.sign ? vmprog_header_flags_v1_0::signed_pkg : vmprog_header_flags_v1_0::none;
+    header.file_size = offset;
+    header.toc_offset = sizeof(vmprog_header_v1_0);
+    header.toc_count = toc_count;
+    header.toc_bytes = toc_bytes;
+
+    std::vector<uint8_t> package(offset);
+    memcpy(package.data(), &header, sizeof(header));
+    memcpy(package.data() + header.toc_offset, toc.data(), toc_bytes);
+    for (uint32_t i = 0; i < toc_count; ++i) {
+        memcpy(package.data() + toc[i].offset, payloads[i], sizes[i]);
+    }
+    if (spec.package_hash) {
+        calculate_package_sha256(package.data(), offset, package.data() + offsetof(vmprog_header_v1_0, sha256_package));
+    }
+    return package;
+}
@@ -0,0 +1,276 @@
+// Videomancer SDK - Unit Tests for vmprog_package_installer.hpp
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <lzx/videomancer/vmprog_package_installer.hpp>
+#include "test_vmprog_package.hpp"
+#include <iostream>
+#include <cstring>
+#include <vector>
+
+using namespace lzx;
+
+// Install target that records every write into a staging copy
+class memory_target : public vmprog_install_target {
+public:
+    std::vector<uint8_t> staged;
+    std::vector<uint8_t> installed;
+    std::vector<uint32_t> write_offsets;
+    std::vector<uint32_t> write_sizes;
+    uint32_t capacity = 1u << 20;
+    bool began = false;
+    bool aborted = false;
+    bool committed = false;
+
+    bool begin(uint32_t size) override {
+        began = true;
+        if (size > capacity) return false;
+        staged.assign(size, 0xFF);
+        return true;
+    }
+
+    bool write(uint32_t offset, const uint8_t* data, uint32_t size) override {
+        if (offset + size > staged.size()) return false;
+        memcpy(staged.data() + offset, data, size);
+        write_offsets.push_back(offset);
+        write_sizes.push_back(size);
+        return true;
+    }
+
+    bool commit() override {
+        installed = staged;
+        committed = true;
+        return true;
+    }
+
+    void abort() override { aborted = true; }
+};
+
+// Package with config, descriptor, signature and one bitstream
+static std::vector<uint8_t> create_package(const test_keys& keys, uint32_t bitstream_size,
+                                           bool sign = true, bool package_hash = false) {
+    test_package_spec spec;
+    spec.program_id = "test.install";
+    spec.program_name = "Install Test";
+    spec.bitstream_size = bitstream_size;
+    spec.sign = sign;
+    spec.package_hash = package_hash;
+    return create_test_package(keys, spec);
+}
+
+// Feed a package in fixed-size chunks, stopping early once the installer leaves receiving
+static vmprog_install_state feed_chunks(vmprog_package_installer& installer, const std::vector<uint8_t>& package,
+                                        uint32_t chunk) {
+    vmprog_install_state state = installer.state();
+    for (uint32_t offset = 0; offset < package.size() && state == vmprog_install_state::receiving; offset += chunk) {
+        const uint32_t n = (chunk < package.size() - offset) ? chunk : static_cast<uint32_t>(package.size() - offset);
+        state = installer.feed(package.data() + offset, n);
+    }
+    return state;
+}
+
+// Test installation for several transport chunk sizes
+bool test_install_chunked() {
+    const test_keys keys;
+    const std::vector<uint8_t> package = create_package(keys, 20000, true, true);
+    const uint32_t sector_size = 4096;
+    uint8_t sector[sector_size];
+    vmprog_package_installer installer(sector, sector_size);
+
+    const uint32_t chunks[] = { 1, 7, 64, 1000, 4096, static_cast<uint32_t>(package.size()) };
+    for (uint32_t chunk : chunks) {
+        memory_target target;
+        installer.begin(target, keys.public_key);
+        if (feed_chunks(installer, package, chunk) != vmprog_install_state::committed || !target.committed) {
+            std::cerr << "FAILED: Chunked install test - chunk " << chunk << " result "
+                      << static_cast<int>(installer.result()) << std::endl;
+            return false;
+        }
+        if (target.installed != package || target.aborted) {
+            std::cerr << "FAILED: Chunked install test - installed data differs (chunk " << chunk << ")" << std::endl;
+            return false;
+        }
+
+        // Every write is one aligned sector except the last
+        for (size_t i = 0; i < target.write_offsets.size(); ++i) {
+            const bool last = i + 1 == target.write_offsets.size();
+            if (target.write_offsets[i] != i * sector_size ||
+                (!last && target.write_sizes[i] != sector_size) ||
+                target.write_sizes[i] > sector_size) {
+                std::cerr << "FAILED: Chunked install test - unaligned write " << i << std::endl;
+                return false;
+            }
+        }
+        if (std::strcmp(installer.config().program_id, "test.install") != 0) {
+            std::cerr << "FAILED: Chunked install test - config not captured" << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "PASSED: Chunked install test" << std::endl;
+    return true;
+}
+
+// Test that corruption is caught mid-transfer and nothing commits
+bool test_install_tampered() {
+    const test_keys keys;
+    std::vector<uint8_t> package = create_package(keys, 20000);
+    uint8_t sector[1024];
+    vmprog_package_installer installer(sector, sizeof(sector));
+
+    // Flip a byte early in the bitstream: rejected at the end of that payload
+    const vmprog_toc_entry_v1_0* toc = reinterpret_cast<const vmprog_toc_entry_v1_0*>(package.data() + 64);
+    const uint32_t bitstream_offset = toc[3].offset;
+    package[bitstream_offset + 10] ^= 0x01;
+
+    memory_target target;
+    installer.begin(target, keys.public_key);
+    if (feed_chunks(installer, package, 512) != vmprog_install_state::failed ||
+        installer.result() != vmprog_validation_result::invalid_hash) {
+        std::cerr << "FAILED: Tampered install test - corrupt bitstream accepted" << std::endl;
+        return false;
+    }
+    if (target.committed || !target.aborted) {
+        std::cerr << "FAILED: Tampered install test - target not aborted" << std::endl;
+        return false;
+    }
+
+    // Wrong key: rejected once the signature arrives, before the bitstream
+    test_keys other;
+    other.public_key[0] ^= 0xFF;
+    const std::vector<uint8_t> clean = create_package(keys, 20000);
+    memory_target target2;
+    installer.begin(target2, other.public_key);
+    if (feed_chunks(installer, clean, 64) != vmprog_install_state::failed ||
+        installer.bytes_received() > bitstream_offset) {
+        std::cerr << "FAILED: Tampered install test - bad signature not rejected early ("
+                  << installer.bytes_received() << " bytes)" << std::endl;
+        return false;
+    }
+    if (target2.committed || !target2.aborted) {
+        std::cerr << "FAILED: Tampered install test - target not aborted on bad signature" << std::endl;
+        return false;
+    }
+
+    // Corrupt package hash: rejected at the final byte
+    std::vector<uint8_t> hashed = create_package(keys, 3000, true, true);
+    hashed[40] ^= 0x01;
+    memory_target target3;
+    installer.begin(target3, keys.public_key);
+    if (feed_chunks(installer, hashed, 256) != vmprog_install_state::failed || target3.committed) {
+        std::cerr << "FAILED: Tampered install test - bad package hash accepted" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Tampered install test" << std::endl;
+    return true;
+}
+
+// Test rejection of unsigned, oversized and overlong input
+bool test_install_rejections() {
+    const test_keys keys;
+    uint8_t sector[256];
+    vmprog_package_installer installer(sector, sizeof(sector));
+
+    // Unsigned packages are refused after the header unless allowed
+    const std::vector<uint8_t> unsigned_package = create_package(keys, 3000, false);
+    memory_target target;
+    installer.begin(target, keys.public_key);
+    if (installer.feed(unsigned_package.data(), 64) != vmprog_install_state::failed || target.began) {
+        std::cerr << "FAILED: Install rejections test - unsigned package not refused" << std::endl;
+        return false;
+    }
+    memory_target target2;
+    installer.begin(target2, keys.public_key, true);
+    if (feed_chunks(installer, unsigned_package, 100) != vmprog_install_state::committed) {
+        std::cerr << "FAILED: Install rejections test - allowed unsigned package refused" << std::endl;
+        return false;
+    }
+
+    // Target without room
+    const std::vector<uint8_t> package = create_package(keys, 3000);
+    memory_target small;
+    small.capacity = 1000;
+    installer.begin(small, keys.public_key);
+    if (feed_chunks(installer, package, 100) != vmprog_install_state::failed ||
+        installer.result() != vmprog_validation_result::invalid_file_size) {
+        std::cerr << "FAILED: Install rejections test - oversized package accepted" << std::endl;
+        return false;
+    }
+
+    // Trailing bytes after file_size, even in the same chunk
+    std::vector<uint8_t> overlong = package;
+    overlong.push_back(0);
+    memory_target target3;
+    installer.begin(target3, keys.public_key);
+    if (installer.feed(overlong.data(), static_cast<uint32_t>(overlong.size())) != vmprog_install_state::failed ||
+        target3.committed) {
+        std::cerr << "FAILED: Install rejections test - trailing bytes accepted" << std::endl;
+        return false;
+    }
+
+    // Truncated transfer: caller aborts
+    memory_target target4;
+    installer.begin(target4, keys.public_key);
+    installer.feed(package.data(), static_cast<uint32_t>(package.size() - 1));
+    installer.abort();
+    if (installer.state() != vmprog_install_state::idle || !target4.aborted || target4.committed) {
+        std::cerr << "FAILED: Install rejections test - abort did not discard" << std::endl;
+        return false;
+    }
+
+    // Signed package with an extra bitstream the descriptor does not list
+    test_package_spec spec;
+    spec.variants = { vmprog_toc_entry_type_v1_0::bitstream_hd_analog, vmprog_toc_entry_type_v1_0::bitstream_hd_hdmi };
+    spec.signed_variants = 1;
+    spec.bitstream_size = 3000;
+    const std::vector<uint8_t> unlisted = create_test_package(keys, spec);
+    memory_target target6;
+    installer.begin(target6, keys.public_key);
+    if (feed_chunks(installer, unlisted, 100) != vmprog_install_state::failed ||
+        installer.result() != vmprog_validation_result::invalid_toc_entry || target6.committed) {
+        std::cerr << "FAILED: Install rejections test - unsigned bitstream variant accepted" << std::endl;
+        return false;
+    }
+
+    // Sector buffer smaller than the header
+    uint8_t tiny[16];
+    vmprog_package_installer tiny_installer(tiny, sizeof(tiny));
+    memory_target target5;
+    if (tiny_installer.begin(target5)) {
+        std::cerr << "FAILED: Install rejections test - undersized sector buffer accepted" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Install rejections test" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "Videomancer vmprog_package_installer.hpp Tests" << std::endl;
+    std::cout << "============================================" << std::endl;
+    std::cout << std::endl;
+
+    int passed = 0;
+    int total = 0;
+
+    #define RUN_TEST(test_func) \
+        do { \
+            total++; \
+            if (test_func()) { \
+                passed++; \
+            } \
+        } while(0)
+
+    RUN_TEST(test_install_chunked);
+    RUN_TEST(test_install_tampered);
+    RUN_TEST(test_install_rejections);
+
+    std::cout << std::endl;
+    std::cout << "============================================" << std::endl;
+    std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
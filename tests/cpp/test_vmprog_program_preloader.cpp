@@ -0,0 +1,253 @@
+// Videomancer SDK - Unit Tests for vmprog_program_preloader.hpp
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <lzx/videomancer/vmprog_program_preloader.hpp>
+#include "test_vmprog_package.hpp"
+#include <iostream>
+#include <cstring>
+#include <vector>
+
+using namespace lzx;
+
+// Memory stream that records the largest single read
+class memory_stream : public vmprog_stream {
+public:
+    std::vector<uint8_t> data;
+    size_t position = 0;
+    size_t largest_read = 0;
+
+    size_t read(uint8_t* buffer, size_t size) override {
+        if (position >= data.size()) return 0;
+        size_t n = (size < data.size() - position) ? size : data.size() - position;
+        memcpy(buffer, data.data() + position, n);
+        position += n;
+        if (n > largest_read) largest_read = n;
+        return n;
+    }
+
+    bool seek(size_t offset) override {
+        if (offset > data.size()) return false;
+        position = offset;
+        return true;
+    }
+};
+
+// Package with config, descriptor, signature and SD/HD analog bitstreams (salts 1 and 2)
+static std::vector<uint8_t> create_package(const test_keys& keys, uint32_t bitstream_size, bool sign = true) {
+    test_package_spec spec;
+    spec.program_id = "test.preload.next";
+    spec.program_name = "Preload Test";
+    spec.bitstream_size = bitstream_size;
+    spec.variants = { vmprog_toc_entry_type_v1_0::bitstream_sd_analog, vmprog_toc_entry_type_v1_0::bitstream_hd_analog };
+    spec.salt = 1;
+    spec.sign = sign;
+    return create_test_package(keys, spec);
+}
+
+// Test a full preload in bounded steps
+bool test_preload_steps() {
+    const test_keys keys;
+    const uint32_t bitstream_size = 10000;
+    memory_stream stream;
+    stream.data = create_package(keys, bitstream_size);
+
+    uint8_t chunk[1024];
+    std::vector<uint8_t> staging(bitstream_size);
+    vmprog_preload_buffer sink(staging.data(), bitstream_size);
+    vmprog_program_preloader preloader(chunk, sizeof(chunk));
+
+    if (!preloader.begin(stream, static_cast<uint32_t>(stream.data.size()),
+                         vmprog_toc_entry_type_v1_0::bitstream_hd_analog, sink, keys.public_key)) {
+        std::cerr << "FAILED: Preload steps test - begin failed" << std::endl;
+        return false;
+    }
+
+    // Header, signature, config, then one step per chunk
+    uint32_t steps = 0;
+    size_t largest_bitstream_read = 0;
+    while (preloader.is_busy()) {
+        const bool staging_bitstream = preloader.state() == vmprog_preload_state::bitstream;
+        stream.largest_read = 0;
+        preloader.step();
+        ++steps;
+        if (staging_bitstream && stream.largest_read > largest_bitstream_read) {
+            largest_bitstream_read = stream.largest_read;
+        }
+    }
+
+    const uint32_t expected_steps = 3 + (bitstream_size + sizeof(chunk) - 1) / sizeof(chunk);
+    const std::vector<uint8_t> expected = make_test_bitstream(bitstream_size, 2);
+    if (!preloader.is_ready() || steps != expected_steps || largest_bitstream_read > sizeof(chunk)) {
+        std::cerr << "FAILED: Preload steps test - " << steps << " steps, state "
+                  << static_cast<int>(preloader.state()) << std::endl;
+        return false;
+    }
+    if (sink.size() != bitstream_size || memcmp(sink.data(), expected.data(), bitstream_size) != 0 ||
+        strcmp(preloader.config().program_id, "test.preload.next") != 0 ||
+        preloader.bitstream_staged() != bitstream_size) {
+        std::cerr << "FAILED: Preload steps test - staged program incorrect" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Preload steps test" << std::endl;
+    return true;
+}
+
+// Test that a tampered bitstream fails and the sink is discarded
+bool test_preload_tampered() {
+    const test_keys keys;
+    const uint32_t bitstream_size = 4096;
+    memory_stream stream;
+    stream.data = create_package(keys, bitstream_size);
+    stream.data[stream.data.size() - 1] ^= 0x80;  // Last byte of the HD bitstream
+
+    uint8_t chunk[512];
+    std::vector<uint8_t> staging(bitstream_size);
+    vmprog_preload_buffer sink(staging.data(), bitstream_size);
+    vmprog_program_preloader preloader(chunk, sizeof(chunk));
+
+    preloader.begin(stream, static_cast<uint32_t>(stream.data.size()),
+                    vmprog_toc_entry_type_v1_0::bitstream_hd_analog, sink, keys.public_key);
+    if (preloader.run() != vmprog_preload_state::failed ||
+        preloader.result() != vmprog_validation_result::invalid_hash || sink.size() != 0) {
+        std::cerr << "FAILED: Preload tampered test - tampered bitstream staged" << std::endl;
+        return false;
+    }
+
+    // The untouched SD variant still preloads
+    preloader.begin(stream, static_cast<uint32_t>(stream.data.size()),
+                    vmprog_toc_entry_type_v1_0::bitstream_sd_analog, sink, keys.public_key);
+    if (preloader.run() != vmprog_preload_state::ready) {
+        std::cerr << "FAILED: Preload tampered test - untouched variant rejected" << std::endl;
+        return false;
+    }
+
+    // Wrong key
+    uint8_t wrong_key[32];
+    memcpy(wrong_key, keys.public_key, 32);
+    wrong_key[5] ^= 0x10;
+    preloader.begin(stream, static_cast<uint32_t>(stream.data.size()),
+                    vmprog_toc_entry_type_v1_0::bitstream_sd_analog, sink, wrong_key);
+    if (preloader.run() != vmprog_preload_state::failed ||
+        preloader.result() != vmprog_validation_result::invalid_hash) {
+        std::cerr << "FAILED: Preload tampered test - wrong key accepted" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Preload tampered test" << std::endl;
+    return true;
+}
+
+// Test unsigned packages, missing variants and small sinks
+bool test_preload_rejections() {
+    const test_keys keys;
+    const uint32_t bitstream_size = 2048;
+    memory_stream stream;
+    stream.data = create_package(keys, bitstream_size, false);
+    const uint32_t file_size = static_cast<uint32_t>(stream.data.size());
+
+    uint8_t chunk[256];
+    std::vector<uint8_t> staging(bitstream_size);
+    vmprog_preload_buffer sink(staging.data(), bitstream_size);
+    vmprog_preload_buffer small_sink(staging.data(), bitstream_size - 1);
+    vmprog_program_preloader preloader(chunk, sizeof(chunk));
+
+    preloader.begin(stream, file_size, vmprog_toc_entry_type_v1_0::bitstream_sd_analog, sink);
+    if (preloader.run() != vmprog_preload_state::failed) {
+        std::cerr << "FAILED: Preload rejections test - unsigned package accepted by default" << std::endl;
+        return false;
+    }
+
+    preloader.begin(stream, file_size, vmprog_toc_entry_type_v1_0::bitstream_sd_analog, sink, nullptr, true);
+    if (preloader.run() != vmprog_preload_state::ready) {
+        std::cerr << "FAILED: Preload rejections test - allowed unsigned package rejected" << std::endl;
+        return false;
+    }
+
+    preloader.begin(stream, file_size, vmprog_toc_entry_type_v1_0::bitstream_hd_hdmi, sink, nullptr, true);
+    if (preloader.run() != vmprog_preload_state::failed ||
+        preloader.result() != vmprog_validation_result::invalid_toc_entry) {
+        std::cerr << "FAILED: Preload rejections test - missing variant accepted" << std::endl;
+        return false;
+    }
+
+    preloader.begin(stream, file_size, vmprog_toc_entry_type_v1_0::bitstream_sd_analog, small_sink, nullptr, true);
+    if (preloader.run() != vmprog_preload_state::failed ||
+        preloader.result() != vmprog_validation_result::invalid_file_size) {
+        std::cerr << "FAILED: Preload rejections test - undersized sink accepted" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Preload rejections test" << std::endl;
+    return true;
+}
+
+// Test cancelling a preload in progress
+bool test_preload_cancel() {
+    const test_keys keys;
+    const uint32_t bitstream_size = 4096;
+    memory_stream stream;
+    stream.data = create_package(keys, bitstream_size);
+
+    uint8_t chunk[512];
+    std::vector<uint8_t> staging(bitstream_size);
+    vmprog_preload_buffer sink(staging.data(), bitstream_size);
+    vmprog_program_preloader preloader(chunk, sizeof(chunk));
+
+    preloader.begin(stream, static_cast<uint32_t>(stream.data.size()),
+                    vmprog_toc_entry_type_v1_0::bitstream_sd_analog, sink, keys.public_key);
+    for (int i = 0; i < 5; ++i) preloader.step();
+    if (preloader.state() != vmprog_preload_state::bitstream || sink.size() == 0) {
+        std::cerr << "FAILED: Preload cancel test - not staging after 5 steps" << std::endl;
+        return false;
+    }
+
+    preloader.cancel();
+    if (preloader.state() != vmprog_preload_state::idle || preloader.is_busy() || sink.size() != 0 ||
+        preloader.step() != vmprog_preload_state::idle) {
+        std::cerr << "FAILED: Preload cancel test - cancel did not discard staging" << std::endl;
+        return false;
+    }
+
+    vmprog_program_preloader no_chunk(nullptr, 0);
+    if (no_chunk.begin(stream, static_cast<uint32_t>(stream.data.size()),
+                       vmprog_toc_entry_type_v1_0::bitstream_sd_analog, sink)) {
+        std::cerr << "FAILED: Preload cancel test - begin accepted missing chunk buffer" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Preload cancel test" << std::endl;
+    return true;
+}
+
+// Main test runner
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "Videomancer vmprog_program_preloader.hpp Tests" << std::endl;
+    std::cout << "============================================" << std::endl;
+    std::cout << std::endl;
+
+    int passed = 0;
+    int total = 0;
+
+    #define RUN_TEST(test_func) \
+        do { \
+            total++; \
+            if (test_func()) { \
+                passed++; \
+            } \
+        } while(0)
+
+    RUN_TEST(test_preload_steps);
+    RUN_TEST(test_preload_tampered);
+    RUN_TEST(test_preload_rejections);
+    RUN_TEST(test_preload_cancel);
+
+    std::cout << std::endl;
+    std::cout << "============================================" << std::endl;
+    std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
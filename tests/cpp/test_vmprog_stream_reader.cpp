@@ -15,6 +15,7 @@ class mock_vmprog_stream : public vmprog_stream {
 private:
     std::vector<uint8_t> data_;
     size_t position_;
+    size_t total_read_ = 0;
 
 public:
     mock_vmprog_stream() : position_(0) {}
@@ -34,6 +35,7 @@ public:
 
         memcpy(buffer, data_.data() + position_, to_read);
         position_ += to_read;
+        total_read_ += to_read;
 
         return to_read;
     }
@@ -54,6 +56,18 @@ public:
     size_t size() const {
         return data_.size();
     }
+
+    size_t total_read() const {
+        return total_read_;
+    }
+
+    void reset_total_read() {
+        total_read_ = 0;
+    }
+
+    std::vector<uint8_t>& data() {
+        return data_;
+    }
 };
 
 // Helper to create a minimal valid header
@@ -1534,6 +1548,195 @@ bool test_find_toc_entry_by_type() {
 }
 
 // Main test runner
+// Helper to create a package signed with a test key, carrying three bitstream variants
+std::vector<uint8_t> create_signed_multi_bitstream_package(const uint8_t secret_key[64], uint32_t bitstream_size) {
+    const vmprog_toc_entry_type_v1_0 variants[3] = {
+        vmprog_toc_entry_type_v1_0::bitstream_sd_analog,
+        vmprog_toc_entry_type_v1_0::bitstream_hd_analog,
+        vmprog_toc_entry_type_v1_0::bitstream_hd_hdmi,
+    };
+    const uint32_t toc_count = 6;
+
+    vmprog_program_config_v1_0 config;
+    init_vmprog_config(config);
+    safe_strncpy(config.program_id, "test.selective.package", sizeof(config.program_id));
+    safe_strncpy(config.program_name, "Selective Test Program", sizeof(config.program_name));
+
+    std::vector<uint8_t> bitstreams[3];
+    for (uint32_t v = 0; v < 3; ++v) {
+        bitstreams[v].resize(bitstream_size);
+        for (uint32_t i = 0; i < bitstream_size; ++i) {
+            bitstreams[v][i] = static_cast<uint8_t>(i * 7 + v * 31);
+        }
+    }
+
+    vmprog_signed_descriptor_v1_0 descriptor;
+    init_signed_descriptor(descriptor);
+    sha256_oneshot(reinterpret_cast<const uint8_t*>(&config), sizeof(config), descriptor.config_sha256);
+    descriptor.artifact_count = 3;
+    for (uint32_t v = 0; v < 3; ++v) {
+        descriptor.artifacts[v].type = variants[v];
+        sha256_oneshot(bitstreams[v].data(), bitstream_size, descriptor.artifacts[v].sha256);
+    }
+    descriptor.build_id = 4242;
+
+    uint8_t signature[64];
+    crypto_ed25519_sign(signature, secret_key, reinterpret_cast<const uint8_t*>(&descriptor), sizeof(descriptor));
+
+    vmprog_toc_entry_v1_0 toc[toc_count];
+    const uint8_t* payloads[toc_count] = {
+        reinterpret_cast<const uint8_t*>(&config),
+        reinterpret_cast<const uint8_t*>(&descriptor),
+        signature,
+        bitstreams[0].data(), bitstreams[1].data(), bitstreams[2].data(),
+    };
+    const vmprog_toc_entry_type_v1_0 types[toc_count] = {
+        vmprog_toc_entry_type_v1_0::config,
+        vmprog_toc_entry_type_v1_0::signed_descriptor,
+        vmprog_toc_entry_type_v1_0::signature,
+        variants[0], variants[1], variants[2],
+    };
+    const uint32_t sizes[toc_count] = {
+        sizeof(config), sizeof(descriptor), 64, bitstream_size, bitstream_size, bitstream_size,
+    };
+
+    uint32_t offset = sizeof(vmprog_header_v1_0) + toc_count * sizeof(vmprog_toc_entry_v1_0);
+    for (uint32_t i = 0; i < toc_count; ++i) {
+        init_toc_entry(toc[i]);
+        toc[i].type = types[i];
+        toc[i].offset = offset;
+        toc[i].size = sizes[i];
+        sha256_oneshot(payloads[i], sizes[i], toc[i].sha256);
+        offset += sizes[i];
+    }
+
+    vmprog_header_v1_0 header;
+    init_vmprog_header(header);
+    header.flags = vmprog_header_flags_v1_0::signed_pkg;
+    header.file_size = offset;
+    header.toc_offset = sizeof(vmprog_header_v1_0);
+    header.toc_count = toc_count;
+    header.toc_bytes = toc_count * sizeof(vmprog_toc_entry_v1_0);
+
+    std::vector<uint8_t> package(header.file_size);
+    memcpy(package.data(), &header, sizeof(header));
+    memcpy(package.data() + header.toc_offset, toc, sizeof(toc));
+    for (uint32_t i = 0; i < toc_count; ++i) {
+        memcpy(package.data() + toc[i].offset, payloads[i], sizes[i]);
+    }
+    return package;
+}
+
+// Test selective verification reads only the descriptor, signature, config and one bitstream
+bool test_selective_verification() {
+    uint8_t seed[32];
+    for (int i = 0; i < 32; i++) seed[i] = static_cast<uint8_t>(0xA0 + i);
+    uint8_t secret_key[64];
+    uint8_t public_key[32];
+    crypto_ed25519_key_pair(secret_key, public_key, seed);
+
+    const uint32_t bitstream_size = 65536;
+    mock_vmprog_stream stream;
+    stream.set_data(create_signed_multi_bitstream_package(secret_key, bitstream_size));
+    const uint32_t file_size = static_cast<uint32_t>(stream.size());
+    uint8_t scratch[256];
+    vmprog_program_config_v1_0 config;
+
+    auto result = validate_vmprog_package_selective_stream(
+        stream, file_size, vmprog_toc_entry_type_v1_0::bitstream_hd_analog, public_key, scratch, sizeof(scratch), config);
+    if (result != vmprog_validation_result::ok) {
+        std::cerr << "FAILED: Selective verification test - valid package rejected (" << static_cast<int>(result) << ")" << std::endl;
+        return false;
+    }
+
+    // The authenticated config is returned, matching the package bytes
+    const auto* toc = reinterpret_cast<const vmprog_toc_entry_v1_0*>(stream.data().data() + sizeof(vmprog_header_v1_0));
+    if (std::memcmp(&config, stream.data().data() + toc[0].offset, sizeof(config)) != 0) {
+        std::cerr << "FAILED: Selective verification test - returned config differs from package" << std::endl;
+        return false;
+    }
+
+    // Read cost: descriptor + signature + config + one bitstream
+    vmprog_package_reader reader;
+    if (reader.open(stream, file_size, false) != vmprog_validation_result::ok) {
+        std::cerr << "FAILED: Selective verification test - open failed" << std::endl;
+        return false;
+    }
+    stream.reset_total_read();
+    result = reader.verify_selective(vmprog_toc_entry_type_v1_0::bitstream_hd_analog, public_key, scratch, sizeof(scratch));
+    const size_t expected_read = sizeof(vmprog_signed_descriptor_v1_0) + 64 +
+                                 sizeof(vmprog_program_config_v1_0) + bitstream_size;
+    if (result != vmprog_validation_result::ok || stream.total_read() != expected_read) {
+        std::cerr << "FAILED: Selective verification test - read " << stream.total_read()
+                  << " bytes, expected " << expected_read << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Selective verification test" << std::endl;
+    return true;
+}
+
+// Test selective verification rejects tampering with anything it loads
+bool test_selective_verification_tampered() {
+    uint8_t seed[32];
+    for (int i = 0; i < 32; i++) seed[i] = static_cast<uint8_t>(0x10 + i);
+    uint8_t secret_key[64];
+    uint8_t public_key[32];
+    uint8_t other_public_key[32];
+    uint8_t other_secret_key[64];
+    crypto_ed25519_key_pair(secret_key, public_key, seed);
+    seed[0] ^= 0xFF;
+    crypto_ed25519_key_pair(other_secret_key, other_public_key, seed);
+
+    const uint32_t bitstream_size = 4096;
+    const std::vector<uint8_t> original = create_signed_multi_bitstream_package(secret_key, bitstream_size);
+    const uint32_t file_size = static_cast<uint32_t>(original.size());
+    const auto* toc = reinterpret_cast<const vmprog_toc_entry_v1_0*>(original.data() + sizeof(vmprog_header_v1_0));
+    uint8_t scratch[100];  // Deliberately not a divisor of the payload sizes
+    vmprog_program_config_v1_0 config;
+    mock_vmprog_stream stream;
+
+    // Corrupt an unselected bitstream: still valid for the selected one
+    stream.set_data(original);
+    stream.data()[toc[3].offset + 10] ^= 0x01;
+    if (validate_vmprog_package_selective_stream(stream, file_size, vmprog_toc_entry_type_v1_0::bitstream_hd_hdmi,
+                                                 public_key, scratch, sizeof(scratch), config) != vmprog_validation_result::ok) {
+        std::cerr << "FAILED: Selective tamper test - unselected bitstream affected result" << std::endl;
+        return false;
+    }
+
+    // Corrupt the selected bitstream
+    if (validate_vmprog_package_selective_stream(stream, file_size, vmprog_toc_entry_type_v1_0::bitstream_sd_analog,
+                                                 public_key, scratch, sizeof(scratch), config) != vmprog_validation_result::invalid_hash) {
+        std::cerr << "FAILED: Selective tamper test - corrupted bitstream accepted" << std::endl;
+        return false;
+    }
+
+    // Corrupt the config
+    stream.set_data(original);
+    stream.data()[toc[0].offset + 200] ^= 0x01;
+    if (validate_vmprog_package_selective_stream(stream, file_size, vmprog_toc_entry_type_v1_0::bitstream_hd_hdmi,
+                                                 public_key, scratch, sizeof(scratch), config) != vmprog_validation_result::invalid_hash) {
+        std::cerr << "FAILED: Selective tamper test - corrupted config accepted" << std::endl;
+        return false;
+    }
+
+    // Wrong key, unsigned variant, missing scratch buffer
+    stream.set_data(original);
+    if (validate_vmprog_package_selective_stream(stream, file_size, vmprog_toc_entry_type_v1_0::bitstream_hd_hdmi,
+                                                 other_public_key, scratch, sizeof(scratch), config) != vmprog_validation_result::invalid_hash ||
+        validate_vmprog_package_selective_stream(stream, file_size, vmprog_toc_entry_type_v1_0::bitstream_sd_dual,
+                                                 public_key, scratch, sizeof(scratch), config) != vmprog_validation_result::invalid_toc_entry ||
+        validate_vmprog_package_selective_stream(stream, file_size, vmprog_toc_entry_type_v1_0::bitstream_hd_hdmi,
+                                                 public_key, nullptr, 0, config) != vmprog_validation_result::invalid_file_size) {
+        std::cerr << "FAILED: Selective tamper test - key or variant checks incorrect" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Selective tamper test" << std::endl;
+    return true;
+}
+
 int main() {
     std::cout << "============================================" << std::endl;
     std::cout << "Videomancer vmprog_stream_reader.hpp Tests" << std::endl;
@@ -1588,6 +1791,8 @@ int main() {
     RUN_TEST(test_signed_package_missing_signature);
     RUN_TEST(test_config_invalid_abi_range);
     RUN_TEST(test_find_toc_entry_by_type);
+    RUN_TEST(test_selective_verification);
+    RUN_TEST(test_selective_verification_tampered);
 
     std::cout << std::endl;
     std::cout << "============================================" << std::endl;
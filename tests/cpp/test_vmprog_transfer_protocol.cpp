@@ -0,0 +1,354 @@
+// Videomancer SDK - Unit Tests for vmprog_transfer_protocol.hpp
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <lzx/videomancer/vmprog_transfer_protocol.hpp>
+#include "test_vmprog_package.hpp"
+#include <iostream>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+using namespace lzx;
+
+class manual_clock : public videomancer_clock {
+public:
+    uint64_t now = 0;
+    uint64_t now_us() override { return now; }
+};
+
+class memory_stream : public vmprog_stream {
+public:
+    std::vector<uint8_t> data;
+    size_t position = 0;
+
+    size_t read(uint8_t* buffer, size_t size) override {
+        if (position >= data.size()) return 0;
+        size_t n = (size < data.size() - position) ? size : data.size() - position;
+        memcpy(buffer, data.data() + position, n);
+        position += n;
+        return n;
+    }
+
+    bool seek(size_t offset) override {
+        if (offset > data.size()) return false;
+        position = offset;
+        return true;
+    }
+};
+
+// One direction of an in-memory byte pipe; each write() is one frame, so
+// faults can drop or corrupt whole frames
+class pipe_end : public vmprog_transfer_link {
+public:
+    std::deque<uint8_t>* tx = nullptr;
+    std::deque<uint8_t>* rx = nullptr;
+    uint32_t drop_every = 0;
+    uint32_t corrupt_every = 0;
+    uint32_t writes = 0;
+    bool garbage_first = false;
+
+    size_t write(const uint8_t* data, size_t size) override {
+        ++writes;
+        if (garbage_first) {
+            const uint8_t garbage[] = { 0x56, 0x00, 0x56, 0x54, 0xFF, 0xFF, 0x12 };
+            tx->insert(tx->end(), garbage, garbage + sizeof(garbage));
+            garbage_first = false;
+        }
+        if (drop_every && writes % drop_every == 0) return size;
+        const size_t start = tx->size();
+        tx->insert(tx->end(), data, data + size);
+        if (corrupt_every && writes % corrupt_every == 0) (*tx)[start + size / 2] ^= 0x20;
+        return size;
+    }
+
+    size_t read(uint8_t* buffer, size_t size) override {
+        size_t n = 0;
+        while (n < size && !rx->empty()) {
+            buffer[n++] = rx->front();
+            rx->pop_front();
+        }
+        return n;
+    }
+};
+
+struct loopback {
+    std::deque<uint8_t> to_receiver;
+    std::deque<uint8_t> to_sender;
+    pipe_end sender_end;
+    pipe_end receiver_end;
+
+    loopback() {
+        sender_end.tx = &to_receiver;
+        sender_end.rx = &to_sender;
+        receiver_end.tx = &to_sender;
+        receiver_end.rx = &to_receiver;
+    }
+};
+
+class memory_target : public vmprog_install_target {
+public:
+    std::vector<uint8_t> staged;
+    std::vector<uint8_t> installed;
+
+    bool begin(uint32_t size) override { staged.assign(size, 0xFF); return true; }
+    bool write(uint32_t offset, const uint8_t* data, uint32_t size) override {
+        if (offset + size > staged.size()) return false;
+        memcpy(staged.data() + offset, data, size);
+        return true;
+    }
+    bool commit() override { installed = staged; return true; }
+};
+
+// Sink that records chunk boundaries as they are delivered
+class recording_sink : public vmprog_transfer_sink {
+public:
+    std::vector<uint8_t> data;
+    std::vector<uint32_t> chunk_starts;
+
+    bool begin(uint32_t) override { data.clear(); chunk_starts.clear(); return true; }
+    bool write(const uint8_t* bytes, uint32_t size) override {
+        chunk_starts.push_back(static_cast<uint32_t>(data.size()));
+        data.insert(data.end(), bytes, bytes + size);
+        return true;
+    }
+};
+
+// Signed package with config, descriptor, signature and one bitstream
+static std::vector<uint8_t> create_package(const test_keys& keys, uint32_t bitstream_size, uint8_t salt = 0) {
+    test_package_spec spec;
+    spec.program_id = "test.transfer";
+    spec.program_name = "Transfer Test";
+    spec.bitstream_size = bitstream_size;
+    spec.salt = salt;
+    return create_test_package(keys, spec);
+}
+
+// Poll both ends until both are finished, advancing the clock 1 ms per round
+static bool run_transfer(vmprog_transfer_sender& sender, vmprog_transfer_receiver& receiver,
+                         manual_clock& clock, uint32_t max_rounds = 100000) {
+    for (uint32_t round = 0; round < max_rounds; ++round) {
+        const vmprog_transfer_state s = sender.poll();
+        const vmprog_transfer_state r = receiver.poll();
+        if (s == vmprog_transfer_state::failed || r == vmprog_transfer_state::failed) return false;
+        if (s == vmprog_transfer_state::done && r == vmprog_transfer_state::done) return true;
+        clock.now += 1000;
+    }
+    return false;
+}
+
+// Test a clean transfer into the installer; chunks stay within TOC regions
+bool test_transfer_clean() {
+    const test_keys keys;
+    memory_stream stream;
+    stream.data = create_package(keys, 20000);
+    const uint32_t file_size = static_cast<uint32_t>(stream.data.size());
+
+    loopback pipe;
+    manual_clock clock;
+    uint8_t sector[1024];
+    vmprog_package_installer installer(sector, sizeof(sector));
+    memory_target target;
+    vmprog_transfer_install_sink sink(installer, target, keys.public_key);
+    std::vector<uint8_t> window(8 * 1024);
+    vmprog_transfer_receiver receiver(pipe.receiver_end, sink, window.data(), static_cast<uint32_t>(window.size()));
+    vmprog_transfer_sender sender(pipe.sender_end, clock);
+
+    if (sender.begin(stream, file_size, 1024, 8) != vmprog_validation_result::ok) {
+        std::cerr << "FAILED: Clean transfer test - begin failed" << std::endl;
+        return false;
+    }
+    if (!run_transfer(sender, receiver, clock) || !installer.is_committed() || target.installed != stream.data) {
+        std::cerr << "FAILED: Clean transfer test - package not installed" << std::endl;
+        return false;
+    }
+    if (sender.retransmits() != 0 || receiver.bytes_delivered() != file_size) {
+        std::cerr << "FAILED: Clean transfer test - unexpected retransmits " << sender.retransmits() << std::endl;
+        return false;
+    }
+
+    // Region boundaries must also be chunk boundaries
+    loopback pipe2;
+    recording_sink recorder;
+    vmprog_transfer_receiver receiver2(pipe2.receiver_end, recorder, window.data(), static_cast<uint32_t>(window.size()));
+    vmprog_transfer_sender sender2(pipe2.sender_end, clock);
+    sender2.begin(stream, file_size, 1000, 8);
+    if (!run_transfer(sender2, receiver2, clock) || recorder.data != stream.data) {
+        std::cerr << "FAILED: Clean transfer test - recorded transfer differs" << std::endl;
+        return false;
+    }
+    const vmprog_toc_entry_v1_0* toc = reinterpret_cast<const vmprog_toc_entry_v1_0*>(stream.data.data() + 64);
+    for (uint32_t i = 0; i < 4; ++i) {
+        bool found = false;
+        for (uint32_t start : recorder.chunk_starts) found |= (start == toc[i].offset);
+        if (!found) {
+            std::cerr << "FAILED: Clean transfer test - payload " << i << " does not start a chunk" << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "PASSED: Clean transfer test" << std::endl;
+    return true;
+}
+
+// Test recovery from dropped, corrupted and garbage frames in both directions
+bool test_transfer_lossy() {
+    const test_keys keys;
+    memory_stream stream;
+    stream.data = create_package(keys, 30000);
+    const uint32_t file_size = static_cast<uint32_t>(stream.data.size());
+
+    loopback pipe;
+    pipe.sender_end.drop_every = 5;
+    pipe.sender_end.corrupt_every = 13;
+    pipe.sender_end.garbage_first = true;
+    pipe.receiver_end.drop_every = 7;
+    pipe.receiver_end.corrupt_every = 11;
+
+    manual_clock clock;
+    uint8_t sector[512];
+    vmprog_package_installer installer(sector, sizeof(sector));
+    memory_target target;
+    vmprog_transfer_install_sink sink(installer, target, keys.public_key);
+    std::vector<uint8_t> window(16 * 1024);
+    vmprog_transfer_receiver receiver(pipe.receiver_end, sink, window.data(), static_cast<uint32_t>(window.size()));
+    vmprog_transfer_sender sender(pipe.sender_end, clock);
+    sender.begin(stream, file_size, 1024, 16, 20000);
+
+    if (!run_transfer(sender, receiver, clock) || !installer.is_committed() || target.installed != stream.data) {
+        std::cerr << "FAILED: Lossy transfer test - package not installed (sender "
+                  << static_cast<int>(sender.state()) << ", receiver " << static_cast<int>(receiver.state()) << ")"
+                  << std::endl;
+        return false;
+    }
+    if (sender.retransmits() == 0 || receiver.frames_rejected() == 0 || sender.frames_rejected() == 0) {
+        std::cerr << "FAILED: Lossy transfer test - faults were not exercised" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Lossy transfer test" << std::endl;
+    return true;
+}
+
+// Test resuming with a new sender after the first one goes away
+bool test_transfer_resume() {
+    const test_keys keys;
+    memory_stream stream;
+    stream.data = create_package(keys, 30000);
+    const uint32_t file_size = static_cast<uint32_t>(stream.data.size());
+
+    loopback pipe;
+    manual_clock clock;
+    uint8_t sector[1024];
+    vmprog_package_installer installer(sector, sizeof(sector));
+    memory_target target;
+    vmprog_transfer_install_sink sink(installer, target, keys.public_key);
+    std::vector<uint8_t> window(8 * 1024);
+    vmprog_transfer_receiver receiver(pipe.receiver_end, sink, window.data(), static_cast<uint32_t>(window.size()));
+
+    {
+        vmprog_transfer_sender first(pipe.sender_end, clock);
+        first.begin(stream, file_size, 1024, 8);
+        for (int round = 0; round < 1000 && receiver.chunks_delivered() < 15; ++round) {
+            first.poll();
+            receiver.poll();
+            clock.now += 1000;
+        }
+    }
+    pipe.to_receiver.clear();
+    pipe.to_sender.clear();
+    const uint32_t delivered = receiver.chunks_delivered();
+
+    vmprog_transfer_sender second(pipe.sender_end, clock);
+    second.begin(stream, file_size, 1024, 8);
+    if (!run_transfer(second, receiver, clock) || second.resume_index() != delivered || delivered == 0) {
+        std::cerr << "FAILED: Resume transfer test - did not resume at chunk " << delivered << std::endl;
+        return false;
+    }
+    if (!installer.is_committed() || target.installed != stream.data) {
+        std::cerr << "FAILED: Resume transfer test - resumed package not installed" << std::endl;
+        return false;
+    }
+
+    // A different package starts over
+    memory_stream other;
+    other.data = create_package(keys, 30000, 9);
+    vmprog_transfer_sender third(pipe.sender_end, clock);
+    third.begin(other, static_cast<uint32_t>(other.data.size()), 1024, 8);
+    if (!run_transfer(third, receiver, clock) || third.resume_index() != 0 || target.installed != other.data) {
+        std::cerr << "FAILED: Resume transfer test - different package resumed" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Resume transfer test" << std::endl;
+    return true;
+}
+
+// Test that an installer rejection stops the sender
+bool test_transfer_rejected() {
+    const test_keys keys;
+    memory_stream stream;
+    stream.data = create_package(keys, 20000);
+    stream.data[stream.data.size() - 100] ^= 0x01;
+    const uint32_t file_size = static_cast<uint32_t>(stream.data.size());
+
+    loopback pipe;
+    manual_clock clock;
+    uint8_t sector[1024];
+    vmprog_package_installer installer(sector, sizeof(sector));
+    memory_target target;
+    vmprog_transfer_install_sink sink(installer, target, keys.public_key);
+    std::vector<uint8_t> window(4 * 1024);
+    vmprog_transfer_receiver receiver(pipe.receiver_end, sink, window.data(), static_cast<uint32_t>(window.size()));
+    vmprog_transfer_sender sender(pipe.sender_end, clock);
+    sender.begin(stream, file_size);
+
+    run_transfer(sender, receiver, clock, 1000);
+    sender.poll();
+    if (receiver.state() != vmprog_transfer_state::failed || sender.state() != vmprog_transfer_state::failed ||
+        !target.installed.empty()) {
+        std::cerr << "FAILED: Rejected transfer test - tampered package not refused" << std::endl;
+        return false;
+    }
+
+    // Invalid sender parameters
+    vmprog_transfer_sender bad(pipe.sender_end, clock);
+    if (bad.begin(stream, file_size, 0) == vmprog_validation_result::ok ||
+        bad.begin(stream, file_size, 1024, vmprog_transfer_max_window + 1) == vmprog_validation_result::ok) {
+        std::cerr << "FAILED: Rejected transfer test - invalid parameters accepted" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Rejected transfer test" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "Videomancer vmprog_transfer_protocol.hpp Tests" << std::endl;
+    std::cout << "============================================" << std::endl;
+    std::cout << std::endl;
+
+    int passed = 0;
+    int total = 0;
+
+    #define RUN_TEST(test_func) \
+        do { \
+            total++; \
+            if (test_func()) { \
+                passed++; \
+            } \
+        } while(0)
+
+    RUN_TEST(test_transfer_clean);
+    RUN_TEST(test_transfer_lossy);
+    RUN_TEST(test_transfer_resume);
+    RUN_TEST(test_transfer_rejected);
+
+    std::cout << std::endl;
+    std::cout << "============================================" << std::endl;
+    std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
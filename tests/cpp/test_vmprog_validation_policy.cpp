@@ -0,0 +1,317 @@
+// Videomancer SDK - Unit Tests for vmprog_validation_policy.hpp
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <lzx/videomancer/vmprog_validation_policy.hpp>
+#include "test_vmprog_package.hpp"
+#include <iostream>
+#include <cstring>
+#include <vector>
+
+using namespace lzx;
+
+// Package with config, signed descriptor, signature and one bitstream
+static std::vector<uint8_t> create_package(const test_keys& keys, uint32_t bitstream_size, bool sign = true) {
+    test_package_spec spec;
+    spec.program_id = "test.policy.package";
+    spec.program_name = "Policy Test";
+    spec.bitstream_size = bitstream_size;
+    spec.variants = { vmprog_toc_entry_type_v1_0::fpga_bitstream };
+    spec.sign = sign;
+    spec.package_hash = true;
+    return create_test_package(keys, spec);
+}
+
+// Access the config payload in place
+static vmprog_program_config_v1_0& edit_config(std::vector<uint8_t>& package) {
+    auto* toc = reinterpret_cast<vmprog_toc_entry_v1_0*>(package.data() + sizeof(vmprog_header_v1_0));
+    return *reinterpret_cast<vmprog_program_config_v1_0*>(package.data() + toc[0].offset);
+}
+
+// Recompute the config TOC hash and package hash after editing the config
+static void rehash(std::vector<uint8_t>& package) {
+    auto& header = *reinterpret_cast<vmprog_header_v1_0*>(package.data());
+    auto* toc = reinterpret_cast<vmprog_toc_entry_v1_0*>(package.data() + header.toc_offset);
+    sha256_oneshot(package.data() + toc[0].offset, toc[0].size, toc[0].sha256);
+    calculate_package_sha256(package.data(), header.file_size, header.sha256_package);
+}
+
+// Test cheapest-first plan ordering
+bool test_plan_order() {
+    const auto small = make_vmprog_validation_plan(vmprog_validation_checks_v1_0::all, 32 * 1024);
+    const vmprog_validation_checks_v1_0 expected_small[] = {
+        vmprog_validation_checks_v1_0::structure, vmprog_validation_checks_v1_0::reserved_zero,
+        vmprog_validation_checks_v1_0::strings, vmprog_validation_checks_v1_0::payload_hashes,
+        vmprog_validation_checks_v1_0::package_hash, vmprog_validation_checks_v1_0::signature,
+    };
+    if (small.step_count != 6 || memcmp(small.steps, expected_small, sizeof(expected_small)) != 0) {
+        std::cerr << "FAILED: Plan order test - small package order incorrect" << std::endl;
+        return false;
+    }
+
+    // Large packages verify the signature before hashing
+    const auto large = make_vmprog_validation_plan(vmprog_validation_checks_v1_0::all, 1024 * 1024);
+    if (large.steps[3] != vmprog_validation_checks_v1_0::signature ||
+        large.steps[4] != vmprog_validation_checks_v1_0::payload_hashes) {
+        std::cerr << "FAILED: Plan order test - large package order incorrect" << std::endl;
+        return false;
+    }
+
+    // Structure is always present and first
+    const auto none = make_vmprog_validation_plan(vmprog_validation_checks_v1_0::none, 1024);
+    const auto sig = make_vmprog_validation_plan(vmprog_validation_checks_v1_0::signature, 1024);
+    if (none.step_count != 1 || sig.step_count != 2 ||
+        sig.steps[0] != vmprog_validation_checks_v1_0::structure) {
+        std::cerr << "FAILED: Plan order test - structure not forced first" << std::endl;
+        return false;
+    }
+
+    // Without payload_hashes the signature step hashes the signed payloads itself
+    const auto sig_large = make_vmprog_validation_plan(
+        vmprog_validation_checks_v1_0::signature | vmprog_validation_checks_v1_0::package_hash, 1024 * 1024);
+    if (estimate_vmprog_check_cost(vmprog_validation_checks_v1_0::signature, 1024, vmprog_validation_checks_v1_0::signature) !=
+            vmprog_signature_cost_bytes + 1024 ||
+        sig_large.steps[1] != vmprog_validation_checks_v1_0::package_hash) {
+        std::cerr << "FAILED: Plan order test - signature cost ignores payload hashing" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Plan order test" << std::endl;
+    return true;
+}
+
+// Test that every profile accepts a valid signed package
+bool test_profiles_accept_valid() {
+    const test_keys keys;
+    const std::vector<uint8_t> package = create_package(keys, 4096);
+    const uint32_t size = static_cast<uint32_t>(package.size());
+
+    const vmprog_validation_policy_v1_0 profiles[] = {
+        vmprog_validation_profile_boot, vmprog_validation_profile_ingest,
+        vmprog_validation_profile_strict, vmprog_validation_profile_browse,
+    };
+    for (vmprog_validation_policy_v1_0 policy : profiles) {
+        policy.public_key = keys.public_key;
+        vmprog_validation_checks_v1_0 failed = vmprog_validation_checks_v1_0::all;
+        if (validate_vmprog_package_with_policy(package.data(), size, policy, &failed) != vmprog_validation_result::ok ||
+            failed != vmprog_validation_checks_v1_0::none) {
+            std::cerr << "FAILED: Profiles accept valid test - profile rejected valid package" << std::endl;
+            return false;
+        }
+    }
+
+    if (validate_vmprog_package(package.data(), size, true, true, keys.public_key) != vmprog_validation_result::ok) {
+        std::cerr << "FAILED: Profiles accept valid test - legacy validation disagrees" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Profiles accept valid test" << std::endl;
+    return true;
+}
+
+// Test that single defects are reported with the same code as validate_vmprog_package()
+bool test_matches_legacy_results() {
+    const test_keys keys;
+    vmprog_validation_policy_v1_0 strict = vmprog_validation_profile_strict;
+    strict.public_key = keys.public_key;
+
+    struct defect {
+        const char* name;
+        void (*apply)(std::vector<uint8_t>&);
+        vmprog_validation_checks_v1_0 check;
+    };
+    const defect defects[] = {
+        { "config reserved", [](std::vector<uint8_t>& p) { edit_config(p).reserved_pad = 1; rehash(p); },
+          vmprog_validation_checks_v1_0::reserved_zero },
+        { "parameter reserved", [](std::vector<uint8_t>& p) { edit_config(p).parameters[0].reserved[1] = 1; rehash(p); },
+          vmprog_validation_checks_v1_0::reserved_zero },
+        { "unterminated name", [](std::vector<uint8_t>& p) { memset(edit_config(p).program_name, 'x', 32); rehash(p); },
+          vmprog_validation_checks_v1_0::strings },
+        { "parameter range", [](std::vector<uint8_t>& p) { edit_config(p).parameters[0].initial_value = 1; edit_config(p).parameters[0].min_value = 2; rehash(p); },
+          vmprog_validation_checks_v1_0::structure },
+        { "bitstream payload", [](std::vector<uint8_t>& p) { p[p.size() - 1] ^= 1; },
+          vmprog_validation_checks_v1_0::payload_hashes },
+    };
+
+    for (const defect& d : defects) {
+        std::vector<uint8_t> package = create_package(keys, 2048);
+        d.apply(package);
+        const uint32_t size = static_cast<uint32_t>(package.size());
+
+        vmprog_validation_checks_v1_0 failed = vmprog_validation_checks_v1_0::none;
+        const auto result = validate_vmprog_package_with_policy(package.data(), size, strict, &failed);
+        const auto legacy = validate_vmprog_package(package.data(), size, true, true, keys.public_key);
+        if (result == vmprog_validation_result::ok || result != legacy || failed != d.check) {
+            std::cerr << "FAILED: Matches legacy results test - " << d.name << " gave "
+                      << validation_result_string(result) << ", legacy "
+                      << validation_result_string(legacy) << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "PASSED: Matches legacy results test" << std::endl;
+    return true;
+}
+
+// Test that profiles skip checks they do not include
+bool test_profiles_skip_checks() {
+    const test_keys keys;
+    std::vector<uint8_t> package = create_package(keys, 2048);
+    package[package.size() - 1] ^= 1;  // Corrupt bitstream
+    edit_config(package).reserved_pad = 1;
+    rehash(package);
+    const uint32_t size = static_cast<uint32_t>(package.size());
+
+    // Browse ignores both defects, boot only sees the bitstream
+    vmprog_validation_policy_v1_0 boot = vmprog_validation_profile_boot;
+    boot.public_key = keys.public_key;
+    vmprog_validation_checks_v1_0 failed = vmprog_validation_checks_v1_0::none;
+    if (validate_vmprog_package_with_policy(package.data(), size, vmprog_validation_profile_browse) != vmprog_validation_result::ok ||
+        validate_vmprog_package_with_policy(package.data(), size, boot, &failed) != vmprog_validation_result::invalid_hash ||
+        failed != vmprog_validation_checks_v1_0::payload_hashes) {
+        std::cerr << "FAILED: Profiles skip checks test - profile ran unexpected checks" << std::endl;
+        return false;
+    }
+
+    // Ingest stops at the cheaper reserved-field check
+    if (validate_vmprog_package_with_policy(package.data(), size, vmprog_validation_profile_ingest, &failed) !=
+            vmprog_validation_result::reserved_field_not_zero ||
+        failed != vmprog_validation_checks_v1_0::reserved_zero) {
+        std::cerr << "FAILED: Profiles skip checks test - ingest did not stop at first failure" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Profiles skip checks test" << std::endl;
+    return true;
+}
+
+// Test signature handling: wrong key and unsigned packages
+bool test_signature_policy() {
+    const test_keys keys;
+    const std::vector<uint8_t> signed_package = create_package(keys, 1024);
+    const std::vector<uint8_t> unsigned_package = create_package(keys, 1024, false);
+
+    uint8_t wrong_key[32];
+    memcpy(wrong_key, keys.public_key, 32);
+    wrong_key[0] ^= 0x01;
+
+    vmprog_validation_policy_v1_0 boot = vmprog_validation_profile_boot;
+    boot.public_key = wrong_key;
+    vmprog_validation_checks_v1_0 failed = vmprog_validation_checks_v1_0::none;
+    if (validate_vmprog_package_with_policy(signed_package.data(), static_cast<uint32_t>(signed_package.size()), boot, &failed) !=
+            vmprog_validation_result::invalid_hash ||
+        failed != vmprog_validation_checks_v1_0::signature) {
+        std::cerr << "FAILED: Signature policy test - wrong key accepted" << std::endl;
+        return false;
+    }
+
+    // Boot requires a signed package; a permissive policy skips the check
+    boot.public_key = keys.public_key;
+    vmprog_validation_policy_v1_0 permissive = boot;
+    permissive.require_signed = false;
+    const uint32_t size = static_cast<uint32_t>(unsigned_package.size());
+    if (validate_vmprog_package_with_policy(unsigned_package.data(), size, boot) != vmprog_validation_result::invalid_hash ||
+        validate_vmprog_package_with_policy(unsigned_package.data(), size, permissive) != vmprog_validation_result::ok) {
+        std::cerr << "FAILED: Signature policy test - unsigned package handling incorrect" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Signature policy test" << std::endl;
+    return true;
+}
+
+// Test that boot rejects payloads swapped together with their unsigned TOC hashes
+bool test_signed_payload_binding() {
+    const test_keys keys;
+    vmprog_validation_policy_v1_0 boot = vmprog_validation_profile_boot;
+    boot.public_key = keys.public_key;
+
+    // Swapped bitstream with a matching TOC hash: payload_hashes passes, the signature step does not
+    std::vector<uint8_t> package = create_package(keys, 2048);
+    auto& header = *reinterpret_cast<vmprog_header_v1_0*>(package.data());
+    auto* toc = reinterpret_cast<vmprog_toc_entry_v1_0*>(package.data() + header.toc_offset);
+    memset(package.data() + toc[3].offset, 0xA5, toc[3].size);
+    sha256_oneshot(package.data() + toc[3].offset, toc[3].size, toc[3].sha256);
+    calculate_package_sha256(package.data(), header.file_size, header.sha256_package);
+    uint32_t size = static_cast<uint32_t>(package.size());
+
+    vmprog_validation_checks_v1_0 failed = vmprog_validation_checks_v1_0::none;
+    if (validate_vmprog_package_with_policy(package.data(), size, vmprog_validation_profile_ingest) != vmprog_validation_result::ok ||
+        validate_vmprog_package_with_policy(package.data(), size, boot, &failed) != vmprog_validation_result::invalid_hash ||
+        failed != vmprog_validation_checks_v1_0::signature) {
+        std::cerr << "FAILED: Signed payload binding test - swapped bitstream accepted" << std::endl;
+        return false;
+    }
+
+    // Signature alone hashes the payloads: a swapped bitstream is caught even with its signed TOC hash kept
+    vmprog_validation_policy_v1_0 signature_only = boot;
+    signature_only.checks = vmprog_validation_checks_v1_0::signature;
+    package = create_package(keys, 2048);
+    toc = reinterpret_cast<vmprog_toc_entry_v1_0*>(package.data() + sizeof(vmprog_header_v1_0));
+    if (validate_vmprog_package_with_policy(package.data(), size, signature_only) != vmprog_validation_result::ok) {
+        std::cerr << "FAILED: Signed payload binding test - signature-only policy rejected a valid package" << std::endl;
+        return false;
+    }
+    memset(package.data() + toc[3].offset, 0xA5, toc[3].size);
+    if (validate_vmprog_package_with_policy(package.data(), size, signature_only) != vmprog_validation_result::invalid_hash ||
+        validate_vmprog_package_with_policy(package.data(), size, boot, &failed) != vmprog_validation_result::invalid_hash ||
+        failed != vmprog_validation_checks_v1_0::payload_hashes) {
+        std::cerr << "FAILED: Signed payload binding test - swapped bitstream with signed TOC hash accepted" << std::endl;
+        return false;
+    }
+
+    // Same for a rewritten config
+    package = create_package(keys, 2048);
+    safe_strncpy(edit_config(package).program_name, "Swapped", sizeof(edit_config(package).program_name));
+    rehash(package);
+    if (validate_vmprog_package_with_policy(package.data(), size, boot, &failed) != vmprog_validation_result::invalid_hash ||
+        failed != vmprog_validation_checks_v1_0::signature) {
+        std::cerr << "FAILED: Signed payload binding test - swapped config accepted" << std::endl;
+        return false;
+    }
+
+    // A signed artifact missing from the TOC
+    package = create_package(keys, 2048);
+    toc = reinterpret_cast<vmprog_toc_entry_v1_0*>(package.data() + sizeof(vmprog_header_v1_0));
+    toc[3].type = vmprog_toc_entry_type_v1_0::bitstream_hd_hdmi;
+    if (validate_vmprog_package_with_policy(package.data(), size, boot) != vmprog_validation_result::invalid_toc_entry) {
+        std::cerr << "FAILED: Signed payload binding test - unsigned bitstream variant accepted" << std::endl;
+        return false;
+    }
+
+    std::cout << "PASSED: Signed payload binding test" << std::endl;
+    return true;
+}
+
+// Main test runner
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "Videomancer vmprog_validation_policy.hpp Tests" << std::endl;
+    std::cout << "============================================" << std::endl;
+    std::cout << std::endl;
+
+    int passed = 0;
+    int total = 0;
+
+    #define RUN_TEST(test_func) \
+        do { \
+            total++; \
+            if (test_func()) { \
+                passed++; \
+            } \
+        } while(0)
+
+    RUN_TEST(test_plan_order);
+    RUN_TEST(test_profiles_accept_valid);
+    RUN_TEST(test_matches_legacy_results);
+    RUN_TEST(test_profiles_skip_checks);
+    RUN_TEST(test_signature_policy);
+    RUN_TEST(test_signed_payload_binding);
+
+    std::cout << std::endl;
+    std::cout << "============================================" << std::endl;
+    std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
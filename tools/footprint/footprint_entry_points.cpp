@@ -0,0 +1,248 @@
+// Videomancer SDK - Footprint Entry Points
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+//
+// One out-of-line wrapper per public SDK entry point that firmware calls.
+// The footprint target compiles this file with -fstack-usage and
+// -fcallgraph-info so footprint_report.py can walk each wrapper's call tree
+// and report its worst-case stack depth. Every SDK call is inlined into its
+// wrapper or reached from it, so a wrapper's depth is the depth of the API.
+//
+// Wrappers are named vmfp_<api>. Objects that firmware owns for the length
+// of an operation are measured through vmfp_sizeof_<type> arrays, whose
+// symbol size equals sizeof(type) on the target.
+
+#include <lzx/videomancer/videomancer_fpga_configurator.hpp>
+#include <lzx/videomancer/videomancer_fpga_controller.hpp>
+#include <lzx/videomancer/videomancer_modulation_generators.hpp>
+#include <lzx/videomancer/videomancer_modulation_matrix.hpp>
+#include <lzx/videomancer/videomancer_program_switcher.hpp>
+#include <lzx/videomancer/vmprog_compact_config.hpp>
+#include <lzx/videomancer/vmprog_crypto.hpp>
+#include <lzx/videomancer/vmprog_format.hpp>
+#include <lzx/videomancer/vmprog_package_installer.hpp>
+#include <lzx/videomancer/vmprog_program_preloader.hpp>
+#include <lzx/videomancer/vmprog_stream_reader.hpp>
+#include <lzx/videomancer/vmprog_transfer_protocol.hpp>
+#include <lzx/videomancer/vmprog_validation_policy.hpp>
+
+using namespace lzx;
+
+#define VMFP_ENTRY extern "C" __attribute__((noinline, used))
+#define VMFP_SIZEOF(type) \
+    extern "C" __attribute__((used)) const unsigned char vmfp_sizeof_##type[sizeof(lzx::type)] = {}
+
+// Objects held by the caller
+VMFP_SIZEOF(vmprog_package_reader);
+VMFP_SIZEOF(vmprog_program_preloader);
+VMFP_SIZEOF(vmprog_package_installer);
+VMFP_SIZEOF(vmprog_transfer_receiver);
+VMFP_SIZEOF(vmprog_program_config_v1_0);
+VMFP_SIZEOF(vmprog_compact_config_view);
+VMFP_SIZEOF(videomancer_fpga_controller);
+VMFP_SIZEOF(videomancer_fpga_configurator);
+VMFP_SIZEOF(videomancer_program_switcher);
+VMFP_SIZEOF(videomancer_modulation_matrix);
+VMFP_SIZEOF(videomancer_modulation_generators);
+VMFP_SIZEOF(sha256_ctx);
+
+// Crypto primitives
+VMFP_ENTRY void vmfp_sha256_oneshot(const uint8_t* data, uint32_t length, uint8_t out[32])
+{
+    sha256_oneshot(data, length, out);
+}
+
+VMFP_ENTRY bool vmfp_ed25519_verify(const uint8_t sig[64], const uint8_t pubkey[32], const uint8_t* msg, size_t length)
+{
+    return ed25519_verify(sig, pubkey, msg, length);
+}
+
+// In-memory package validation
+VMFP_ENTRY bool vmfp_calculate_config_sha256(const vmprog_program_config_v1_0& config, uint8_t* out_hash)
+{
+    return calculate_config_sha256(config, out_hash);
+}
+
+VMFP_ENTRY vmprog_validation_result vmfp_validate_vmprog_program_config(const vmprog_program_config_v1_0& config)
+{
+    return validate_vmprog_program_config_v1_0(config);
+}
+
+VMFP_ENTRY vmprog_validation_result vmfp_validate_vmprog_package(const uint8_t* data, uint32_t size, const uint8_t* key)
+{
+    return validate_vmprog_package(data, size, true, key != nullptr, key);
+}
+
+VMFP_ENTRY bool vmfp_verify_with_builtin_keys(const uint8_t signature[64],
+                                              const vmprog_signed_descriptor_v1_0& descriptor, size_t* out_key_index)
+{
+    return verify_with_builtin_keys(signature, descriptor, out_key_index);
+}
+
+VMFP_ENTRY vmprog_validation_result vmfp_validate_vmprog_package_with_policy(
+    const uint8_t* data, uint32_t size, const vmprog_validation_policy_v1_0& policy)
+{
+    return validate_vmprog_package_with_policy(data, size, policy);
+}
+
+// Streaming package validation
+VMFP_ENTRY vmprog_validation_result vmfp_validate_vmprog_package_stream(
+    vmprog_stream& stream, uint32_t size, const uint8_t* key, uint8_t* scratch, uint32_t scratch_size)
+{
+    return validate_vmprog_package_stream(stream, size, true, key != nullptr, key, scratch, scratch_size);
+}
+
+VMFP_ENTRY vmprog_validation_result vmfp_validate_vmprog_package_selective_stream(
+    vmprog_stream& stream, uint32_t size, const uint8_t* key, uint8_t* scratch, uint32_t scratch_size,
+    vmprog_program_config_v1_0& out_config)
+{
+    return validate_vmprog_package_selective_stream(stream, size, vmprog_toc_entry_type_v1_0::fpga_bitstream,
+                                                    key, scratch, scratch_size, out_config);
+}
+
+VMFP_ENTRY vmprog_validation_result vmfp_read_and_validate_vmprog_config(
+    vmprog_stream& stream, const vmprog_toc_entry_v1_0& entry, vmprog_program_config_v1_0& out_config)
+{
+    return read_and_validate_vmprog_config(stream, entry, out_config);
+}
+
+VMFP_ENTRY vmprog_validation_result vmfp_package_reader_open(
+    vmprog_package_reader& reader, vmprog_stream& stream, uint32_t size, uint8_t* scratch, uint32_t scratch_size)
+{
+    return reader.open(stream, size, true, scratch, scratch_size);
+}
+
+VMFP_ENTRY vmprog_validation_result vmfp_package_reader_read_config(
+    vmprog_package_reader& reader, vmprog_program_config_v1_0& out_config)
+{
+    return reader.read_config(out_config);
+}
+
+// Compact config
+VMFP_ENTRY vmprog_validation_result vmfp_read_vmprog_compact_config(
+    vmprog_stream& stream, const vmprog_toc_entry_v1_0& entry, const vmprog_signed_descriptor_v1_0& descriptor,
+    uint8_t* buffer, uint32_t capacity, vmprog_compact_config_view& out_view)
+{
+    return read_vmprog_compact_config(stream, entry, descriptor, buffer, capacity, out_view);
+}
+
+VMFP_ENTRY vmprog_validation_result vmfp_compact_config_view_open(vmprog_compact_config_view& view,
+                                                                  const uint8_t* data, uint32_t size)
+{
+    return view.open(data, size);
+}
+
+VMFP_ENTRY bool vmfp_compact_config_view_find_parameter(const vmprog_compact_config_view& view,
+                                                        vmprog_parameter_id_v1_0 id,
+                                                        vmprog_compact_parameter_view& out)
+{
+    return view.find_parameter(id, out);
+}
+
+VMFP_ENTRY void vmfp_compact_config_view_expand(const vmprog_compact_config_view& view,
+                                                vmprog_program_config_v1_0& out)
+{
+    view.expand(out);
+}
+
+// Program loading
+VMFP_ENTRY bool vmfp_program_preloader_begin(vmprog_program_preloader& preloader, vmprog_stream& stream,
+                                             uint32_t size, vmprog_preload_sink& sink, const uint8_t* key)
+{
+    return preloader.begin(stream, size, vmprog_toc_entry_type_v1_0::fpga_bitstream, sink, key);
+}
+
+VMFP_ENTRY vmprog_preload_state vmfp_program_preloader_step(vmprog_program_preloader& preloader)
+{
+    return preloader.step();
+}
+
+VMFP_ENTRY bool vmfp_package_installer_begin(vmprog_package_installer& installer,
+                                             vmprog_install_target& target, const uint8_t* key)
+{
+    return installer.begin(target, key);
+}
+
+VMFP_ENTRY vmprog_install_state vmfp_package_installer_feed(vmprog_package_installer& installer,
+                                                            const uint8_t* data, uint32_t size)
+{
+    return installer.feed(data, size);
+}
+
+VMFP_ENTRY vmprog_transfer_state vmfp_transfer_receiver_poll(vmprog_transfer_receiver& receiver)
+{
+    return receiver.poll();
+}
+
+// FPGA configuration and program switching
+VMFP_ENTRY videomancer_configuration_result vmfp_fpga_configurator_configure(
+    videomancer_fpga_configurator& configurator, videomancer_fpga& fpga, vmprog_stream& stream,
+    const vmprog_toc_entry_v1_0& entry, const uint8_t* expected_sha256)
+{
+    return configurator.configure(fpga, stream, entry, expected_sha256);
+}
+
+VMFP_ENTRY videomancer_configuration_result vmfp_fpga_configurator_configure_memory(
+    videomancer_fpga_configurator& configurator, videomancer_fpga& fpga, const uint8_t* bitstream, uint32_t size)
+{
+    return configurator.configure(fpga, bitstream, size);
+}
+
+VMFP_ENTRY videomancer_configuration_result vmfp_program_switcher_switch_program(
+    videomancer_program_switcher& switcher, const vmprog_program_config_v1_0& config, vmprog_stream& stream,
+    const vmprog_toc_entry_v1_0& entry, const vmprog_signed_descriptor_v1_0& descriptor)
+{
+    return switcher.switch_program(config, stream, entry, descriptor);
+}
+
+VMFP_ENTRY videomancer_configuration_result vmfp_program_switcher_switch_program_memory(
+    videomancer_program_switcher& switcher, const vmprog_program_config_v1_0& config,
+    const uint8_t* bitstream, uint32_t size, const uint8_t sha256[32])
+{
+    return switcher.switch_program(config, bitstream, size, sha256);
+}
+
+// Control path
+VMFP_ENTRY bool vmfp_fpga_controller_set_all_controls(videomancer_fpga_controller& controller,
+                                                      const uint16_t pots[6], uint16_t slider,
+                                                      uint8_t switches, uint8_t timing_id)
+{
+    return controller.set_all_controls(pots, slider, switches, timing_id);
+}
+
+VMFP_ENTRY bool vmfp_fpga_controller_flush(videomancer_fpga_controller& controller)
+{
+    return controller.flush();
+}
+
+VMFP_ENTRY bool vmfp_fpga_controller_resync(videomancer_fpga_controller& controller,
+                                            const vmprog_program_config_v1_0& config)
+{
+    return controller.resync(config);
+}
+
+VMFP_ENTRY bool vmfp_fpga_controller_apply_initial_values(videomancer_fpga_controller& controller,
+                                                          const vmprog_program_config_v1_0& config)
+{
+    return controller.apply_initial_values(config);
+}
+
+// Modulation
+VMFP_ENTRY bool vmfp_modulation_matrix_tick(videomancer_modulation_matrix& matrix,
+                                            videomancer_fpga_controller& controller)
+{
+    return matrix.tick(controller);
+}
+
+VMFP_ENTRY bool vmfp_modulation_generators_tick(videomancer_modulation_generators& generators,
+                                                videomancer_fpga_controller& controller, uint32_t ticks)
+{
+    return generators.tick(controller, ticks);
+}
+
+VMFP_ENTRY bool vmfp_modulation_generators_tick_matrix(videomancer_modulation_generators& generators,
+                                                       videomancer_modulation_matrix& matrix,
+                                                       videomancer_fpga_controller& controller, uint32_t ticks)
+{
+    return generators.tick(matrix, controller, ticks);
+}
@@ -0,0 +1,242 @@
+#!/usr/bin/env python3
+# Copyright (C) 2025 LZX Industries LLC
+# SPDX-License-Identifier: GPL-3.0-only
+"""
+Videomancer SDK Stack and Static Memory Footprint Report
+
+Reads the GCC -fstack-usage (.su) and -fcallgraph-info=su (.ci) files
+written next to each object of the footprint target, computes the
+worst-case stack depth below every vmfp_* entry point, and lists the
+static RAM (.data and .bss) of the objects and the size of each
+vmfp_sizeof_* caller-held object. The result is compared against a
+budget file; any value over budget fails with exit status 1.
+
+Usage:
+    python footprint_report.py --nm NM --budgets FILE [--report FILE]
+                               [--bless] OBJECT...
+
+    --bless rewrites the budget file from the current measurement,
+    rounded up to the next 64 bytes.
+"""
+
+import argparse
+import re
+import subprocess
+import sys
+from pathlib import Path
+from typing import Dict, List, Optional, Set, Tuple
+
+ENTRY_PREFIX = 'vmfp_'
+SIZEOF_PREFIX = 'vmfp_sizeof_'
+BLESS_ROUNDING = 64
+
+NODE_RE = re.compile(r'node: \{ title: "([^"]+)" label: "([^"]*)"')
+EDGE_RE = re.compile(r'edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"')
+STACK_RE = re.compile(r'\\n(\d+) bytes \(([a-z,]+)\)')
+
+
+class CallGraph:
+    """Merged call graph of all objects"""
+
+    def __init__(self):
+        self.frames: Dict[str, int] = {}
+        self.qualifiers: Dict[str, str] = {}
+        self.labels: Dict[str, str] = {}
+        self.edges: Dict[str, List[str]] = {}
+
+    def load(self, ci_path: Path) -> None:
+        for line in ci_path.read_text().splitlines():
+            node = NODE_RE.search(line)
+            if node:
+                title, label = node.groups()
+                self.labels.setdefault(title, label.split('\\n')[0])
+                stack = STACK_RE.search(label)
+                if stack:
+                    self.frames[title] = int(stack.group(1))
+                    self.qualifiers[title] = stack.group(2)
+                continue
+            edge = EDGE_RE.search(line)
+            if edge:
+                source, target = edge.groups()
+                targets = self.edges.setdefault(source, [])
+                if target not in targets:
+                    targets.append(target)
+
+    def worst_path(self, root: str) -> Tuple[int, List[str], Set[str]]:
+        """
+        Deepest stack path below root.
+
+        Returns (bytes, path, notes). Notes name anything the depth cannot
+        account for: indirect calls, recursion, unbounded frames and
+        functions without stack information (libc, compiler runtime).
+        """
+        memo: Dict[str, Tuple[int, List[str]]] = {}
+        notes: Set[str] = set()
+
+        def visit(node: str, active: Set[str]) -> Tuple[int, List[str]]:
+            if node in memo:
+                return memo[node]
+            if node == '__indirect_call':
+                notes.add('indirect calls')
+                return 0, []
+            if node in active:
+                notes.add('recursion in ' + self.labels.get(node, node))
+                return 0, []
+            if node not in self.frames:
+                notes.add('no stack info for ' + self.labels.get(node, node))
+                return 0, [node]
+            qualifiers = self.qualifiers.get(node, '').split(',')
+            if 'dynamic' in qualifiers and 'bounded' not in qualifiers:
+                notes.add('unbounded frame in ' + self.labels.get(node, node))
+
+            active.add(node)
+            best_depth, best_path = 0, []
+            for target in self.edges.get(node, []):
+                depth, path = visit(target, active)
+                if depth > best_depth:
+                    best_depth, best_path = depth, path
+            active.discard(node)
+
+            result = (self.frames[node] + best_depth, [node] + best_path)
+            memo[node] = result
+            return result
+
+        depth, path = visit(root, set())
+        return depth, path, notes
+
+
+def read_symbols(nm: str, objects: List[Path]) -> Tuple[Dict[str, int], Dict[str, int]]:
+    """Return (static RAM by symbol, vmfp_sizeof_* sizes by type)"""
+    static_ram: Dict[str, int] = {}
+    sizes: Dict[str, int] = {}
+    output = subprocess.run([nm, '-S', '--size-sort'] + [str(o) for o in objects],
+                            check=True, capture_output=True, text=True).stdout
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) != 4:
+            continue
+        size, kind, name = int(fields[1], 16), fields[2], fields[3]
+        if name.startswith(SIZEOF_PREFIX):
+            sizes[name[len(SIZEOF_PREFIX):]] = size
+        elif kind in 'bBdD':
+            static_ram[name] = static_ram.get(name, 0) + size
+    return static_ram, sizes
+
+
+def load_budgets(path: Path) -> Dict[Tuple[str, str], int]:
+    """Budget lines: <stack|object|static> <name> <bytes>, # comments"""
+    budgets: Dict[Tuple[str, str], int] = {}
+    if not path.exists():
+        return budgets
+    for number, line in enumerate(path.read_text().splitlines(), 1):
+        line = line.split('#', 1)[0].strip()
+        if not line:
+            continue
+        fields = line.split()
+        if len(fields) != 3 or fields[0] not in ('stack', 'object', 'static'):
+            print(f"ERROR: {path}:{number}: expected '<stack|object|static> <name> <bytes>'", file=sys.stderr)
+            sys.exit(2)
+        budgets[(fields[0], fields[1])] = int(fields[2])
+    return budgets
+
+
+def write_budgets(path: Path, measured: Dict[Tuple[str, str], int]) -> None:
+    lines = [
+        '# Videomancer SDK footprint budgets (bytes)',
+        '# Regenerate with: cmake --build <dir> --target footprint-bless',
+        '',
+    ]
+    for kind in ('stack', 'object', 'static'):
+        for (k, name), value in sorted(measured.items()):
+            if k == kind:
+                rounded = (value + BLESS_ROUNDING - 1) // BLESS_ROUNDING * BLESS_ROUNDING
+                lines.append(f'{kind:<7}{name:<48}{rounded}')
+        lines.append('')
+    path.parent.mkdir(parents=True, exist_ok=True)
+    path.write_text('\n'.join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Videomancer SDK stack and static memory report')
+    parser.add_argument('--nm', default='nm', help='nm for the target toolchain')
+    parser.add_argument('--budgets', type=Path, required=True, help='Budget file')
+    parser.add_argument('--report', type=Path, help='Also write the report to this file')
+    parser.add_argument('--bless', action='store_true', help='Rewrite the budget file from this measurement')
+    parser.add_argument('objects', type=Path, nargs='+', help='Objects of the footprint target')
+    args = parser.parse_args()
+
+    graph = CallGraph()
+    for obj in args.objects:
+        ci_path = obj.with_suffix('.ci')
+        if not ci_path.exists():
+            print(f'ERROR: {ci_path} not found; build with -fcallgraph-info=su', file=sys.stderr)
+            sys.exit(2)
+        graph.load(ci_path)
+
+    static_ram, sizes = read_symbols(args.nm, args.objects)
+    entries = sorted(t for t in graph.frames if t.startswith(ENTRY_PREFIX))
+    if not entries:
+        print('ERROR: no vmfp_* entry points found', file=sys.stderr)
+        sys.exit(2)
+
+    measured: Dict[Tuple[str, str], int] = {}
+    report: List[str] = []
+    report.append('Worst-case stack per entry point')
+    report.append(f"  {'entry point':<48}{'bytes':>8}  deepest frame")
+    for entry in entries:
+        depth, path, notes = graph.worst_path(entry)
+        name = entry[len(ENTRY_PREFIX):]
+        measured[('stack', name)] = depth
+        frames = [(graph.frames.get(n, 0), graph.labels.get(n, n)) for n in path]
+        deepest = max(frames)[1] if frames else ''
+        report.append(f'  {name:<48}{depth:>8}  {deepest}')
+        for note in sorted(notes):
+            report.append(f"  {'':<48}{'':>8}  + {note}")
+
+    report.append('')
+    report.append('Caller-held objects')
+    for name, size in sorted(sizes.items()):
+        measured[('object', name)] = size
+        report.append(f'  {name:<48}{size:>8}')
+
+    report.append('')
+    report.append('Static RAM (.data + .bss)')
+    total = sum(static_ram.values())
+    measured[('static', 'total')] = total
+    for name, size in sorted(static_ram.items(), key=lambda item: -item[1])[:10]:
+        report.append(f'  {name:<48}{size:>8}')
+    report.append(f"  {'total':<48}{total:>8}")
+
+    if args.bless:
+        write_budgets(args.budgets, measured)
+        report.append('')
+        report.append(f'Budgets written to {args.budgets}')
+        failures: List[str] = []
+    else:
+        budgets = load_budgets(args.budgets)
+        failures = []
+        for key, value in sorted(measured.items()):
+            budget: Optional[int] = budgets.get(key)
+            if budget is None:
+                if budgets:
+                    failures.append(f'{key[0]} {key[1]}: {value} bytes has no budget')
+            elif value > budget:
+                failures.append(f'{key[0]} {key[1]}: {value} bytes exceeds budget of {budget}')
+        report.append('')
+        if not budgets:
+            report.append(f'No budgets in {args.budgets}; run the footprint-bless target to create them')
+        elif failures:
+            report.append('Over budget:')
+            report.extend('  ' + f for f in failures)
+        else:
+            report.append(f'All {len(measured)} values within budget')
+
+    text = '\n'.join(report) + '\n'
+    print(text, end='')
+    if args.report:
+        args.report.write_text(text)
+    sys.exit(1 if failures else 0)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,172 @@
+// Videomancer SDK - Virtual Device Emulator
+// Copyright (C) 2025 LZX Industries LLC
+// SPDX-License-Identifier: GPL-3.0-only
+//
+// Runs one or more virtual Videomancer units, each listening on its own Unix
+// domain socket. Control software connects with videomancer_socket_fpga and
+// drives the unit exactly as it would drive the SPI bus of real hardware.
+//
+// Usage: videomancer-virtual-device [--socket PREFIX] [--count N]
+//                                   [--timing ID] [--duration SECONDS]
+
+#include <lzx/videomancer/videomancer_virtual_device.hpp>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <poll.h>
+
+using namespace lzx;
+
+namespace
+{
+    volatile std::sig_atomic_t g_stop = 0;
+
+    void handle_signal(int)
+    {
+        g_stop = 1;
+    }
+
+    class steady_clock_us : public videomancer_clock
+    {
+    public:
+        uint64_t now_us() override
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+    };
+
+    struct unit
+    {
+        std::string path;
+        int listen_fd = -1;
+        int client_fd = -1;
+        std::unique_ptr<videomancer_virtual_device> device;
+        std::unique_ptr<videomancer_socket_server> server;
+    };
+
+    void print_usage(const char* program)
+    {
+        std::printf("Usage: %s [--socket PREFIX] [--count N] [--timing ID] [--duration SECONDS]\n", program);
+        std::printf("  --socket PREFIX     Socket path prefix (default /tmp/videomancer); unit i listens on PREFIX.i\n");
+        std::printf("  --count N           Number of virtual units (default 1)\n");
+        std::printf("  --timing ID         Video timing ID 0-14 (default 0, NTSC)\n");
+        std::printf("  --duration SECONDS  Exit after this many seconds (default: run until interrupted)\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string prefix = "/tmp/videomancer";
+    int count = 1;
+    int timing = 0;
+    double duration = 0.0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc)
+            prefix = argv[++i];
+        else if (std::strcmp(argv[i], "--count") == 0 && i + 1 < argc)
+            count = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--timing") == 0 && i + 1 < argc)
+            timing = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--duration") == 0 && i + 1 < argc)
+            duration = std::atof(argv[++i]);
+        else
+        {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    const auto timing_id = static_cast<videomancer_abi_v1_0::video_timing_id>(timing);
+    if (count < 1 || timing < 0 || timing > 15 || !videomancer_abi_v1_0::is_video_timing_defined(timing_id))
+    {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    std::signal(SIGINT, handle_signal);
+    std::signal(SIGTERM, handle_signal);
+
+    steady_clock_us clock;
+    videomancer_passthru_model program;
+    std::vector<unit> units(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i)
+    {
+        unit& u = units[static_cast<size_t>(i)];
+        u.path = prefix + "." + std::to_string(i);
+        u.listen_fd = videomancer_socket_listen(u.path.c_str());
+        if (u.listen_fd < 0)
+        {
+            std::fprintf(stderr, "Error: cannot listen on %s\n", u.path.c_str());
+            return 1;
+        }
+        u.device = std::make_unique<videomancer_virtual_device>(clock, &program);
+        u.device->reset(timing_id);
+        std::printf("Unit %d listening on %s\n", i, u.path.c_str());
+    }
+
+    const uint64_t start_us = clock.now_us();
+    std::vector<pollfd> fds(units.size());
+    while (!g_stop)
+    {
+        for (size_t i = 0; i < units.size(); ++i)
+        {
+            fds[i].fd = units[i].client_fd >= 0 ? units[i].client_fd : units[i].listen_fd;
+            fds[i].events = POLLIN;
+            fds[i].revents = 0;
+        }
+
+        // Wake at least once per millisecond so rasters keep running
+        ::poll(fds.data(), fds.size(), 1);
+
+        for (size_t i = 0; i < units.size(); ++i)
+        {
+            unit& u = units[i];
+            if (fds[i].revents & POLLIN)
+            {
+                if (u.client_fd < 0)
+                {
+                    u.client_fd = ::accept(u.listen_fd, nullptr, nullptr);
+                    if (u.client_fd >= 0)
+                        u.server = std::make_unique<videomancer_socket_server>(u.client_fd, u.device->registers());
+                }
+                else if (u.server->poll_once() < 0)
+                {
+                    ::close(u.client_fd);
+                    u.client_fd = -1;
+                    u.server.reset();
+                }
+            }
+            u.device->advance();
+        }
+
+        if (duration > 0.0 && static_cast<double>(clock.now_us() - start_us) >= duration * 1e6)
+            break;
+    }
+
+    std::printf("\n%-6s %10s %10s %10s %10s %10s\n", "Unit", "Writes", "Frames", "Lat min", "Lat mean", "Lat max");
+    for (size_t i = 0; i < units.size(); ++i)
+    {
+        unit& u = units[i];
+        const videomancer_latency_stats& lat = u.device->latency();
+        std::printf("%-6zu %10u %10u %8lluus %8lluus %8lluus\n", i,
+                    u.device->registers().accepted_write_count(),
+                    u.device->frame_count(),
+                    static_cast<unsigned long long>(lat.sample_count ? lat.min_us : 0),
+                    static_cast<unsigned long long>(lat.mean_us()),
+                    static_cast<unsigned long long>(lat.max_us));
+        if (u.client_fd >= 0)
+            ::close(u.client_fd);
+        ::close(u.listen_fd);
+        ::unlink(u.path.c_str());
+    }
+
+    return 0;
+}
@@ -69,6 +69,12 @@ SIGNED_DESCRIPTOR_SIZE = 332
 SIGNATURE_SIZE = 64
 ARTIFACT_HASH_SIZE = 36
 
+# Compact config (config_compact payload)
+COMPACT_CONFIG_MAGIC = 0x43434D56  # 'VMCC'
+COMPACT_CONFIG_VERSION = 1
+COMPACT_HEADER_SIZE = 52
+COMPACT_PARAMETER_SIZE = 20
+
 # Limits
 MAX_FILE_SIZE = 1048576  # 1 MB
 MAX_ARTIFACTS = 8
@@ -87,6 +93,7 @@ class TOCEntryType:
     BITSTREAM_HD_ANALOG = 8
     BITSTREAM_HD_HDMI = 9
     BITSTREAM_HD_DUAL = 10
+    CONFIG_COMPACT = 11
 
 # Header flags
 class HeaderFlags:
@@ -281,6 +288,74 @@ def validate_reserved_zero(data: bytes, offset: int, length: int, field_name: st
     return ValidationResult.OK
 
 
+# =============================================================================
+# Compact Config Encoding
+# =============================================================================
+
+# (offset, size) of the fixed config string fields, in encoding order
+PROGRAM_STRING_FIELDS = [
+    (0, 64),     # program_id
+    (86, 32),    # program_name
+    (118, 64),   # author
+    (182, 32),   # license
+    (214, 32),   # category
+    (246, 128),  # description
+    (374, 127),  # url (not required to be terminated; encoded like safe_strncpy)
+]
+PARAMETERS_OFFSET = 506
+PARAMETER_STRUCT_SIZE = 572
+
+
+def encode_compact_config(config_data: bytes) -> bytes:
+    """
+    Encode a fixed program config as a config_compact payload.
+
+    Byte-for-byte the same as encode_vmprog_compact_config() in
+    vmprog_compact_config.hpp: fixed numeric records plus a string table in
+    which every string reuses an existing NUL-terminated run when it can.
+    """
+    table = bytearray(b'\x00')
+
+    def add(offset: int, max_length: int) -> int:
+        raw = config_data[offset:offset + max_length]
+        text = raw.split(b'\x00', 1)[0]
+        position = table.find(text + b'\x00')
+        if position >= 0:
+            return position
+        position = len(table)
+        table.extend(text + b'\x00')
+        return position
+
+    parameter_count = struct.unpack_from('<H', config_data, 502)[0]
+    string_offsets = [add(offset, size) for offset, size in PROGRAM_STRING_FIELDS]
+
+    records = bytearray()
+    labels = bytearray()
+    label_count = 0
+    for i in range(parameter_count):
+        base = PARAMETERS_OFFSET + i * PARAMETER_STRUCT_SIZE
+        parameter_id, control_mode, min_value, max_value, initial_value, display_min, display_max, \
+            float_digits, value_label_count = struct.unpack_from('<IIHHHhhBB', config_data, base)
+        name_label = add(base + 22, 32)
+        suffix_label = add(base + 566, 4)
+        records += struct.pack('<BBBBHHHhhHHH', parameter_id, control_mode, float_digits, value_label_count,
+                               min_value, max_value, initial_value, display_min, display_max,
+                               name_label, suffix_label, label_count)
+        for j in range(value_label_count):
+            labels += struct.pack('<H', add(base + 54 + j * 32, 32))
+        label_count += value_label_count
+
+    versions = struct.unpack_from('<7H', config_data, 64)
+    hw_mask, core_id = struct.unpack_from('<II', config_data, 78)
+    header = struct.pack('<IHHHH7HII7H2H', COMPACT_CONFIG_MAGIC, COMPACT_CONFIG_VERSION, parameter_count,
+                         label_count, len(table), *versions, hw_mask, core_id, *string_offsets, 0, 0)
+    assert len(header) == COMPACT_HEADER_SIZE
+    payload = header + bytes(records) + bytes(labels) + bytes(table)
+    if len(payload) > PROGRAM_CONFIG_SIZE:
+        raise ValueError(f"Compact config is {len(payload)} bytes, larger than the fixed config")
+    return payload
+
+
 # =============================================================================
 # Bitstream Detection
 # =============================================================================
@@ -325,7 +400,7 @@ def find_bitstreams(input_dir: Path) -> List[BitstreamFile]:
 # Package Building
 # =============================================================================
 
-def build_vmprog_package(input_dir: Path, output_path: Path, sign: bool = True, keys_dir: Optional[Path] = None, hardware: Optional[str] = None, toml_path: Optional[Path] = None) -> bool:
+def build_vmprog_package(input_dir: Path, output_path: Path, sign: bool = True, keys_dir: Optional[Path] = None, hardware: Optional[str] = None, toml_path: Optional[Path] = None, compact_config: bool = False) -> bool:
     """
     Build a complete .vmprog package from input directory.
 
@@ -336,6 +411,7 @@ def build_vmprog_package(input_dir: Path, output_path: Path, sign: bool = True,
         keys_dir: Directory containing Ed25519 keys (default: ./keys relative to script)
         hardware: Hardware name to build for (e.g., 'rev_a')
         toml_path: Path to program TOML file for validation
+        compact_config: If True, also add a config_compact entry (signed as an artifact)
 
     Returns:
         True if successful, False otherwise
@@ -430,10 +506,19 @@ def build_vmprog_package(input_dir: Path, output_path: Path, sign: bool = True,
     toc_entries: List[TOCEntry] = []
     payloads: List[bytes] = []
 
+    # Compact encoding of the same config (after any hardware mask change)
+    compact_data = b''
+    if compact_config:
+        if len(bitstreams) + 1 > MAX_ARTIFACTS:
+            print(f"ERROR: No artifact slot left for the compact config")
+            return False
+        compact_data = encode_compact_config(config_data)
+        print(f"Compact config: {len(compact_data)} bytes ({len(config_data)} fixed)")
+
     # Calculate TOC offset and payload start
     toc_offset = HEADER_SIZE
-    # config + signed_descriptor + (optional signature) + bitstreams
-    toc_count = 1 + 1 + (1 if will_sign else 0) + len(bitstreams)
+    # config + (optional compact config) + signed_descriptor + (optional signature) + bitstreams
+    toc_count = 1 + (1 if compact_data else 0) + 1 + (1 if will_sign else 0) + len(bitstreams)
     toc_bytes = toc_count * TOC_ENTRY_SIZE
     payload_offset = toc_offset + toc_bytes
 
@@ -456,6 +541,24 @@ def build_vmprog_package(input_dir: Path, output_path: Path, sign: bool = True,
     print(f"  Size: {toc_entries[0].size}")
     print(f"  Hash: {config_hash.hex()[:16]}...")
 
+    # Add compact config entry
+    if compact_data:
+        compact_hash = calculate_sha256(compact_data)
+        toc_entries.append(TOCEntry(
+            entry_type=TOCEntryType.CONFIG_COMPACT,
+            flags=0,
+            offset=current_offset,
+            size=len(compact_data),
+            sha256=compact_hash
+        ))
+        payloads.append(compact_data)
+        current_offset += len(compact_data)
+
+        print(f"\nTOC Entry 1: CONFIG_COMPACT")
+        print(f"  Offset: {toc_entries[1].offset}")
+        print(f"  Size: {toc_entries[1].size}")
+        print(f"  Hash: {compact_hash.hex()[:16]}...")
+
     # Build signed descriptor
     print(f"\nBuilding signed descriptor...")
     signed_descriptor = bytearray(SIGNED_DESCRIPTOR_SIZE)
@@ -463,20 +566,25 @@ def build_vmprog_package(input_dir: Path, output_path: Path, sign: bool = True,
     # config_sha256 (32 bytes at offset 0)
     signed_descriptor[0:32] = config_hash
 
+    # Artifacts: bitstreams, then the compact config if present
+    artifacts = [(bitstream.entry_type, bitstream.data) for bitstream in bitstreams]
+    if compact_data:
+        artifacts.append((TOCEntryType.CONFIG_COMPACT, compact_data))
+
     # artifact_count (1 byte at offset 32)
-    artifact_count = min(len(bitstreams), MAX_ARTIFACTS)
+    artifact_count = min(len(artifacts), MAX_ARTIFACTS)
     struct.pack_into('<B', signed_descriptor, 32, artifact_count)
 
     # reserved_pad (3 bytes at offset 33-35) - already zero-filled
 
     # artifacts (288 bytes = 8 × 36 bytes, at offset 36)
     artifact_offset = 36
-    for i, bitstream in enumerate(bitstreams[:MAX_ARTIFACTS]):
-        bitstream_hash = calculate_sha256(bitstream.data)
+    for artifact_type, artifact_data in artifacts[:MAX_ARTIFACTS]:
+        artifact_hash = calculate_sha256(artifact_data)
         # artifact type (4 bytes)
-        struct.pack_into('<I', signed_descriptor, artifact_offset, bitstream.entry_type)
+        struct.pack_into('<I', signed_descriptor, artifact_offset, artifact_type)
         # artifact sha256 (32 bytes)
-        signed_descriptor[artifact_offset + 4:artifact_offset + 36] = bitstream_hash
+        signed_descriptor[artifact_offset + 4:artifact_offset + 36] = artifact_hash
         artifact_offset += ARTIFACT_HASH_SIZE
 
     # flags (4 bytes at offset 324)
@@ -499,9 +607,9 @@ def build_vmprog_package(input_dir: Path, output_path: Path, sign: bool = True,
     payloads.append(bytes(signed_descriptor))
     current_offset += len(signed_descriptor)
 
-    print(f"\nTOC Entry 1: SIGNED_DESCRIPTOR")
-    print(f"  Offset: {toc_entries[1].offset}")
-    print(f"  Size: {toc_entries[1].size}")
+    print(f"\nTOC Entry {len(toc_entries) - 1}: SIGNED_DESCRIPTOR")
+    print(f"  Offset: {toc_entries[-1].offset}")
+    print(f"  Size: {toc_entries[-1].size}")
     print(f"  Artifact count: {artifact_count}")
     print(f"  Build ID: 0x{build_id:08X}")
     print(f"  Hash: {descriptor_hash.hex()[:16]}...")
@@ -524,9 +632,9 @@ def build_vmprog_package(input_dir: Path, output_path: Path, sign: bool = True,
             payloads.append(signature)
             current_offset += len(signature)
 
-            print(f"\nTOC Entry 2: SIGNATURE")
-            print(f"  Offset: {toc_entries[2].offset}")
-            print(f"  Size: {toc_entries[2].size}")
+            print(f"\nTOC Entry {len(toc_entries) - 1}: SIGNATURE")
+            print(f"  Offset: {toc_entries[-1].offset}")
+            print(f"  Size: {toc_entries[-1].size}")
             print(f"  Hash: {signature_hash.hex()[:16]}...")
             print(f"  Signature: {signature.hex()[:32]}...")
         except Exception as e:
@@ -534,8 +642,7 @@ def build_vmprog_package(input_dir: Path, output_path: Path, sign: bool = True,
             return False
 
     # Add bitstream entries
-    bitstream_start_idx = 2 if will_sign else 1
-    for i, bitstream in enumerate(bitstreams):
+    for bitstream in bitstreams:
         bitstream_hash = calculate_sha256(bitstream.data)
         toc_entries.append(TOCEntry(
             entry_type=bitstream.entry_type,
@@ -548,8 +655,7 @@ def build_vmprog_package(input_dir: Path, output_path: Path, sign: bool = True,
 
         entry_type_name = [k for k, v in vars(TOCEntryType).items()
                           if not k.startswith('_') and v == bitstream.entry_type][0]
-        toc_entry_idx = bitstream_start_idx + 1 + i
-        print(f"\nTOC Entry {toc_entry_idx}: {entry_type_name}")
+        print(f"\nTOC Entry {len(toc_entries) - 1}: {entry_type_name}")
         print(f"  File: {bitstream.path.name}")
         print(f"  Offset: {current_offset}")
         print(f"  Size: {len(bitstream.data)}")
@@ -831,7 +937,7 @@ def validate_signed_descriptor(data: bytes, offset: int) -> int:
         artifact_type = struct.unpack_from('<I', data, artifact_offset)[0]
 
         # Check artifact type is valid
-        if artifact_type < TOCEntryType.FPGA_BITSTREAM or artifact_type > TOCEntryType.BITSTREAM_HD_DUAL:
+        if artifact_type < TOCEntryType.FPGA_BITSTREAM or artifact_type > TOCEntryType.CONFIG_COMPACT:
             return ValidationResult.INVALID_ENUM_VALUE
 
     return ValidationResult.OK
@@ -909,6 +1015,7 @@ Example:
   python vmprog_pack.py ./build/programs/passthru ./output/passthru.vmprog
   python vmprog_pack.py --no-sign ./build/programs/passthru ./output/passthru.vmprog
   python vmprog_pack.py --keys-dir ./my_keys ./build/programs/passthru ./output/passthru.vmprog
+  python vmprog_pack.py --compact-config ./build/programs/passthru ./output/passthru.vmprog
         """
     )
 
@@ -924,6 +1031,8 @@ Example:
                        help='Hardware name to build for (e.g., rev_a). Will validate against hardware_compatibility field.')
     parser.add_argument('--toml-path', type=Path, default=None,
                        help='Path to program TOML file for hardware validation')
+    parser.add_argument('--compact-config', action='store_true',
+                       help='Also add a compact config entry (string table encoding, needs firmware that accepts TOC type 11)')
 
     args = parser.parse_args()
 
@@ -942,7 +1051,8 @@ Example:
 
     # Build package
     success = build_vmprog_package(input_dir, output_path, sign=sign, keys_dir=keys_dir,
-                                   hardware=args.hardware, toml_path=args.toml_path)
+                                   hardware=args.hardware, toml_path=args.toml_path,
+                                   compact_config=args.compact_config)
     if not success:
         print("\nERROR: Package creation failed")
         sys.exit(1)